@@ -0,0 +1,352 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Benchmark harness: sample registry, timers, report and command line */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+// Safe primes for Paillier and Pedersen key generation
+static char *PT_hex[BENCH_MAX_PLAYERS] =
+{
+    "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67",
+    "db47424304e2c5d57f50f6f73881eef53f55ea680d9f48b57df3e404303442c7fa5bd9418c5928cbe3b293281bdf8dce0350d7c65f22acfcf6b0fe5442fdb0c61bf396d13bc81992392d67c260a596b88eebe25661859fbcc8e871760794a3b810da2e881bb0cec6ca9310375d37bcc867436152ee71c59508220c8fbc6d9783",
+    "c883b3abc4b6dd37e41d7bcf2b326442a58a874089691af7dd5a4a039f30551b2b2c11aa1a0dd0cfdc66d5a1ed311d6e331599faec066af94f65ebbdc7b1c9813da0216de612e340a7381a6b73d692bdb093f307fc904b0a44b63b478a88454c05730ba2ea071006ab4132bdfc3bc94994f8958636e7e7a1564117cc543043bb",
+    "ccb0d6ca8525fe14d283a29b4a673ef0b5dae276ff60dc346cb28a83144b3f2f788f7876e817e58eb2944f51cc4b15a815b30f8dfffacf2cac2ddab94a2ff5ac0e14adc2f56ec6bb9bcb66988c165ecb530bd7abc8c7068be9fbc66d53cbd6f42f07b4accab7019d09ec73286d2406d10748209cc0bb1b2d03da14cc7cb7ebdb",
+    "d4bb5a43bc21ea77eab86aca9636d4e7c0d2596d8bc3a00c1ae26a3e442fa2530fbdb8f93e2fd14fa8e26809e5d27b193cdb092fc1c287aba9d132f54764cd95abc77c6e007cc588022a3ff4910ca54f8ea23e836bf6baaec3b701bb0a1a68a3f2af825971f70f347ea260e6e3bd9cf922229f6c366a4c0e113a4f5f45bfb54f",
+    "D1C72114B7EC80C0BBFBF512FB4B52CA7F0EABCB5FC5ACF31A14CDB49BB4C95C213160351B39FD154DB3F783AB8A3F09999719368CF254401EBD8F64A13E4F3E65C4B96DD2F1A48D1812548DD8655245111E37469DE300A288E60D1E3674FEF99BB0C2E17188370B470A5F8851CA1F0C6E7B1020D1192F30EDB6A90777CC3957",
+    "FB309114DA74B0E1B9D65B59F638B72C0B76EC2A5C2B3BE6DFDA2DCFBBE9D073FAFFDCEB712A714E60C697563E1312D6BA3B3808365EE6974022A25541EF2DAB4151DF021575C3A67BE746782ABDE4A371A24BEB615E769AD8AD46FAA6113A2E12C605C923EF22014A6FD7F22C1CA1F13B988C21B73A0F232BE300C1084D1A23",
+    "E70CA10EE2675809EB6565A9D54799B5947E2090947F22EA8D2A55A33B9B395DC5F626C0F5E46FE438D55867F9752422A3109A1F764F5A4C455252F931C53C38788A133EEAE2D34604A7162B0AA5F89733A32259BB4AA1C20E2FD190F57F425E6C6B6A1F744C417BE1C66C9F436A52650E438F23D5002C5C0C25A41686B5BC6B",
+    "F4238DB0B6237AB1170A75140F50B1344EAFA15127F8027D210A525720BEF0675F9829CDB3917A7AB5728E5A8276E7A6A610D2A73DD8DDC6BEB96BDB72C5B3A8D52DA46B919E6765568076F5C59A771E6C651D480E00FA71580092D2C94037D14F1281215F5C1718BB5D72254787AD771A75DA6C5D33C5976DEFA898BF7304B3",
+    "D03E9702648056ACA9D252A2E17F6BBC215BE40CB76DFC6C2F36BBD3DF380378321AE0C06578FB363BA364D34EAE96F6C3D0484BC753776BDA60097A681A2F36C9377B50347A1F8C3A1BEBB571E05278B35ACF6546D586C0EFCB22A884882ECE480A4CFA648756594F6F2D81CA964C55A6FFCE64221223D7D56965BCC060FFC3",
+    "F63594C1249574BD9BD30172B6D162D01069668C1063A0FA21465DF634F6C334DAE8E07EC34AEBACCBE38A5B5D88969F3EEB518562E7180B97FE022F959D0E0A32D1501162EB4F56C1B224994D8639366EE4A53B767E50BB45F2AC40210D2CFE154B0E442467293AB98EB054B549600666736503BD39C19B530315C668D63F67",
+    "D26E19247917D3EDB99F1960983F2290A1FB7510DB823816BF509B0D5B30D3066185E763230DD236E9C71829B323D5BF47E3062CDEE566D44978F542D4B41215FD5736F0A054F7AB610F6553D5BC1A75225D093D87017173DF2F299525273C22CFECA575D67912BF2D3551BADBFA331BCE6D58531E4466E108518C47BEB180A7"
+};
+
+static char *QT_hex[BENCH_MAX_PLAYERS] =
+{
+    "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b",
+    "ec9732ba347856682086c6538a7a642e18fc409846d25a33afe835a6c0f71e73c70c4ab664c73e1c48750e53e3f86730f8c25f02d8836151be2d0a1575e291dae444d09d5568287ec8fbb7a2bc7a90ddd30d71d33190a521d7f3600ee4a1be514004bd650f100a0fc0e75e202d13fbde36a2bf055a6de03ba8d8fa968a619be3",
+    "ff095fd68d025eb5051e4d06c3b581ce23cd599013bdb9485b3775df8f4af936b6b60906269f48380f71fa49eb04970ab15e4d5ed2b1bbcfc1c2b5f8ed1ee5bee8a8d791dbe3e420f672aeb5d830c632ddc02de95b042ea943341ed73bab492ca32f1ba4c0cdace982e8c1c249e5c92a39e272b79eb09caf294fee74a42a330f",
+    "e93b9900d422108975781193a0b52bd466ed584946251148a37d952df2da8d6366869823aff52b7435ade7ac8a21424db364a63fb2a04375361fe145d3f57cf43fa1cc1b6f52f58ad10ec8f0a9de8bf20a4bb4bcdb82a41eb07e2f1265ebb5d0d490e606dff1a2f5c09fbf3aa68ee4bcc1cb7291ddfad691a27ff277e6126c7b",
+    "e15a6a18a7b6bf0893c00526202ea5fcb7cde901f780406ea78ca951459ce3130fd65687badb4a8e41bbe676c672ff7b5914ca983bf0937fe5f423f2e655b144302a3ae17d2a3f1ef9d779baac67939924ba1a0210d37bc2badb90c76d38daa74704eb93cec5588f2452b9829511332cc7e5933e08392839b79a8cd8336948ab",
+    "F890B673647DE4FEA41CAA06907E226F446166ADCE49B635FB6504B4EDD6501B53AD3E68A0859D22E7FE461C8DAAAAACEC197407A942A85C461FD1E1A46DDE694EB41E9E72FAC45ED7ECE12253AA3363AAA61409372A27ED5A2D3BD6FF59FC26B9E0EFA76CD17AD9128821B32B2D7887934838B12E05C5E0AD7399876BFADF97",
+    "D022D76DED4A8DFA49926E60ED0148C34E839973682633D4D8168E4B58DC950367BB262F92780924D6A54CB2D3592D203DFC1E5057022993310596885263C4B521BBFF4BAE2C86E3731F32A6C5F048558B7B358788FB3C1B1A5B6FBD106D92B49C0982F3F085BE1DD6C0C1DFBCF150ECAE1265C71B1F4B36F8ABC9C363A3A72F",
+    "C56AFD488DC3E731BC8C45B290464CE5E2972BDA7586B81BBF8102E04AC5F6BBC73CF0B6F7467CF6AD7833F0CCF43EEE14DCB203C6B98801BB0E021591DB04872BF26352E540068094F03C7C549D3D377170B7DFAC5810ED91ED4158C655242C25B2F494664BDFEB86DC877C53F4E755670185E542489423A7134CB9D85210F7",
+    "D8CE89E0ED56A6BB6C65B65FF0DAE68B8A65675D5FC3A415CF54126DBC1580FAB23C5FDDD603A8395D80C284440643FF33BFE84E9275AC95CDA2CC29FCD2A16AE4F20F3D22CEF9AB33833A25507C4EE70D24110493192A619FC1298341A6FDA48D91DCB01C0AA402AB311CF88227832BD3025ED4850C824AAF0D4E235CC6F813",
+    "C346063FEC83F926B44F55785F079233D6FB13814A5EC3D98F7756C5EF4D5FB7B5523DD9122592151865E12F02F87FE8F005024E814AEC3DACBD66F3C2CFCA3EB6397ECE6F04BCC1EE0B1B7CF34CE7AA611B50C1622738ADFFDCF55AA270C86BA104386F9F58C5758F4B02B7F44174B2B8429BABDC263DB4D2576CE0BEB70503",
+    "D522D84AA79E269413631D526B11D09A621F717A585385033109EC8F7A1A0DBFE74572B6C9BAA2D9AE8B8E994A08B97531A2D4852BF077314205599EA0A4EECC1535620AD88BC5C54BED9ED0BB00607063AF31B9D9DC13499E66125E2C998CCA8C6FF82B328011D3BC5680477981EA34B39385D8A44BB0F44DEEA5D43854EE17",
+    "D365FE411E7F07CC94B6377126BD9EE5D133F1908B6EECF514D7ABC91BF6C3BA7818E7EFD5F12092C8D733A69CF0BAB8212271BFF54F44387AD61B4E7A204459CE55230E749F799968729E8A40251803091200D1E8D35138CD827E40EFF9C3A5FB64AB444E5D7F0F0AFB8CFFA6B830C4B0E4B93CBBFC20B28B795C396EF28F5F"
+};
+
+typedef struct
+{
+    const char *name;
+    uint64_t *ns;
+    uint64_t *cycles;
+    int count;
+    int max;
+} BENCH_ENTRY;
+
+typedef struct BENCH_CHUNK
+{
+    struct BENCH_CHUNK *next;
+} BENCH_CHUNK;
+
+static BENCH_ENTRY entries[BENCH_MAX_ENTRIES];
+static int n_entries = 0;
+static BENCH_CHUNK *chunks = NULL;
+
+uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int lo;
+    unsigned int hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((uint64_t)hi << 32) | lo;
+#else
+    return 0;
+#endif
+}
+
+static void *bench_xalloc(void *p, size_t size)
+{
+    void *q = realloc(p, size);
+    if (q == NULL)
+    {
+        fprintf(stderr, "FAILURE out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return q;
+}
+
+void bench_record(const char *name, uint64_t ns, uint64_t cycles)
+{
+    BENCH_ENTRY *e = NULL;
+
+    for (int i = 0; i < n_entries; i++)
+    {
+        if (strcmp(entries[i].name, name) == 0)
+        {
+            e = entries + i;
+            break;
+        }
+    }
+
+    if (e == NULL)
+    {
+        if (n_entries == BENCH_MAX_ENTRIES)
+        {
+            fprintf(stderr, "FAILURE too many entry points, increase BENCH_MAX_ENTRIES\n");
+            exit(EXIT_FAILURE);
+        }
+        e = entries + n_entries++;
+        e->name = name;
+    }
+
+    if (e->count == e->max)
+    {
+        e->max = (e->max == 0) ? 64 : 2 * e->max;
+        e->ns = bench_xalloc(e->ns, e->max * sizeof(uint64_t));
+        e->cycles = bench_xalloc(e->cycles, e->max * sizeof(uint64_t));
+    }
+
+    e->ns[e->count] = ns;
+    e->cycles[e->count] = cycles;
+    e->count++;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest rank percentile of a sorted sample
+static uint64_t percentile(const uint64_t *sorted, int count, int pct)
+{
+    int rank = (pct * count + 99) / 100;
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    return sorted[rank - 1];
+}
+
+void bench_report(const BENCH_CONFIG *cfg)
+{
+    if (cfg->csv)
+    {
+        printf("name,t,n,calls,ops_per_sec,p50_us,p99_us,cycles_per_op\n");
+    }
+    else
+    {
+        printf("\n(t, n) = (%d, %d), %d iteration(s)\n\n", cfg->t, cfg->n, cfg->iterations);
+        printf("%-44s %8s %12s %12s %12s %14s\n", "entry point", "calls", "ops/sec", "p50 (us)", "p99 (us)", "cycles/op");
+    }
+
+    for (int i = 0; i < n_entries; i++)
+    {
+        BENCH_ENTRY *e = entries + i;
+        uint64_t total_ns = 0;
+        uint64_t total_cycles = 0;
+
+        if (cfg->filter != NULL && strstr(e->name, cfg->filter) == NULL)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < e->count; j++)
+        {
+            total_ns += e->ns[j];
+            total_cycles += e->cycles[j];
+        }
+
+        qsort(e->ns, e->count, sizeof(uint64_t), cmp_u64);
+
+        double ops = (total_ns == 0) ? 0.0 : (double)e->count * 1e9 / (double)total_ns;
+        double p50 = (double)percentile(e->ns, e->count, 50) / 1e3;
+        double p99 = (double)percentile(e->ns, e->count, 99) / 1e3;
+        double cpo = (double)total_cycles / (double)e->count;
+
+        if (cfg->csv)
+        {
+            printf("%s,%d,%d,%d,%.3f,%.3f,%.3f,%.0f\n", e->name, cfg->t, cfg->n, e->count, ops, p50, p99, cpo);
+        }
+        else
+        {
+            printf("%-44s %8d %12.3f %12.3f %12.3f %14.0f\n", e->name, e->count, ops, p50, p99, cpo);
+        }
+    }
+}
+
+void bench_check(const char *name, int rc, int ok)
+{
+    if (rc != ok)
+    {
+        fprintf(stderr, "FAILURE %s returned %d\n", name, rc);
+        exit(EXIT_FAILURE);
+    }
+}
+
+void *bench_alloc(size_t size)
+{
+    BENCH_CHUNK *c = bench_xalloc(NULL, sizeof(BENCH_CHUNK) + size);
+    memset(c, 0, sizeof(BENCH_CHUNK) + size);
+
+    c->next = chunks;
+    chunks = c;
+
+    return c + 1;
+}
+
+octet *bench_octets(int count, int max)
+{
+    octet *O = bench_alloc(count * sizeof(octet));
+    char *mem = bench_alloc((size_t)count * max);
+
+    for (int i = 0; i < count; i++)
+    {
+        O[i].len = 0;
+        O[i].max = max;
+        O[i].val = mem + (size_t)i * max;
+    }
+
+    return O;
+}
+
+void bench_free_all(void)
+{
+    while (chunks != NULL)
+    {
+        BENCH_CHUNK *next = chunks->next;
+        free(chunks);
+        chunks = next;
+    }
+}
+
+void bench_load_keys(csprng *RNG, BENCH_KEYS *keys, int n)
+{
+    keys->n = n;
+    keys->P = bench_octets(n, HFS_2048);
+    keys->Q = bench_octets(n, HFS_2048);
+    keys->paillier = bench_alloc(n * sizeof(CG21_PAILLIER_KEYS));
+    keys->pedersen = bench_alloc(n * sizeof(CG21_PEDERSEN_KEYS));
+
+    for (int i = 0; i < n; i++)
+    {
+        OCT_fromHex(keys->P + i, PT_hex[i]);
+        OCT_fromHex(keys->Q + i, QT_hex[i]);
+
+        BENCH_TIME("PAILLIER_KEY_PAIR",
+                   PAILLIER_KEY_PAIR(NULL, keys->P + i, keys->Q + i, &keys->paillier[i].paillier_pk,
+                                     &keys->paillier[i].paillier_sk));
+
+        BENCH_TIME("ring_Pedersen_setup",
+                   ring_Pedersen_setup(RNG, &keys->pedersen[i].pedersenPriv, keys->P + i, keys->Q + i));
+
+        Pedersen_get_public_param(&keys->pedersen[i].pedersenPub, &keys->pedersen[i].pedersenPriv);
+    }
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [-t t] [-n n] [-i iterations] [-f filter] [-c]\n", name);
+    printf("Time every public entry point of the library\n");
+    printf("\n");
+    printf("  -t  Threshold. 2 <= t <= n (default 2)\n");
+    printf("  -n  Number of players. 2 <= n <= %d (default 3)\n", BENCH_MAX_PLAYERS);
+    printf("  -i  Number of full protocol runs (default 5)\n");
+    printf("  -f  Only report entry points whose name contains filter\n");
+    printf("  -c  Print the report as CSV\n");
+    printf("\n");
+    printf("Example:\n");
+    printf("  %s -t 3 -n 5 -i 10 -f PRESIGN\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    BENCH_CONFIG cfg = {2, 3, 5, NULL, 0};
+    BENCH_KEYS keys;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-c") == 0)
+        {
+            cfg.csv = 1;
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-t") == 0)
+        {
+            cfg.t = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0)
+        {
+            cfg.n = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-i") == 0)
+        {
+            cfg.iterations = atoi(argv[++i]);
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "-f") == 0)
+        {
+            cfg.filter = argv[++i];
+        }
+        else
+        {
+            usage(argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (cfg.t < 2 || cfg.n < cfg.t || cfg.n > BENCH_MAX_PLAYERS || cfg.iterations < 1)
+    {
+        usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // Deterministic RNG, the benchmark does not need fresh entropy
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    bench_load_keys(&RNG, &keys, cfg.n);
+
+    bench_primitives(&RNG, &cfg, &keys);
+    bench_cg21(&RNG, &cfg, &keys);
+
+    bench_report(&cfg);
+
+    bench_free_all();
+    KILL_CSPRNG(&RNG);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/**
+ * @file bench.h
+ * @brief Benchmark harness for the MPC library
+ *
+ * Every public entry point is timed individually. Samples are
+ * collected per entry point name and reported as ops/sec,
+ * p50/p99 latency and cycles/op.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <amcl/amcl.h>
+#include <amcl/randapi.h>
+#include <amcl/paillier.h>
+#include "amcl/cg21/cg21_utilities.h"
+#include "amcl/cg21/cg21.h"
+#include "amcl/cg21/cg21_presign_pool.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define BENCH_MAX_ENTRIES 160   /**< Maximum number of distinct timed entry points */
+#define BENCH_MAX_PLAYERS 12    /**< Number of safe prime pairs available for Paillier/Pedersen keys */
+
+/*! \brief Benchmark configuration */
+typedef struct
+{
+    int t;              /**< Threshold */
+    int n;              /**< Number of players */
+    int iterations;     /**< Number of full protocol runs */
+    const char *filter; /**< Only report entry points containing this string */
+    int csv;            /**< Print the report as CSV */
+} BENCH_CONFIG;
+
+/*! \brief Long term keys shared by the CG21 and ZKP benchmarks */
+typedef struct
+{
+    int n;
+    CG21_PAILLIER_KEYS *paillier;   /**< Paillier key pair per player */
+    CG21_PEDERSEN_KEYS *pedersen;   /**< Ring Pedersen parameters per player */
+    octet *P;                       /**< Safe prime P per player */
+    octet *Q;                       /**< Safe prime Q per player */
+} BENCH_KEYS;
+
+/** \brief Monotonic clock in nanoseconds
+ *
+ *  @return current time in nanoseconds
+ */
+extern uint64_t bench_now_ns(void);
+
+/** \brief CPU cycle counter
+ *
+ *  @return current value of the time stamp counter, 0 if not available
+ */
+extern uint64_t bench_cycles(void);
+
+/** \brief Record one sample for an entry point
+ *
+ *  @param name      Name of the timed entry point
+ *  @param ns        Elapsed time in nanoseconds
+ *  @param cycles    Elapsed cycles
+ */
+extern void bench_record(const char *name, uint64_t ns, uint64_t cycles);
+
+/** \brief Print the collected samples
+ *
+ *  @param cfg       Benchmark configuration
+ */
+extern void bench_report(const BENCH_CONFIG *cfg);
+
+/** \brief Abort the benchmark if an entry point failed
+ *
+ *  @param name      Name of the entry point
+ *  @param rc        Return code of the entry point
+ *  @param ok        Expected return code
+ */
+extern void bench_check(const char *name, int rc, int ok);
+
+/** \brief Allocate an array of empty octets
+ *
+ *  The memory is owned by the harness and released by bench_free_all
+ *
+ *  @param count     Number of octets
+ *  @param max       Capacity of each octet
+ *  @return          Array of count octets
+ */
+extern octet *bench_octets(int count, int max);
+
+/** \brief Allocate zeroed memory owned by the harness
+ *
+ *  @param size      Number of bytes
+ *  @return          Pointer to the allocated memory
+ */
+extern void *bench_alloc(size_t size);
+
+/** \brief Release all the memory allocated by bench_octets and bench_alloc */
+extern void bench_free_all(void);
+
+/** \brief Load Paillier and ring Pedersen keys for n players
+ *
+ *  @param RNG       csprng for random generation
+ *  @param keys      Destination keys
+ *  @param n         Number of players
+ */
+extern void bench_load_keys(csprng *RNG, BENCH_KEYS *keys, int n);
+
+/** \brief Time HDLOG, SSS/VSS and Schnorr entry points
+ *
+ *  @param RNG       csprng for random generation
+ *  @param cfg       Benchmark configuration
+ *  @param keys      Long term keys
+ */
+extern void bench_primitives(csprng *RNG, const BENCH_CONFIG *cfg, const BENCH_KEYS *keys);
+
+/** \brief Time every CG21 round, from KeyGen to Sign
+ *
+ *  @param RNG       csprng for random generation
+ *  @param cfg       Benchmark configuration
+ *  @param keys      Long term keys
+ */
+extern void bench_cg21(csprng *RNG, const BENCH_CONFIG *cfg, const BENCH_KEYS *keys);
+
+/** \brief Time the prove/verify pairs of every ZKP
+ *
+ *  @param RNG       csprng for random generation
+ *  @param keys      Long term keys
+ *  @param ssid      Fully formed session ID
+ *  @param n         Size of the packages in the ssid
+ */
+extern void bench_zkp(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid, int n);
+
+/** \brief Time a single call and record it under name
+ *
+ *  @param name      Name of the timed entry point
+ *  @param call      Statement to time
+ */
+#define BENCH_TIME(name, call)                                                  \
+    do {                                                                        \
+        uint64_t bench_ns_ = bench_now_ns();                                    \
+        uint64_t bench_cy_ = bench_cycles();                                    \
+        call;                                                                   \
+        bench_cy_ = bench_cycles() - bench_cy_;                                 \
+        bench_record((name), bench_now_ns() - bench_ns_, bench_cy_);            \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
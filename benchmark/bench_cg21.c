@@ -0,0 +1,1652 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Benchmark every CG21 round, from KeyGen to Sign
+ *
+ * The protocol is run end to end as in the examples: KeyGen(t,n),
+ * key re-sharing to the same (t,n) set of players, Aux. info, Pre-Sign
+ * and Sign with the first t players. All the state is allocated once
+ * and reused by every iteration.
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "amcl/cg21/cg21_rp_pi_enc.h"
+#include "amcl/cg21/cg21_rp_pi_logstar.h"
+#include "amcl/cg21/cg21_rp_pi_affg.h"
+
+typedef struct
+{
+    int t;
+    int n;
+    octet *P;
+    CG21_KEYGEN_SID *sid;
+    CG21_KEYGEN_ROUND1_STORE_PRIV *r1Priv;
+    CG21_KEYGEN_ROUND1_STORE_PUB *r1Pub;
+    CG21_KEYGEN_ROUND1_output *r1Out;
+    CG21_KEYGEN_ROUND3_STORE *r3Store;
+    CG21_KEYGEN_ROUND3_OUTPUT *r3Out;
+    CG21_KEYGEN_OUTPUT *out;
+} BENCH_KEYGEN;
+
+typedef struct
+{
+    BENCH_KEYGEN *kg;
+    CG21_RESHARE_SETTING setting;
+    CG21_SSID *ssid;
+    octet *RHO;
+    octet *X;
+    SSS_shares *shares;
+    octet *rho;
+    CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1;
+    CG21_RESHARE_ROUND1_STORE_SECRET_T1 *secretT1;
+    CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2;
+    CG21_RESHARE_ROUND1_STORE_SECRET_N2 *secretN2;
+    CG21_RESHARE_ROUND1_OUT *r1Out;
+    CG21_RESHARE_ROUND3_OUTPUT *r3Out;
+    CG21_RESHARE_ROUND4_STORE *r4Store;
+    CG21_RESHARE_ROUND4_OUTPUT *r4Out;
+    CG21_RESHARE_OUTPUT *out;
+    SSS_shares decrypted;
+} BENCH_RESHARE;
+
+typedef struct
+{
+    int n;
+    BENCH_RESHARE *rs;
+    CG21_SSID *ssid;
+    CG21_AUX_ROUND1_STORE_PUB *r1Pub;
+    CG21_AUX_ROUND1_STORE_PRIV *r1Priv;
+    CG21_AUX_ROUND1_OUT *r1Out;
+    CG21_AUX_ROUND3 *r3;
+    CG21_AUX_OUTPUT *out;
+} BENCH_AUX;
+
+typedef struct
+{
+    int t;
+    BENCH_RESHARE *rs;
+    BENCH_AUX *aux;
+    CG21_SSID *ssid;
+    CG21_PRESIGN_ROUND1_OUTPUT *r1Out;
+    CG21_PRESIGN_ROUND1_STORE *r1Store;
+    CG21_PRESIGN_ROUND2_OUTPUT *r2Out;
+    CG21_PRESIGN_ROUND2_STORE *r2Store;
+    CG21_PRESIGN_ROUND3_OUTPUT *r3Out;
+    CG21_PRESIGN_ROUND3_STORE_1 *r3Store1;
+    CG21_PRESIGN_ROUND3_STORE_2 *r3Store2;
+    CG21_PRESIGN_ROUND4_STORE_1 *r4Store1;
+    CG21_PRESIGN_ROUND4_STORE_2 *r4Store2;
+    CG21_PRESIGN_ROUND4_OUTPUT *r4Out;
+} BENCH_PRESIGN;
+
+typedef struct
+{
+    int t;
+    BENCH_PRESIGN *ps;
+    octet *msg;
+    CG21_SIGN_ROUND1_STORE *r1Store;
+    CG21_SIGN_ROUND1_OUTPUT *r1Out;
+    CG21_SIGN_ROUND2_OUTPUT *r2Out;
+} BENCH_SIGN;
+
+/* Status of the i-th player accumulating the contribution of the j-th one
+ *
+ * 0: first call, 1: intermediate call, 2: last call, 3: first and last call
+ */
+static int bench_status(int i, int j, int t)
+{
+    int status = 1;
+
+    if (j == 0 || (j == 1 && i == 0))
+    {
+        status = 0;
+    }
+
+    if (j == t - 1 || (j == t - 2 && i == t - 1))
+    {
+        status = (status == 0) ? 3 : 2;
+    }
+
+    return status;
+}
+
+static void bench_ssid_init(CG21_SSID *ssid, int count, int n1, int n2)
+{
+    octet *uid = bench_octets(count, iLEN);
+    octet *rid = bench_octets(count, EGS_SECP256K1);
+    octet *rho = bench_octets(count, EGS_SECP256K1);
+    octet *X = bench_octets(count, n1 * (EFS_SECP256K1 + 1));
+    octet *j = bench_octets(count, n1 * 4 + 1);
+    octet *j2 = bench_octets(count, n2 * 4 + 1);
+    octet *q = bench_octets(count, EFS_SECP256K1);
+    octet *g = bench_octets(count, EFS_SECP256K1 + 1);
+    octet *N = bench_octets(count, n2 * FS_2048);
+    octet *s = bench_octets(count, n2 * FS_2048);
+    octet *t = bench_octets(count, n2 * FS_2048);
+    int *n1_ = bench_alloc(count * sizeof(int));
+    int *n2_ = bench_alloc(count * sizeof(int));
+
+    for (int i = 0; i < count; i++)
+    {
+        ssid[i].uid = uid + i;
+        ssid[i].rid = rid + i;
+        ssid[i].rho = rho + i;
+        ssid[i].X_set_packed = X + i;
+        ssid[i].j_set_packed = j + i;
+        ssid[i].j_set_packed2 = j2 + i;
+        ssid[i].q = q + i;
+        ssid[i].g = g + i;
+        ssid[i].N_set_packed = N + i;
+        ssid[i].s_set_packed = s + i;
+        ssid[i].t_set_packed = t + i;
+        ssid[i].n1 = n1_ + i;
+        ssid[i].n2 = n2_ + i;
+    }
+}
+
+static void bench_keygen_init(BENCH_KEYGEN *kg, int t, int n)
+{
+    char id[8];
+
+    kg->t = t;
+    kg->n = n;
+
+    kg->P = bench_octets(1, n * 4 + 1);
+    for (int i = 0; i < n; i++)
+    {
+        snprintf(id, sizeof(id), "%04d", i + 1);
+        OCT_jstring(kg->P, id);
+    }
+
+    kg->sid = bench_alloc(n * sizeof(CG21_KEYGEN_SID));
+    kg->r1Priv = bench_alloc(n * sizeof(CG21_KEYGEN_ROUND1_STORE_PRIV));
+    kg->r1Pub = bench_alloc(n * sizeof(CG21_KEYGEN_ROUND1_STORE_PUB));
+    kg->r1Out = bench_alloc(n * sizeof(CG21_KEYGEN_ROUND1_output));
+    kg->r3Store = bench_alloc(n * sizeof(CG21_KEYGEN_ROUND3_STORE));
+    kg->r3Out = bench_alloc(n * sizeof(CG21_KEYGEN_ROUND3_OUTPUT));
+    kg->out = bench_alloc(n * sizeof(CG21_KEYGEN_OUTPUT));
+
+    octet *uid = bench_octets(n, iLEN);
+    octet *q = bench_octets(n, EFS_SECP256K1);
+    octet *g = bench_octets(n, EFS_SECP256K1 + 1);
+    octet *P = bench_octets(n, n * 4 + 1);
+
+    octet *x = bench_octets(n, EGS_SECP256K1);
+    octet *tau = bench_octets(n, EGS_SECP256K1);
+    octet *tau2 = bench_octets(n, EGS_SECP256K1);
+    octet *sharesX = bench_octets(n * n, EGS_SECP256K1);
+    octet *sharesY = bench_octets(n * n, EGS_SECP256K1);
+
+    octet *X = bench_octets(n, EFS_SECP256K1 + 1);
+    octet *A = bench_octets(n, SFS_SECP256K1 + 1);
+    octet *A2 = bench_octets(n, SFS_SECP256K1 + 1);
+    octet *rid = bench_octets(n, EGS_SECP256K1);
+    octet *u = bench_octets(n, EGS_SECP256K1);
+    octet *checks = bench_octets(n, t * (EFS_SECP256K1 + 1));
+    octet *V = bench_octets(n, SHA256);
+
+    octet *xorRid = bench_octets(n, EGS_SECP256K1);
+    octet *packedY = bench_octets(n, (n - 1) * EGS_SECP256K1);
+    octet *allChecks = bench_octets(n, n * t * (EFS_SECP256K1 + 1));
+    octet *xiX = bench_octets(n, EGS_SECP256K1);
+    octet *xiY = bench_octets(n, EGS_SECP256K1);
+
+    octet *uiPsi = bench_octets(n, SGS_SECP256K1);
+    octet *uiA = bench_octets(n, SFS_SECP256K1 + 1);
+    octet *xiPsi = bench_octets(n, SGS_SECP256K1);
+    octet *xiA = bench_octets(n, SFS_SECP256K1 + 1);
+
+    octet *PK = bench_octets(n, EFS_SECP256K1 + 1);
+    octet *jPacked = bench_octets(n, n * 4 + 1);
+    octet *XPacked = bench_octets(n, n * (EFS_SECP256K1 + 1));
+    octet *pkSum = bench_octets(n, (n - 1) * (SFS_SECP256K1 + 1));
+
+    for (int i = 0; i < n; i++)
+    {
+        kg->sid[i].uid = uid + i;
+        kg->sid[i].q = q + i;
+        kg->sid[i].g = g + i;
+        kg->sid[i].P = P + i;
+
+        kg->r1Priv[i].x = x + i;
+        kg->r1Priv[i].tau = tau + i;
+        kg->r1Priv[i].tau2 = tau2 + i;
+        kg->r1Priv[i].shares.X = sharesX + n * i;
+        kg->r1Priv[i].shares.Y = sharesY + n * i;
+
+        kg->r1Pub[i].X = X + i;
+        kg->r1Pub[i].A = A + i;
+        kg->r1Pub[i].A2 = A2 + i;
+        kg->r1Pub[i].rid = rid + i;
+        kg->r1Pub[i].u = u + i;
+        kg->r1Pub[i].packed_checks = checks + i;
+
+        kg->r1Out[i].V = V + i;
+
+        kg->r3Store[i].xor_rid = xorRid + i;
+        kg->r3Store[i].packed_share_Y = packedY + i;
+        kg->r3Store[i].packed_all_checks = allChecks + i;
+        kg->r3Store[i].xi.X = xiX + i;
+        kg->r3Store[i].xi.Y = xiY + i;
+
+        kg->r3Out[i].ui_proof.psi = uiPsi + i;
+        kg->r3Out[i].ui_proof.A = uiA + i;
+        kg->r3Out[i].xi_proof.psi = xiPsi + i;
+        kg->r3Out[i].xi_proof.A = xiA + i;
+
+        kg->out[i].X = PK + i;
+        kg->out[i].j_set_packed = jPacked + i;
+        kg->out[i].X_set_packed = XPacked + i;
+        kg->out[i].pk_ss_sum_pack = pkSum + i;
+    }
+}
+
+static void bench_keygen(csprng *RNG, BENCH_KEYGEN *kg)
+{
+    int rc;
+    int n = kg->n;
+
+    char uid[iLEN];
+    octet UID = {0, sizeof(uid), uid};
+
+    // All the players agree on the same session ID
+    OCT_rand(&UID, RNG, UID.max);
+
+    for (int i = 0; i < n; i++)
+    {
+        OCT_copy(kg->sid[i].uid, &UID);
+
+        // Accumulators filled by ROUND3_1 and OUTPUT_1_2
+        OCT_clear(kg->r3Store[i].packed_all_checks);
+        OCT_clear(kg->r3Store[i].packed_share_Y);
+        OCT_clear(kg->out[i].pk_ss_sum_pack);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("CG21_KEY_GENERATE_ROUND1",
+                   rc = CG21_KEY_GENERATE_ROUND1(RNG, kg->r1Priv + i, kg->r1Pub + i, kg->r1Out + i,
+                                                 kg->sid + i, i + 1, n, kg->t, kg->P));
+        bench_check("CG21_KEY_GENERATE_ROUND1", rc, CG21_OK);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            SSS_shares shares = {kg->r1Priv[j].shares.X + i, kg->r1Priv[j].shares.Y + i};
+
+            BENCH_TIME("CG21_KEY_GENERATE_ROUND3_1",
+                       rc = CG21_KEY_GENERATE_ROUND3_1(kg->r1Out + j, kg->r1Pub + j, kg->r1Priv + i,
+                                                       &shares, kg->sid + i, kg->r3Store + i));
+            bench_check("CG21_KEY_GENERATE_ROUND3_1", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("CG21_KEY_GENERATE_ROUND3_2_1",
+                   CG21_KEY_GENERATE_ROUND3_2_1(kg->r1Pub + i, kg->r3Store + i, true));
+
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_GENERATE_ROUND3_2_1",
+                       CG21_KEY_GENERATE_ROUND3_2_1(kg->r1Pub + j, kg->r3Store + i, false));
+        }
+
+        BENCH_TIME("CG21_KEY_GENERATE_ROUND3_2_2",
+                   rc = CG21_KEY_GENERATE_ROUND3_2_2(kg->r1Priv + i, kg->r1Pub + i, kg->r3Store + i,
+                                                     kg->sid + i, kg->r3Out + i));
+        bench_check("CG21_KEY_GENERATE_ROUND3_2_2", rc, CG21_OK);
+
+        BENCH_TIME("CG21_KEY_GENERATE_ROUND3_2_3",
+                   rc = CG21_KEY_GENERATE_ROUND3_2_3(kg->r1Priv + i, kg->r1Pub + i, kg->r3Store + i,
+                                                     kg->sid + i, kg->r3Out + i));
+        bench_check("CG21_KEY_GENERATE_ROUND3_2_3", rc, CG21_OK);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_GENERATE_OUTPUT_1_1",
+                       rc = CG21_KEY_GENERATE_OUTPUT_1_1(kg->r3Out + j, kg->r1Pub + j, kg->sid + i, kg->r3Store + i));
+            bench_check("CG21_KEY_GENERATE_OUTPUT_1_1", rc, CG21_OK);
+
+            BENCH_TIME("CG21_KEY_GENERATE_OUTPUT_1_2",
+                       rc = CG21_KEY_GENERATE_OUTPUT_1_2(kg->out + i, kg->r3Out + j, kg->r3Store + i,
+                                                         kg->r1Priv + i, kg->sid + i, kg->r1Pub + j));
+            bench_check("CG21_KEY_GENERATE_OUTPUT_1_2", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("CG21_KEY_GENERATE_OUTPUT_2",
+                   rc = CG21_KEY_GENERATE_OUTPUT_2(kg->out + i, kg->r1Pub + i, true));
+        bench_check("CG21_KEY_GENERATE_OUTPUT_2", rc, CG21_OK);
+
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_GENERATE_OUTPUT_2",
+                       rc = CG21_KEY_GENERATE_OUTPUT_2(kg->out + i, kg->r1Pub + j, false));
+            bench_check("CG21_KEY_GENERATE_OUTPUT_2", rc, CG21_OK);
+        }
+
+        BENCH_TIME("CG21_KEY_GENERATE_OUTPUT_3", rc = CG21_KEY_GENERATE_OUTPUT_3(kg->out + i, n));
+        bench_check("CG21_KEY_GENERATE_OUTPUT_3", rc, CG21_OK);
+    }
+}
+
+static void bench_reshare_init(BENCH_RESHARE *rs, BENCH_KEYGEN *kg)
+{
+    int t = kg->t;
+    int n = kg->n;
+
+    int *T1 = bench_alloc(t * sizeof(int));
+    int *T2 = bench_alloc(t * sizeof(int));
+    int *N2 = bench_alloc(n * sizeof(int));
+
+    rs->kg = kg;
+
+    // Re-share the key among the same set of players, with the first t
+    // players as the old quorum. T2 is the quorum used by Pre-Sign
+    for (int i = 0; i < t; i++)
+    {
+        T1[i] = i + 1;
+        T2[i] = i + 1;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        N2[i] = i + 1;
+    }
+
+    CG21_KEY_RESHARE_GET_RESHARE_SETTING(&rs->setting, t, n, t, n, T1, N2);
+    rs->setting.T2 = T2;
+
+    int t1 = rs->setting.t1;
+    int n1 = rs->setting.n1;
+    int t2 = rs->setting.t2;
+    int n2 = rs->setting.n2;
+
+    rs->ssid = bench_alloc(n2 * sizeof(CG21_SSID));
+    bench_ssid_init(rs->ssid, n2, n1, n2);
+
+    rs->RHO = bench_octets(1, EGS_SECP256K1);
+    rs->X = bench_octets(1, EFS_SECP256K1 + 1);
+
+    rs->shares = bench_alloc(t1 * sizeof(SSS_shares));
+    for (int i = 0; i < t1; i++)
+    {
+        rs->shares[i] = kg->r3Store[i].xi;
+    }
+
+    rs->pubT1 = bench_alloc(t1 * sizeof(CG21_RESHARE_ROUND1_STORE_PUB_T1));
+    rs->secretT1 = bench_alloc(t1 * sizeof(CG21_RESHARE_ROUND1_STORE_SECRET_T1));
+    rs->pubN2 = bench_alloc((n2 - t1) * sizeof(CG21_RESHARE_ROUND1_STORE_PUB_N2));
+    rs->secretN2 = bench_alloc((n2 - t1) * sizeof(CG21_RESHARE_ROUND1_STORE_SECRET_N2));
+    rs->r1Out = bench_alloc(n2 * sizeof(CG21_RESHARE_ROUND1_OUT));
+
+    octet *a = bench_octets(t1, EGS_SECP256K1);
+    octet *aG = bench_octets(t1, EFS_SECP256K1 + 1);
+    octet *sharesX = bench_octets(t1 * n2, EGS_SECP256K1);
+    octet *sharesY = bench_octets(t1 * n2, EGS_SECP256K1);
+    octet *checks = bench_octets(t1, t2 * (EFS_SECP256K1 + 1));
+    octet *u = bench_octets(n2, EGS_SECP256K1);
+    octet *r = bench_octets(n2, SGS_SECP256K1);
+    octet *A = bench_octets(n2, SFS_SECP256K1 + 1);
+    octet *V = bench_octets(n2, SHA256);
+    int *r1i = bench_alloc(n2 * sizeof(int));
+    int *r1i2 = bench_alloc(n2 * sizeof(int));
+
+    rs->rho = bench_octets(n2, EGS_SECP256K1);
+
+    for (int i = 0; i < t1; i++)
+    {
+        rs->pubT1[i].Xi = aG + i;
+        rs->pubT1[i].rho = rs->rho + i;
+        rs->pubT1[i].u = u + i;
+        rs->pubT1[i].A = A + i;
+        rs->pubT1[i].checks = checks + i;
+        rs->pubT1[i].i = r1i2 + i;
+
+        rs->secretT1[i].r = r + i;
+        rs->secretT1[i].a = a + i;
+        rs->secretT1[i].shares.X = sharesX + n2 * i;
+        rs->secretT1[i].shares.Y = sharesY + n2 * i;
+    }
+
+    for (int i = t1; i < n2; i++)
+    {
+        rs->pubN2[i - t1].rho = rs->rho + i;
+        rs->pubN2[i - t1].u = u + i;
+        rs->pubN2[i - t1].A = A + i;
+        rs->pubN2[i - t1].i = r1i2 + i;
+
+        rs->secretN2[i - t1].r = r + i;
+    }
+
+    for (int i = 0; i < n2; i++)
+    {
+        rs->r1Out[i].V = V + i;
+        rs->r1Out[i].i = r1i + i;
+    }
+
+    // Every player in T1 sends an encrypted share to every other player in N2
+    rs->r3Out = bench_alloc(t1 * (n2 - 1) * sizeof(CG21_RESHARE_ROUND3_OUTPUT));
+
+    octet *C = bench_octets(t1 * (n2 - 1), FS_4096);
+    octet *X = bench_octets(t1 * (n2 - 1), EGS_SECP256K1);
+    int *r3i = bench_alloc(t1 * (n2 - 1) * sizeof(int));
+    int *r3j = bench_alloc(t1 * (n2 - 1) * sizeof(int));
+
+    for (int i = 0; i < t1 * (n2 - 1); i++)
+    {
+        rs->r3Out[i].C = C + i;
+        rs->r3Out[i].X = X + i;
+        rs->r3Out[i].i = r3i + i;
+        rs->r3Out[i].j = r3j + i;
+    }
+
+    rs->decrypted.X = bench_octets(1, EGS_SECP256K1);
+    rs->decrypted.Y = bench_octets(1, FS_2048);
+
+    rs->r4Store = bench_alloc(n2 * sizeof(CG21_RESHARE_ROUND4_STORE));
+    rs->r4Out = bench_alloc(n2 * sizeof(CG21_RESHARE_ROUND4_OUTPUT));
+    rs->out = bench_alloc(n2 * sizeof(CG21_RESHARE_OUTPUT));
+
+    octet *skX = bench_octets(n2, EGS_SECP256K1);
+    octet *skY = bench_octets(n2, EGS_SECP256K1);
+    octet *xorRho = bench_octets(n2, EGS_SECP256K1);
+    octet *allChecks = bench_octets(n2, t1 * t2 * (EFS_SECP256K1 + 1));
+    octet *psi = bench_octets(n2, SGS_SECP256K1);
+    octet *proofA = bench_octets(n2, SFS_SECP256K1 + 1);
+    int *r4i = bench_alloc(n2 * sizeof(int));
+
+    octet *PK = bench_octets(n2, EFS_SECP256K1 + 1);
+    octet *XPacked = bench_octets(n2, n2 * (EFS_SECP256K1 + 1));
+    octet *jPacked = bench_octets(n2, n2 * 4 + 1);
+    octet *outRho = bench_octets(n2, EGS_SECP256K1);
+    octet *outRid = bench_octets(n2, EGS_SECP256K1);
+    octet *outX = bench_octets(n2, EGS_SECP256K1);
+    octet *outY = bench_octets(n2, EGS_SECP256K1);
+
+    for (int i = 0; i < n2; i++)
+    {
+        rs->r4Store[i].shares.X = skX + i;
+        rs->r4Store[i].shares.Y = skY + i;
+        rs->r4Store[i].rho = xorRho + i;
+        rs->r4Store[i].pack_all_checks = allChecks + i;
+
+        rs->r4Out[i].proof.psi = psi + i;
+        rs->r4Out[i].proof.A = proofA + i;
+        rs->r4Out[i].i = r4i + i;
+
+        rs->out[i].pk.X = PK + i;
+        rs->out[i].pk.X_set_packed = XPacked + i;
+        rs->out[i].pk.j_set_packed = jPacked + i;
+        rs->out[i].rho = outRho + i;
+        rs->out[i].rid = outRid + i;
+        rs->out[i].shares.X = outX + i;
+        rs->out[i].shares.Y = outY + i;
+    }
+}
+
+static void bench_reshare(csprng *RNG, BENCH_RESHARE *rs, const BENCH_KEYS *keys)
+{
+    int rc;
+
+    BENCH_KEYGEN *kg = rs->kg;
+    CG21_RESHARE_SETTING setting = rs->setting;
+
+    int t1 = setting.t1;
+    int n1 = setting.n1;
+    int n2 = setting.n2;
+
+    octet *rid = kg->r3Store[0].xor_rid;
+    octet *PK = kg->out[0].X;
+
+    for (int i = 0; i < n2; i++)
+    {
+        CG21_AUX_FORM_SSID(rs->ssid + i, rid, kg->out[i].X_set_packed, kg->out[i].j_set_packed, n2);
+
+        OCT_clear(rs->r4Store[i].pack_all_checks);
+    }
+
+    // Round 1
+    for (int i = 0; i < t1; i++)
+    {
+        BENCH_TIME("CG21_KEY_RESHARE_ROUND1_T1",
+                   rc = CG21_KEY_RESHARE_ROUND1_T1(RNG, rs->ssid + i, i + 1, setting, rs->shares + i,
+                                                   rs->secretT1 + i, rs->pubT1 + i, rs->r1Out + i));
+        bench_check("CG21_KEY_RESHARE_ROUND1_T1", rc, CG21_OK);
+    }
+
+    for (int i = t1; i < n2; i++)
+    {
+        BENCH_TIME("CG21_KEY_RESHARE_ROUND1_N2",
+                   rc = CG21_KEY_RESHARE_ROUND1_N2(RNG, rs->ssid + i, i + 1, setting, rs->secretN2 + i - t1,
+                                                   rs->pubN2 + i - t1, rs->r1Out + i));
+        bench_check("CG21_KEY_RESHARE_ROUND1_N2", rc, CG21_OK);
+    }
+
+    // Round 2
+    for (int i = 0; i < n2; i++)
+    {
+        CG21_SSID mySsid;
+        mySsid.j_set_packed = kg->out[i].j_set_packed;
+        mySsid.X_set_packed = kg->out[i].X_set_packed;
+
+        for (int j = 0; j < n2; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_AUX_ROUND3_CHECK_SSID",
+                       rc = CG21_AUX_ROUND3_CHECK_SSID(rs->ssid + j, rid, NULL, &mySsid, n1, false));
+            bench_check("CG21_AUX_ROUND3_CHECK_SSID", rc, CG21_OK);
+        }
+    }
+
+    // Round 3
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < t1; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_ROUND3_CHECK_V_T1",
+                       rc = CG21_KEY_RESHARE_ROUND3_CHECK_V_T1(rs->ssid + j, setting, rs->pubT1 + j, rs->r1Out + j));
+            bench_check("CG21_KEY_RESHARE_ROUND3_CHECK_V_T1", rc, CG21_OK);
+        }
+
+        for (int j = t1; j < n2; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_ROUND3_CHECK_V_N2",
+                       rc = CG21_KEY_RESHARE_ROUND3_CHECK_V_N2(rs->ssid + j, setting, rs->pubN2 + j - t1, rs->r1Out + j));
+            bench_check("CG21_KEY_RESHARE_ROUND3_CHECK_V_N2", rc, CG21_OK);
+        }
+    }
+
+    // Every player XORs the partial rhos
+    OCT_copy(rs->RHO, rs->rho);
+    for (int i = 1; i < n2; i++)
+    {
+        OCT_xor(rs->RHO, rs->rho + i);
+    }
+
+    for (int i = 0; i < t1; i++)
+    {
+        int c = 0;
+
+        for (int j = 0; j < n2; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_ENCRYPT_SHARES",
+                       CG21_KEY_RESHARE_ENCRYPT_SHARES(RNG, &keys->paillier[j].paillier_pk, j + 1, rs->secretT1 + i,
+                                                       rs->pubT1[i], rs->r3Out + i * (n2 - 1) + c));
+
+            // The receiver decrypts the share
+            BENCH_TIME("CG21_KEY_RESHARE_DECRYPT_SHARES",
+                       CG21_KEY_RESHARE_DECRYPT_SHARES(&keys->paillier[j].paillier_sk, rs->r3Out + i * (n2 - 1) + c,
+                                                       &rs->decrypted));
+            c++;
+        }
+    }
+
+    // Round 4
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < t1; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            SSS_shares share = {rs->secretT1[j].shares.X + i, rs->secretT1[j].shares.Y + i};
+            int Xstatus = bench_status(i, j, t1);
+
+            if (i < t1)
+            {
+                BENCH_TIME("CG21_KEY_RESHARE_CHECK_VSS_T1",
+                           rc = CG21_KEY_RESHARE_CHECK_VSS_T1(setting, rs->pubT1 + j, rs->pubT1 + i, &share,
+                                                              kg->r3Store[i].xi.X, PK, rs->X,
+                                                              kg->out[i].pk_ss_sum_pack, rs->r4Store + i, Xstatus));
+                bench_check("CG21_KEY_RESHARE_CHECK_VSS_T1", rc, CG21_OK);
+            }
+            else
+            {
+                BENCH_TIME("CG21_KEY_RESHARE_CHECK_VSS_N2",
+                           rc = CG21_KEY_RESHARE_CHECK_VSS_N2(setting, rs->pubT1 + j, &share,
+                                                              kg->r3Store[i].xi.X, PK, rs->X,
+                                                              kg->out[i].pk_ss_sum_pack, rs->r4Store + i, Xstatus));
+                bench_check("CG21_KEY_RESHARE_CHECK_VSS_N2", rc, CG21_OK);
+            }
+        }
+    }
+
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < t1; j++)
+        {
+            SSS_shares share = {rs->secretT1[j].shares.X + i, rs->secretT1[j].shares.Y + i};
+
+            BENCH_TIME("CG21_KEY_RESHARE_SUM_SHARES",
+                       CG21_KEY_RESHARE_SUM_SHARES(&share, rs->r4Store + i, j == 0));
+        }
+    }
+
+    for (int i = 0; i < t1; i++)
+    {
+        BENCH_TIME("CG21_KEY_RESHARE_PROVE_T1",
+                   rc = CG21_KEY_RESHARE_PROVE_T1(rs->r4Out + i, rs->secretT1 + i, rs->pubT1 + i, rs->r4Store + i,
+                                                  rs->ssid + i, rs->RHO, i + 1, n1));
+        bench_check("CG21_KEY_RESHARE_PROVE_T1", rc, CG21_OK);
+    }
+
+    for (int i = t1; i < n2; i++)
+    {
+        BENCH_TIME("CG21_KEY_RESHARE_PROVE_N2",
+                   rc = CG21_KEY_RESHARE_PROVE_N2(rs->r4Out + i, rs->secretN2 + i - t1, rs->pubN2 + i - t1,
+                                                  rs->r4Store + i, rs->ssid + i, rs->RHO, i + 1, n1));
+        bench_check("CG21_KEY_RESHARE_PROVE_N2", rc, CG21_OK);
+    }
+
+    // Round 5
+    for (int i = 0; i < n2; i++)
+    {
+        for (int j = 0; j < t1; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_VERIFY_T1",
+                       rc = CG21_KEY_RESHARE_VERIFY_T1(rs->r4Out + j, rs->pubT1 + j, setting, rs->r4Store + i,
+                                                       rs->ssid + i, j + 1));
+            bench_check("CG21_KEY_RESHARE_VERIFY_T1", rc, CG21_OK);
+        }
+
+        for (int j = t1; j < n2; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_VERIFY_N2",
+                       rc = CG21_KEY_RESHARE_VERIFY_N2(rs->r4Out + j, rs->pubN2 + j - t1, setting, rs->r4Store + i,
+                                                       rs->ssid + i, j + 1));
+            bench_check("CG21_KEY_RESHARE_VERIFY_N2", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < n2; i++)
+    {
+        bool first = true;
+
+        if (i < t1)
+        {
+            BENCH_TIME("CG21_KEY_RESHARE_OUTPUT",
+                       CG21_KEY_RESHARE_OUTPUT(rs->out + i, rs->r4Store + i, rs->pubT1 + i, PK, setting, rid, i + 1, true));
+            first = false;
+        }
+
+        for (int j = 0; j < t1; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_KEY_RESHARE_OUTPUT",
+                       CG21_KEY_RESHARE_OUTPUT(rs->out + i, rs->r4Store + i, rs->pubT1 + j, PK, setting, rid, j + 1, first));
+            first = false;
+        }
+
+        rs->out[i].myID = i + 1;
+    }
+}
+
+static void bench_aux_init(BENCH_AUX *aux, BENCH_RESHARE *rs)
+{
+    int n = rs->setting.n2;
+
+    aux->n = n;
+    aux->rs = rs;
+
+    aux->ssid = bench_alloc(n * sizeof(CG21_SSID));
+    bench_ssid_init(aux->ssid, n, n, n);
+
+    aux->r1Pub = bench_alloc(n * sizeof(CG21_AUX_ROUND1_STORE_PUB));
+    aux->r1Priv = bench_alloc(n * sizeof(CG21_AUX_ROUND1_STORE_PRIV));
+    aux->r1Out = bench_alloc(n * sizeof(CG21_AUX_ROUND1_OUT));
+    aux->r3 = bench_alloc(n * sizeof(CG21_AUX_ROUND3));
+    aux->out = bench_alloc(n * sizeof(CG21_AUX_OUTPUT));
+
+    octet *u = bench_octets(n, EGS_SECP256K1);
+    octet *rho = bench_octets(n, EGS_SECP256K1);
+    octet *pedPub = bench_octets(n, 3 * FS_2048);
+    octet *paiPub = bench_octets(n, FS_4096 + HFS_4096);
+    octet *prmRho = bench_octets(n, HDLOG_VALUES_SIZE);
+    octet *prmIrho = bench_octets(n, HDLOG_VALUES_SIZE);
+    octet *prmT = bench_octets(n, HDLOG_VALUES_SIZE);
+    octet *prmIt = bench_octets(n, HDLOG_VALUES_SIZE);
+    octet *V = bench_octets(n, SHA256);
+    octet *pedPriv = bench_octets(n, 6 * FS_2048 + 3 * HFS_2048);
+    octet *paiPriv = bench_octets(n, 2 * HFS_2048);
+
+    octet *xorRho = bench_octets(n, EGS_SECP256K1);
+    octet *modW = bench_octets(n, HFS_4096);
+    octet *modX = bench_octets(n, CG21_PAILLIER_PROOF_SIZE);
+    octet *modZ = bench_octets(n, CG21_PAILLIER_PROOF_SIZE);
+    octet *modAb = bench_octets(n, CG21_PAILLIER_PROOF_ITERS * 4);
+    octet *sigma = bench_octets(n, 2 * FS_2048 + HFS_2048);
+    octet *P = bench_octets(n, FS_2048);
+    octet *Q = bench_octets(n, FS_2048);
+    octet *A = bench_octets(n, FS_2048);
+    octet *B = bench_octets(n, FS_2048);
+    octet *T = bench_octets(n, FS_2048);
+    octet *z1 = bench_octets(n, FS_2048 + HFS_2048);
+    octet *z2 = bench_octets(n, FS_2048 + HFS_2048);
+    octet *w1 = bench_octets(n, FS_2048 + HFS_2048);
+    octet *w2 = bench_octets(n, FS_2048 + HFS_2048);
+    octet *v = bench_octets(n, 2 * FS_2048 + HFS_2048);
+
+    octet *j = bench_octets(n, n * 4 + 1);
+    octet *N = bench_octets(n, n * FS_2048);
+    octet *s = bench_octets(n, n * FS_2048);
+    octet *t = bench_octets(n, n * FS_2048);
+
+    for (int i = 0; i < n; i++)
+    {
+        aux->r1Pub[i].u = u + i;
+        aux->r1Pub[i].rho = rho + i;
+        aux->r1Pub[i].PedPub = pedPub + i;
+        aux->r1Pub[i].PaiPub = paiPub + i;
+        aux->r1Pub[i].pedersenProof.rho = prmRho + i;
+        aux->r1Pub[i].pedersenProof.irho = prmIrho + i;
+        aux->r1Pub[i].pedersenProof.t = prmT + i;
+        aux->r1Pub[i].pedersenProof.it = prmIt + i;
+
+        aux->r1Out[i].V = V + i;
+
+        aux->r1Priv[i].PEDERSEN_PRIV = pedPriv + i;
+        aux->r1Priv[i].Paillier_PRIV = paiPriv + i;
+
+        aux->r3[i].rho = xorRho + i;
+        aux->r3[i].paillierProof.w = modW + i;
+        aux->r3[i].paillierProof.x = modX + i;
+        aux->r3[i].paillierProof.z = modZ + i;
+        aux->r3[i].paillierProof.ab = modAb + i;
+        aux->r3[i].factorCommits.sigma = sigma + i;
+        aux->r3[i].factorCommits.P = P + i;
+        aux->r3[i].factorCommits.Q = Q + i;
+        aux->r3[i].factorCommits.A = A + i;
+        aux->r3[i].factorCommits.B = B + i;
+        aux->r3[i].factorCommits.T = T + i;
+        aux->r3[i].factorProof.z1 = z1 + i;
+        aux->r3[i].factorProof.z2 = z2 + i;
+        aux->r3[i].factorProof.w1 = w1 + i;
+        aux->r3[i].factorProof.w2 = w2 + i;
+        aux->r3[i].factorProof.v = v + i;
+
+        aux->out[i].j = j + i;
+        aux->out[i].N = N + i;
+        aux->out[i].s = s + i;
+        aux->out[i].t = t + i;
+    }
+}
+
+/* Copy the fields of the ssid that are broadcast in Aux. round 2 */
+static void bench_aux_ssid(CG21_SSID *dst, const CG21_SSID *src, octet *rho)
+{
+    dst->j_set_packed = src->j_set_packed;
+    dst->X_set_packed = src->X_set_packed;
+    dst->rid = src->rid;
+    dst->rho = rho;
+    dst->g = src->g;
+    dst->q = src->q;
+    dst->n1 = src->n1;
+}
+
+static void bench_aux(csprng *RNG, BENCH_AUX *aux, const BENCH_KEYS *keys)
+{
+    int rc;
+    int n = aux->n;
+
+    CG21_SSID ssid;
+    CG21_RESHARE_OUTPUT *rsOut = aux->rs->out;
+
+    octet *rid = rsOut[0].rid;
+    int t1 = rsOut[0].pk.pack_size;
+
+    // Round 1
+    for (int i = 0; i < n; i++)
+    {
+        CG21_AUX_FORM_SSID(aux->ssid + i, rid, rsOut[i].pk.X_set_packed, rsOut[i].pk.j_set_packed, t1);
+
+        BENCH_TIME("CG21_AUX_ROUND1_GEN_V",
+                   rc = CG21_AUX_ROUND1_GEN_V(RNG, aux->r1Pub + i, aux->r1Priv + i, aux->r1Out + i,
+                                              keys->paillier + i, aux->ssid + i, keys->pedersen + i, i + 1, t1));
+        bench_check("CG21_AUX_ROUND1_GEN_V", rc, CG21_OK);
+    }
+
+    // Round 3
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            bench_aux_ssid(&ssid, aux->ssid + j, aux->ssid[j].rho);
+
+            BENCH_TIME("CG21_AUX_ROUND3_CHECK_SSID",
+                       rc = CG21_AUX_ROUND3_CHECK_SSID(&ssid, rid, NULL, aux->ssid + i, t1, false));
+            bench_check("CG21_AUX_ROUND3_CHECK_SSID", rc, CG21_OK);
+
+            BENCH_TIME("CG21_AUX_ROUND3_CHECK_V_N",
+                       rc = CG21_AUX_ROUND3_CHECK_V_N(&ssid, aux->r1Pub[j], aux->r1Out + j));
+            bench_check("CG21_AUX_ROUND3_CHECK_V_N", rc, CG21_OK);
+
+            BENCH_TIME("CG21_PI_PRM_VERIFY_HELPER",
+                       rc = CG21_PI_PRM_VERIFY_HELPER(aux->r1Pub + j, aux->ssid + j));
+            bench_check("CG21_PI_PRM_VERIFY_HELPER", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("CG21_AUX_ROUND3_XOR_RHO", CG21_AUX_ROUND3_XOR_RHO(aux->r1Pub + i, aux->r3 + i, true));
+
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_AUX_ROUND3_XOR_RHO", CG21_AUX_ROUND3_XOR_RHO(aux->r1Pub + j, aux->r3 + i, false));
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        bench_aux_ssid(&ssid, aux->ssid + i, aux->r3[i].rho);
+
+        BENCH_TIME("CG21_PI_MOD_PROVE_HELPER",
+                   rc = CG21_PI_MOD_PROVE_HELPER(RNG, aux->r1Priv + i, &ssid, aux->r3 + i));
+        bench_check("CG21_PI_MOD_PROVE_HELPER", rc, CG21_OK);
+
+        // Pi-factor is proven against the Pedersen parameters of the first player
+        BENCH_TIME("CG21_PI_FACTOR_PROVE_HELPER",
+                   rc = CG21_PI_FACTOR_PROVE_HELPER(RNG, &ssid, aux->r1Pub + i, aux->r3 + i, aux->r1Priv));
+        bench_check("CG21_PI_FACTOR_PROVE_HELPER", rc, CG21_OK);
+    }
+
+    // Output
+    for (int i = 1; i < n; i++)
+    {
+        bench_aux_ssid(&ssid, aux->ssid + i, aux->r3[i].rho);
+
+        BENCH_TIME("CG21_PI_FACTOR_VERIFY_HELPER",
+                   rc = CG21_PI_FACTOR_VERIFY_HELPER(&ssid, aux->r3 + i, aux->r1Pub, aux->r1Priv + i));
+        bench_check("CG21_PI_FACTOR_VERIFY_HELPER", rc, CG21_OK);
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        bench_aux_ssid(&ssid, aux->ssid + i, aux->r3[i].rho);
+
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_PI_MOD_VERIFY_HELPER",
+                       rc = CG21_PI_MOD_VERIFY_HELPER(aux->r1Pub + j, &ssid, aux->r3 + j));
+            bench_check("CG21_PI_MOD_VERIFY_HELPER", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("CG21_AUX_PACK_OUTPUT", CG21_AUX_PACK_OUTPUT(aux->out + i, aux->r1Pub[i], true));
+
+        for (int j = 0; j < n; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_AUX_PACK_OUTPUT", CG21_AUX_PACK_OUTPUT(aux->out + i, aux->r1Pub[j], false));
+        }
+    }
+}
+
+static void bench_presign_init(BENCH_PRESIGN *ps, BENCH_RESHARE *rs, BENCH_AUX *aux)
+{
+    int t = rs->setting.t2;
+    int n = rs->setting.n2;
+
+    ps->t = t;
+    ps->rs = rs;
+    ps->aux = aux;
+
+    ps->ssid = bench_alloc(t * sizeof(CG21_SSID));
+    bench_ssid_init(ps->ssid, t, rs->setting.t1, n);
+
+    ps->r1Out = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND1_OUTPUT));
+    ps->r1Store = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND1_STORE));
+    ps->r3Out = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND3_OUTPUT));
+    ps->r3Store1 = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND3_STORE_1));
+    ps->r3Store2 = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND3_STORE_2));
+    ps->r4Store1 = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND4_STORE_1));
+    ps->r4Store2 = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND4_STORE_2));
+    ps->r4Out = bench_alloc(t * sizeof(CG21_PRESIGN_ROUND4_OUTPUT));
+
+    octet *psi = bench_octets(t, SGS_SECP256K1);
+    octet *G = bench_octets(t, FS_4096);
+    octet *K = bench_octets(t, FS_4096);
+    octet *k = bench_octets(t, EGS_SECP256K1);
+    octet *gamma = bench_octets(t, EGS_SECP256K1);
+    octet *rho = bench_octets(t, FS_4096);
+    octet *nu = bench_octets(t, FS_4096);
+    octet *a = bench_octets(t, EGS_SECP256K1);
+
+    octet *delta = bench_octets(t, EGS_SECP256K1);
+    octet *Delta = bench_octets(t, EFS_SECP256K1 + 1);
+    octet *Gamma3 = bench_octets(t, EFS_SECP256K1 + 1);
+    octet *Delta3 = bench_octets(t, EFS_SECP256K1 + 1);
+    octet *delta3 = bench_octets(t, EGS_SECP256K1);
+    octet *chi3 = bench_octets(t, EGS_SECP256K1);
+
+    octet *Delta4 = bench_octets(t, EFS_SECP256K1 + 1);
+    octet *delta4 = bench_octets(t, EGS_SECP256K1);
+    octet *R = bench_octets(t, EFS_SECP256K1 + 1);
+    octet *chi4 = bench_octets(t, EGS_SECP256K1);
+    octet *k4 = bench_octets(t, EGS_SECP256K1);
+
+    for (int i = 0; i < t; i++)
+    {
+        ps->r1Out[i].psi = psi + i;
+        ps->r1Out[i].G = G + i;
+        ps->r1Out[i].K = K + i;
+
+        ps->r1Store[i].k = k + i;
+        ps->r1Store[i].gamma = gamma + i;
+        ps->r1Store[i].rho = rho + i;
+        ps->r1Store[i].nu = nu + i;
+        ps->r1Store[i].a = a + i;
+
+        ps->r3Out[i].delta = delta + i;
+        ps->r3Out[i].Delta = Delta + i;
+        ps->r3Out[i].psi_douplePrime = NULL;
+
+        ps->r3Store1[i].Gamma = Gamma3 + i;
+        ps->r3Store1[i].Delta = Delta3 + i;
+
+        ps->r3Store2[i].delta = delta3 + i;
+        ps->r3Store2[i].chi = chi3 + i;
+
+        ps->r4Store1[i].Delta = Delta4 + i;
+        ps->r4Store1[i].delta = delta4 + i;
+
+        ps->r4Store2[i].R = R + i;
+        ps->r4Store2[i].chi = chi4 + i;
+        ps->r4Store2[i].k = k4 + i;
+    }
+
+    // Round 2 messages are indexed by sender * t + receiver
+    ps->r2Out = bench_alloc(t * t * sizeof(CG21_PRESIGN_ROUND2_OUTPUT));
+    ps->r2Store = bench_alloc(t * t * sizeof(CG21_PRESIGN_ROUND2_STORE));
+
+    octet *D = bench_octets(t * t, FS_4096);
+    octet *D_hat = bench_octets(t * t, FS_4096);
+    octet *F = bench_octets(t * t, FS_4096);
+    octet *F_hat = bench_octets(t * t, FS_4096);
+    octet *GammaOut = bench_octets(t * t, EFS_SECP256K1 + 1);
+
+    octet *r = bench_octets(t * t, FS_4096);
+    octet *r_hat = bench_octets(t * t, FS_4096);
+    octet *s = bench_octets(t * t, FS_4096);
+    octet *s_hat = bench_octets(t * t, FS_4096);
+    octet *beta = bench_octets(t * t, FS_2048);
+    octet *beta_hat = bench_octets(t * t, FS_2048);
+    octet *neg_beta = bench_octets(t * t, FS_2048);
+    octet *neg_beta_hat = bench_octets(t * t, FS_2048);
+    octet *GammaStore = bench_octets(t * t, EFS_SECP256K1 + 1);
+
+    for (int i = 0; i < t * t; i++)
+    {
+        ps->r2Out[i].D = D + i;
+        ps->r2Out[i].D_hat = D_hat + i;
+        ps->r2Out[i].F = F + i;
+        ps->r2Out[i].F_hat = F_hat + i;
+        ps->r2Out[i].Gamma = GammaOut + i;
+        ps->r2Out[i].psi = NULL;
+        ps->r2Out[i].psi_hat = NULL;
+        ps->r2Out[i].psi_prime = NULL;
+
+        ps->r2Store[i].r = r + i;
+        ps->r2Store[i].r_hat = r_hat + i;
+        ps->r2Store[i].s = s + i;
+        ps->r2Store[i].s_hat = s_hat + i;
+        ps->r2Store[i].beta = beta + i;
+        ps->r2Store[i].beta_hat = beta_hat + i;
+        ps->r2Store[i].neg_beta = neg_beta + i;
+        ps->r2Store[i].neg_beta_hat = neg_beta_hat + i;
+        ps->r2Store[i].Gamma = GammaStore + i;
+    }
+}
+
+/* The first player proves K_1 = enc(k_1) to every other player */
+static void bench_presign_pienc(csprng *RNG, BENCH_PRESIGN *ps, const BENCH_KEYS *keys)
+{
+    int rc;
+
+    PiEnc_SECRETS secrets;
+    PiEnc_COMMITS commits;
+    PiEnc_PROOFS proofs;
+
+    char s[FS_2048];
+    octet S = {0, sizeof(s), s};
+
+    char a[FS_4096];
+    octet A = {0, sizeof(a), a};
+
+    char c[FS_2048];
+    octet C = {0, sizeof(c), c};
+
+    char z1[HFS_2048];
+    octet Z1 = {0, sizeof(z1), z1};
+
+    char z2[HFS_4096];
+    octet Z2 = {0, sizeof(z2), z2};
+
+    char z3[FS_2048 + HFS_2048];
+    octet Z3 = {0, sizeof(z3), z3};
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    PiEnc_COMMITS_OCT commitsOct = {&S, &A, &C};
+    PiEnc_PROOFS_OCT proofsOct = {&Z1, &Z2, &Z3};
+
+    HDLOG_comb *combs = bench_alloc(2 * sizeof(HDLOG_comb));
+
+    for (int i = 1; i < ps->t; i++)
+    {
+        BENCH_TIME("PiEnc_Sample_randoms_and_commit",
+                   rc = PiEnc_Sample_randoms_and_commit(RNG, &keys->paillier[0].paillier_sk,
+                                                        &keys->pedersen[i].pedersenPub, ps->r1Store[0].k,
+                                                        &secrets, &commits, &commitsOct));
+        bench_check("PiEnc_Sample_randoms_and_commit", rc, PiEnc_OK);
+
+        BENCH_TIME("PiEnc_Challenge_gen",
+                   PiEnc_Challenge_gen(&keys->paillier[0].paillier_pk, &keys->pedersen[i].pedersenPub,
+                                       ps->r1Out[0].K, &commits, ps->ssid, &E));
+
+        BENCH_TIME("PiEnc_Prove",
+                   PiEnc_Prove(&keys->paillier[0].paillier_sk, ps->r1Store[0].k, ps->r1Store[0].rho,
+                               &secrets, &E, &proofs, &proofsOct));
+
+        PiEnc_Kill_secrets(&secrets);
+
+        BENCH_TIME("PiEnc_Verify",
+                   rc = PiEnc_Verify(&keys->paillier[0].paillier_pk, &keys->pedersen[i].pedersenPriv,
+                                     ps->r1Out[0].K, &commits, &E, &proofs));
+        bench_check("PiEnc_Verify", rc, PiEnc_OK);
+
+        // Verifier tables built once after the aux-info
+        PEDERSEN_PRIV priv = keys->pedersen[i].pedersenPriv;
+        CG21_Pedersen_precompute(&priv, combs, combs + 1);
+
+        BENCH_TIME("PiEnc_Verify_WITH_COMBS",
+                   rc = PiEnc_Verify(&keys->paillier[0].paillier_pk, &priv,
+                                     ps->r1Out[0].K, &commits, &E, &proofs));
+        bench_check("PiEnc_Verify_WITH_COMBS", rc, PiEnc_OK);
+
+        CG21_Pedersen_comb_kill(&priv);
+    }
+}
+
+/* The first player proves C = enc(x) and X = x.g to every other player */
+static void bench_presign_pilogstar(csprng *RNG, BENCH_PRESIGN *ps, const BENCH_KEYS *keys,
+                                    octet *x, octet *rho, octet *C, octet *g, int round)
+{
+    int rc;
+
+    PiLogstar_SECRETS secrets;
+    PiLogstar_COMMITS commits;
+    PiLogstar_PROOFS proofs;
+
+    char s[FS_2048];
+    octet S = {0, sizeof(s), s};
+
+    char a[FS_4096];
+    octet A = {0, sizeof(a), a};
+
+    char d[FS_2048];
+    octet D = {0, sizeof(d), d};
+
+    char y[FS_2048];
+    octet Y = {0, sizeof(y), y};
+
+    char z1[HFS_2048];
+    octet Z1 = {0, sizeof(z1), z1};
+
+    char z2[HFS_4096];
+    octet Z2 = {0, sizeof(z2), z2};
+
+    char z3[FS_2048 + HFS_2048];
+    octet Z3 = {0, sizeof(z3), z3};
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    PiLogstar_COMMITS_OCT commitsOct = {&S, &A, &D, &Y};
+    PiLogstar_PROOFS_OCT proofsOct = {&Z1, &Z2, &Z3};
+
+    for (int i = 1; i < ps->t; i++)
+    {
+        // X is Gamma_1 in round 2 and Delta_1 in round 3
+        octet *X = (round == 2) ? ps->r2Store[i].Gamma : ps->r3Store1[0].Delta;
+
+        BENCH_TIME("PiLogstar_Sample_and_commit",
+                   rc = PiLogstar_Sample_and_commit(RNG, &keys->paillier[0].paillier_sk,
+                                                    &keys->pedersen[i].pedersenPub, x, g,
+                                                    &secrets, &commits, &commitsOct));
+        bench_check("PiLogstar_Sample_and_commit", rc, PiLogstar_OK);
+
+        BENCH_TIME("PiLogstar_Challenge_gen",
+                   PiLogstar_Challenge_gen(&keys->paillier[0].paillier_pk, &keys->pedersen[i].pedersenPub,
+                                           C, &commits, ps->ssid, X, &E));
+
+        BENCH_TIME("PiLogstar_Prove",
+                   PiLogstar_Prove(&keys->paillier[0].paillier_sk, x, rho, &secrets, &E, &proofs, &proofsOct));
+
+        PiLogstar_clean_secrets(&secrets);
+
+        BENCH_TIME("PiLogstar_Verify",
+                   rc = PiLogstar_Verify(&keys->paillier[0].paillier_pk, &keys->pedersen[i].pedersenPriv,
+                                         C, g, &commits, X, &E, &proofs));
+        bench_check("PiLogstar_Verify", rc, PiLogstar_OK);
+    }
+}
+
+/* The first player proves the well formedness of D_{1,i} (hat = 0) or D_hat_{1,i} (hat = 1) */
+/* Round 2 of the first player with all the other players at once */
+static void bench_presign_round2_fanout(csprng *RNG, BENCH_PRESIGN *ps, const BENCH_KEYS *keys)
+{
+    int rc;
+    int t = ps->t;
+
+    PAILLIER_public_key hisPK[t - 1];
+
+    for (int j = 1; j < t; j++)
+    {
+        hisPK[j - 1] = keys->paillier[j].paillier_pk;
+    }
+
+    BENCH_TIME("CG21_PRESIGN_ROUND2_FANOUT_4_THREADS",
+               rc = CG21_PRESIGN_ROUND2_FANOUT(RNG, ps->r2Out + 1, ps->r2Store + 1, ps->r1Out + 1, ps->r1Store, hisPK,
+                                               &keys->paillier[0].paillier_pk, NULL, NULL, t - 1, 4));
+    bench_check("CG21_PRESIGN_ROUND2_FANOUT_4_THREADS", rc, CG21_OK);
+}
+
+/* Round 3 of the first player with all the other players at once */
+static void bench_presign_round3_fanout(BENCH_PRESIGN *ps, const BENCH_KEYS *keys)
+{
+    int rc;
+    int t = ps->t;
+
+    CG21_PRESIGN_ROUND2_OUTPUT r2hisOut[t - 1];
+
+    for (int j = 1; j < t; j++)
+    {
+        r2hisOut[j - 1] = ps->r2Out[j * t];
+    }
+
+    BENCH_TIME("CG21_PRESIGN_ROUND3_FANOUT_4_THREADS",
+               rc = CG21_PRESIGN_ROUND3_FANOUT(r2hisOut, ps->r3Out, ps->r3Store1, ps->r3Store2, ps->r1Store,
+                                               &keys->paillier[0].paillier_sk, ps->r2Store + 1, t - 1, 4));
+    bench_check("CG21_PRESIGN_ROUND3_FANOUT_4_THREADS", rc, CG21_OK);
+}
+
+static void bench_presign_piaffg(csprng *RNG, BENCH_PRESIGN *ps, const BENCH_KEYS *keys, int hat)
+{
+    int rc;
+
+    BIG_256_56 x;
+    ECP_SECP256K1 G;
+
+    Piaffg_SECRETS secrets;
+    Piaffg_COMMITS commits;
+    Piaffg_PROOFS proofs;
+
+    char ac[2 * FS_2048];
+    octet AC = {0, sizeof(ac), ac};
+
+    char bx[FS_2048];
+    octet BX = {0, sizeof(bx), bx};
+
+    char by[2 * FS_2048];
+    octet BY = {0, sizeof(by), by};
+
+    char ec[FS_2048];
+    octet EC = {0, sizeof(ec), ec};
+
+    char sc[FS_2048];
+    octet SC = {0, sizeof(sc), sc};
+
+    char fc[FS_2048];
+    octet FC = {0, sizeof(fc), fc};
+
+    char tc[FS_2048];
+    octet TC = {0, sizeof(tc), tc};
+
+    char z1[FS_2048];
+    octet Z1 = {0, sizeof(z1), z1};
+
+    char z2[FS_2048];
+    octet Z2 = {0, sizeof(z2), z2};
+
+    char z3[FS_2048 + HFS_2048];
+    octet Z3 = {0, sizeof(z3), z3};
+
+    char z4[FS_2048 + HFS_2048];
+    octet Z4 = {0, sizeof(z4), z4};
+
+    char w[FS_2048];
+    octet W = {0, sizeof(w), w};
+
+    char wy[FS_2048];
+    octet WY = {0, sizeof(wy), wy};
+
+    char e[MODBYTES_256_56];
+    octet E = {0, sizeof(e), e};
+
+    char xg[EFS_SECP256K1 + 1];
+    octet XG = {0, sizeof(xg), xg};
+
+    Piaffg_COMMITS_OCT commitsOct = {&AC, &BX, &BY, &EC, &SC, &FC, &TC};
+    Piaffg_PROOFS_OCT proofsOct = {&Z1, &Z2, &Z3, &Z4, &W, &WY};
+
+    octet *secret = hat ? ps->r1Store[0].a : ps->r1Store[0].gamma;
+
+    // X = a.G for D_hat, Gamma for D
+    if (hat)
+    {
+        BIG_256_56_fromBytesLen(x, secret->val, secret->len);
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+        ECP_SECP256K1_toOctet(&XG, &G, true);
+        BIG_256_56_zero(x);
+    }
+
+    for (int i = 1; i < ps->t; i++)
+    {
+        CG21_PRESIGN_ROUND2_OUTPUT *r2Out = ps->r2Out + i;
+        CG21_PRESIGN_ROUND2_STORE *r2Store = ps->r2Store + i;
+
+        octet *X = hat ? &XG : r2Store->Gamma;
+        octet *beta = hat ? r2Store->beta_hat : r2Store->beta;
+        octet *s = hat ? r2Store->s_hat : r2Store->s;
+        octet *r = hat ? r2Store->r_hat : r2Store->r;
+        octet *D = hat ? r2Out->D_hat : r2Out->D;
+        octet *F = hat ? r2Out->F_hat : r2Out->F;
+
+        BENCH_TIME("Piaffg_Sample_and_Commit",
+                   rc = Piaffg_Sample_and_Commit(RNG, &keys->paillier[0].paillier_sk, &keys->paillier[i].paillier_pk,
+                                                 &keys->pedersen[i].pedersenPub, secret, beta, &secrets,
+                                                 &commits, &commitsOct, ps->r1Out[i].K));
+        bench_check("Piaffg_Sample_and_Commit", rc, Piaffg_OK);
+
+        BENCH_TIME("Piaffg_Challenge_gen",
+                   Piaffg_Challenge_gen(&keys->paillier[i].paillier_pk, &keys->paillier[0].paillier_pk,
+                                        &keys->pedersen[i].pedersenPub, X, F, ps->r1Out[i].K, D,
+                                        &commits, ps->ssid, &E));
+
+        BENCH_TIME("Piaffg_Prove",
+                   Piaffg_Prove(&keys->paillier[0].paillier_pk, &keys->paillier[i].paillier_pk, &secrets,
+                                secret, beta, s, r, &E, &proofs, &proofsOct));
+
+        Piaffg_Kill_secrets(&secrets);
+
+        BENCH_TIME("Piaffg_Verify",
+                   rc = Piaffg_Verify(&keys->paillier[i].paillier_sk, &keys->paillier[0].paillier_pk,
+                                      &keys->pedersen[i].pedersenPriv, ps->r1Out[i].K, D, X, F,
+                                      &commits, &E, &proofs));
+        bench_check("Piaffg_Verify", rc, Piaffg_OK);
+    }
+}
+
+static void bench_presign(csprng *RNG, BENCH_PRESIGN *ps, const BENCH_KEYS *keys)
+{
+    int rc;
+    int t = ps->t;
+
+    ECP_SECP256K1 G;
+
+    char g[SFS_SECP256K1 + 1];
+    octet GEN = {0, sizeof(g), g};
+
+    char uid[iLEN];
+    octet UID = {0, sizeof(uid), uid};
+
+    CG21_RESHARE_OUTPUT *rsOut = ps->rs->out;
+    CG21_RESHARE_SETTING *setting = &ps->rs->setting;
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_toOctet(&GEN, &G, true);
+
+    OCT_rand(&UID, RNG, UID.max);
+
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_VALIDATE_PARTIAL_PKS", rc = CG21_VALIDATE_PARTIAL_PKS(rsOut + i));
+        bench_check("CG21_VALIDATE_PARTIAL_PKS", rc, CG21_OK);
+
+        BENCH_TIME("CG21_PRESIGN_GET_SSID",
+                   CG21_PRESIGN_GET_SSID(ps->ssid + i, rsOut + i, setting->t1, setting->n2, ps->aux->out + i));
+        OCT_copy(ps->ssid[i].uid, &UID);
+    }
+
+    // Round 1
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_PRESIGN_ROUND1",
+                   rc = CG21_PRESIGN_ROUND1(RNG, rsOut + i, setting, ps->r1Out + i, ps->r1Store + i,
+                                            &keys->paillier[i].paillier_pk));
+        bench_check("CG21_PRESIGN_ROUND1", rc, CG21_OK);
+    }
+
+    // Round 1 again for the first player, with rho and nu computed ahead of time
+    CG21_PAILLIER_POOL_ENTRY entries[2];
+    CG21_PAILLIER_POOL pool;
+
+    CG21_PAILLIER_POOL_INIT(&pool, entries, 2, RNG, &keys->paillier[0].paillier_pk, &keys->paillier[0].paillier_sk);
+    BENCH_TIME("CG21_PAILLIER_POOL_FILL", CG21_PAILLIER_POOL_FILL(&pool, 2));
+
+    BENCH_TIME("CG21_PRESIGN_ROUND1_POOLED",
+               rc = CG21_PRESIGN_ROUND1_POOLED(RNG, rsOut, setting, ps->r1Out, ps->r1Store,
+                                               &keys->paillier[0].paillier_pk, &pool));
+    bench_check("CG21_PRESIGN_ROUND1_POOLED", rc, CG21_OK);
+
+    CG21_PAILLIER_POOL_KILL(&pool);
+
+    bench_presign_pienc(RNG, ps, keys);
+
+    // Round 2
+    for (int i = 0; i < t; i++)
+    {
+        for (int j = 0; j < t; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_PRESIGN_ROUND2",
+                       rc = CG21_PRESIGN_ROUND2(RNG, ps->r2Out + i * t + j, ps->r2Store + i * t + j, ps->r1Out + j,
+                                                ps->r1Store + i, &keys->paillier[j].paillier_pk,
+                                                &keys->paillier[i].paillier_pk));
+            bench_check("CG21_PRESIGN_ROUND2", rc, CG21_OK);
+        }
+    }
+
+    bench_presign_round2_fanout(RNG, ps, keys);
+
+    bench_presign_pilogstar(RNG, ps, keys, ps->r1Store[0].gamma, ps->r1Store[0].nu, ps->r1Out[0].G, &GEN, 2);
+    bench_presign_piaffg(RNG, ps, keys, 0);
+    bench_presign_piaffg(RNG, ps, keys, 1);
+
+    // Round 3
+    for (int i = 0; i < t; i++)
+    {
+        for (int j = 0; j < t; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_PRESIGN_ROUND3_2_1",
+                       rc = CG21_PRESIGN_ROUND3_2_1(ps->r2Out + j * t + i, ps->r3Store1 + i, ps->r2Store + i * t + j,
+                                                    ps->r1Store + i, bench_status(i, j, t)));
+            bench_check("CG21_PRESIGN_ROUND3_2_1", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < t; i++)
+    {
+        for (int j = 0; j < t; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_PRESIGN_ROUND3_2_2",
+                       rc = CG21_PRESIGN_ROUND3_2_2(ps->r2Out + j * t + i, ps->r3Out + i, ps->r3Store1 + i,
+                                                    ps->r3Store2 + i, ps->r1Store + i, &keys->paillier[i].paillier_sk,
+                                                    ps->r2Store + i * t + j, bench_status(i, j, t)));
+            bench_check("CG21_PRESIGN_ROUND3_2_2", rc, CG21_OK);
+        }
+    }
+
+    bench_presign_round3_fanout(ps, keys);
+
+    bench_presign_pilogstar(RNG, ps, keys, ps->r1Store[0].k, ps->r1Store[0].rho, ps->r1Out[0].K,
+                            ps->r3Store1[0].Gamma, 3);
+
+    // Output
+    for (int i = 0; i < t; i++)
+    {
+        for (int j = 0; j < t; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_PRESIGN_OUTPUT_2_1",
+                       rc = CG21_PRESIGN_OUTPUT_2_1(ps->r3Out + j, ps->r3Out + i, ps->r4Store1 + i, bench_status(i, j, t)));
+            bench_check("CG21_PRESIGN_OUTPUT_2_1", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_PRESIGN_OUTPUT_2_2",
+                   rc = CG21_PRESIGN_OUTPUT_2_2(ps->r1Store + i, ps->r3Store1 + i, ps->r3Store2 + i,
+                                                ps->r4Store1 + i, ps->r4Store2 + i, ps->r4Out + i));
+        bench_check("CG21_PRESIGN_OUTPUT_2_2", rc, CG21_OK);
+    }
+}
+
+static void bench_sign_init(BENCH_SIGN *sg, BENCH_PRESIGN *ps)
+{
+    int t = ps->t;
+
+    char msg[] = "test message";
+
+    sg->t = t;
+    sg->ps = ps;
+
+    sg->msg = bench_octets(1, sizeof(msg));
+    OCT_jstring(sg->msg, msg);
+
+    sg->r1Store = bench_alloc(t * sizeof(CG21_SIGN_ROUND1_STORE));
+    sg->r1Out = bench_alloc(t * sizeof(CG21_SIGN_ROUND1_OUTPUT));
+    sg->r2Out = bench_alloc(t * sizeof(CG21_SIGN_ROUND2_OUTPUT));
+
+    octet *r1 = bench_octets(t, EGS_SECP256K1);
+    octet *sigma1 = bench_octets(t, EGS_SECP256K1);
+    octet *sigmaOut = bench_octets(t, EGS_SECP256K1);
+    octet *r2 = bench_octets(t, EGS_SECP256K1);
+    octet *sigma2 = bench_octets(t, EGS_SECP256K1);
+
+    for (int i = 0; i < t; i++)
+    {
+        sg->r1Store[i].r = r1 + i;
+        sg->r1Store[i].sigma = sigma1 + i;
+        sg->r1Out[i].sigma = sigmaOut + i;
+        sg->r2Out[i].r = r2 + i;
+        sg->r2Out[i].sigma = sigma2 + i;
+    }
+}
+
+static void bench_sign(BENCH_SIGN *sg)
+{
+    int rc;
+    int t = sg->t;
+
+    octet *PK = sg->ps->rs->out[0].pk.X;
+
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_SIGN_ROUND1",
+                   rc = CG21_SIGN_ROUND1(sg->msg, sg->ps->r4Store2 + i, sg->r1Store + i, sg->r1Out + i));
+        bench_check("CG21_SIGN_ROUND1", rc, CG21_OK);
+    }
+
+    for (int i = 0; i < t; i++)
+    {
+        for (int j = 0; j < t; j++)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            BENCH_TIME("CG21_SIGN_ROUND2",
+                       rc = CG21_SIGN_ROUND2(sg->r1Store + i, sg->r1Out + j, sg->r2Out + i, bench_status(i, j, t)));
+            bench_check("CG21_SIGN_ROUND2", rc, CG21_OK);
+        }
+    }
+
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_SIGN_VALIDATE", rc = CG21_SIGN_VALIDATE(sg->msg, sg->r2Out + i, PK));
+        bench_check("CG21_SIGN_VALIDATE", rc, CG21_OK);
+    }
+}
+
+/* Sign again from presignatures checked out of a pool. The first player
+ * picks the presignature, the others take it by id
+ */
+static void bench_sign_pool(BENCH_SIGN *sg)
+{
+    int rc;
+    int id = -1;
+    int t = sg->t;
+
+    CG21_PRESIGN_POOL *pools = bench_alloc(t * sizeof(CG21_PRESIGN_POOL));
+    CG21_PRESIGN_POOL_ENTRY *entries = bench_alloc(t * sizeof(CG21_PRESIGN_POOL_ENTRY));
+
+    for (int i = 0; i < t; i++)
+    {
+        CG21_PRESIGN_POOL_INIT(pools + i, entries + i, 1, sg->ps->r4Store2[i].i);
+
+        BENCH_TIME("CG21_PRESIGN_POOL_PUT",
+                   rc = CG21_PRESIGN_POOL_PUT(pools + i, sg->ps->r4Store2 + i, NULL));
+        bench_check("CG21_PRESIGN_POOL_PUT", rc, CG21_OK);
+    }
+
+    for (int i = 0; i < t; i++)
+    {
+        BENCH_TIME("CG21_PRESIGN_POOL_SIGN",
+                   rc = CG21_PRESIGN_POOL_SIGN(pools + i, &id, sg->msg, sg->r1Store + i, sg->r1Out + i));
+        bench_check("CG21_PRESIGN_POOL_SIGN", rc, CG21_OK);
+
+        CG21_PRESIGN_POOL_KILL(pools + i);
+    }
+}
+
+void bench_cg21(csprng *RNG, const BENCH_CONFIG *cfg, const BENCH_KEYS *keys)
+{
+    BENCH_KEYGEN kg;
+    BENCH_RESHARE rs;
+    BENCH_AUX aux;
+    BENCH_PRESIGN ps;
+    BENCH_SIGN sg;
+
+    bench_keygen_init(&kg, cfg->t, cfg->n);
+    bench_reshare_init(&rs, &kg);
+    bench_aux_init(&aux, &rs);
+    bench_presign_init(&ps, &rs, &aux);
+    bench_sign_init(&sg, &ps);
+
+    for (int i = 0; i < cfg->iterations; i++)
+    {
+        bench_keygen(RNG, &kg);
+        bench_reshare(RNG, &rs, keys);
+        bench_aux(RNG, &aux, keys);
+        bench_presign(RNG, &ps, keys);
+        bench_zkp(RNG, keys, ps.ssid, *ps.ssid->n1);
+        bench_sign(&sg);
+        bench_sign_pool(&sg);
+    }
+}
@@ -0,0 +1,286 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Benchmark HDLOG, SSS/VSS, Schnorr and EC multiplication entry points */
+
+#include "bench.h"
+#include "amcl/hidden_dlog.h"
+#include "amcl/shamir.h"
+#include "amcl/schnorr.h"
+#include "amcl/ecp_gen.h"
+#include "amcl/ecp_msm.h"
+
+static void bench_hdlog(csprng *RNG, const BENCH_KEYS *keys)
+{
+    int rc;
+
+    BIG_1024_58 ord[FFLEN_2048];
+    BIG_1024_58 ws1[HFLEN_2048];
+    BIG_1024_58 ws2[HFLEN_2048];
+
+    HDLOG_iter_values r;
+    HDLOG_iter_values rho;
+    HDLOG_iter_values t;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char ad[32];
+    octet AD = {0, sizeof(ad), ad};
+
+    char e[HDLOG_CHALLENGE_SIZE];
+    octet E = {0, sizeof(e), e};
+
+    PEDERSEN_PRIV *priv = &keys->pedersen[0].pedersenPriv;
+
+    OCT_rand(&ID, RNG, ID.max);
+    OCT_rand(&AD, RNG, AD.max);
+
+    // Order of B0 is p'q'
+    FF_2048_copy(ws1, priv->mod.p, HFLEN_2048);
+    FF_2048_copy(ws2, priv->mod.q, HFLEN_2048);
+    FF_2048_shr(ws1, HFLEN_2048);
+    FF_2048_shr(ws2, HFLEN_2048);
+    FF_2048_mul(ord, ws1, ws2, HFLEN_2048);
+
+    BENCH_TIME("HDLOG_commit", HDLOG_commit(RNG, &priv->mod, ord, priv->b0, r, rho));
+    BENCH_TIME("HDLOG_challenge", HDLOG_challenge(priv->mod.n, priv->b0, priv->b1, rho, &ID, &AD, &E));
+    BENCH_TIME("HDLOG_prove", HDLOG_prove(ord, priv->alpha, r, &E, t));
+    BENCH_TIME("HDLOG_verify", rc = HDLOG_verify(priv->mod.n, priv->b0, priv->b1, rho, &E, t));
+    bench_check("HDLOG_verify", rc, HDLOG_OK);
+    BENCH_TIME("HDLOG_batch_verify", rc = HDLOG_batch_verify(RNG, priv->mod.n, priv->b0, priv->b1, rho, &E, t, NULL));
+    bench_check("HDLOG_batch_verify", rc, HDLOG_OK);
+
+    HDLOG_iter_values_kill(r);
+    FF_2048_zero(ws1, HFLEN_2048);
+    FF_2048_zero(ws2, HFLEN_2048);
+    FF_2048_zero(ord, FFLEN_2048);
+}
+
+static void bench_shamir(csprng *RNG, int t, int n)
+{
+    int rc;
+
+    char s[SGS_SECP256K1];
+    octet S = {0, sizeof(s), s};
+
+    char sh[SGS_SECP256K1];
+    octet SH = {0, sizeof(sh), sh};
+
+    octet *X = bench_octets(n, SGS_SECP256K1);
+    octet *Y = bench_octets(n, SGS_SECP256K1);
+    octet *C = bench_octets(t, SFS_SECP256K1 + 1);
+    octet *OTHERS = bench_octets(t - 1, SGS_SECP256K1);
+
+    SSS_shares shares = {X, Y};
+
+    BENCH_TIME("SSS_make_shares", SSS_make_shares(t, n, RNG, &shares, &S));
+    BENCH_TIME("SSS_recover_secret", SSS_recover_secret(t, &shares, &S));
+
+    for (int i = 0; i < t; i++)
+    {
+        octet *other = OTHERS;
+        for (int j = 0; j < t; j++)
+        {
+            if (j == i)
+            {
+                continue;
+            }
+            OCT_copy(other, X + j);
+            other++;
+        }
+
+        BENCH_TIME("SSS_shamir_to_additive", SSS_shamir_to_additive(t, X + i, Y + i, OTHERS, &SH));
+    }
+
+    BENCH_TIME("VSS_make_shares", VSS_make_shares(t, n, RNG, &shares, C, &S));
+
+    for (int i = 0; i < n; i++)
+    {
+        BENCH_TIME("VSS_verify_shares", rc = VSS_verify_shares(t, X + i, Y + i, C));
+        bench_check("VSS_verify_shares", rc, VSS_OK);
+    }
+
+    BENCH_TIME("VSS_batch_verify_shares", rc = VSS_batch_verify_shares(t, n, X, Y, C, 0, NULL));
+    bench_check("VSS_batch_verify_shares", rc, VSS_OK);
+
+    OCT_clear(&S);
+    OCT_clear(&SH);
+}
+
+static void bench_schnorr(csprng *RNG)
+{
+    int rc;
+
+    BIG_256_56 x;
+    BIG_256_56 l;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 ECPR;
+
+    char x_char[SGS_SECP256K1];
+    octet X = {0, sizeof(x_char), x_char};
+
+    char l_char[SGS_SECP256K1];
+    octet L = {0, sizeof(l_char), l_char};
+
+    char v[SFS_SECP256K1 + 1];
+    octet V = {0, sizeof(v), v};
+
+    char v2[SFS_SECP256K1 + 1];
+    octet V2 = {0, sizeof(v2), v2};
+
+    char rr[SFS_SECP256K1 + 1];
+    octet RR = {0, sizeof(rr), rr};
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char ad[32];
+    octet AD = {0, sizeof(ad), ad};
+
+    char r[SGS_SECP256K1];
+    octet R = {0, sizeof(r), r};
+
+    char a[SGS_SECP256K1];
+    octet A = {0, sizeof(a), a};
+
+    char b[SGS_SECP256K1];
+    octet B = {0, sizeof(b), b};
+
+    char c[SFS_SECP256K1 + 1];
+    octet C = {0, sizeof(c), c};
+
+    char e[SGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char p[SGS_SECP256K1];
+    octet P = {0, sizeof(p), p};
+
+    char u[SGS_SECP256K1];
+    octet U = {0, sizeof(u), u};
+
+    OCT_rand(&ID, RNG, ID.max);
+    OCT_rand(&AD, RNG, AD.max);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Single DLOG V = x.G
+    BIG_256_56_randomnum(x, q, RNG);
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, x);
+    BIG_256_56_toBytes(X.val, x);
+    X.len = SGS_SECP256K1;
+    ECP_SECP256K1_toOctet(&V, &G, 1);
+
+    BENCH_TIME("SCHNORR_commit", SCHNORR_commit(RNG, &R, &C));
+    BENCH_TIME("SCHNORR_challenge", SCHNORR_challenge(&V, &C, &ID, &AD, &E));
+    BENCH_TIME("SCHNORR_prove", SCHNORR_prove(&R, &E, &X, &P));
+    BENCH_TIME("SCHNORR_verify", rc = SCHNORR_verify(&V, &C, &E, &P));
+    bench_check("SCHNORR_verify", rc, SCHNORR_OK);
+
+    // Double DLOG V = x.R + l.G
+    ECP_SECP256K1_generator(&ECPR);
+    BIG_256_56_randomnum(l, q, RNG);
+    ECP_SECP256K1_mul(&ECPR, l);
+    ECP_SECP256K1_toOctet(&RR, &ECPR, 1);
+
+    BIG_256_56_randomnum(l, q, RNG);
+    BIG_256_56_toBytes(L.val, l);
+    L.len = SGS_SECP256K1;
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul2(&G, &ECPR, l, x);
+    ECP_SECP256K1_toOctet(&V2, &G, 1);
+
+    BENCH_TIME("SCHNORR_D_commit", rc = SCHNORR_D_commit(RNG, &RR, &A, &B, &C));
+    bench_check("SCHNORR_D_commit", rc, SCHNORR_OK);
+    BENCH_TIME("SCHNORR_D_challenge", SCHNORR_D_challenge(&RR, &V2, &C, &ID, &AD, &E));
+    BENCH_TIME("SCHNORR_D_prove", SCHNORR_D_prove(&A, &B, &E, &X, &L, &P, &U));
+    BENCH_TIME("SCHNORR_D_verify", rc = SCHNORR_D_verify(&RR, &V2, &C, &E, &P, &U));
+    bench_check("SCHNORR_D_verify", rc, SCHNORR_OK);
+
+    BIG_256_56_zero(x);
+    BIG_256_56_zero(l);
+    OCT_clear(&X);
+    OCT_clear(&L);
+    OCT_clear(&R);
+    OCT_clear(&A);
+    OCT_clear(&B);
+}
+
+static void bench_ecp_gen(csprng *RNG)
+{
+    BIG_256_56 s;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(s, q, RNG);
+
+    ECP_GEN_precompute();
+
+    BENCH_TIME("ECP_SECP256K1_mul_generator", (ECP_SECP256K1_generator(&G), ECP_SECP256K1_mul(&G, s)));
+    BENCH_TIME("ECP_GEN_mul", ECP_GEN_mul(&G, s));
+
+    BIG_256_56_zero(s);
+}
+
+static void bench_ecp_msm(csprng *RNG, int n)
+{
+    BIG_256_56 q;
+    BIG_256_56 e[n];
+    ECP_SECP256K1 Q[n];
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 T;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (int i = 0; i < n; i++)
+    {
+        BIG_256_56_randomnum(e[i], q, RNG);
+        ECP_GEN_mul(&Q[i], e[i]);
+        BIG_256_56_randomnum(e[i], q, RNG);
+    }
+
+    // n independent multiplications, as done before the MSM
+    BENCH_TIME("ECP_SECP256K1_mul_sum", do {
+        ECP_SECP256K1_inf(&P);
+        for (int i = 0; i < n; i++)
+        {
+            ECP_SECP256K1_copy(&T, &Q[i]);
+            ECP_SECP256K1_mul(&T, e[i]);
+            ECP_SECP256K1_add(&P, &T);
+        }
+    } while (0));
+
+    BENCH_TIME("ECP_MSM_mul", ECP_MSM_mul(&P, Q, e, n));
+}
+
+void bench_primitives(csprng *RNG, const BENCH_CONFIG *cfg, const BENCH_KEYS *keys)
+{
+    for (int i = 0; i < cfg->iterations; i++)
+    {
+        bench_hdlog(RNG, keys);
+        bench_shamir(RNG, cfg->t, cfg->n);
+        bench_schnorr(RNG);
+        bench_ecp_gen(RNG);
+        bench_ecp_msm(RNG, cfg->t);
+    }
+}
@@ -0,0 +1,271 @@
+/*
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing,
+    software distributed under the License is distributed on an
+    "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+    KIND, either express or implied.  See the License for the
+    specific language governing permissions and limitations
+    under the License.
+*/
+
+/* Benchmark the prove/verify pairs of the ZKPs not covered by the CG21 rounds
+ *
+ * The first player is the prover and the second player is the verifier.
+ * The ssid is the one formed by the Pre-Sign benchmark.
+ */
+
+#include "bench.h"
+#include "amcl/cg21/cg21_rp_pi_affp.h"
+
+static void bench_piprm(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid, int n)
+{
+    int rc;
+
+    octet *rho = bench_octets(1, HDLOG_VALUES_SIZE);
+    octet *irho = bench_octets(1, HDLOG_VALUES_SIZE);
+    octet *t = bench_octets(1, HDLOG_VALUES_SIZE);
+    octet *it = bench_octets(1, HDLOG_VALUES_SIZE);
+
+    CG21_PIPRM_PROOF_OCT proof = {rho, irho, t, it};
+
+    BENCH_TIME("CG21_PI_PRM_PROVE",
+               rc = CG21_PI_PRM_PROVE(RNG, &keys->pedersen[0].pedersenPriv, ssid, &proof));
+    bench_check("CG21_PI_PRM_PROVE", rc, CG21_OK);
+
+    // Reuse the combs of b0 and b1 across proofs
+    PEDERSEN_PRIV priv = keys->pedersen[0].pedersenPriv;
+    HDLOG_comb *combs = bench_alloc(2 * sizeof(HDLOG_comb));
+
+    CG21_Pedersen_precompute(&priv, combs, combs + 1);
+
+    BENCH_TIME("CG21_PI_PRM_PROVE_WITH_COMBS",
+               rc = CG21_PI_PRM_PROVE(RNG, &priv, ssid, &proof));
+    bench_check("CG21_PI_PRM_PROVE_WITH_COMBS", rc, CG21_OK);
+
+    CG21_Pedersen_comb_kill(&priv);
+
+    BENCH_TIME("CG21_PI_PRM_VERIFY",
+               rc = CG21_PI_PRM_VERIFY(&keys->pedersen[0].pedersenPub, ssid, &proof, n));
+    bench_check("CG21_PI_PRM_VERIFY", rc, CG21_OK);
+
+    BENCH_TIME("CG21_PI_PRM_VERIFY_BATCH",
+               rc = CG21_PI_PRM_VERIFY_BATCH(RNG, &keys->pedersen[0].pedersenPub, ssid, &proof, n));
+    bench_check("CG21_PI_PRM_VERIFY_BATCH", rc, CG21_OK);
+}
+
+static void bench_pimod(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid, int n)
+{
+    int rc;
+
+    octet *w = bench_octets(1, HFS_4096);
+    octet *x = bench_octets(1, CG21_PAILLIER_PROOF_SIZE);
+    octet *z = bench_octets(1, CG21_PAILLIER_PROOF_SIZE);
+    octet *ab = bench_octets(1, CG21_PAILLIER_PROOF_ITERS * 4);
+
+    CG21_PIMOD_PROOF_OCT proof = {w, x, z, ab};
+    CG21_PIMOD_PROVER prover;
+
+    BENCH_TIME("CG21_PI_MOD_PROVE",
+               rc = CG21_PI_MOD_PROVE(RNG, keys->paillier[0], ssid, &proof, n));
+    bench_check("CG21_PI_MOD_PROVE", rc, CG21_OK);
+
+    BENCH_TIME("CG21_PI_MOD_VERIFY",
+               rc = CG21_PI_MOD_VERIFY(&proof, ssid, keys->paillier[0].paillier_pk, n));
+    bench_check("CG21_PI_MOD_VERIFY", rc, CG21_OK);
+
+    BENCH_TIME("CG21_PI_MOD_PROVER_SETUP",
+               rc = CG21_PI_MOD_PROVER_SETUP(&prover, &keys->paillier[0]));
+    bench_check("CG21_PI_MOD_PROVER_SETUP", rc, CG21_OK);
+
+    BENCH_TIME("CG21_PI_MOD_PROVE_WITH_PROVER",
+               rc = CG21_PI_MOD_PROVE_WITH_PROVER(RNG, &prover, ssid, &proof, n));
+    bench_check("CG21_PI_MOD_PROVE_WITH_PROVER", rc, CG21_OK);
+
+    CG21_PI_MOD_PROVER_KILL(&prover);
+
+    BENCH_TIME("CG21_PI_MOD_BATCH_VERIFY",
+               rc = CG21_PI_MOD_BATCH_VERIFY(&proof, ssid, keys->paillier[0].paillier_pk, n, 1));
+    bench_check("CG21_PI_MOD_BATCH_VERIFY", rc, CG21_OK);
+
+    BENCH_TIME("CG21_PI_MOD_BATCH_VERIFY_4_THREADS",
+               rc = CG21_PI_MOD_BATCH_VERIFY(&proof, ssid, keys->paillier[0].paillier_pk, n, 4));
+    bench_check("CG21_PI_MOD_BATCH_VERIFY_4_THREADS", rc, CG21_OK);
+}
+
+static void bench_pifactor(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid, int n)
+{
+    int rc;
+
+    char N[FS_2048];
+    octet N_oct = {0, sizeof(N), N};
+
+    CG21_PiFACTOR_COMMIT commit;
+    CG21_PiFACTOR_PROOF proof;
+
+    commit.P = bench_octets(1, FS_2048);
+    commit.Q = bench_octets(1, FS_2048);
+    commit.A = bench_octets(1, FS_2048);
+    commit.B = bench_octets(1, FS_2048);
+    commit.T = bench_octets(1, FS_2048);
+    commit.sigma = bench_octets(1, 2 * FS_2048 + HFS_2048);
+
+    proof.z1 = bench_octets(1, FS_2048 + HFS_2048);
+    proof.z2 = bench_octets(1, FS_2048 + HFS_2048);
+    proof.w1 = bench_octets(1, FS_2048 + HFS_2048);
+    proof.w2 = bench_octets(1, FS_2048 + HFS_2048);
+    proof.v = bench_octets(1, 2 * FS_2048 + HFS_2048);
+
+    FF_4096_toOctet(&N_oct, keys->paillier[0].paillier_pk.n, HFLEN_4096);
+
+    BENCH_TIME("CG21_PI_FACTOR_COMMIT_PROVE",
+               CG21_PI_FACTOR_COMMIT_PROVE(RNG, ssid, &keys->pedersen[1].pedersenPub, &commit, &proof,
+                                           keys->P, keys->Q, n));
+
+    BENCH_TIME("CG21_PI_FACTOR_VERIFY",
+               rc = CG21_PI_FACTOR_VERIFY(&commit, &proof, &N_oct, &keys->pedersen[1].pedersenPriv, ssid, n));
+    bench_check("CG21_PI_FACTOR_VERIFY", rc, CG21_OK);
+}
+
+static void bench_piaffp(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid)
+{
+    int rc;
+
+    PAILLIER_private_key *prover_sk = &keys->paillier[0].paillier_sk;
+    PAILLIER_public_key *prover_pk = &keys->paillier[0].paillier_pk;
+    PAILLIER_private_key *verifier_sk = &keys->paillier[1].paillier_sk;
+    PAILLIER_public_key *verifier_pk = &keys->paillier[1].paillier_pk;
+
+    PiAffp_SECRETS secrets;
+    PiAffp_COMMITS commits;
+    PiAffp_PROOFS proofs;
+    PiAffp_COMMITS_OCT commitsOct;
+    PiAffp_PROOFS_OCT proofsOct;
+
+    char x[MODBYTES_256_56];
+    octet X_PT = {0, sizeof(x), x};
+
+    char y[MODBYTES_256_56];
+    octet Y_PT = {0, sizeof(y), y};
+
+    char pt[HFS_4096];
+    octet PT = {0, sizeof(pt), pt};
+
+    char rho[2 * FS_2048];
+    octet RHO = {0, sizeof(rho), rho};
+
+    char rho_x[2 * FS_2048];
+    octet RHO_X = {0, sizeof(rho_x), rho_x};
+
+    char rho_y[2 * FS_2048];
+    octet RHO_Y = {0, sizeof(rho_y), rho_y};
+
+    char r[2 * FS_2048];
+    octet R = {0, sizeof(r), r};
+
+    char cx[2 * FS_2048];
+    octet CX = {0, sizeof(cx), cx};
+
+    char cy[2 * FS_2048];
+    octet CY = {0, sizeof(cy), cy};
+
+    char c[2 * FS_2048];
+    octet C = {0, sizeof(c), c};
+
+    char d[2 * FS_2048];
+    octet D = {0, sizeof(d), d};
+
+    char e[EGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char a1[2 * FS_2048], a2[2 * FS_2048], a3[2 * FS_2048];
+    char a4[FS_2048], a5[FS_2048], a6[FS_2048], a7[FS_2048];
+
+    commitsOct.A = (octet){0, sizeof(a1), a1};
+    commitsOct.Bx = (octet){0, sizeof(a2), a2};
+    commitsOct.By = (octet){0, sizeof(a3), a3};
+    commitsOct.E = (octet){0, sizeof(a4), a4};
+    commitsOct.S = (octet){0, sizeof(a5), a5};
+    commitsOct.F = (octet){0, sizeof(a6), a6};
+    commitsOct.T = (octet){0, sizeof(a7), a7};
+
+    char z1[FS_2048], z2[FS_2048], z3[FS_2048 + HFS_2048], z4[FS_2048 + HFS_2048];
+    char w[FS_2048], wx[FS_2048], wy[FS_2048];
+
+    proofsOct.z1 = (octet){0, sizeof(z1), z1};
+    proofsOct.z2 = (octet){0, sizeof(z2), z2};
+    proofsOct.z3 = (octet){0, sizeof(z3), z3};
+    proofsOct.z4 = (octet){0, sizeof(z4), z4};
+    proofsOct.w = (octet){0, sizeof(w), w};
+    proofsOct.wx = (octet){0, sizeof(wx), wx};
+    proofsOct.wy = (octet){0, sizeof(wy), wy};
+
+    OCT_rand(&X_PT, RNG, X_PT.max);
+    OCT_rand(&Y_PT, RNG, Y_PT.max);
+
+    // X = Enc_prover(x; rho_x), Y = Enc_prover(y; rho_y)
+    OCT_copy(&PT, &X_PT);
+    OCT_pad(&PT, HFS_4096);
+    PAILLIER_ENCRYPT(RNG, prover_pk, &PT, &CX, &RHO_X);
+
+    OCT_copy(&PT, &Y_PT);
+    OCT_pad(&PT, HFS_4096);
+    PAILLIER_ENCRYPT(RNG, prover_pk, &PT, &CY, &RHO_Y);
+
+    // C = Enc_verifier(random), D = C^x * Enc_verifier(y; rho)
+    OCT_rand(&PT, RNG, MODBYTES_256_56);
+    OCT_pad(&PT, HFS_4096);
+    PAILLIER_ENCRYPT(RNG, verifier_pk, &PT, &C, NULL);
+
+    OCT_copy(&PT, &X_PT);
+    OCT_pad(&PT, HFS_4096);
+    PAILLIER_MULT(verifier_pk, &C, &PT, &D);
+
+    OCT_copy(&PT, &Y_PT);
+    OCT_pad(&PT, HFS_4096);
+    PAILLIER_ENCRYPT(RNG, verifier_pk, &PT, &R, &RHO);
+    PAILLIER_ADD(verifier_pk, &D, &R, &D);
+
+    BENCH_TIME("PiAffp_Sample_and_Commit",
+               rc = PiAffp_Sample_and_Commit(RNG, prover_sk, verifier_pk, &keys->pedersen[1].pedersenPub,
+                                             &X_PT, &Y_PT, &secrets, &commits, &commitsOct, &C));
+    bench_check("PiAffp_Sample_and_Commit", rc, PiAffp_OK);
+
+    BENCH_TIME("PiAffp_Challenge_gen",
+               PiAffp_Challenge_gen(verifier_pk, prover_pk, &keys->pedersen[1].pedersenPub,
+                                    &CX, &CY, &C, &D, &commits, ssid, &E));
+
+    BENCH_TIME("PiAffp_Prove",
+               PiAffp_Prove(prover_pk, verifier_pk, &secrets, &X_PT, &Y_PT, &RHO, &RHO_X, &RHO_Y,
+                            &E, &proofs, &proofsOct));
+
+    PiAffp_Kill_secrets(&secrets);
+
+    BENCH_TIME("PiAffp_Verify",
+               rc = PiAffp_Verify(verifier_sk, prover_pk, &keys->pedersen[1].pedersenPriv,
+                                  &C, &D, &CX, &CY, &commits, &E, &proofs));
+    bench_check("PiAffp_Verify", rc, PiAffp_OK);
+
+    OCT_clear(&X_PT);
+    OCT_clear(&Y_PT);
+    OCT_clear(&PT);
+    OCT_clear(&RHO);
+    OCT_clear(&RHO_X);
+    OCT_clear(&RHO_Y);
+}
+
+void bench_zkp(csprng *RNG, const BENCH_KEYS *keys, CG21_SSID *ssid, int n)
+{
+    bench_piprm(RNG, keys, ssid, n);
+    bench_pimod(RNG, keys, ssid, n);
+    bench_pifactor(RNG, keys, ssid, n);
+    bench_piaffp(RNG, keys, ssid);
+}
@@ -147,6 +147,13 @@ int main() {
 
     // verify the proofs
     rc = CG21_PI_MOD_VERIFY(&paillierProof, &ssid, paillierKeys.paillier_pk, n);
+    if (rc != CG21_OK){
+        printf("FAILURE\n");
+        exit(1);
+    }
+
+    // verify the proofs with the batched verifier on two threads
+    rc = CG21_PI_MOD_BATCH_VERIFY(&paillierProof, &ssid, paillierKeys.paillier_pk, n, 2);
     if (rc == CG21_OK){
         printf("SUCCESS\n");
         exit(0);
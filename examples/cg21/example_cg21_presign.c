@@ -82,6 +82,8 @@ typedef struct
     CG21_PEDERSEN_KEYS *pedersenKeys;
     CG21_RESHARE_SETTING *setting;
     CG21_SSID *ssid;
+    CG21_SSID_CTX ssid_ctx;
+    octet *ssid_bytes;
 
     // Pi-Enc
     PiEnc_COMMITS_OCT *PiEncCommitOct;
@@ -315,8 +317,8 @@ void CG21_presign_round1(CG21_PRESIGN_SESSION *session){
             char e_[MODBYTES_256_56];
             octet e = {0, sizeof(e_), e_};
 
-            PiEnc_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                                session->r1out[0].K, &session->PiEncCommit[i], &session->ssid[0], &e);
+            PiEnc_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                    session->r1out[0].K, &session->PiEncCommit[i], &session->ssid_ctx, &e);
 
             PiEnc_Prove(&session->paillierKeys[0].paillier_sk, session->r1Store[0].k,
                         session->r1Store[0].rho, &PiEncSecrets, &e, &session->PiEnc_proof[i],
@@ -337,8 +339,8 @@ void CG21_presign_round2(CG21_PRESIGN_SESSION *session){
         char e_[MODBYTES_256_56];
         octet e = {0, sizeof(e_), e_};
 
-        PiEnc_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                            session->r1out[0].K, &session->PiEncCommit[i], &session->ssid[0], &e);
+        PiEnc_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                session->r1out[0].K, &session->PiEncCommit[i], &session->ssid_ctx, &e);
 
         int rc = PiEnc_Verify(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPriv,
                               session->r1out[0].K, &session->PiEncCommit[i], &e, &session->PiEnc_proof[i]);
@@ -390,8 +392,8 @@ void CG21_presign_round2(CG21_PRESIGN_SESSION *session){
         char e_[MODBYTES_256_56];
         octet e = {0, sizeof(e_), e_};
 
-        PiLogstar_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                                session->r1out[0].G, &session->PiLogCommit1[i], (session->ssid + 0), session->r2Store[i].Gamma, &e);
+        PiLogstar_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                    session->r1out[0].G, &session->PiLogCommit1[i], &session->ssid_ctx, session->r2Store[i].Gamma, &e);
 
         PiLogstar_Prove(&session->paillierKeys[0].paillier_sk, session->r1Store[0].gamma,
                         session->r1Store[0].nu,&PiLogSecrets, &e, &session->PiLogProof1[i],
@@ -418,9 +420,9 @@ void CG21_presign_round2(CG21_PRESIGN_SESSION *session){
         char e_[MODBYTES_256_56];
         octet e = {0, sizeof(e_), e_};
 
-        Piaffg_Challenge_gen(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
-                             &session->pedersenKeys[i].pedersenPub, session->r2Store[i].Gamma, (session->r2out+i)->F, (session->r1out+i)->K,
-                             (session->r2out+i)->D, &session->PiAffgCommit1[i], (session->ssid + 0), &e);
+        Piaffg_Challenge_gen_ctx(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
+                                 &session->pedersenKeys[i].pedersenPub, session->r2Store[i].Gamma, (session->r2out+i)->F, (session->r1out+i)->K,
+                                 (session->r2out+i)->D, &session->PiAffgCommit1[i], &session->ssid_ctx, &e);
 
         Piaffg_Prove(&session->paillierKeys[0].paillier_pk, &session->paillierKeys[i].paillier_pk,
                      &PiAffgSecrets, session->r1Store[0].gamma, session->r2Store[i].beta,
@@ -458,9 +460,9 @@ void CG21_presign_round2(CG21_PRESIGN_SESSION *session){
         ECP_SECP256K1_mul(&G, s);   // compute gamma*G
         ECP_SECP256K1_toOctet(&X, &G, true); // store gamma*G
 
-        Piaffg_Challenge_gen(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
-                             &session->pedersenKeys[i].pedersenPub, &X, (session->r2out+i)->F_hat, (session->r1out+i)->K,
-                             (session->r2out+i)->D_hat, &session->PiAffgCommit2[i], (session->ssid + 0), &e);
+        Piaffg_Challenge_gen_ctx(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
+                                 &session->pedersenKeys[i].pedersenPub, &X, (session->r2out+i)->F_hat, (session->r1out+i)->K,
+                                 (session->r2out+i)->D_hat, &session->PiAffgCommit2[i], &session->ssid_ctx, &e);
 
         Piaffg_Prove(&session->paillierKeys[0].paillier_pk, &session->paillierKeys[i].paillier_pk,
                      &PiAffgSecrets, session->r1Store[0].a, session->r2Store[i].beta_hat,
@@ -486,8 +488,8 @@ void CG21_presign_round3(CG21_PRESIGN_SESSION *session){
         octet g_ = {0, sizeof(t), t};
         ECP_SECP256K1_toOctet(&g_, &G, true);
 
-        PiLogstar_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                                session->r1out[0].G, &session->PiLogCommit1[i], (session->ssid + 0), session->r2Store[i].Gamma, &e);
+        PiLogstar_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                    session->r1out[0].G, &session->PiLogCommit1[i], &session->ssid_ctx, session->r2Store[i].Gamma, &e);
 
         int rc = PiLogstar_Verify(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPriv,
                                   session->r1out[0].G, &g_, &session->PiLogCommit1[i], session->r2Store[i].Gamma,
@@ -509,9 +511,9 @@ void CG21_presign_round3(CG21_PRESIGN_SESSION *session){
         char e2_[MODBYTES_256_56];
         octet e2 = {0, sizeof(e2_), e2_};
 
-        Piaffg_Challenge_gen(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
-                             &session->pedersenKeys[i].pedersenPub, session->r2Store[i].Gamma, (session->r2out+i)->F, (session->r1out+i)->K,
-                             (session->r2out+i)->D, &session->PiAffgCommit1[i], (session->ssid + 0), &e2);
+        Piaffg_Challenge_gen_ctx(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
+                                 &session->pedersenKeys[i].pedersenPub, session->r2Store[i].Gamma, (session->r2out+i)->F, (session->r1out+i)->K,
+                                 (session->r2out+i)->D, &session->PiAffgCommit1[i], &session->ssid_ctx, &e2);
 
         int rc = Piaffg_Verify(&session->paillierKeys[i].paillier_sk, &session->paillierKeys[0].paillier_pk,
                                &session->pedersenKeys[i].pedersenPriv,session->r1out[i].K, session->r2out[i].D, session->r2Store[i].Gamma,
@@ -545,9 +547,9 @@ void CG21_presign_round3(CG21_PRESIGN_SESSION *session){
         ECP_SECP256K1_mul(&G, s);   // compute gamma*G
         ECP_SECP256K1_toOctet(&X, &G, true); // store gamma*G
 
-        Piaffg_Challenge_gen(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
-                             &session->pedersenKeys[i].pedersenPub, &X, (session->r2out+i)->F_hat, (session->r1out+i)->K,
-                             (session->r2out+i)->D_hat, &session->PiAffgCommit2[i], (session->ssid + 0), &e2);
+        Piaffg_Challenge_gen_ctx(&session->paillierKeys[i].paillier_pk, &session->paillierKeys[0].paillier_pk,
+                                 &session->pedersenKeys[i].pedersenPub, &X, (session->r2out+i)->F_hat, (session->r1out+i)->K,
+                                 (session->r2out+i)->D_hat, &session->PiAffgCommit2[i], &session->ssid_ctx, &e2);
 
         int rc = Piaffg_Verify(&session->paillierKeys[i].paillier_sk, &session->paillierKeys[0].paillier_pk,
                                &session->pedersenKeys[i].pedersenPriv,session->r1out[i].K, session->r2out[i].D_hat,
@@ -635,8 +637,8 @@ void CG21_presign_round3(CG21_PRESIGN_SESSION *session){
         char e_[MODBYTES_256_56];
         octet e = {0, sizeof(e_), e_};
 
-        PiLogstar_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                                (session->r1out+i)->K, &session->PiLogCommit2[i], (session->ssid + 0), session->r3Store1[i].Delta, &e);
+        PiLogstar_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                    (session->r1out+i)->K, &session->PiLogCommit2[i], &session->ssid_ctx, session->r3Store1[i].Delta, &e);
 
         PiLogstar_Prove(&session->paillierKeys[0].paillier_sk, session->r1Store[0].k,
                         session->r1Store[0].rho,&PiLogSecrets, &e, &session->PiLogProof2[i],
@@ -659,8 +661,8 @@ void CG21_presign_output(CG21_PRESIGN_SESSION *session){
         ECP_SECP256K1 G;
         ECP_SECP256K1_generator(&G);
 
-        PiLogstar_Challenge_gen(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
-                                (session->r1out+i)->K, &session->PiLogCommit2[i], (session->ssid + 0), session->r3Store1[i].Delta, &e);
+        PiLogstar_Challenge_gen_ctx(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPub,
+                                    (session->r1out+i)->K, &session->PiLogCommit2[i], &session->ssid_ctx, session->r3Store1[i].Delta, &e);
 
         int rc = PiLogstar_Verify(&session->paillierKeys[0].paillier_pk, &session->pedersenKeys[i].pedersenPriv,
                                   session->r1out[0].K, session->r3Store1[0].Gamma, &session->PiLogCommit2[i], session->r3Store1[0].Delta,
@@ -931,6 +933,13 @@ void Form_SSID(CG21_PRESIGN_SESSION *session){
         CG21_PRESIGN_GET_SSID(session->ssid+i,session->reshareOutput+i,
                               session->setting->t1, session->setting->n2, session->auxOutput+i);
     }
+
+    // the SSID is serialised once for all the challenges of the session
+    int rc = CG21_SSID_CTX_init(&session->ssid_ctx, session->ssid+0, session->ssid_bytes);
+    if (rc != CG21_OK){
+        printf("\nCG21_SSID_CTX_init Failed!");
+        exit(rc);
+    }
 }
 
 void Print_SSID(CG21_PRESIGN_SESSION *session, int index){
@@ -1200,7 +1209,11 @@ int main() {
         OCT_copy(ssid[i].uid, &ID_);
     }
 
+    char ssid_bytes[CG21_SSID_CTX_SIZE(iLEN, setting.t1, n)];
+    octet SSID_BYTES = {0, sizeof(ssid_bytes), ssid_bytes};
+
     session.ssid = ssid;
+    session.ssid_bytes = &SSID_BYTES;
     Form_SSID(&session);
 //    Print_SSID(&session, 0);
     Validate_SSID(&session);
@@ -17,7 +17,8 @@ specific language governing permissions and limitations
 under the License.
 */
 
-
+#ifndef CG21_H
+#define CG21_H
 
 #include <amcl/amcl.h>
 #include <amcl/big_512_60.h>
@@ -35,6 +36,9 @@ under the License.
 #include "cg21_pi_mod.h"
 #include "cg21_pi_prm.h"
 #include "cg21_pi_factor.h"
+#include "cg21_paillier_pool.h"
+#include "cg21_prime_pool.h"
+#include "cg21_fanout.h"
 
 
 #define CG21_KEY_ERROR                       3130101
@@ -534,6 +538,27 @@ extern int CG21_KEY_GENERATE_OUTPUT_1_1(const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
                                         const CG21_KEYGEN_SID *sid,
                                         const CG21_KEYGEN_ROUND3_STORE *r3Store);
 
+/**	@brief Verify the Schnorr proofs for partial secret keys of n players at once
+*
+*  Same as CG21_KEY_GENERATE_OUTPUT_1_1 for each player, with the proofs
+*  checked together by SCHNORR_batch_verify
+*
+*  @param RNG       pointer to a cryptographically secure random number generator for the batch weights
+*  @param r3Out     array of n structures that hold data broadcast in Round 3
+*  @param r3        array of n structures that hold public data computed in Round 1
+*  @param sid       session ID
+*  @param r3Store   the structure that holds data to be stored in the database in Round 3
+*  @param n         number of players
+*  @param bad       index in the arrays of the first rejected player on failure. Optional
+*  @return          CG21_OK, CG21_A_DOES_NOT_MATCH or CG21_SCHNORR_VERIFY_FAILED
+*/
+extern int CG21_KEY_GENERATE_OUTPUT_1_1_BATCH(csprng *RNG,
+                                              const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
+                                              const CG21_KEYGEN_ROUND1_STORE_PUB *r3,
+                                              const CG21_KEYGEN_SID *sid,
+                                              const CG21_KEYGEN_ROUND3_STORE *r3Store,
+                                              int n, int *bad);
+
 /**	@brief Verify Schnorr proof for sum-of-the-shares
 *
 *  1: Unpack all the VSS checks
@@ -554,6 +579,20 @@ extern int CG21_KEY_GENERATE_OUTPUT_1_2(CG21_KEYGEN_OUTPUT *output,
                                         const CG21_KEYGEN_SID *sid,
                                         const CG21_KEYGEN_ROUND1_STORE_PUB *r1Pub);
 
+/**	@brief Same as CG21_KEY_GENERATE_OUTPUT_1_2, with the VSS checks parsed through a cache
+*
+*  The checks of each party are decompressed once for all the proofs verified in the session
+*
+*  @param cache         point cache of the session, see CG21_POINT_CACHE_init
+*/
+extern int CG21_KEY_GENERATE_OUTPUT_1_2_CACHED(CG21_KEYGEN_OUTPUT *output,
+                                               const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
+                                               CG21_KEYGEN_ROUND3_STORE *r3Store,
+                                               CG21_KEYGEN_ROUND1_STORE_PRIV *myPriv,
+                                               const CG21_KEYGEN_SID *sid,
+                                               const CG21_KEYGEN_ROUND1_STORE_PUB *r1Pub,
+                                               CG21_POINT_CACHE *cache);
+
 /**	@brief Pack partial PKs and the corresponding player's IDs
 *
 *
@@ -677,7 +716,7 @@ extern int CG21_PI_PRM_PROVE_HELPER(csprng *RNG, CG21_AUX_ROUND1_STORE_PRIV *rnd
 extern int CG21_PI_MOD_PROVE_HELPER(csprng *RNG, CG21_AUX_ROUND1_STORE_PRIV *rnd1Priv, const CG21_SSID *ssid,
                                         CG21_AUX_ROUND3 *rnd3);
 
-/**	@brief Generate proof for correctness of Paillier
+/**	@brief Verify proof for correctness of Paillier
 *
 *  @param rnd1Pub           hold Paillier and Pedersen public parameters in packed form
 *  @param ssid              system-wide session-ID, refers to the same notation as in CG21
@@ -830,6 +869,22 @@ extern int CG21_KEY_RESHARE_CHECK_VSS_T1(CG21_RESHARE_SETTING setting, CG21_RESH
                                          octet *myX, octet *PK, octet *X, octet *pack_pk_sum_shares,
                                          CG21_RESHARE_ROUND4_STORE *r3Store, int Xstatus);
 
+/**	@brief Same as CG21_KEY_RESHARE_CHECK_VSS_T1, with the running sum kept projective and the Lagrange coefficients cached
+*
+*  The partial PKs are summed in X_sum, which is not serialised, and X is
+*  only set by the last call. X_sum must stay in memory from the call with
+*  Xstatus 0 to the call with Xstatus 2
+*
+*  @param X_sum                 running sum of the partial PKs, owned by the caller
+*  @param lagrange              Lagrange coefficient cache, see CG21_LAGRANGE_CACHE_init. NULL to compute
+*                               the coefficient on each call
+*/
+extern int CG21_KEY_RESHARE_CHECK_VSS_T1_ACC(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                             const CG21_RESHARE_ROUND1_STORE_PUB_T1 *myR3_T1, const SSS_shares *SS_R3,
+                                             octet *myX, octet *PK, octet *X, octet *pack_pk_sum_shares,
+                                             CG21_RESHARE_ROUND4_STORE *r3Store, int Xstatus, CG21_ECP_ACCUMULATOR *X_sum,
+                                             CG21_LAGRANGE_CACHE *lagrange);
+
 /**	@brief Encrypt ECDSA shares using receivers' Paillier PKs
 *
 *
@@ -845,6 +900,25 @@ extern void CG21_KEY_RESHARE_ENCRYPT_SHARES(csprng *RNG, PAILLIER_public_key *pk
                                             CG21_RESHARE_ROUND1_STORE_PUB_T1 storePub,
                                             CG21_RESHARE_ROUND3_OUTPUT *output);
 
+/**	@brief Encrypt ECDSA shares using receivers' Paillier PKs and a pool of randomizers
+*
+*  Same as CG21_KEY_RESHARE_ENCRYPT_SHARES, with the randomizer taken
+*  from a pool built for the receiver's key
+*
+*  @param RNG           pointer to a cryptographically secure random number generator
+*  @param pool          randomizers for pk. The RNG is used if NULL
+*  @param pk            Paillier PK
+*  @param hisID         ID of the receiver
+*  @param storeSecret   secret data to be stored and used in the next round
+*  @param storePub      shared output with the other players in round2
+*  @param output        output of the function
+*  @return              CG21_OK or CG21_PAILLIER_POOL_WRONG_KEY
+*/
+extern int CG21_KEY_RESHARE_ENCRYPT_SHARES_POOLED(csprng *RNG, CG21_PAILLIER_POOL *pool, PAILLIER_public_key *pk, int hisID,
+                                                 CG21_RESHARE_ROUND1_STORE_SECRET_T1 *storeSecret,
+                                                 CG21_RESHARE_ROUND1_STORE_PUB_T1 storePub,
+                                                 CG21_RESHARE_ROUND3_OUTPUT *output);
+
 /**	@brief Encrypt ECDSA shares using receivers' Paillier PKs
 *
 *
@@ -881,6 +955,21 @@ extern int CG21_KEY_RESHARE_CHECK_VSS_N2(CG21_RESHARE_SETTING setting, CG21_RESH
                                          const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
                                          CG21_RESHARE_ROUND4_STORE *r3Store, int Xstatus);
 
+/**	@brief Same as CG21_KEY_RESHARE_CHECK_VSS_N2, with the running sum kept projective and the Lagrange coefficients cached
+*
+*  The partial PKs are summed in X_sum, which is not serialised, and X is
+*  only set by the last call. X_sum must stay in memory from the call with
+*  Xstatus 0 to the call with Xstatus 2
+*
+*  @param X_sum                 running sum of the partial PKs, owned by the caller
+*  @param lagrange              Lagrange coefficient cache, see CG21_LAGRANGE_CACHE_init. NULL to compute
+*                               the coefficient on each call
+*/
+extern int CG21_KEY_RESHARE_CHECK_VSS_N2_ACC(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                             const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
+                                             CG21_RESHARE_ROUND4_STORE *r3Store, int Xstatus, CG21_ECP_ACCUMULATOR *X_sum,
+                                             CG21_LAGRANGE_CACHE *lagrange);
+
 /**	@brief Sum the received SSS shares
 *
 *
@@ -945,6 +1034,36 @@ extern int CG21_KEY_RESHARE_VERIFY_T1(const CG21_RESHARE_ROUND4_OUTPUT *input, c
                                       CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
                                       CG21_SSID *ssid, int hisID);
 
+/**	@brief Same as CG21_KEY_RESHARE_VERIFY_T1, with the VSS checks parsed through a cache
+*
+*  @param cache         point cache of the session, see CG21_POINT_CACHE_init
+*/
+extern int CG21_KEY_RESHARE_VERIFY_T1_CACHED(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1,
+                                             CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                             CG21_SSID *ssid, int hisID, CG21_POINT_CACHE *cache);
+
+/**	@brief Verify the zero knowledge proofs on sum-of-the-shares of n players at once
+*
+*  Same as CG21_KEY_RESHARE_VERIFY_T1_CACHED for each player, with the proofs
+*  checked together by SCHNORR_batch_verify
+*
+*  @param RNG           pointer to a cryptographically secure random number generator for the batch weights
+*  @param input         array of n proofs from the other players generated in round3
+*  @param pubT1         array of n data received from the other parties in round3
+*  @param setting       holds (t1,n1), (t2,n2), and (T2, N2)
+*  @param r3Store       data that is generated and stored in round3
+*  @param ssid          system-wide session-ID, refers to the same notation as in CG21
+*  @param hisID         array of n IDs of the other players
+*  @param n             number of players
+*  @param cache         point cache of the session, see CG21_POINT_CACHE_init. Optional
+*  @param bad           index in the arrays of the first rejected player on failure. Optional
+*  @return              CG21_OK or an error code
+*/
+extern int CG21_KEY_RESHARE_VERIFY_T1_BATCH(csprng *RNG, const CG21_RESHARE_ROUND4_OUTPUT *input,
+                                            const CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1, CG21_RESHARE_SETTING setting,
+                                            CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, const int *hisID, int n,
+                                            CG21_POINT_CACHE *cache, int *bad);
+
 /**	@brief Verify the zero knowledge proof on sum-of-the-shares
 *
 *  1: computes sum-of-shares*G of the other players based on VSS checks
@@ -962,6 +1081,36 @@ extern int CG21_KEY_RESHARE_VERIFY_N2(const CG21_RESHARE_ROUND4_OUTPUT *input, c
                                       CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
                                       CG21_SSID *ssid, int hisID);
 
+/**	@brief Same as CG21_KEY_RESHARE_VERIFY_N2, with the VSS checks parsed through a cache
+*
+*  @param cache         point cache of the session, see CG21_POINT_CACHE_init
+*/
+extern int CG21_KEY_RESHARE_VERIFY_N2_CACHED(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2,
+                                             CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                             CG21_SSID *ssid, int hisID, CG21_POINT_CACHE *cache);
+
+/**	@brief Verify the zero knowledge proofs on sum-of-the-shares of n players at once
+*
+*  Same as CG21_KEY_RESHARE_VERIFY_N2_CACHED for each player, with the proofs
+*  checked together by SCHNORR_batch_verify
+*
+*  @param RNG           pointer to a cryptographically secure random number generator for the batch weights
+*  @param input         array of n proofs from the other players generated in round3
+*  @param pubN2         array of n data received from the other parties in round3
+*  @param setting       holds (t1,n1), (t2,n2), and (T2, N2)
+*  @param r3Store       data that is generated and stored in round3
+*  @param ssid          system-wide session-ID, refers to the same notation as in CG21
+*  @param hisID         array of n IDs of the other players
+*  @param n             number of players
+*  @param cache         point cache of the session, see CG21_POINT_CACHE_init. Optional
+*  @param bad           index in the arrays of the first rejected player on failure. Optional
+*  @return              CG21_OK or an error code
+*/
+extern int CG21_KEY_RESHARE_VERIFY_N2_BATCH(csprng *RNG, const CG21_RESHARE_ROUND4_OUTPUT *input,
+                                            const CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2, CG21_RESHARE_SETTING setting,
+                                            CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, const int *hisID, int n,
+                                            CG21_POINT_CACHE *cache, int *bad);
+
 /**	@brief Form the output of key re-sharing protocol
 *
 *  @param output        output structure of key re-sharing
@@ -1014,6 +1163,64 @@ extern int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOu
                                 CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
                                 CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys);
 
+/**	@brief Round 1 with rho and nu taken from a pool of randomizers
+*
+*  Same as CG21_PRESIGN_ROUND1, without the exponentiations rho^N and nu^N
+*
+*  @param RNG               pointer to a cryptographically secure random number generator
+*  @param reshareOutput     data stored in the db at the end of key resharing protocol
+*  @param setting           holds (t1,n1), (t2,n2), and (T2, N2)
+*  @param output            data to be broadcast in round 1
+*  @param store             data to be stored in db in round 1
+*  @param keys              Paillier public key
+*  @param myPool            randomizers for keys. The RNG is used if NULL
+*  @return                  CG21_OK or CG21_PAILLIER_POOL_WRONG_KEY
+*/
+extern int CG21_PRESIGN_ROUND1_POOLED(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                                      CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                                      CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys,
+                                      CG21_PAILLIER_POOL *myPool);
+
+/**	@brief Round 1 with the Lagrange coefficient of the signer set taken from a cache
+*
+*  Same as CG21_PRESIGN_ROUND1_POOLED. The coefficients of all the players in T2
+*  are computed once for each set and kept in the cache
+*
+*  @param RNG               pointer to a cryptographically secure random number generator
+*  @param reshareOutput     data stored in the db at the end of key resharing protocol
+*  @param setting           holds (t1,n1), (t2,n2), and (T2, N2)
+*  @param output            data to be broadcast in round 1
+*  @param store             data to be stored in db in round 1
+*  @param keys              Paillier public key
+*  @param myPool            randomizers for keys. The RNG is used if NULL
+*  @param lagrange          Lagrange coefficient cache, see CG21_LAGRANGE_CACHE_init
+*  @return                  CG21_OK, CG21_PAILLIER_POOL_WRONG_KEY or CG21_LAGRANGE_INVALID_SET
+*/
+extern int CG21_PRESIGN_ROUND1_CACHED(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                                      CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                                      CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys,
+                                      CG21_PAILLIER_POOL *myPool, CG21_LAGRANGE_CACHE *lagrange);
+
+/**	@brief Run Round 1 for K independent presignatures
+*
+*  The additive share is computed once and copied into every store,
+*  since it only depends on the set T2. The batch stops at the first
+*  failed presignature and the additive share is then not computed
+*
+*  @param RNG               pointer to a cryptographically secure random number generator
+*  @param reshareOutput     data stored in the db at the end of key resharing protocol
+*  @param setting           holds (t1,n1), (t2,n2), and (T2, N2)
+*  @param output            array of K outputs, broadcast in round 1 as one message
+*  @param store             array of K stores, to be stored in db in round 1
+*  @param keys              Paillier public key
+*  @param K                 number of presignatures
+*  @param bad               index of the failed presignature, -1 if none. Optional
+*  @return                  CG21_OK or the error of the failed presignature
+*/
+extern int CG21_PRESIGN_ROUND1_BATCH(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                                     CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                                     CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys, int K, int *bad);
+
 /**	@brief Operations in CG21:Round2 as follows:
 *
 *  1: compute Gamma = gamma*G
@@ -1034,6 +1241,69 @@ extern int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output
                                const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
                                PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK);
 
+/**	@brief Round 2 with r, r_hat, s and s_hat taken from pools of randomizers
+*
+*  Same as CG21_PRESIGN_ROUND2, without the exponentiations of the randomizers
+*
+*  @param RNG           pointer to a cryptographically secure random number generator
+*  @param r2output      data to be broadcast in round 2
+*  @param r2store       data to be stored in db in round 2
+*  @param r1output      output of round 1
+*  @param r1store       data that are stored in round 1
+*  @param hisPK         Paillier PK
+*  @param myPK          Paillier PK
+*  @param hisPool       randomizers for hisPK. The RNG is used if NULL
+*  @param myPool        randomizers for myPK. The RNG is used if NULL
+*  @return              CG21_OK or CG21_PAILLIER_POOL_WRONG_KEY
+*/
+extern int CG21_PRESIGN_ROUND2_POOLED(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                                      const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                                      PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK,
+                                      CG21_PAILLIER_POOL *hisPool, CG21_PAILLIER_POOL *myPool);
+
+/**	@brief Run Round 2 with one player for K independent presignatures
+*
+*  The range q^5 of beta and beta_hat is computed once for the batch.
+*  The batch stops at the first failed presignature
+*
+*  @param RNG           pointer to a cryptographically secure random number generator
+*  @param r2output      array of K outputs, broadcast in round 2 as one message
+*  @param r2store       array of K stores, to be stored in db in round 2
+*  @param r1output      array of K outputs of round 1 received from the other player
+*  @param r1store       array of K stores of round 1
+*  @param hisPK         Paillier PK
+*  @param myPK          Paillier PK
+*  @param K             number of presignatures
+*  @param bad           index of the failed presignature, -1 if none. Optional
+*  @return              CG21_OK or the error of the failed presignature
+*/
+extern int CG21_PRESIGN_ROUND2_BATCH(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                                     const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                                     PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK, int K, int *bad);
+
+/**	@brief Run Round 2 with all the other players concurrently
+*
+*  Same as calling CG21_PRESIGN_ROUND2_POOLED once for every other player.
+*  Each player gets its own RNG, seeded from RNG
+*
+*  @param RNG           pointer to a cryptographically secure random number generator
+*  @param r2output      array of n outputs, one to be sent to each player
+*  @param r2store       array of n stores, one for each player
+*  @param r1output      array of n outputs of round 1 received from the other players
+*  @param r1store       data that are stored in round 1
+*  @param hisPK         array of n Paillier PKs of the other players
+*  @param myPK          Paillier PK
+*  @param hisPool       array of n pools of randomizers for hisPK. Optional
+*  @param myPool        randomizers for myPK. Optional
+*  @param n             number of other players
+*  @param threads       number of worker threads, including the calling one
+*  @return              CG21_OK or the error for the first failed player
+*/
+extern int CG21_PRESIGN_ROUND2_FANOUT(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                                      const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                                      PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK,
+                                      CG21_PAILLIER_POOL *hisPool, CG21_PAILLIER_POOL *myPool, int n, int threads);
+
 /**	@brief Compute Gamma and Delta in CG21:Round3 as follows:
 *
 *  1: compute Gamma = \prod Gamma_j
@@ -1048,6 +1318,35 @@ extern int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output
 extern int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
                                    const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store, int status);
 
+/**	@brief Same as CG21_PRESIGN_ROUND3_2_1, with the running product kept projective
+*
+*  The Gamma_j are multiplied in Gamma_sum, which is not serialised, and
+*  r3Store->Gamma is only set by the last call. Gamma_sum must stay in
+*  memory from the first call to the last call
+*
+*  @param Gamma_sum     running product of the Gamma_j, owned by the caller
+*/
+extern int CG21_PRESIGN_ROUND3_2_1_ACC(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                                       const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                       int status, CG21_ECP_ACCUMULATOR *Gamma_sum);
+
+/**	@brief Run CG21_PRESIGN_ROUND3_2_1 on K independent presignatures
+*
+*  A failed presignature does not stop the others
+*
+*  @param r2hisOutput   array of K outputs broadcast in round 2
+*  @param r3Store       array of K public stores of round 3
+*  @param r2Store       array of K stores of round 2
+*  @param r1Store       array of K stores of round 1
+*  @param status        whether it is the first call or the last call of this function
+*  @param K             number of presignatures
+*  @param bad           index of the first failed presignature, -1 if none. Optional
+*  @return              CG21_OK or the error of the first failed presignature
+*/
+extern int CG21_PRESIGN_ROUND3_2_1_BATCH(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                                         const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                         int status, int K, int *bad);
+
 /**	@brief Operations in CG21:Round3 as follows:
 *
 *  1: compute alpha = Decryption(D)
@@ -1073,6 +1372,57 @@ extern int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput
                                    const CG21_PRESIGN_ROUND2_STORE *r2Store,
                                    int status);
 
+/**	@brief Run CG21_PRESIGN_ROUND3_2_2 on K independent presignatures
+*
+*  The curve order used to reduce alpha, alpha_hat, beta and
+*  beta_hat is loaded once for the batch
+*
+*  @param r2hisOutput   array of K outputs broadcast in round 2
+*  @param r3Output      array of K outputs, broadcast in round 3 as one message
+*  @param r3Store1      array of K public stores of round 3
+*  @param r3Store2      array of K private stores of round 3
+*  @param r1Store       array of K stores of round 1
+*  @param myKeys        Paillier private key
+*  @param r2Store       array of K stores of round 2
+*  @param status        whether it is the first call or the last call of this function
+*  @param K             number of presignatures
+*/
+extern int CG21_PRESIGN_ROUND3_2_2_BATCH(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                                         CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                                         const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                         CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                         const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                         PAILLIER_private_key *myKeys,
+                                         const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                                         int status, int K);
+
+/**	@brief Run Round 3 with all the other players, decrypting concurrently
+*
+*  Same as calling CG21_PRESIGN_ROUND3_2_1 and then CG21_PRESIGN_ROUND3_2_2
+*  for every other player with the status 0, 1, ..., 1, 2 (or 3 with one other
+*  player). The decryptions of D and D_hat run on threads workers, the results
+*  are then added in the order of the players
+*
+*  @param r2hisOutput   array of n outputs of round 2 received from the other players
+*  @param r3Output      data to be broadcast in round 3
+*  @param r3Store1      public data to be stored in db in round 3
+*  @param r3Store2      private data to be stored in db in round 3
+*  @param r1Store       data stored in db in round 1
+*  @param myKeys        Paillier private key
+*  @param r2Store       array of n stores of round 2, one for each player
+*  @param n             number of other players
+*  @param threads       number of worker threads, including the calling one
+*  @return              CG21_OK or an error code, in which case r3Output and r3Store2 are not written
+*/
+extern int CG21_PRESIGN_ROUND3_FANOUT(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                                      CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                                      CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                      CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                      const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                      PAILLIER_private_key *myKeys,
+                                      const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                                      int n, int threads);
+
 /**	@brief Operations in CG21:round4 (output) as follows:
 *
 *  1: compute delta=\sum delta_i
@@ -1089,6 +1439,36 @@ extern int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput
                                    CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
                                    int status);
 
+/**	@brief Same as CG21_PRESIGN_OUTPUT_2_1, with the running product kept projective
+*
+*  The Delta_j are multiplied in Delta_sum, which is not serialised, and
+*  r4Store->Delta is only set by the last call. Delta_sum must stay in
+*  memory from the first call to the last call
+*
+*  @param Delta_sum         running product of the Delta_j, owned by the caller
+*/
+extern int CG21_PRESIGN_OUTPUT_2_1_ACC(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                                       const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                                       CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                                       int status, CG21_ECP_ACCUMULATOR *Delta_sum);
+
+/**	@brief Run CG21_PRESIGN_OUTPUT_2_1 on K independent presignatures
+*
+*  A failed presignature does not stop the others
+*
+*  @param r3hisOutput       array of K outputs received from another player in round 3
+*  @param r3myOutput        array of K outputs generated and broadcast in round 3
+*  @param r4Store           array of K stores of round 4
+*  @param status            whether it is the first call or the last call of this function
+*  @param K                 number of presignatures
+*  @param bad               index of the first failed presignature, -1 if none. Optional
+*  @return                  CG21_OK or the error of the first failed presignature
+*/
+extern int CG21_PRESIGN_OUTPUT_2_1_BATCH(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                                         const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                                         CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                                         int status, int K, int *bad);
+
 /**	@brief Compute R = Gamma ^ {delta^{-1}} in CG21:round4 (output)
 *
 *  @param r1Store       data stored in db in round 1
@@ -1105,6 +1485,29 @@ extern int CG21_PRESIGN_OUTPUT_2_2(const CG21_PRESIGN_ROUND1_STORE *r1Store,
                                    CG21_PRESIGN_ROUND4_STORE_2 *r4Store2,
                                    CG21_PRESIGN_ROUND4_OUTPUT *r4Output);
 
+/**	@brief Compute R = Gamma ^ {delta^{-1}} for K independent presignatures
+*
+*  The K deltas are inverted with a single modular inversion. Every output
+*  is written, and a failed presignature does not stop the others
+*
+*  @param r1Store       array of K stores of round 1
+*  @param r3Store1      array of K public stores of round 3
+*  @param r3Store2      array of K private stores of round 3
+*  @param r4Store1      array of K stores of round 4 step 1
+*  @param r4Store2      array of K presignatures, stored once round 4 ends
+*  @param r4Output      array of K outputs, publish SUCCESS if no problem is discovered
+*  @param K             number of presignatures
+*  @param bad           index of the first failed presignature, -1 if none. Optional
+*  @return              CG21_OK, or for the first failed presignature CG21_PRESIGN_DELTA_NOT_VALID
+*                       if its delta is zero or CG21_INVALID_ECP
+*/
+extern int CG21_PRESIGN_OUTPUT_2_2_BATCH(const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                         const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                         const CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                         const CG21_PRESIGN_ROUND4_STORE_1 *r4Store1,
+                                         CG21_PRESIGN_ROUND4_STORE_2 *r4Store2,
+                                         CG21_PRESIGN_ROUND4_OUTPUT *r4Output, int K, int *bad);
+
 
 /*  ------------- PHASE 4: SIGN ----------------  */
 
@@ -1142,3 +1545,4 @@ extern int CG21_SIGN_VALIDATE(const octet *msg,
                               CG21_SIGN_ROUND2_OUTPUT *out,
                               octet *PK);
 
+#endif
@@ -0,0 +1,72 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file cg21_fanout.h
+ * @brief Run independent per-peer computations on several threads
+ *
+ * Most of the work of a round is repeated once for every other player
+ * and the repetitions do not depend on each other. The fan-out runs
+ * them on a fixed number of threads, the calling one included, and
+ * reports the errors in the order of the peers, so the result does not
+ * depend on the number of threads. The same fan-out splits the
+ * independent iterations of the batched proof verifications, with an
+ * iteration or a group of iterations in place of a peer.
+ */
+
+#ifndef CG21_FANOUT_H
+#define CG21_FANOUT_H
+
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** \brief Computation for one peer
+ *
+ *  Called concurrently for different peers, so it must only write
+ *  the outputs of peer j
+ *
+ *  @param arg       Argument given to CG21_FANOUT
+ *  @param j         Index of the peer
+ *  @return          CG21_OK or an error code
+ */
+typedef int (*CG21_FANOUT_JOB)(void *arg, int j);
+
+/** \brief Run job for the peers 0, ..., n-1 on threads workers
+ *
+ *  The peers are split in contiguous ranges and the last range runs on
+ *  the calling thread. If a thread can not be spawned its range also
+ *  runs on the calling thread
+ *
+ *  @param job       Computation for one peer
+ *  @param arg       Argument of the job
+ *  @param n         Number of peers
+ *  @param threads   Number of worker threads, including the calling one
+ *  @return          CG21_OK or the error of the first failed peer
+ */
+extern int CG21_FANOUT(CG21_FANOUT_JOB job, void *arg, int n, int threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file cg21_paillier_pool.h
+ * @brief Pool of Paillier randomizers generated ahead of time
+ *
+ * A Paillier encryption CT = (1+N)^m * r^N mod N^2 is dominated by the
+ * exponentiation r^N. The pool computes the pairs (r, r^N mod N^2) for
+ * one public key in advance, so that an encryption only costs two
+ * multiplications modulo N^2. When the factors of N are known the
+ * exponentiation is split modulo P^2 and Q^2.
+ *
+ * Every pair is handed out at most once. The memory for the entries
+ * is owned by the caller.
+ */
+
+#ifndef CG21_PAILLIER_POOL_H
+#define CG21_PAILLIER_POOL_H
+
+#include <pthread.h>
+#include <amcl/amcl.h>
+#include <amcl/randapi.h>
+#include <amcl/ff_2048.h>
+#include <amcl/ff_4096.h>
+#include <amcl/paillier.h>
+#include "cg21_utilities.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CG21_PAILLIER_POOL_INVALID          3131001     /**< Invalid pool parameters */
+#define CG21_PAILLIER_POOL_RUNNING          3131002     /**< The background generation is already running */
+#define CG21_PAILLIER_POOL_WRONG_KEY        3131003     /**< The pool was built for another public key */
+
+/*! \brief Stored randomizer */
+typedef struct
+{
+    char r[FS_4096];                /**< Randomizer r in Z^*_N */
+    char rn[FS_4096];               /**< r^N mod N^2 */
+} CG21_PAILLIER_POOL_ENTRY;
+
+/*! \brief Pool of randomizers for one Paillier public key */
+typedef struct
+{
+    CG21_PAILLIER_POOL_ENTRY *entries;  /**< Caller owned entries */
+    int capacity;                       /**< Number of entries */
+    int head;                           /**< Index of the oldest stored randomizer */
+    int count;                          /**< Number of stored randomizers */
+
+    PAILLIER_public_key pub;            /**< Public key of the randomizers */
+
+    int crt;                            /**< The factors of N are known */
+    BIG_1024_58 p2[FFLEN_2048];         /**< P^2 */
+    BIG_1024_58 q2[FFLEN_2048];         /**< Q^2 */
+    BIG_1024_58 invp2q2[FFLEN_2048];    /**< P^{-2} mod Q^2 */
+    BIG_1024_58 n[FFLEN_2048];          /**< N, as the CRT exponent */
+
+    csprng RNG;                         /**< Source of the randomizers, seeded by the caller's RNG */
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    pthread_t producer;                 /**< Background generation thread */
+    int low;                            /**< Refill when fewer randomizers are available */
+    int running;                        /**< The background generation is running */
+} CG21_PAILLIER_POOL;
+
+/** \brief Initialise an empty pool for a public key
+ *
+ *  If the private key is given the randomizers are computed with the CRT.
+ *  It must be the private key of pub
+ *
+ *  @param pool      Pool to initialise
+ *  @param entries   Array of capacity entries
+ *  @param capacity  Number of entries
+ *  @param RNG       Pointer to a cryptographically secure random number generator, used to seed the pool
+ *  @param pub       Paillier public key
+ *  @param priv      Paillier private key of pub. Optional
+ *  @return          CG21_OK or CG21_PAILLIER_POOL_INVALID
+ */
+extern int CG21_PAILLIER_POOL_INIT(CG21_PAILLIER_POOL *pool, CG21_PAILLIER_POOL_ENTRY *entries, int capacity,
+                                   csprng *RNG, PAILLIER_public_key *pub, PAILLIER_private_key *priv);
+
+/** \brief Stop the background generation and clean the pool
+ *
+ *  @param pool      Pool to clean
+ */
+extern void CG21_PAILLIER_POOL_KILL(CG21_PAILLIER_POOL *pool);
+
+/** \brief Compute randomizers in the calling thread
+ *
+ *  @param pool      Pool
+ *  @param count     Number of randomizers to add, stops early once the pool is full
+ *  @return          Number of randomizers added
+ */
+extern int CG21_PAILLIER_POOL_FILL(CG21_PAILLIER_POOL *pool, int count);
+
+/** \brief Number of randomizers in the pool
+ *
+ *  @param pool      Pool
+ *  @return          Number of stored randomizers
+ */
+extern int CG21_PAILLIER_POOL_SIZE(CG21_PAILLIER_POOL *pool);
+
+/** \brief Start computing randomizers in a background thread
+ *
+ *  The pool is refilled whenever fewer than low randomizers are available
+ *
+ *  @param pool      Pool
+ *  @param low       Refill threshold, between 1 and the capacity of the pool
+ *  @return          CG21_OK, CG21_PAILLIER_POOL_RUNNING or CG21_PAILLIER_POOL_INVALID
+ */
+extern int CG21_PAILLIER_POOL_START(CG21_PAILLIER_POOL *pool, int low);
+
+/** \brief Stop the background generation
+ *
+ *  Waits for the randomizer in progress, if any
+ *
+ *  @param pool      Pool
+ */
+extern void CG21_PAILLIER_POOL_STOP(CG21_PAILLIER_POOL *pool);
+
+/** \brief Paillier encryption with a randomizer from the pool
+ *
+ *  Same result as PAILLIER_ENCRYPT with the randomizer written in R.
+ *  If the pool is empty the randomizer is computed on the spot
+ *
+ *  @param pool      Pool
+ *  @param pub       Paillier public key, must be the key of the pool
+ *  @param PT        Plaintext, FS_2048 bytes
+ *  @param CT        Ciphertext
+ *  @param R         Randomizer used for the encryption. Optional
+ *  @return          CG21_OK or CG21_PAILLIER_POOL_WRONG_KEY
+ */
+extern int CG21_PAILLIER_POOL_ENCRYPT(CG21_PAILLIER_POOL *pool, PAILLIER_public_key *pub, octet *PT, octet *CT, octet *R);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
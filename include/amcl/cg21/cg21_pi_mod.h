@@ -44,7 +44,25 @@ typedef struct
     octet *ab;
 } CG21_PIMOD_PROOF_OCT;
 
+/*! \brief Precomputed values to generate Pi-mod proofs for one Paillier key */
+typedef struct
+{
+    BIG_1024_58 n[FFLEN_2048];      /**< N = PQ */
+    BIG_1024_58 p[HFLEN_2048];      /**< Blum prime P */
+    BIG_1024_58 q[HFLEN_2048];      /**< Blum prime Q */
+    BIG_1024_58 invpq[HFLEN_2048];  /**< P^(-1) mod Q, for CRT */
+    BIG_1024_58 ndp[HFLEN_2048];    /**< Montgomery constant of P */
+    BIG_1024_58 ndq[HFLEN_2048];    /**< Montgomery constant of Q */
+    BIG_1024_58 ep[HFLEN_2048];     /**< (P-1)/2, quadratic residue test mod P */
+    BIG_1024_58 eq[HFLEN_2048];     /**< (Q-1)/2, quadratic residue test mod Q */
+    BIG_1024_58 fp[HFLEN_2048];     /**< ((P+1)/4)^2 mod P-1, 4th root mod P */
+    BIG_1024_58 fq[HFLEN_2048];     /**< ((Q+1)/4)^2 mod Q-1, 4th root mod Q */
+    BIG_1024_58 mp[HFLEN_2048];     /**< N^(-1) mod P-1, N-th root mod P */
+    BIG_1024_58 mq[HFLEN_2048];     /**< N^(-1) mod Q-1, N-th root mod Q */
+} CG21_PIMOD_PROVER;
+
 #define iLEN 32
+#define CG21_PI_MOD_BATCH_COEFFICIENT_SIZE 8     /**< Length in bytes of the coefficients used in CG21_PI_MOD_BATCH_VERIFY */
 
 /**	@brief Generate proof that N is a Paillier-Blum modulus
 *
@@ -61,6 +79,37 @@ typedef struct
 extern int CG21_PI_MOD_PROVE(csprng *RNG, CG21_PAILLIER_KEYS paillierKeys, const CG21_SSID *ssid,
                              CG21_PIMOD_PROOF_OCT *paillierProof, int n);
 
+/**	@brief Precompute the values used to generate Pi-mod proofs
+*
+*  The prover can be reused for any number of proofs on the same key,
+*  and must be cleaned with CG21_PI_MOD_PROVER_KILL
+*
+*  @param prover            precomputed values
+*  @param paillierKeys      Paillier keys
+*  @return                  CG21_OK or CG21_PAILLIER_NOT_BLUM
+*/
+extern int CG21_PI_MOD_PROVER_SETUP(CG21_PIMOD_PROVER *prover, CG21_PAILLIER_KEYS *paillierKeys);
+
+/**	@brief Clean the precomputed values of a Pi-mod prover
+*
+*  @param prover            precomputed values
+*/
+extern void CG21_PI_MOD_PROVER_KILL(CG21_PIMOD_PROVER *prover);
+
+/**	@brief Generate proof that N is a Paillier-Blum modulus using a precomputed prover
+*
+*  Same as CG21_PI_MOD_PROVE. The Legendre symbols of yi select (ai,bi)
+*  directly, and all the exponentiations are done mod P and Q
+*
+*  @param RNG               is a pointer to a cryptographically secure random number generator
+*  @param prover            values precomputed with CG21_PI_MOD_PROVER_SETUP
+*  @param ssid              system-wide session-ID, refers to the same notation as in CG21
+*  @param paillierProof     generated proof
+*  @param n                 size of packed elements in SSID
+*/
+extern int CG21_PI_MOD_PROVE_WITH_PROVER(csprng *RNG, CG21_PIMOD_PROVER *prover, const CG21_SSID *ssid,
+                                         CG21_PIMOD_PROOF_OCT *paillierProof, int n);
+
 /**	@brief Validate proofs that N is a Paillier-Blum modulus
 *
 *  1: check N is an odd composite number
@@ -73,4 +122,26 @@ extern int CG21_PI_MOD_PROVE(csprng *RNG, CG21_PAILLIER_KEYS paillierKeys, const
 *  @param n                 size of packed elements in SSID
 */
 extern int CG21_PI_MOD_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid,
-                              PAILLIER_public_key pk, int n);
\ No newline at end of file
+                              PAILLIER_public_key pk, int n);
+
+/**	@brief Validate proofs that N is a Paillier-Blum modulus using batching
+*
+*  Same checks as CG21_PI_MOD_VERIFY, but the 128 relations zi^N = yi are
+*  combined with small coefficients derived from the proof into a single
+*  (prod zi^ci)^N = prod yi^ci, computed with multi-exponentiations.
+*  N and w are converted once, and the xi checks are done in BIG_1024_58.
+*
+*  A combined relation only shows that every yi is an N-th power, and it
+*  relies on N having no small prime factors. The check is only sound once
+*  the Pi^fac proof for the same N has been verified; otherwise, and in the
+*  Aux. Info. helpers, use CG21_PI_MOD_VERIFY.
+*
+*  @param paillierProof     generated proof
+*  @param ssid              system-wide session-ID, refers to the same notation as in CG21
+*  @param pk                Paillier public key
+*  @param n                 size of packed elements in SSID
+*  @param threads           number of threads to split the iterations on. Values
+*                           smaller than 2 run on the calling thread
+*/
+extern int CG21_PI_MOD_BATCH_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid,
+                                    PAILLIER_public_key pk, int n, int threads);
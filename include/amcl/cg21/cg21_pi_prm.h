@@ -58,6 +58,19 @@ typedef struct
 extern int CG21_PI_PRM_PROVE(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid,
                              CG21_PIPRM_PROOF_OCT *proofOct);
 
+/**	@brief Generate ZKP for Ring-Pedersen Parameters using multiple threads
+*
+*  Same as CG21_PI_PRM_PROVE, with the HDLOG commitments split across threads workers
+*
+*  @param RNG       is a pointer to a cryptographically secure random number generator
+*  @param priv      Ring-Pedersen private parameters
+*  @param ssid      system-wide session-ID, refers to the same notation as in CG21
+*  @param proofOct  ZKP in octet form
+*  @param threads   number of worker threads, including the calling one
+*/
+extern int CG21_PI_PRM_PROVE_MT(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid,
+                                CG21_PIPRM_PROOF_OCT *proofOct, int threads);
+
 /**	@brief Verify ZKP for Ring-Pedersen Parameters
 *
 *  @param pub       Ring-Pedersen public parameters
@@ -65,4 +78,33 @@ extern int CG21_PI_PRM_PROVE(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *
 *  @param proofOct  ZKP in octet form
 *  @param n         number of the players
 */
-extern int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n);
\ No newline at end of file
+extern int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n);
+
+/**	@brief Verify ZKP for Ring-Pedersen Parameters using multiple threads
+*
+*  Same as CG21_PI_PRM_VERIFY, with the HDLOG iterations split across threads workers
+*
+*  @param pub       Ring-Pedersen public parameters
+*  @param ssid      system-wide session-ID, refers to the same notation as in CG21
+*  @param proofOct  ZKP in octet form
+*  @param n         number of the players
+*  @param threads   number of worker threads, including the calling one
+*/
+extern int CG21_PI_PRM_VERIFY_MT(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n,
+                                 int threads);
+
+/**	@brief Verify ZKP for Ring-Pedersen Parameters with the combined HDLOG check
+*
+*  The HDLOG iterations are checked with HDLOG_batch_verify. This is opt-in only:
+*  against a modulus chosen by the prover, an invalid proof using elements of
+*  small odd order passes with non negligible probability. Only use it once the
+*  modulus is known to be well formed, otherwise use CG21_PI_PRM_VERIFY
+*
+*  @param RNG       is a pointer to a cryptographically secure random number generator, kept private to the verifier
+*  @param pub       Ring-Pedersen public parameters
+*  @param ssid      system-wide session-ID, refers to the same notation as in CG21
+*  @param proofOct  ZKP in octet form
+*  @param n         number of the players
+*/
+extern int CG21_PI_PRM_VERIFY_BATCH(csprng *RNG, PEDERSEN_PUB *pub, const CG21_SSID *ssid,
+                                    CG21_PIPRM_PROOF_OCT *proofOct, int n);
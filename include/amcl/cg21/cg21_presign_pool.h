@@ -0,0 +1,187 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file cg21_presign_pool.h
+ * @brief Pool of presignatures generated ahead of time
+ *
+ * Every presignature is stored once and handed out at most once,
+ * so that a nonce k is never used to sign two messages. Entries are
+ * identified by the order in which they were stored, so players that
+ * fill their pools from the same sequence of Pre-Sign sessions can
+ * agree on the entry to use by its id.
+ *
+ * The memory for the entries is owned by the caller.
+ */
+
+#ifndef CG21_PRESIGN_POOL_H
+#define CG21_PRESIGN_POOL_H
+
+#include <pthread.h>
+#include "cg21.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CG21_PRESIGN_POOL_FULL              3130901     /**< No free entry to store a presignature */
+#define CG21_PRESIGN_POOL_EMPTY             3130902     /**< No presignature available */
+#define CG21_PRESIGN_POOL_UNKNOWN_ID        3130903     /**< The presignature does not exist or was already used */
+#define CG21_PRESIGN_POOL_INVALID           3130904     /**< Invalid pool parameters or presignature */
+#define CG21_PRESIGN_POOL_RUNNING           3130905     /**< The background generation is already running */
+
+/** \brief Generate one presignature
+ *
+ *  Drives the Pre-Sign rounds with the other players and fills pre.
+ *  It is called outside of the pool lock.
+ *
+ *  @param arg       Argument given to CG21_PRESIGN_POOL_START
+ *  @param pre       Destination presignature
+ *  @return          CG21_OK or an error code, which stops the generation
+ */
+typedef int (*CG21_PRESIGN_GENERATOR)(void *arg, CG21_PRESIGN_ROUND4_STORE_2 *pre);
+
+/*! \brief Stored presignature */
+typedef struct
+{
+    char R[EFS_SECP256K1 + 1];      /**< R = Gamma^{delta^{-1}} */
+    char chi[EGS_SECP256K1];        /**< Share of k*x */
+    char k[EGS_SECP256K1];          /**< Share of the nonce */
+    int id;                         /**< Sequence number of the presignature */
+    int ready;                      /**< The entry holds an unused presignature */
+} CG21_PRESIGN_POOL_ENTRY;
+
+/*! \brief Pool of presignatures */
+typedef struct
+{
+    CG21_PRESIGN_POOL_ENTRY *entries;   /**< Caller owned entries */
+    int capacity;                       /**< Number of entries */
+    int i;                              /**< My id */
+    int head;                           /**< Oldest sequence number that can still be unused */
+    int tail;                           /**< Sequence number of the next stored presignature */
+    int count;                          /**< Number of unused presignatures */
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    pthread_t producer;                 /**< Background generation thread */
+    CG21_PRESIGN_GENERATOR generator;   /**< Presignature generator */
+    void *arg;                          /**< Argument of the generator */
+    int low;                            /**< Refill when fewer presignatures are available */
+    int running;                        /**< The background generation is running */
+    int rc;                             /**< Last error returned by the generator */
+} CG21_PRESIGN_POOL;
+
+/** \brief Initialise an empty pool
+ *
+ *  @param pool      Pool to initialise
+ *  @param entries   Array of capacity entries
+ *  @param capacity  Number of entries
+ *  @param i         My id, checked against the stored presignatures
+ *  @return          CG21_OK or CG21_PRESIGN_POOL_INVALID
+ */
+extern int CG21_PRESIGN_POOL_INIT(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_POOL_ENTRY *entries, int capacity, int i);
+
+/** \brief Stop the background generation and clean all the stored presignatures
+ *
+ *  @param pool      Pool to clean
+ */
+extern void CG21_PRESIGN_POOL_KILL(CG21_PRESIGN_POOL *pool);
+
+/** \brief Store a presignature generated by CG21_PRESIGN_OUTPUT_2_2
+ *
+ *  @param pool      Pool
+ *  @param pre       Presignature to store
+ *  @param id        Sequence number assigned to the presignature. Optional
+ *  @return          CG21_OK, CG21_PRESIGN_POOL_FULL or CG21_PRESIGN_POOL_INVALID
+ */
+extern int CG21_PRESIGN_POOL_PUT(CG21_PRESIGN_POOL *pool, const CG21_PRESIGN_ROUND4_STORE_2 *pre, int *id);
+
+/** \brief Hand out the oldest unused presignature and mark it used
+ *
+ *  The entry is cleaned, so the presignature can not be handed out again
+ *
+ *  @param pool      Pool
+ *  @param pre       Destination presignature
+ *  @param id        Sequence number of the presignature, to be shared with the other players
+ *  @return          CG21_OK or CG21_PRESIGN_POOL_EMPTY
+ */
+extern int CG21_PRESIGN_POOL_CHECKOUT(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_ROUND4_STORE_2 *pre, int *id);
+
+/** \brief Hand out the presignature with sequence number id and mark it used
+ *
+ *  @param pool      Pool
+ *  @param id        Sequence number of the presignature
+ *  @param pre       Destination presignature
+ *  @return          CG21_OK or CG21_PRESIGN_POOL_UNKNOWN_ID
+ */
+extern int CG21_PRESIGN_POOL_TAKE(CG21_PRESIGN_POOL *pool, int id, CG21_PRESIGN_ROUND4_STORE_2 *pre);
+
+/** \brief Run CG21_SIGN_ROUND1 on a presignature taken from the pool
+ *
+ *  If id is negative the oldest unused presignature is used and its
+ *  sequence number is written in id, otherwise the presignature with
+ *  sequence number id is used. The presignature is used even if the
+ *  signing fails.
+ *
+ *  @param pool      Pool
+ *  @param id        Sequence number of the presignature
+ *  @param msg       Message to be signed
+ *  @param store     Data to be stored in db in round 1
+ *  @param out       Data to be broadcast once round 1 ends
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_PRESIGN_POOL_SIGN(CG21_PRESIGN_POOL *pool, int *id, octet *msg,
+                                  CG21_SIGN_ROUND1_STORE *store, CG21_SIGN_ROUND1_OUTPUT *out);
+
+/** \brief Number of unused presignatures in the pool
+ *
+ *  @param pool      Pool
+ *  @return          Number of unused presignatures
+ */
+extern int CG21_PRESIGN_POOL_SIZE(CG21_PRESIGN_POOL *pool);
+
+/** \brief Start generating presignatures in a background thread
+ *
+ *  The generator is called whenever fewer than low presignatures
+ *  are available, until the pool is full
+ *
+ *  @param pool      Pool
+ *  @param generator Presignature generator
+ *  @param arg       Argument of the generator
+ *  @param low       Refill threshold, between 1 and the capacity of the pool
+ *  @return          CG21_OK, CG21_PRESIGN_POOL_RUNNING or CG21_PRESIGN_POOL_INVALID
+ */
+extern int CG21_PRESIGN_POOL_START(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_GENERATOR generator, void *arg, int low);
+
+/** \brief Stop the background generation
+ *
+ *  Waits for the generator call in progress, if any
+ *
+ *  @param pool      Pool
+ *  @return          CG21_OK or the error that stopped the generator
+ */
+extern int CG21_PRESIGN_POOL_STOP(CG21_PRESIGN_POOL *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,199 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file cg21_prime_pool.h
+ * @brief Pool of safe primes generated ahead of time
+ *
+ * The Auxiliary Info round needs fresh Paillier and ring Pedersen
+ * moduli, and the search for their safe primes takes far longer than
+ * the rest of the protocol. The pool finds safe primes in advance, in
+ * the calling thread or in the background, and hands each of them out
+ * at most once.
+ *
+ * The content of the pool can be exported to an octet encrypted and
+ * authenticated with AES-GCM, to be written to disk by the caller and
+ * imported again after a restart. The memory for the entries is owned
+ * by the caller.
+ */
+
+#ifndef CG21_PRIME_POOL_H
+#define CG21_PRIME_POOL_H
+
+#include <pthread.h>
+#include <amcl/amcl.h>
+#include <amcl/randapi.h>
+#include <amcl/ff_2048.h>
+#include <amcl/ecdh_SECP256K1.h>
+#include <amcl/paillier.h>
+#include "cg21_utilities.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CG21_PRIME_POOL_INVALID             3131101     /**< Invalid pool parameters */
+#define CG21_PRIME_POOL_RUNNING             3131102     /**< The background generation is already running */
+#define CG21_PRIME_POOL_INVALID_FORMAT      3131103     /**< The exported pool has an invalid format */
+#define CG21_PRIME_POOL_WRONG_VERSION       3131104     /**< The exported pool has an unknown version */
+#define CG21_PRIME_POOL_AUTH_FAIL           3131105     /**< The exported pool was not encrypted with this key */
+#define CG21_PRIME_POOL_OUTPUT_TOO_SMALL    3131106     /**< The output octet can not hold the exported pool */
+#define CG21_PRIME_POOL_DUPLICATE           3131107     /**< An imported prime is already in the pool */
+
+#define CG21_PRIME_POOL_VERSION             1           /**< Version of the export format */
+#define CG21_PRIME_POOL_IV_SIZE             12          /**< Length of the AES-GCM IV in bytes */
+#define CG21_PRIME_POOL_TAG_SIZE            16          /**< Length of the AES-GCM tag in bytes */
+#define CG21_PRIME_POOL_HEADER_SIZE         5           /**< Version byte and number of primes */
+
+/** Length in bytes of an exported pool of k primes */
+#define CG21_PRIME_POOL_EXPORT_SIZE(k)      (CG21_PRIME_POOL_HEADER_SIZE + CG21_PRIME_POOL_IV_SIZE + (k) * HFS_2048 + CG21_PRIME_POOL_TAG_SIZE)
+
+/*! \brief Stored safe prime */
+typedef struct
+{
+    char P[HFS_2048];               /**< Safe prime P = 2p+1 */
+} CG21_PRIME_POOL_ENTRY;
+
+/*! \brief Pool of safe primes */
+typedef struct
+{
+    CG21_PRIME_POOL_ENTRY *entries; /**< Caller owned entries */
+    int capacity;                   /**< Number of entries */
+    int head;                       /**< Index of the oldest stored prime */
+    int count;                      /**< Number of stored primes */
+
+    int threads;                    /**< Search threads for each prime */
+
+    csprng RNG;                     /**< Seeds the searches, seeded by the caller's RNG */
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+
+    pthread_t producer;             /**< Background generation thread */
+    int low;                        /**< Refill when fewer primes are available */
+    int running;                    /**< The background generation is running */
+} CG21_PRIME_POOL;
+
+/** \brief Initialise an empty pool
+ *
+ *  @param pool      Pool to initialise
+ *  @param entries   Array of capacity entries
+ *  @param capacity  Number of entries
+ *  @param RNG       Pointer to a cryptographically secure random number generator, used to seed the pool
+ *  @param threads   Number of threads searching each prime, see safe_prime_gen_mt
+ *  @return          CG21_OK or CG21_PRIME_POOL_INVALID
+ */
+extern int CG21_PRIME_POOL_INIT(CG21_PRIME_POOL *pool, CG21_PRIME_POOL_ENTRY *entries, int capacity,
+                                csprng *RNG, int threads);
+
+/** \brief Stop the background generation and clean the pool
+ *
+ *  @param pool      Pool to clean
+ */
+extern void CG21_PRIME_POOL_KILL(CG21_PRIME_POOL *pool);
+
+/** \brief Search safe primes in the calling thread
+ *
+ *  @param pool      Pool
+ *  @param count     Number of primes to add, stops early once the pool is full
+ *  @return          Number of primes added
+ */
+extern int CG21_PRIME_POOL_FILL(CG21_PRIME_POOL *pool, int count);
+
+/** \brief Number of safe primes in the pool
+ *
+ *  @param pool      Pool
+ *  @return          Number of stored primes
+ */
+extern int CG21_PRIME_POOL_SIZE(CG21_PRIME_POOL *pool);
+
+/** \brief Start searching safe primes in a background thread
+ *
+ *  The pool is refilled whenever fewer than low primes are available
+ *
+ *  @param pool      Pool
+ *  @param low       Refill threshold, between 1 and the capacity of the pool
+ *  @return          CG21_OK, CG21_PRIME_POOL_RUNNING or CG21_PRIME_POOL_INVALID
+ */
+extern int CG21_PRIME_POOL_START(CG21_PRIME_POOL *pool, int low);
+
+/** \brief Stop the background generation
+ *
+ *  Waits for the search in progress, if any
+ *
+ *  @param pool      Pool
+ */
+extern void CG21_PRIME_POOL_STOP(CG21_PRIME_POOL *pool);
+
+/** \brief Take a safe prime from the pool
+ *
+ *  If the pool is empty the prime is searched on the spot
+ *
+ *  @param pool      Pool
+ *  @param P         Safe prime P = 2p+1, HFS_2048 bytes
+ */
+extern void CG21_PRIME_POOL_TAKE(CG21_PRIME_POOL *pool, octet *P);
+
+/** \brief Set up Paillier and ring Pedersen keys from two safe primes of the pool
+ *
+ *  As in CG21, the same primes are used for both moduli
+ *
+ *  @param pool      Pool
+ *  @param RNG       Pointer to a cryptographically secure random number generator for the Pedersen parameters
+ *  @param paillier  Paillier keys
+ *  @param pedersen  Pedersen keys
+ */
+extern void CG21_PRIME_POOL_KEYS(CG21_PRIME_POOL *pool, csprng *RNG, CG21_PAILLIER_KEYS *paillier, CG21_PEDERSEN_KEYS *pedersen);
+
+/** \brief Export the primes of the pool, encrypted with AES-GCM
+ *
+ *  The primes are taken out of the pool, so that they are not handed
+ *  out both by the pool and after the import. The output is the version
+ *  byte, the number of primes, a random IV, the encrypted primes and
+ *  the tag. The header is authenticated with the primes
+ *
+ *  @param pool      Pool
+ *  @param RNG       Pointer to a cryptographically secure random number generator for the IV
+ *  @param K         AES key, 16 or 32 bytes
+ *  @param OUT       Exported pool, at least CG21_PRIME_POOL_EXPORT_SIZE(capacity) bytes
+ *  @return          CG21_OK or CG21_PRIME_POOL_OUTPUT_TOO_SMALL, in which case the pool is unchanged
+ */
+extern int CG21_PRIME_POOL_EXPORT(CG21_PRIME_POOL *pool, csprng *RNG, octet *K, octet *OUT);
+
+/** \brief Add the primes of an exported pool
+ *
+ *  Nothing is added unless all the primes fit in the pool and none of
+ *  them is already stored. An export that does not fit is rejected
+ *  before it is decrypted. The caller must delete the export once it
+ *  is imported, since the primes of an export imported again after
+ *  they are taken can not be told apart from fresh ones
+ *
+ *  @param pool      Pool
+ *  @param K         AES key used for the export
+ *  @param IN        Exported pool
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_PRIME_POOL_IMPORT(CG21_PRIME_POOL *pool, octet *K, octet *IN);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
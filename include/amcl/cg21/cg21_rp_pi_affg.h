@@ -175,6 +175,16 @@ extern void Piaffg_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key
                                  const octet *X, const octet *Y, const octet *C, const octet *D,
                                  Piaffg_COMMITS *affg, CG21_SSID *ssid, octet *E);
 
+/** \brief Challenge generation from a session context
+ *
+ *  Same as Piaffg_Challenge_gen, with the SSID serialised once per session. The challenge is the same
+ *
+ *  @param ctx         Session context, see CG21_SSID_CTX_init
+ */
+extern void Piaffg_Challenge_gen_ctx(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                                     const octet *X, const octet *Y, const octet *C, const octet *D,
+                                     Piaffg_COMMITS *affg, const CG21_SSID_CTX *ctx, octet *E);
+
 /** \brief Proof generation
  *
  *  Generate a proof for the ZKP
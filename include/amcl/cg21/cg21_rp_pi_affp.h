@@ -179,6 +179,16 @@ extern void PiAffp_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key
                                  const octet *X, const octet *Y, const octet *C, const octet *D,
                                  PiAffp_COMMITS *affp, CG21_SSID *ssid, octet *E);
 
+/** \brief Challenge generation from a session context
+ *
+ *  Same as PiAffp_Challenge_gen, with the SSID serialised once per session. The challenge is the same
+ *
+ *  @param ctx         Session context, see CG21_SSID_CTX_init
+ */
+extern void PiAffp_Challenge_gen_ctx(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                                     const octet *X, const octet *Y, const octet *C, const octet *D,
+                                     PiAffp_COMMITS *affp, const CG21_SSID_CTX *ctx, octet *E);
+
 /** \brief Proof generation
  *
  *  Generate a proof for the ZKP
@@ -109,6 +109,15 @@ typedef struct
 extern void PiEnc_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com, const octet *K,
                                 PiEnc_COMMITS *secrets, CG21_SSID *ssid, octet *E);
 
+/** \brief Challenge generation from a session context
+ *
+ *  Same as PiEnc_Challenge_gen, with the SSID serialised once per session. The challenge is the same
+ *
+ *  @param ctx        Session context, see CG21_SSID_CTX_init
+ */
+extern void PiEnc_Challenge_gen_ctx(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com, const octet *K,
+                                    PiEnc_COMMITS *secrets, const CG21_SSID_CTX *ctx, octet *E);
+
 /** \brief Commitment Generation
  *
  *  Generate a commitment for the ZKP
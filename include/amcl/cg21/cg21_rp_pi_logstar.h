@@ -120,6 +120,16 @@ extern void PiLogstar_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *
                                     const octet *C, PiLogstar_COMMITS *commits, CG21_SSID *ssid,
                                     const octet *X, octet *E);
 
+/** \brief Challenge generation from a session context
+ *
+ *  Same as PiLogstar_Challenge_gen, with the SSID serialised once per session. The challenge is the same
+ *
+ *  @param ctx        Session context, see CG21_SSID_CTX_init
+ */
+extern void PiLogstar_Challenge_gen_ctx(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                                        const octet *C, PiLogstar_COMMITS *commits, const CG21_SSID_CTX *ctx,
+                                        const octet *X, octet *E);
+
 /** \brief Commitment Generation
  *
  *  Generate a commitment for the ZKP
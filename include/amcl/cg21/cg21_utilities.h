@@ -29,15 +29,24 @@ under the License.
 #define CG21_INVALID_ECP                    3130306
 #define CG21_PI_PRM_INVALID_PROOF           3130307     /**< The Proof of well formednes is invalid */
 #define CG21_PI_PRM_INVALID_FORMAT          3130308     /**< An octet value has an invalid format */
+#define CG21_PAILLIER_NOT_BLUM              3130309     /**< Paillier primes should be 3 mod 4 */
+#define CG21_PEDERSEN_CHECK_FAIL            3130310     /**< The Pedersen commitment check failed */
+#define CG21_SSID_CTX_TOO_SMALL             3130311     /**< The octet of the session context can not hold the SSID */
+
+#define CG21_LAGRANGE_INVALID_SET           3131301     /**< The signer set is empty, too large, has repeated or non positive IDs, or misses the ID */
 
 #define CG21_PAILLIER_PROOF_SIZE  CG21_PAILLIER_PROOF_ITERS * FS_2048 /**< Length of components of the Proof in bytes */
 #define CG21_PAILLIER_PROOF_ITERS           128                        /**< Iterations necessary for the Proof of Paillier N */
 
+#define SAFE_PRIME_SIEVE_BOUND              16384       /**< Bound of the small primes sieved from the safe prime candidates */
+
 #include "amcl/amcl.h"
 #include "amcl/modulus.h"
 #include "amcl/hidden_dlog.h"
 #include "amcl/ecp_SECP256K1.h"
 #include "amcl/ecdh_SECP256K1.h"
+#include "amcl/ecp_gen.h"
+#include "amcl/ecp_msm.h"
 #include "amcl/hash_utils.h"
 #include "amcl/paillier.h"
 #include "amcl/shamir.h"
@@ -56,6 +65,8 @@ typedef struct
     BIG_1024_58 ialpha[FFLEN_2048]; /**< Inverse of alpha mod pq. */
     BIG_1024_58 b0[FFLEN_2048];     /**< Generator  of Z/PQZ */
     BIG_1024_58 b1[FFLEN_2048];     /**< Generator  of Z/PQZ */
+    struct HDLOG_comb *comb_b0;     /**< Optional comb of b0 modulo P and Q, NULL if not precomputed */
+    struct HDLOG_comb *comb_b1;     /**< Optional comb of b1 modulo P and Q, NULL if not precomputed */
 } PEDERSEN_PRIV;
 
 /*! \brief Public Ring Pedersen Parameters */
@@ -66,6 +77,18 @@ typedef struct
     BIG_1024_58 b1[FFLEN_2048];     /**< Generator of Z/PQZ */
 } PEDERSEN_PUB;
 
+/*! \brief Players' IDs of a packed set, sorted once
+ *
+ * The packed sets of the session hold one entry for each ID, so
+ * they can be visited in the order of the IDs without unpacking them
+ */
+typedef struct CG21_PARTY_TABLE
+{
+    int n;          /**< Number of players */
+    int *ids;       /**< ids[k] is the k-th ID in j_packed */
+    int *order;     /**< order[k] is the position in j_packed of the k-th ID in the hashing order */
+} CG21_PARTY_TABLE;
+
 typedef struct
 {
     octet *uid;             // session ID
@@ -97,18 +120,105 @@ typedef struct
 
 } CG21_PEDERSEN_KEYS;
 
+/*! \brief Session ID serialised once for all the challenges of a session */
+typedef struct
+{
+    octet *S;       /**< SSID in the order CG21_hash_SSID hashes it */
+} CG21_SSID_CTX;
+
+/** Bytes of the serialised SSID with a uid of uid_len bytes, n1 partial PKs and n2 Aux. sets */
+#define CG21_SSID_CTX_SIZE(uid_len, n1, n2) (3 * EGS_SECP256K1 + (uid_len) + ((n1) + 1) * (EFS_SECP256K1 + 1) + 3 * (n2) * FS_2048)
+
+#define CG21_POINT_CACHE_VSS_CHECK          1           /**< VSS check, indexed by the power of x */
+#define CG21_POINT_CACHE_GAMMA              2           /**< Presign Gamma */
+#define CG21_POINT_CACHE_DELTA              3           /**< Presign Delta */
+#define CG21_POINT_CACHE_PARTIAL_PK         4           /**< Partial ECDSA PK */
+
+/*! \brief Point decompressed and validated once per session */
+typedef struct
+{
+    int id;                         /**< Party the point belongs to */
+    int role;                       /**< What the point is, see CG21_POINT_CACHE_VSS_CHECK and the like */
+    int index;                      /**< Position of the point within its role */
+    int len;                        /**< Length of the encoding */
+    char P[EFS_SECP256K1 + 1];      /**< Encoding the point was parsed from */
+    ECP_SECP256K1 G;                /**< Validated point */
+} CG21_POINT_CACHE_ENTRY;
+
+/*! \brief Cache of the peers' points for one session
+ *
+ * The entries are keyed by party, role and index. A lookup also
+ * compares the encoding, so a changed point is parsed again
+ */
+typedef struct
+{
+    CG21_POINT_CACHE_ENTRY *entries;    /**< Caller owned entries */
+    int capacity;                       /**< Number of entries */
+    int count;                          /**< Number of used entries */
+    int next;                           /**< Entry replaced once the cache is full */
+} CG21_POINT_CACHE;
+
+/*! \brief Running sum of points across calls
+ *
+ * The sum stays in projective coordinates and is converted to affine
+ * only once, when it is output. It has no octet form, so it must stay
+ * in memory between the calls, see the _ACC status functions
+ */
+typedef struct
+{
+    ECP_SECP256K1 P;                /**< Sum of the points added so far */
+} CG21_ECP_ACCUMULATOR;
+
+#define CG21_LAGRANGE_MAX_SIGNERS           64          /**< Largest signer set held by a Lagrange cache entry */
+
+/*! \brief Lagrange coefficients at 0 of all the signers of a set */
+typedef struct
+{
+    int t;                                          /**< Number of signers, 0 if unused */
+    int ids[CG21_LAGRANGE_MAX_SIGNERS];             /**< Signer IDs in increasing order */
+    BIG_256_56 coeff[CG21_LAGRANGE_MAX_SIGNERS];    /**< coeff[k] is the coefficient of ids[k] */
+} CG21_LAGRANGE_CACHE_ENTRY;
+
+/*! \brief Cache of Lagrange coefficients keyed by signer set */
+typedef struct
+{
+    CG21_LAGRANGE_CACHE_ENTRY *entries; /**< Caller owned entries */
+    int capacity;                       /**< Number of entries */
+    int count;                          /**< Number of used entries */
+    int next;                           /**< Entry replaced once the cache is full */
+} CG21_LAGRANGE_CACHE;
+
 /*
  * Find random element of order p in Z/PZ
  * Assuming P = 2p + 1 is a safe prime, i.e. phi(P) = 2p
  */
 void BC_find_generator(csprng *RNG, BIG_1024_58* x, BIG_1024_58 *P, int n);
 
+/*
+ * Sieve of the safe prime candidates p + 12i, i = 0, ..., m-1, as done
+ * by safe_prime_gen. pass[i] is 0 if p + 12i or P = 2(p + 12i) + 1 has
+ * an odd prime factor 3 < s < SAFE_PRIME_SIEVE_BOUND, 1 otherwise.
+ * n is the size of p in BIGs
+ */
+extern void safe_prime_sieve(BIG_1024_58 *p, int *pass, int m, int n);
+
 /*
  * Generate a safe prime P, such that P = 2 * p + 1
  * n is the size of P in BIGs
  */
 extern void safe_prime_gen (csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n);
 
+/*
+ * Generate k safe primes P = 2 * p + 1 with several search threads
+ * n is the size of P in BIGs. The pairs are stored one after the
+ * other in p and P, each of size k * n. Every thread searches with
+ * its own csprng seeded from RNG and the threads stop as soon as the
+ * k primes are found, so the output depends on the scheduling.
+ * With a single thread this is k calls to safe_prime_gen. With
+ * k <= 0 it returns at once without reading RNG
+ */
+extern void safe_prime_gen_mt(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int k, int n, int threads);
+
 /** \brief Pack Pedersen private parameters into one octet
  *
  *   @param priv    input:  Pedersen private parameters
@@ -116,6 +226,24 @@ extern void safe_prime_gen (csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n);
  */
 extern void CG21_PedersenPriv_to_octet(PEDERSEN_PRIV *priv, octet *oct);
 
+/** \brief Precompute the combs of b0 and b1 modulo P and Q
+ *
+ *   Call once the aux-info is complete. The combs are owned by the
+ *   caller and are reused by the Pi^prm commitments and by every range
+ *   proof verified with these parameters.
+ *
+ *   The combs are opt-in: they are not part of the octet encoding, so
+ *   parameters loaded with CG21_PedersenPriv_from_octet have none until
+ *   this function is called on them. Copies of priv share the same
+ *   combs, which are cleaned once with CG21_Pedersen_comb_kill after the
+ *   last copy is used
+ *
+ *   @param priv    Pedersen private parameters
+ *   @param comb_b0 output: comb of b0
+ *   @param comb_b1 output: comb of b1
+ */
+extern void CG21_Pedersen_precompute(PEDERSEN_PRIV *priv, struct HDLOG_comb *comb_b0, struct HDLOG_comb *comb_b1);
+
 /** \brief Pack Pedersen public parameters into one octet
  *
  *   @param pub    input:  Pedersen public parameters
@@ -204,6 +332,19 @@ extern void CG21_hash_pubKey2x_pubCom(hash256 *sha, PAILLIER_public_key *pub_key
  */
 extern void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q);
 
+/*! \brief Generate a Private Ring Pedersen modulus on several threads
+ *
+ * Same as ring_Pedersen_setup, but the missing safe primes are searched
+ * concurrently with safe_prime_gen_mt
+ *
+ * @param RNG       CSPRNG to generate P, Q, B0 and ALPHA
+ * @param m         Private modulus to populate
+ * @param P         Safe prime 2p+1. Generated if NULL
+ * @param Q         Safe prime 2q+1. Generated if NULL
+ * @param threads   Number of search threads, including the calling one
+ */
+extern void ring_Pedersen_setup_mt(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q, int threads);
+
 /*! \brief Export the public part of the modulus
  *
  * @param pub   The destination public modulus
@@ -212,11 +353,22 @@ extern void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *
 extern void Pedersen_get_public_param(PEDERSEN_PUB *pub, PEDERSEN_PRIV *priv);
 
 /*! \brief Clean up Pedersen private parameters
+ *
+ * The combs, if any, are detached but not cleaned, since they may be
+ * shared with copies of priv
  *
  * @param priv  Pedersen private parameters
  */
 extern void CG21_Pedersen_Private_Kill( PEDERSEN_PRIV *priv);
 
+/*! \brief Clean up the combs attached by CG21_Pedersen_precompute
+ *
+ * Every copy of priv sharing the combs must not use them afterwards
+ *
+ * @param priv  Pedersen private parameters
+ */
+extern void CG21_Pedersen_comb_kill(PEDERSEN_PRIV *priv);
+
 
 /*! \brief Asymmetric mul
  *
@@ -263,6 +415,39 @@ extern void CG21_FF_2048_amod(BIG_1024_58 *r, BIG_1024_58 *x, int xlen, BIG_1024
 extern void CG21_Pedersen_verify(BIG_1024_58 *proof, PEDERSEN_PRIV *st, BIG_1024_58 *z1,
                                  BIG_1024_58 *z3, BIG_1024_58 *S, BIG_1024_58 *e, BIG_1024_58 *p, bool reduce_s1);
 
+/** \brief Check s^z1 * t^z3 * S^(-e) == C mod PQ using CRT
+ *
+ *   Same check as CG21_Pedersen_verify modulo P and Q followed by the comparison
+ *   with C. If the combs of s and t have been precomputed with CG21_Pedersen_precompute
+ *   they are used, and the check is done as s^z1 * t^z3 == C * S^e
+ *
+ *   @param st          Pedersen private parameters
+ *   @param z1          exponent of s
+ *   @param z3          exponent of t
+ *   @param S           commitment of the prover
+ *   @param C           expected value
+ *   @param e           challenge
+ *   @param reduce_s1   reduce z1 modulo the order before the exponentiation
+ *   @return            CG21_OK if the check passes, CG21_PEDERSEN_CHECK_FAIL otherwise
+ */
+extern int CG21_Pedersen_check(PEDERSEN_PRIV *st, BIG_1024_58 *z1, BIG_1024_58 *z3, BIG_1024_58 *S, BIG_1024_58 *C,
+                               BIG_1024_58 *e, bool reduce_s1);
+
+/** \brief Homomorphic multiplications CT[i] = CT1^PT[i] mod N^2 for short plaintexts
+ *
+ *   Same result as PAILLIER_MULT, with the exponentiations only as long as
+ *   the longest plaintext, rounded up to a BIG, instead of HFS_4096 bytes.
+ *   The table of CT1 is computed once and shared by all the plaintexts.
+ *   Constant time in the plaintexts, whose length in bytes is public
+ *
+ *   @param PUB         Paillier public key
+ *   @param CT1         Ciphertext to multiply
+ *   @param PT          Array of k plaintexts, at most HFS_4096 bytes
+ *   @param CT          Array of k destination ciphertexts
+ *   @param k           Number of plaintexts
+ */
+extern void CG21_PAILLIER_MULT_SHORT(PAILLIER_public_key *PUB, octet *CT1, octet *PT[], octet *CT[], int k);
+
 /**	@brief Initialize an array of octets
 *
 *
@@ -317,6 +502,31 @@ extern int CG21_hash_set_X(hash256 *sha, octet *X_packed, octet *j_packed, int n
 */
 extern int CG21_set_comp(octet *set_packed1, octet *j_packed1, octet *set_packed2, octet *j_packed2, int n, int size);
 
+/**	@brief Parse and sort packed players' IDs
+*
+*  The IDs are ordered as the hex strings of j_packed were before, each
+*  digit a-f counting as its ASCII distance from '0', so the challenges
+*  keep hashing the packed sets in the same order
+*
+*  @param table         table to fill
+*  @param ids           array of n integers for the IDs
+*  @param order         array of n integers for the sorted positions
+*  @param j_packed      players' IDs, two bytes each
+*  @param n             number of players
+*/
+extern int CG21_PARTY_TABLE_init(CG21_PARTY_TABLE *table, int *ids, int *order, const octet *j_packed, int n);
+
+/**	@brief Hash a packed set of octets in the order of the players' IDs
+*
+*  Same as CG21_hash_set_X, with the IDs already sorted
+*
+*  @param sha           instance of hash256
+*  @param table         sorted players' IDs of the set
+*  @param X_packed      packed set of octets
+*  @param m             size of octets in X_packed
+*/
+extern int CG21_PARTY_TABLE_hash_set(hash256 *sha, const CG21_PARTY_TABLE *table, const octet *X_packed, int m);
+
 /**	@brief Get curve group generator
 *
 *  @param g       curve group generator
@@ -340,6 +550,29 @@ extern void CG21_get_q(octet *q);
 */
 extern int CG21_ADD_TWO_PK(octet *O, const octet *P);
 
+/**	@brief Start a running sum of points at the point at infinity
+ *
+ *  @param acc     accumulator
+ */
+extern void CG21_ECP_ACCUMULATOR_init(CG21_ECP_ACCUMULATOR *acc);
+
+/**	@brief Add a point to a running sum
+ *
+ *  @param acc     accumulator
+ *  @param P       compressed point to add
+ *  @return        CG21_OK or CG21_INVALID_ECP
+ */
+extern int CG21_ECP_ACCUMULATOR_add(CG21_ECP_ACCUMULATOR *acc, const octet *P);
+
+/**	@brief Output a running sum as a compressed point
+ *
+ *  The sum is left in affine coordinates in acc
+ *
+ *  @param acc     accumulator
+ *  @param O       compressed sum
+ */
+extern void CG21_ECP_ACCUMULATOR_output(CG21_ECP_ACCUMULATOR *acc, octet *O);
+
 /**	@brief Pack VSS checks into one octet
 *
 *
@@ -374,6 +607,8 @@ extern int CG21_double_unpack(octet *checks, int t1, int t2, octet *out);
 /**	@brief Sort hex number in char form
 *   e.g. (0003000100050002) -> (1,3,0,2)
 *
+*  The packed IDs are sorted in the same order by CG21_PARTY_TABLE_init
+*
 *  @param temp      concatenated hex values
 *  @param indices   indices that reflect sorted number
 *  @param n         number of hex values
@@ -402,9 +637,105 @@ extern void CG21_lagrange_index_to_octet(int t, const int *T, int myID, octet *o
 
 extern void CG21_lagrange_calc_coeff(int k, const octet *X_j, const octet *X, BIG_256_56 *out);
 
+/**	@brief Compute the Lagrange coefficient at 0 of one signer of a set
+ *
+ *  Used when no coefficient table is kept, and for the sets larger than
+ *  CG21_LAGRANGE_MAX_SIGNERS
+ *
+ *  @param t          number of signers, at least 2
+ *  @param T          IDs of the signers, in any order
+ *  @param id         ID of the signer
+ *  @param coeff      Lagrange coefficient at 0 of id
+ *  @return           CG21_OK or CG21_LAGRANGE_INVALID_SET if id is not in the set
+ */
+extern int CG21_lagrange_coeff(int t, const int *T, int id, BIG_256_56 coeff);
+
+/**	@brief Compute the Lagrange coefficients at 0 of all the signers of a set
+ *
+ *  The denominators are inverted together with a single modular inversion
+ *
+ *  @param t          number of signers
+ *  @param T          IDs of the signers, in any order
+ *  @param entry      coefficients of the set
+ *  @return           CG21_OK or CG21_LAGRANGE_INVALID_SET
+ */
+extern int CG21_lagrange_coeffs(int t, const int *T, CG21_LAGRANGE_CACHE_ENTRY *entry);
+
+/**	@brief Look up the Lagrange coefficient of a signer
+ *
+ *  @param entry      coefficients of the set, see CG21_lagrange_coeffs
+ *  @param id         ID of the signer
+ *  @param coeff      Lagrange coefficient at 0 of id
+ *  @return           CG21_OK or CG21_LAGRANGE_INVALID_SET if id is not in the set
+ */
+extern int CG21_lagrange_entry_coeff(const CG21_LAGRANGE_CACHE_ENTRY *entry, int id, BIG_256_56 coeff);
+
+/**	@brief Initialise an empty Lagrange coefficient cache
+ *
+ *  @param cache      cache to initialise
+ *  @param entries    array of capacity entries
+ *  @param capacity   number of entries
+ */
+extern void CG21_LAGRANGE_CACHE_init(CG21_LAGRANGE_CACHE *cache, CG21_LAGRANGE_CACHE_ENTRY *entries, int capacity);
+
+/**	@brief Clean the Lagrange coefficient cache
+ *
+ *  @param cache      cache to clean
+ */
+extern void CG21_LAGRANGE_CACHE_kill(CG21_LAGRANGE_CACHE *cache);
+
+/**	@brief Lagrange coefficient of a signer, computed once per signer set
+ *
+ *  The coefficients of all the signers are computed on the first lookup of a set.
+ *  A set rejected with CG21_LAGRANGE_INVALID_SET leaves the cache unchanged.
+ *  Sets larger than CG21_LAGRANGE_MAX_SIGNERS are not cached, the coefficient is
+ *  computed on each lookup with CG21_lagrange_coeff
+ *
+ *  @param cache      Lagrange coefficient cache, NULL to always compute the coefficients
+ *  @param t          number of signers
+ *  @param T          IDs of the signers, in any order
+ *  @param id         ID of the signer
+ *  @param coeff      Lagrange coefficient at 0 of id
+ *  @return           CG21_OK or CG21_LAGRANGE_INVALID_SET
+ */
+extern int CG21_LAGRANGE_CACHE_coeff(CG21_LAGRANGE_CACHE *cache, int t, const int *T, int id, BIG_256_56 coeff);
+
 /*  computes g^{\sigma_i} as described in GG20, p.:11 */
 extern int CG21_CALC_XI(int t, const octet *i, const octet *checks, ECP_SECP256K1 *V);
 
+/*  same as CG21_CALC_XI, the checks of party id are parsed through the cache, which can be NULL */
+extern int CG21_CALC_XI_CACHED(int t, const octet *i, const octet *checks, CG21_POINT_CACHE *cache, int id,
+                               ECP_SECP256K1 *V);
+
+/**	@brief Initialise an empty point cache
+ *
+ *  @param cache      Cache to initialise
+ *  @param entries    Array of capacity entries
+ *  @param capacity   Number of entries
+ */
+extern void CG21_POINT_CACHE_init(CG21_POINT_CACHE *cache, CG21_POINT_CACHE_ENTRY *entries, int capacity);
+
+/**	@brief Clean the points of the cache
+ *
+ *  @param cache      Cache to clean
+ */
+extern void CG21_POINT_CACHE_kill(CG21_POINT_CACHE *cache);
+
+/**	@brief Parse a point through the cache
+ *
+ *  The point is decompressed and validated only if the cache has no
+ *  entry for the same party, role, index and encoding
+ *
+ *  @param cache      Point cache, NULL to always parse the point
+ *  @param id         Party the point belongs to
+ *  @param role       What the point is, see CG21_POINT_CACHE_VSS_CHECK and the like
+ *  @param index      Position of the point within its role
+ *  @param P          Encoding of the point
+ *  @param G          Parsed point
+ *  @return           CG21_OK or CG21_INVALID_ECP
+ */
+extern int CG21_POINT_CACHE_get(CG21_POINT_CACHE *cache, int id, int role, int index, const octet *P, ECP_SECP256K1 *G);
+
 /**	@brief  Calculate jacobi Symbol (a/p) - not constant time
  *
 	@param a BIG number
@@ -432,6 +763,26 @@ extern void CG21_sqrt(BIG_1024_58 r[FFLEN_2048], BIG_1024_58 a[FFLEN_2048], BIG_
 */
 extern int CG21_hash_SSID(CG21_SSID *ssid, hash256 *sha);
 
+/**	@brief Serialise the SSID once for all the challenges of a session
+*
+*  The sets are sorted once, so the challenges only hash the bytes
+*
+*  @param ctx       session context
+*  @param ssid      system-wide session-ID, refers to the same notation as in CG21
+*  @param S         holds the serialised SSID for the session, see CG21_SSID_CTX_SIZE
+*  @return          CG21_OK, CG21_SSID_CTX_TOO_SMALL or the error of CG21_hash_SSID
+*/
+extern int CG21_SSID_CTX_init(CG21_SSID_CTX *ctx, CG21_SSID *ssid, octet *S);
+
+/**	@brief Hash the SSID of the session
+*
+*  Same as CG21_hash_SSID on the SSID of the session
+*
+*  @param ctx       session context
+*  @param sha       instance of hash256
+*/
+extern void CG21_SSID_CTX_hash(const CG21_SSID_CTX *ctx, hash256 *sha);
+
 /**	@brief takes an integer number as input and return its bit-length
 *
 *  @param number    input integer
@@ -0,0 +1,347 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file cg21_wire.h
+ * @brief Binary encoding of the CG21 round messages
+ *
+ * A message is a version byte and a message type byte, followed by its
+ * fields in the order of the struct. An integer is encoded in 4 bytes
+ * and an octet as its length in 4 bytes followed by its content, all
+ * big endian. Nested structs are flattened.
+ *
+ * The fields are written straight into the output octet and decoded
+ * into the octets already allocated by the caller, so nothing is
+ * allocated or copied in between. If the decoding fails the fields
+ * decoded so far are left in the destination message.
+ */
+
+#ifndef CG21_WIRE_H
+#define CG21_WIRE_H
+
+#include "cg21.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define CG21_WIRE_INVALID_FORMAT            3131201     /**< The message is truncated or has trailing bytes */
+#define CG21_WIRE_WRONG_VERSION             3131202     /**< The message has an unknown version */
+#define CG21_WIRE_WRONG_TYPE                3131203     /**< The message is of another type */
+#define CG21_WIRE_BUFFER_TOO_SMALL          3131204     /**< A destination octet is too small */
+
+#define CG21_WIRE_VERSION                   1           /**< Version of the encoding */
+#define CG21_WIRE_HEADER_SIZE               2           /**< Version and message type bytes */
+
+#define CG21_WIRE_KEYGEN_ROUND1_OUTPUT              1          /**< KeyGen Round 1 output */
+#define CG21_WIRE_KEYGEN_ROUND1_STORE_PUB           2          /**< KeyGen Round 1 public data */
+#define CG21_WIRE_KEYGEN_ROUND3_OUTPUT              3          /**< KeyGen Round 3 output */
+#define CG21_WIRE_AUX_ROUND1_OUT                    4          /**< Auxiliary Info Round 1 output */
+#define CG21_WIRE_AUX_ROUND1_STORE_PUB              5          /**< Auxiliary Info Round 1 public data */
+#define CG21_WIRE_AUX_ROUND3                        6          /**< Auxiliary Info Round 3 output */
+#define CG21_WIRE_RESHARE_ROUND1_OUT                7          /**< Key Re-Sharing Round 1 output */
+#define CG21_WIRE_RESHARE_ROUND1_STORE_PUB_T1       8          /**< Key Re-Sharing Round 1 public data of a player in T1 */
+#define CG21_WIRE_RESHARE_ROUND1_STORE_PUB_N2       9          /**< Key Re-Sharing Round 1 public data of a player in N2 */
+#define CG21_WIRE_RESHARE_ROUND3_OUTPUT            10          /**< Key Re-Sharing Round 3 output */
+#define CG21_WIRE_RESHARE_ROUND4_OUTPUT            11          /**< Key Re-Sharing Round 4 output */
+#define CG21_WIRE_PRESIGN_ROUND1_OUTPUT            12          /**< Pre-Sign Round 1 output */
+#define CG21_WIRE_PRESIGN_ROUND2_OUTPUT            13          /**< Pre-Sign Round 2 output */
+#define CG21_WIRE_PRESIGN_ROUND3_OUTPUT            14          /**< Pre-Sign Round 3 output */
+#define CG21_WIRE_PRESIGN_ROUND4_OUTPUT            15          /**< Pre-Sign Round 4 output */
+#define CG21_WIRE_SIGN_ROUND1_OUTPUT               16          /**< Sign Round 1 output */
+#define CG21_WIRE_SIGN_ROUND2_OUTPUT               17          /**< Sign Round 2 output */
+
+/** \brief Encode the KeyGen Round 1 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_KEYGEN_ROUND1_OUTPUT(octet *OUT, CG21_KEYGEN_ROUND1_output *m);
+
+/** \brief Decode the KeyGen Round 1 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_KEYGEN_ROUND1_OUTPUT(CG21_KEYGEN_ROUND1_output *m, octet *IN);
+
+/** \brief Encode the KeyGen Round 1 public data
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_KEYGEN_ROUND1_STORE_PUB(octet *OUT, CG21_KEYGEN_ROUND1_STORE_PUB *m);
+
+/** \brief Decode the KeyGen Round 1 public data
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_KEYGEN_ROUND1_STORE_PUB(CG21_KEYGEN_ROUND1_STORE_PUB *m, octet *IN);
+
+/** \brief Encode the KeyGen Round 3 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_KEYGEN_ROUND3_OUTPUT(octet *OUT, CG21_KEYGEN_ROUND3_OUTPUT *m);
+
+/** \brief Decode the KeyGen Round 3 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_KEYGEN_ROUND3_OUTPUT(CG21_KEYGEN_ROUND3_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Auxiliary Info Round 1 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_AUX_ROUND1_OUT(octet *OUT, CG21_AUX_ROUND1_OUT *m);
+
+/** \brief Decode the Auxiliary Info Round 1 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_AUX_ROUND1_OUT(CG21_AUX_ROUND1_OUT *m, octet *IN);
+
+/** \brief Encode the Auxiliary Info Round 1 public data
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_AUX_ROUND1_STORE_PUB(octet *OUT, CG21_AUX_ROUND1_STORE_PUB *m);
+
+/** \brief Decode the Auxiliary Info Round 1 public data
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_AUX_ROUND1_STORE_PUB(CG21_AUX_ROUND1_STORE_PUB *m, octet *IN);
+
+/** \brief Encode the Auxiliary Info Round 3 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_AUX_ROUND3(octet *OUT, CG21_AUX_ROUND3 *m);
+
+/** \brief Decode the Auxiliary Info Round 3 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_AUX_ROUND3(CG21_AUX_ROUND3 *m, octet *IN);
+
+/** \brief Encode the Key Re-Sharing Round 1 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_RESHARE_ROUND1_OUT(octet *OUT, CG21_RESHARE_ROUND1_OUT *m);
+
+/** \brief Decode the Key Re-Sharing Round 1 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_RESHARE_ROUND1_OUT(CG21_RESHARE_ROUND1_OUT *m, octet *IN);
+
+/** \brief Encode the Key Re-Sharing Round 1 public data of a player in T1
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_RESHARE_ROUND1_STORE_PUB_T1(octet *OUT, CG21_RESHARE_ROUND1_STORE_PUB_T1 *m);
+
+/** \brief Decode the Key Re-Sharing Round 1 public data of a player in T1
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_RESHARE_ROUND1_STORE_PUB_T1(CG21_RESHARE_ROUND1_STORE_PUB_T1 *m, octet *IN);
+
+/** \brief Encode the Key Re-Sharing Round 1 public data of a player in N2
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_RESHARE_ROUND1_STORE_PUB_N2(octet *OUT, CG21_RESHARE_ROUND1_STORE_PUB_N2 *m);
+
+/** \brief Decode the Key Re-Sharing Round 1 public data of a player in N2
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_RESHARE_ROUND1_STORE_PUB_N2(CG21_RESHARE_ROUND1_STORE_PUB_N2 *m, octet *IN);
+
+/** \brief Encode the Key Re-Sharing Round 3 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_RESHARE_ROUND3_OUTPUT(octet *OUT, CG21_RESHARE_ROUND3_OUTPUT *m);
+
+/** \brief Decode the Key Re-Sharing Round 3 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_RESHARE_ROUND3_OUTPUT(CG21_RESHARE_ROUND3_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Key Re-Sharing Round 4 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_RESHARE_ROUND4_OUTPUT(octet *OUT, CG21_RESHARE_ROUND4_OUTPUT *m);
+
+/** \brief Decode the Key Re-Sharing Round 4 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_RESHARE_ROUND4_OUTPUT(CG21_RESHARE_ROUND4_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Pre-Sign Round 1 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_PRESIGN_ROUND1_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND1_OUTPUT *m);
+
+/** \brief Decode the Pre-Sign Round 1 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_PRESIGN_ROUND1_OUTPUT(CG21_PRESIGN_ROUND1_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Pre-Sign Round 2 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_PRESIGN_ROUND2_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND2_OUTPUT *m);
+
+/** \brief Decode the Pre-Sign Round 2 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(CG21_PRESIGN_ROUND2_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Pre-Sign Round 3 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_PRESIGN_ROUND3_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND3_OUTPUT *m);
+
+/** \brief Decode the Pre-Sign Round 3 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_PRESIGN_ROUND3_OUTPUT(CG21_PRESIGN_ROUND3_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Pre-Sign Round 4 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_PRESIGN_ROUND4_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND4_OUTPUT *m);
+
+/** \brief Decode the Pre-Sign Round 4 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_PRESIGN_ROUND4_OUTPUT(CG21_PRESIGN_ROUND4_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Sign Round 1 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_SIGN_ROUND1_OUTPUT(octet *OUT, CG21_SIGN_ROUND1_OUTPUT *m);
+
+/** \brief Decode the Sign Round 1 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_SIGN_ROUND1_OUTPUT(CG21_SIGN_ROUND1_OUTPUT *m, octet *IN);
+
+/** \brief Encode the Sign Round 2 output
+ *
+ *  @param OUT       Destination octet
+ *  @param m         Message to encode
+ *  @return          CG21_OK or CG21_WIRE_BUFFER_TOO_SMALL
+ */
+extern int CG21_WIRE_ENCODE_SIGN_ROUND2_OUTPUT(octet *OUT, CG21_SIGN_ROUND2_OUTPUT *m);
+
+/** \brief Decode the Sign Round 2 output
+ *
+ *  @param m         Destination message, with octets allocated by the caller
+ *  @param IN        Encoded message
+ *  @return          CG21_OK or an error code
+ */
+extern int CG21_WIRE_DECODE_SIGN_ROUND2_OUTPUT(CG21_SIGN_ROUND2_OUTPUT *m, octet *IN);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file ecp_gen.h
+ * @brief Fixed-base multiplication by the SECP256K1 generator
+ *
+ * The multiples j * 16^i * G are precomputed once, so that s.G
+ * takes one point addition for each 4-bit digit of s and no
+ * doublings. The table lookups are constant time.
+ */
+
+#ifndef ECP_GEN_H
+#define ECP_GEN_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_256_56.h"
+#include "amcl/ecp_SECP256K1.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ECP_GEN_WINDOW 4                    /**< Bits of the scalar consumed by each table lookup */
+#define ECP_GEN_DIGITS (1 << ECP_GEN_WINDOW) /**< Number of multiples for each window */
+#define ECP_GEN_WINDOWS ((8 * MODBYTES_256_56 + ECP_GEN_WINDOW - 1) / ECP_GEN_WINDOW) /**< Number of windows */
+
+/*! \brief Precompute the table of multiples of the generator
+ *
+ * The table is computed on the first call to ECP_GEN_mul, so this
+ * is only needed to move that cost out of the first multiplication.
+ * It is safe to call this concurrently and more than once.
+ */
+extern void ECP_GEN_precompute(void);
+
+/*! \brief Compute P = s.G for the curve generator G
+ *
+ * Equivalent to ECP_SECP256K1_generator(P); ECP_SECP256K1_mul(P, s)
+ *
+ * @param P     Destination point
+ * @param s     Scalar
+ */
+extern void ECP_GEN_mul(ECP_SECP256K1 *P, BIG_256_56 s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file ecp_msm.h
+ * @brief Multi-scalar multiplication over SECP256K1
+ *
+ * Computes e_0.Q_0 + ... + e_{n-1}.Q_{n-1} sharing the doublings
+ * among all the terms. Small batches use Straus' method with a
+ * 4-bit window for each point, large batches use Pippenger's
+ * bucket method.
+ *
+ * The running time depends on the scalars, so this must only be
+ * used with public values, e.g. to verify VSS checks or proofs.
+ */
+
+#ifndef ECP_MSM_H
+#define ECP_MSM_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_256_56.h"
+#include "amcl/ecp_SECP256K1.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ECP_MSM_STRAUS_MAX 16   /**< Largest batch computed with Straus' method */
+
+/*! \brief Compute P = e_0.Q_0 + ... + e_{n-1}.Q_{n-1}
+ *
+ * Not constant time, only use with public scalars
+ *
+ * @param P     Destination point
+ * @param Q     Array of n points
+ * @param e     Array of n scalars
+ * @param n     Number of terms
+ */
+extern void ECP_MSM_mul(ECP_SECP256K1 *P, ECP_SECP256K1 Q[], BIG_256_56 e[], int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/**
+ * @file ff_comb.h
+ * @brief Fixed-base exponentiation modulo a 1024 bit prime
+ *
+ * A comb of B with t teeth holds, for each j < 2^t, the product of
+ * B^(2^(k * FF_COMB_SPACING)) for the bits k set in j. An exponentiation
+ * of B then takes FF_COMB_SPACING squarings and multiplications instead
+ * of one squaring for each bit of the exponent.
+ *
+ * The moduli are the secret factors P, Q of a 2048 bit modulus, so
+ * they fit in a single BIG_1024_58 and the arithmetic is done with
+ * BIG level Montgomery multiplication.
+ */
+
+#ifndef FF_COMB_H
+#define FF_COMB_H
+
+#include "amcl/amcl.h"
+#include "amcl/big_1024_58.h"
+#include "amcl/ff_2048.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FF_COMB_TEETH   6                       /**< Teeth of the comb */
+#define FF_COMB_SIZE    (1 << FF_COMB_TEETH)    /**< Entries of the comb */
+#define FF_COMB_SPACING ((8 * HFS_2048 + FF_COMB_TEETH - 1) / FF_COMB_TEETH) /**< Bits between two teeth of the comb */
+
+/*! \brief Precompute the comb of B modulo p
+ *
+ * The entries are in Montgomery form and must only be used
+ * with the same modulus
+ *
+ * @param T     Destination comb
+ * @param B     Base, an element of size FFLEN_2048
+ * @param p     Prime modulus of size HFLEN_2048
+ */
+extern void FF_COMB_precompute(BIG_1024_58 T[FF_COMB_SIZE], BIG_1024_58 *B, BIG_1024_58 *p);
+
+/*! \brief Compute r = B^e mod p using the comb of B
+ *
+ * Constant time in the exponent
+ *
+ * @param r     Destination, of size HFLEN_2048
+ * @param T     Comb of B modulo p
+ * @param e     Exponent, of size HFLEN_2048
+ * @param p     Prime modulus of size HFLEN_2048
+ */
+extern void FF_COMB_pow(BIG_1024_58 *r, BIG_1024_58 T[FF_COMB_SIZE], BIG_1024_58 *e, BIG_1024_58 *p);
+
+/*! \brief Compute r = B0^e0 * B1^e1 mod p using the combs of B0 and B1
+ *
+ * The squarings are shared between the two bases. Constant time in the exponents
+ *
+ * @param r     Destination, of size HFLEN_2048
+ * @param T0    Comb of B0 modulo p
+ * @param e0    Exponent of B0, of size HFLEN_2048
+ * @param T1    Comb of B1 modulo p
+ * @param e1    Exponent of B1, of size HFLEN_2048
+ * @param p     Prime modulus of size HFLEN_2048
+ */
+extern void FF_COMB_pow2(BIG_1024_58 *r, BIG_1024_58 T0[FF_COMB_SIZE], BIG_1024_58 *e0, BIG_1024_58 T1[FF_COMB_SIZE], BIG_1024_58 *e1, BIG_1024_58 *p);
+
+/*! \brief Compute r = c * x^e mod p for a public exponent
+ *
+ * Not constant time in the exponent, only the bits up to the
+ * most significant one set are processed
+ *
+ * @param r     Destination, of size HFLEN_2048
+ * @param c     Multiplier, of size HFLEN_2048
+ * @param x     Base, of size HFLEN_2048
+ * @param e     Public exponent, of size HFLEN_2048
+ * @param p     Prime modulus of size HFLEN_2048
+ */
+extern void FF_COMB_nt_mul_pow(BIG_1024_58 *r, BIG_1024_58 *c, BIG_1024_58 *x, BIG_1024_58 *e, BIG_1024_58 *p);
+
+/*! \brief Clean the comb
+ *
+ * @param T     The comb to clean
+ */
+extern void FF_COMB_kill(BIG_1024_58 T[FF_COMB_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
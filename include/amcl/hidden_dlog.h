@@ -27,6 +27,7 @@ under the License.
 #define HDLOG
 
 #include "amcl/shamir.h"
+#include "amcl/ff_comb.h"
 #include "amcl/cg21/cg21_utilities.h"
 
 
@@ -41,6 +42,7 @@ extern "C"
 #define HDLOG_PROOF_ITERS       128                         /**< Iterations necessary for the Proof */
 #define HDLOG_CHALLENGE_SIZE HDLOG_PROOF_ITERS / 8    /**< Length of the challenge necessary for the chosen Proof iterations */
 #define HDLOG_VALUES_SIZE HDLOG_PROOF_ITERS * FS_2048 /**< Length of the values encoding */
+#define HDLOG_BATCH_COEFFICIENT_SIZE 8                /**< Length in bytes of the batch verification coefficients */
 
 typedef struct
 {
@@ -60,6 +62,30 @@ typedef struct
 /*! \brief Holds the values for each iteration of the protocol */
 typedef BIG_1024_58 HDLOG_iter_values[HDLOG_PROOF_ITERS][FFLEN_2048];
 
+/*! \brief Fixed-base combs of the commitment base modulo P and Q, see ff_comb.h */
+typedef struct HDLOG_comb
+{
+    BIG_1024_58 tp[FF_COMB_SIZE];   /**< Comb modulo P */
+    BIG_1024_58 tq[FF_COMB_SIZE];   /**< Comb modulo Q */
+} HDLOG_comb;
+
+/*! \brief Precompute the comb of B0 for the commitments
+ *
+ * The comb depends on the secret factors of the modulus and
+ * must be cleaned with HDLOG_comb_kill
+ *
+ * @param C     Destination comb
+ * @param m     Private modulus
+ * @param B0    Base of the DLOG
+ */
+extern void HDLOG_comb_precompute(HDLOG_comb *C, MODULUS_priv *m, BIG_1024_58 *B0);
+
+/*! \brief Clean the comb
+ *
+ * @param C     The comb to clean
+ */
+extern void HDLOG_comb_kill(HDLOG_comb *C);
+
 /*! \brief Generate a commitment for the ZKPs
  *
  * @param RNG   CSPRNG
@@ -71,6 +97,35 @@ typedef BIG_1024_58 HDLOG_iter_values[HDLOG_PROOF_ITERS][FFLEN_2048];
  */
 extern void  HDLOG_commit(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B0, HDLOG_iter_values R, HDLOG_iter_values RHO);
 
+/*! \brief Generate a commitment for the ZKPs using multiple threads
+ *
+ * The iterations are split across threads workers. The random values are
+ * generated serially, so the output is the same as HDLOG_commit
+ *
+ * @param RNG     CSPRNG
+ * @param m       Private modulus (necessary to speed up computations)
+ * @param ord     Order of B0
+ * @param B0      Base of the DLOG
+ * @param R       Random value used in the commitment. If RNG is NULL this is read
+ * @param RHO     Commitment of the ZKP
+ * @param threads Number of worker threads, including the calling one
+ */
+extern void HDLOG_commit_mt(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B0, HDLOG_iter_values R, HDLOG_iter_values RHO, int threads);
+
+/*! \brief Generate a commitment for the ZKPs with a precomputed comb
+ *
+ * Same as HDLOG_commit_mt, but reuses the comb of B0 across calls
+ *
+ * @param RNG     CSPRNG
+ * @param m       Private modulus (necessary to speed up computations)
+ * @param ord     Order of B0
+ * @param C       Comb of B0, see HDLOG_comb_precompute
+ * @param R       Random value used in the commitment. If RNG is NULL this is read
+ * @param RHO     Commitment of the ZKP
+ * @param threads Number of worker threads, including the calling one
+ */
+extern void HDLOG_commit_comb_mt(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, HDLOG_comb *C, HDLOG_iter_values R, HDLOG_iter_values RHO, int threads);
+
 /*! \brief Generate a challenge
  *
  * @param N     Public Modulus
@@ -118,6 +173,48 @@ extern void HDLOG_prove(BIG_1024_58 *ord, BIG_1024_58 *alpha, HDLOG_iter_values
  */
 extern int HDLOG_verify(BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T);
 
+/*! \brief Verify the ZKP using multiple threads
+ *
+ * The iterations are split across threads workers
+ *
+ * @param N       Public Modulus
+ * @param B0      Base of the DLOG
+ * @param B1      Public Value of the DLOG
+ * @param RHO     Commitment of the ZKP
+ * @param E       Challenge of the ZKP
+ * @param T       Proof of the ZKP
+ * @param threads Number of worker threads, including the calling one
+ *
+ * @return        Returns HDLOG_OK if the proof is valid or an error code
+ */
+extern int HDLOG_verify_mt(BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T, int threads);
+
+/*! \brief Verify the ZKP with a random linear combination of the iterations
+ *
+ * The iterations are combined with 64 bit coefficients drawn from the
+ * verifier's RNG and checked with one multi-exponentiation on each side.
+ * The combined check is performed on the squares, so it holds up to
+ * elements of order two of Z/NZ. If the combined check fails, the iterations
+ * are verified one by one to find the invalid one
+ *
+ * The check is weaker than HDLOG_verify when the prover chooses N: an
+ * invalid proof using elements of small odd order d of Z/NZ passes with
+ * probability about 1/d. Only use it when N is known to be well formed,
+ * e.g. after the proofs that N is a product of two large safe primes
+ *
+ * @param RNG   Pointer to a cryptographically secure RNG for the coefficients
+ * @param N     Public Modulus
+ * @param B0    Base of the DLOG
+ * @param B1    Public Value of the DLOG
+ * @param RHO   Commitment of the ZKP
+ * @param E     Challenge of the ZKP
+ * @param T     Proof of the ZKP
+ * @param bad   Index of the first invalid iteration, -1 if the proof is valid. Optional
+ *
+ * @return      Returns HDLOG_OK if the proof is valid or an error code
+ */
+extern int HDLOG_batch_verify(csprng *RNG, BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T, int *bad);
+
 /*! \brief Encode v into an octet
  *
  * @param O      Destination Octet
@@ -93,6 +93,24 @@ extern void SCHNORR_prove(const octet *R, const octet *E, const octet *X, octet
  */
 extern int SCHNORR_verify(const octet *V, const octet *C, const octet *E, const octet *P);
 
+/*! \brief Verify several proofs of knowledge for the DLOG at once
+ *
+ * Check a random linear combination of the n verification equations
+ * with one multi-scalar multiplication. If the combination does not
+ * hold, the proofs are split in halves until the first invalid one is
+ * found. The random weights are sampled from RNG.
+ *
+ * @param RNG   CSPRNG for the weights
+ * @param V     Array of n public ECPs of the DLOGs
+ * @param C     Array of n commitment values received from the provers
+ * @param E     Array of n challenges for the Schnorr Proofs
+ * @param P     Array of n proofs received from the provers
+ * @param n     Number of proofs
+ * @param bad   Index of the first invalid proof on failure. Optional
+ * @return      SCHNORR_OK if all the proofs are valid or an error code
+ */
+extern int SCHNORR_batch_verify(csprng *RNG, const octet *V, const octet *C, const octet *E, const octet *P, int n, int *bad);
+
 /* Double Schnorr's proofs API */
 
 // The double Schnorr Proof allows to prove knowledge of
@@ -39,6 +39,8 @@ extern "C"
 #define VSS_INVALID_SHARES 161 /**< Shares verification failed   */
 #define VSS_INVALID_CHECKS 162 /**< Checks are not valid ECp     */
 
+#define VSS_BATCH_COEFFICIENT_SIZE 16  /**< Size in bytes of the random coefficients for the batch verification */
+
 #define SGS_SECP256K1 MODBYTES_256_56  /**< Shamir Group Size */
 #define SFS_SECP256K1 MODBYTES_256_56  /**< Shamir Field Size */
 
@@ -98,6 +100,30 @@ void VSS_make_shares(int k, int n, csprng *RNG, SSS_shares *shares, octet *C, oc
  */
 int VSS_verify_shares(int k, const octet *X_j, const octet * Y_j, const octet *C);
 
+/** @brief Verify m VSS Shares at once
+ *
+ * The shares are checked with a random linear combination, computed
+ * with a single multi-scalar multiplication. The coefficients are
+ * derived from a hash of all the shares and checks.
+ *
+ * The checks for the i-th share are C + i*stride. Use stride 0 to
+ * verify many shares from the same dealer and stride k to verify
+ * one share from each of many dealers.
+ *
+ * If the batch is not valid, the shares are verified one by one
+ * to find the first invalid one.
+ *
+ * @param k      Threshold
+ * @param m      Number of shares
+ * @param X      X components of the shares to check
+ * @param Y      Y components of the shares to check
+ * @param C      Checks for the shares
+ * @param stride Distance between the checks of consecutive shares
+ * @param bad    Index of the first invalid share, or -1. Optional
+ * @return       VSS_OK or an error code
+ */
+int VSS_batch_verify_shares(int k, int m, const octet *X, const octet *Y, const octet *C, int stride, int *bad);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,100 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/cg21/cg21_fanout.h"
+#include "amcl/cg21/cg21_utilities.h"
+
+typedef struct
+{
+    CG21_FANOUT_JOB job;
+    void *arg;
+    int from;
+    int to;
+    int *rc;            // one return code per peer
+} CG21_FANOUT_RANGE;
+
+static void *CG21_FANOUT_WORKER(void *arg){
+    CG21_FANOUT_RANGE *range = (CG21_FANOUT_RANGE *)arg;
+
+    for (int j=range->from; j<range->to; j++){
+        range->rc[j] = range->job(range->arg, j);
+    }
+
+    return NULL;
+}
+
+int CG21_FANOUT(CG21_FANOUT_JOB job, void *arg, int n, int threads){
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    if (threads < 1){
+        threads = 1;
+    }
+
+    if (threads > n){
+        threads = n;
+    }
+
+    // drop the workers that would be left without peers
+    int step = (n + threads - 1) / threads;
+    threads = (n + step - 1) / step;
+
+    int rc[n];
+    CG21_FANOUT_RANGE ranges[threads];
+    pthread_t tids[threads];
+    int spawned[threads];
+
+    for (int i=0; i<threads; i++){
+        ranges[i].job = job;
+        ranges[i].arg = arg;
+        ranges[i].from = i * step;
+        ranges[i].to = (i + 1) * step;
+        ranges[i].rc = rc;
+
+        if (ranges[i].to > n){
+            ranges[i].to = n;
+        }
+
+        spawned[i] = 0;
+    }
+
+    for (int i=0; i<threads-1; i++){
+        spawned[i] = (pthread_create(&tids[i], NULL, CG21_FANOUT_WORKER, &ranges[i]) == 0);
+    }
+
+    CG21_FANOUT_WORKER(&ranges[threads - 1]);
+
+    for (int i=0; i<threads-1; i++){
+        if (spawned[i]){
+            pthread_join(tids[i], NULL);
+        }
+        else{
+            CG21_FANOUT_WORKER(&ranges[i]);
+        }
+    }
+
+    for (int j=0; j<n; j++){
+        if (rc[j] != CG21_OK){
+            return rc[j];
+        }
+    }
+
+    return CG21_OK;
+}
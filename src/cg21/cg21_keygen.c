@@ -119,9 +119,6 @@ int CG21_KEY_GENERATE_ROUND1(csprng *RNG,
     char v[SHA256];
     octet V = {0, sizeof(v), v};
 
-    // get curve generator
-    ECP_SECP256K1_generator(&G);
-
     // get curve order
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
@@ -142,7 +139,7 @@ int CG21_KEY_GENERATE_ROUND1(csprng *RNG,
     CG21_pack_vss_checks(CC, t, pub->packed_checks);
 
     // compute partial ECDSA PK(G)
-    ECP_SECP256K1_mul(&G, s);
+    ECP_GEN_mul(&G, s);
     BIG_256_56_zero(s);
 
     // convert partial ECDSA PK from ECP to octet
@@ -310,9 +307,6 @@ int CG21_KEY_GENERATE_ROUND3_2_3(const CG21_KEYGEN_ROUND1_STORE_PRIV *myPriv,
     // Curve order
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
-    // Curve generator
-    ECP_SECP256K1_generator(&G);
-
     char y[myPriv->n-1][EGS_SECP256K1];
     octet Y[myPriv->n-1];
     init_octets((char *)y,   Y,   EGS_SECP256K1, myPriv->n-1);
@@ -340,7 +334,7 @@ int CG21_KEY_GENERATE_ROUND3_2_3(const CG21_KEYGEN_ROUND1_STORE_PRIV *myPriv,
     OCT_copy(r3->xi.X,myPriv->shares.X + t);
 
     // computes (sum-of-the-shares)*G
-    ECP_SECP256K1_mul(&G, accum);
+    ECP_GEN_mul(&G, accum);
 
     // convert (sum-of-the-shares)*G to octet
     ECP_SECP256K1_toOctet(&X, &G, true);
@@ -389,6 +383,51 @@ int CG21_KEY_GENERATE_OUTPUT_1_1(const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
 }
 
 
+int CG21_KEY_GENERATE_OUTPUT_1_1_BATCH(csprng *RNG,
+                                       const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
+                                       const CG21_KEYGEN_ROUND1_STORE_PUB *r3,
+                                       const CG21_KEYGEN_SID *sid,
+                                       const CG21_KEYGEN_ROUND3_STORE *r3Store,
+                                       int n, int *bad){
+
+    char e[n > 0 ? n : 1][SGS_SECP256K1];
+    octet E[n > 0 ? n : 1];
+    octet V[n > 0 ? n : 1];
+    octet C[n > 0 ? n : 1];
+    octet P[n > 0 ? n : 1];
+
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    init_octets((char *)e, E, SGS_SECP256K1, n);
+
+    for (int k=0; k<n; k++){
+        if (!OCT_comp(r3Out[k].ui_proof.A, r3[k].A)){
+            if (bad != NULL){
+                *bad = k;
+            }
+            return CG21_A_DOES_NOT_MATCH;
+        }
+
+        // generate challenge e
+        CG21_GENERATE_CHALLENGE((r3[k].X),r3[k].i,*r3Store->xor_rid, sid, E + k, r3[k].A);
+
+        V[k] = *r3[k].X;
+        C[k] = *r3[k].A;
+        P[k] = *r3Out[k].ui_proof.psi;
+    }
+
+    // verify all the Schnorr proofs for partial secrets at once
+    int rc = SCHNORR_batch_verify(RNG, V, C, E, P, n, bad);
+    if (rc)
+    {
+        return CG21_SCHNORR_VERIFY_FAILED;
+    }
+
+    return CG21_OK;
+}
+
 int CG21_KEY_GENERATE_OUTPUT_1_2(CG21_KEYGEN_OUTPUT *output,
                                  const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
                                  CG21_KEYGEN_ROUND3_STORE *r3Store,
@@ -396,6 +435,17 @@ int CG21_KEY_GENERATE_OUTPUT_1_2(CG21_KEYGEN_OUTPUT *output,
                                  const CG21_KEYGEN_SID *sid,
                                  const CG21_KEYGEN_ROUND1_STORE_PUB *r1Pub){
 
+    return CG21_KEY_GENERATE_OUTPUT_1_2_CACHED(output, r3Out, r3Store, myPriv, sid, r1Pub, NULL);
+}
+
+int CG21_KEY_GENERATE_OUTPUT_1_2_CACHED(CG21_KEYGEN_OUTPUT *output,
+                                        const CG21_KEYGEN_ROUND3_OUTPUT *r3Out,
+                                        CG21_KEYGEN_ROUND3_STORE *r3Store,
+                                        CG21_KEYGEN_ROUND1_STORE_PRIV *myPriv,
+                                        const CG21_KEYGEN_SID *sid,
+                                        const CG21_KEYGEN_ROUND1_STORE_PUB *r1Pub,
+                                        CG21_POINT_CACHE *cache){
+
     ECP_SECP256K1 V;
     ECP_SECP256K1 Xi;
     BIG_256_56 T;
@@ -428,14 +478,14 @@ int CG21_KEY_GENERATE_OUTPUT_1_2(CG21_KEYGEN_OUTPUT *output,
 
     // initialize Xi with (myPriv->shares.Y + ind)*G
     BIG_256_56_fromBytesLen(T, (myPriv->shares.Y + ind)->val, (myPriv->shares.Y + ind)->len);
-    ECP_SECP256K1_generator(&Xi);
-    ECP_SECP256K1_mul(&Xi, T);
+    ECP_GEN_mul(&Xi, T);
 
     for (int j=0; j<n-1; j++) {
         // this functions calculates g^{x_i}, same x_i used in GG20 section 3.1 (phase 2), based on the VSS checks
         // CC+j*t refers to the beginning of each parties' octet and +t means we don't want to include the first checks
         // that belongs to the verifier in calculation of XI
-        CG21_CALC_XI(t, myPriv->shares.X + ind, CC + j * t, &V);
+        // the checks of party j are the same for every proof verified in this session
+        CG21_CALC_XI_CACHED(t, myPriv->shares.X + ind, CC + j * t, cache, j, &V);
         ECP_SECP256K1_add(&Xi, &V);
     }
     ECP_SECP256K1_toOctet(&Xi_, &Xi, true);
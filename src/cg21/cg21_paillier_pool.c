@@ -0,0 +1,343 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/cg21/cg21_paillier_pool.h"
+
+static void CG21_PAILLIER_POOL_ENTRY_KILL(CG21_PAILLIER_POOL_ENTRY *entry){
+    octet R = {0, sizeof(entry->r), entry->r};
+    octet RN = {0, sizeof(entry->rn), entry->rn};
+
+    OCT_clear(&R);
+    OCT_clear(&RN);
+}
+
+/* Sample r in Z^*_N. Must be called with the lock held, since the RNG is shared */
+static void CG21_PAILLIER_POOL_SAMPLE_LOCKED(CG21_PAILLIER_POOL *pool, BIG_512_60 *r){
+    FF_4096_zero(r, FFLEN_4096);
+    FF_4096_randomnum(r, pool->pub.n, &pool->RNG, HFLEN_4096);
+}
+
+/* rn = r^N mod N^2, split modulo P^2 and Q^2 when the factors are known */
+static void CG21_PAILLIER_POOL_POW(CG21_PAILLIER_POOL *pool, BIG_512_60 *rn, BIG_512_60 *r){
+    BIG_1024_58 x[2 * FFLEN_2048];
+    BIG_1024_58 xp[FFLEN_2048];
+    BIG_1024_58 xq[FFLEN_2048];
+    BIG_1024_58 n2[2 * FFLEN_2048];
+
+    char oct[FS_4096];
+    octet OCT = {0, sizeof(oct), oct};
+
+    if (!pool->crt){
+        FF_4096_ct_pow(rn, r, pool->pub.n, pool->pub.n2, FFLEN_4096, HFLEN_4096);
+        return;
+    }
+
+    // r < N, so it fits in a 2048 bit number
+    FF_4096_toOctet(&OCT, r, HFLEN_4096);
+    FF_2048_fromOctet(x, &OCT, FFLEN_2048);
+
+    FF_2048_ct_pow(xp, x, pool->n, pool->p2, FFLEN_2048, FFLEN_2048);
+    FF_2048_ct_pow(xq, x, pool->n, pool->q2, FFLEN_2048, FFLEN_2048);
+
+    FF_2048_sqr(n2, pool->n, FFLEN_2048);
+    FF_2048_norm(n2, 2 * FFLEN_2048);
+
+    // Combine results and convert to FF_4096
+    FF_2048_crt(x, xp, xq, pool->p2, pool->invp2q2, n2, FFLEN_2048);
+
+    FF_2048_toOctet(&OCT, x, 2 * FFLEN_2048);
+    FF_4096_fromOctet(rn, &OCT, FFLEN_4096);
+
+    // clean up
+    OCT_clear(&OCT);
+    FF_2048_zero(x, 2 * FFLEN_2048);
+    FF_2048_zero(xp, FFLEN_2048);
+    FF_2048_zero(xq, FFLEN_2048);
+    FF_2048_zero(n2, 2 * FFLEN_2048);
+}
+
+/* Store a randomizer. Must be called with the lock held and a free entry */
+static void CG21_PAILLIER_POOL_PUT_LOCKED(CG21_PAILLIER_POOL *pool, BIG_512_60 *r, BIG_512_60 *rn){
+    CG21_PAILLIER_POOL_ENTRY *entry = pool->entries + ((pool->head + pool->count) % pool->capacity);
+
+    octet R = {0, sizeof(entry->r), entry->r};
+    octet RN = {0, sizeof(entry->rn), entry->rn};
+
+    FF_4096_toOctet(&R, r, FFLEN_4096);
+    FF_4096_toOctet(&RN, rn, FFLEN_4096);
+
+    pool->count++;
+}
+
+/* Compute one randomizer and store it. Called with the lock held,
+ * which is released during the exponentiation
+ */
+static int CG21_PAILLIER_POOL_ADD_LOCKED(CG21_PAILLIER_POOL *pool){
+    int added = 0;
+
+    BIG_512_60 r[FFLEN_4096];
+    BIG_512_60 rn[FFLEN_4096];
+
+    CG21_PAILLIER_POOL_SAMPLE_LOCKED(pool, r);
+
+    pthread_mutex_unlock(&pool->lock);
+    CG21_PAILLIER_POOL_POW(pool, rn, r);
+    pthread_mutex_lock(&pool->lock);
+
+    // the pool may have been filled by another thread in the meantime
+    if (pool->count < pool->capacity){
+        CG21_PAILLIER_POOL_PUT_LOCKED(pool, r, rn);
+        added = 1;
+    }
+
+    FF_4096_zero(r, FFLEN_4096);
+    FF_4096_zero(rn, FFLEN_4096);
+
+    return added;
+}
+
+int CG21_PAILLIER_POOL_INIT(CG21_PAILLIER_POOL *pool, CG21_PAILLIER_POOL_ENTRY *entries, int capacity,
+                            csprng *RNG, PAILLIER_public_key *pub, PAILLIER_private_key *priv){
+    char seed[32];
+
+    if (entries == NULL || capacity < 1){
+        return CG21_PAILLIER_POOL_INVALID;
+    }
+
+    pool->entries = entries;
+    pool->capacity = capacity;
+    pool->head = 0;
+    pool->count = 0;
+
+    for (int j=0; j<capacity; j++){
+        CG21_PAILLIER_POOL_ENTRY_KILL(entries + j);
+    }
+
+    FF_4096_copy(pool->pub.n, pub->n, FFLEN_4096);
+    FF_4096_copy(pool->pub.g, pub->g, FFLEN_4096);
+    FF_4096_copy(pool->pub.n2, pub->n2, FFLEN_4096);
+
+    pool->crt = (priv != NULL);
+    if (pool->crt){
+        FF_2048_copy(pool->p2, priv->p2, FFLEN_2048);
+        FF_2048_copy(pool->q2, priv->q2, FFLEN_2048);
+        FF_2048_invmodp(pool->invp2q2, priv->p2, priv->q2, FFLEN_2048);
+        FF_2048_mul(pool->n, priv->p, priv->q, HFLEN_2048);
+    }
+    else{
+        FF_2048_zero(pool->p2, FFLEN_2048);
+        FF_2048_zero(pool->q2, FFLEN_2048);
+        FF_2048_zero(pool->invp2q2, FFLEN_2048);
+        FF_2048_zero(pool->n, FFLEN_2048);
+    }
+
+    // the pool has its own RNG, so it can be used from the background thread
+    for (int j=0; j<32; j++){
+        seed[j] = (char) RAND_byte(RNG);
+    }
+    RAND_seed(&pool->RNG, 32, seed);
+
+    for (int j=0; j<32; j++){
+        seed[j] = 0;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    pool->low = 0;
+    pool->running = 0;
+
+    return CG21_OK;
+}
+
+void CG21_PAILLIER_POOL_KILL(CG21_PAILLIER_POOL *pool){
+    CG21_PAILLIER_POOL_STOP(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    for (int j=0; j<pool->capacity; j++){
+        CG21_PAILLIER_POOL_ENTRY_KILL(pool->entries + j);
+    }
+
+    pool->head = 0;
+    pool->count = 0;
+
+    FF_2048_zero(pool->p2, FFLEN_2048);
+    FF_2048_zero(pool->q2, FFLEN_2048);
+    FF_2048_zero(pool->invp2q2, FFLEN_2048);
+    FF_2048_zero(pool->n, FFLEN_2048);
+    pool->crt = 0;
+
+    RAND_clean(&pool->RNG);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+int CG21_PAILLIER_POOL_FILL(CG21_PAILLIER_POOL *pool, int count){
+    int added = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (added < count && pool->count < pool->capacity){
+        added += CG21_PAILLIER_POOL_ADD_LOCKED(pool);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return added;
+}
+
+int CG21_PAILLIER_POOL_SIZE(CG21_PAILLIER_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+    int count = pool->count;
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+}
+
+static void *CG21_PAILLIER_POOL_PRODUCER(void *arg){
+    CG21_PAILLIER_POOL *pool = (CG21_PAILLIER_POOL *)arg;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->running){
+
+        // wait until the pool runs low
+        if (pool->count >= pool->low){
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+
+        // then refill it
+        while (pool->running && pool->count < pool->capacity){
+            CG21_PAILLIER_POOL_ADD_LOCKED(pool);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int CG21_PAILLIER_POOL_START(CG21_PAILLIER_POOL *pool, int low){
+    if (low < 1 || low > pool->capacity){
+        return CG21_PAILLIER_POOL_INVALID;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->running){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PAILLIER_POOL_RUNNING;
+    }
+
+    pool->low = low;
+    pool->running = 1;
+
+    if (pthread_create(&pool->producer, NULL, CG21_PAILLIER_POOL_PRODUCER, pool) != 0){
+        pool->running = 0;
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PAILLIER_POOL_INVALID;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return CG21_OK;
+}
+
+void CG21_PAILLIER_POOL_STOP(CG21_PAILLIER_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+
+    if (!pool->running){
+        pthread_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    pool->running = 0;
+    pthread_cond_broadcast(&pool->cond);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_join(pool->producer, NULL);
+}
+
+int CG21_PAILLIER_POOL_ENCRYPT(CG21_PAILLIER_POOL *pool, PAILLIER_public_key *pub, octet *PT, octet *CT, octet *R){
+    BIG_512_60 pt[HFLEN_4096];
+    BIG_512_60 r[FFLEN_4096];
+    BIG_512_60 rn[FFLEN_4096];
+    BIG_512_60 ct[FFLEN_4096];
+    BIG_512_60 dws[2 * FFLEN_4096];
+
+    if (FF_4096_comp(pool->pub.n, pub->n, FFLEN_4096) != 0){
+        return CG21_PAILLIER_POOL_WRONG_KEY;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->count > 0){
+        CG21_PAILLIER_POOL_ENTRY *entry = pool->entries + pool->head;
+
+        octet RO = {sizeof(entry->r), sizeof(entry->r), entry->r};
+        octet RNO = {sizeof(entry->rn), sizeof(entry->rn), entry->rn};
+
+        FF_4096_fromOctet(r, &RO, FFLEN_4096);
+        FF_4096_fromOctet(rn, &RNO, FFLEN_4096);
+
+        // the randomizer is handed out only once
+        CG21_PAILLIER_POOL_ENTRY_KILL(entry);
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+
+        pthread_cond_signal(&pool->cond);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    else{
+        CG21_PAILLIER_POOL_SAMPLE_LOCKED(pool, r);
+        pthread_mutex_unlock(&pool->lock);
+
+        CG21_PAILLIER_POOL_POW(pool, rn, r);
+    }
+
+    // CT = (1 + m*N) * r^N mod N^2
+    FF_4096_fromOctet(pt, PT, HFLEN_4096);
+
+    FF_4096_mul(ct, pt, pool->pub.n, HFLEN_4096);
+    FF_4096_inc(ct, 1, FFLEN_4096);
+    FF_4096_norm(ct, FFLEN_4096);
+
+    FF_4096_mul(dws, ct, rn, FFLEN_4096);
+    FF_4096_dmod(ct, dws, pool->pub.n2, FFLEN_4096);
+
+    FF_4096_toOctet(CT, ct, FFLEN_4096);
+
+    if (R != NULL){
+        FF_4096_toOctet(R, r, FFLEN_4096);
+    }
+
+    // clean up
+    FF_4096_zero(pt, HFLEN_4096);
+    FF_4096_zero(r, FFLEN_4096);
+    FF_4096_zero(rn, FFLEN_4096);
+    FF_4096_zero(dws, 2 * FFLEN_4096);
+
+    return CG21_OK;
+}
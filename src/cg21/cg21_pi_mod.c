@@ -18,21 +18,23 @@ under the License.
 */
 
 #include "amcl/cg21/cg21_pi_mod.h"
+#include "amcl/cg21/cg21_fanout.h"
 #include <amcl/big_256_56.h>
 #include <amcl/paillier.h>
 #include "amcl/hash_utils.h"
 #include "amcl/ff_4096.h"
 #include "amcl/ff_2048.h"
 
-static void CG21_PI_MOD_GET_W(csprng *RNG, BIG_512_60 n[HFLEN_4096], BIG_512_60 ws1[HFLEN_4096]){
-    while(1){
-        FF_4096_randomnum(ws1, n, RNG,HFLEN_4096);
-        int rc = FF_4096_jacobi(ws1,n);
-        if (rc==-1) {
-            break;
-        }
-    }
-}
+// Window and table size for CT exponentiations
+// using 2^w ary method
+#define C_WINDOW 4
+#define C_SIZE (1 << C_WINDOW)
+
+// Window, table size and number of bases per multi-exponentiation
+// for the small batching coefficients
+#define B_WINDOW 4
+#define B_SIZE (1 << (B_WINDOW - 1))
+#define B_BASES 16
 
 /**	@brief Generate m number of challenges, y_i
 *
@@ -86,183 +88,224 @@ static int CG21_PI_MOD_CHALLENGE(BIG_1024_58 *N, octet w, const CG21_SSID *ssid,
     return CG21_OK;
 }
 
-static void CG21_PI_MOD_GEN_Xi(CG21_PIMOD_PROOF *pimodProof, CG21_PAILLIER_KEYS paillierKeys){
-    bool ab_[4][2]={{0,0},{0,1},{1,0},{1,1}};
-    BIG_512_60 yi_[HFLEN_4096];
-    BIG_512_60 yMULw[FFLEN_4096];
-    BIG_512_60 n_[FFLEN_4096];
-    BIG_1024_58 r1[FFLEN_2048];
-    BIG_1024_58 r2[FFLEN_2048];
-    BIG_1024_58 r11[FFLEN_2048];
-    BIG_1024_58 r22[FFLEN_2048];
-    BIG_1024_58 yi_2048[FFLEN_2048];
-    BIG_1024_58 n_2048[FFLEN_2048];
+/* r = x^e mod m, using the 2^w-ary method with the precomputed
+ * Montgomery constant ND of m
+ */
+static void CG21_PI_MOD_POW(BIG_1024_58 *r, BIG_1024_58 *x, BIG_1024_58 *e, BIG_1024_58 *m, BIG_1024_58 *ND){
+    BIG_1024_58 *X[] = {x};
+    BIG_1024_58 *E[] = {e};
 
-    char oct[2*FS_2048];
-    octet OCT = {0, sizeof(oct), oct};
+    BIG_1024_58 T_mem[C_SIZE][HFLEN_2048];
+    BIG_1024_58 *T[C_SIZE];
 
-    FF_4096_zero(n_,FFLEN_4096);
-    FF_4096_copy(n_,paillierKeys.paillier_pk.n,HFLEN_4096);
+    for (int i=0; i<C_SIZE;i++){
+        T[i] = T_mem[i];
+    }
 
-    // convert paillier_pk.n from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
-    FF_4096_toOctet(&OCT, paillierKeys.paillier_pk.n, HFLEN_4096);
-    FF_2048_fromOctet(n_2048, &OCT, FFLEN_2048);
+    FF_2048_2w_precompute(X, T, 1, C_WINDOW, m, ND, HFLEN_2048);
+    FF_2048_ct_2w_pow(r, T, E, 1, C_WINDOW, m, ND, HFLEN_2048, HFLEN_2048);
 
-    // for each yi[i] we need to choose (ai,bi) from ab_ such that y'i has 4th root
-    for (int i=0;i<CG21_PAILLIER_PROOF_ITERS;i++){
+    // clean up
+    for (int i=0; i<C_SIZE;i++){
+        FF_2048_zero(T_mem[i], HFLEN_2048);
+    }
+}
 
-        // convert yi from BIG_1024_58[FFLEN_2048] to y_oct
-        char oct2[2 * FS_2048];
-        octet y_oct = {0, sizeof(oct2), oct2};
-        FF_2048_toOctet(&y_oct, pimodProof->yi[i], FFLEN_2048);
+/* Legendre symbol (x/p) using the Euler criterion x^{(p-1)/2} mod p.
+ * It returns 1, -1 or 0 if x is zero mod p
+ */
+static int CG21_PI_MOD_LEGENDRE(BIG_1024_58 *x, BIG_1024_58 *p, BIG_1024_58 *e, BIG_1024_58 *ND){
+    BIG_1024_58 ws[HFLEN_2048];
 
-        for (int j=0;j<4;j++){
+    CG21_PI_MOD_POW(ws, x, e, p, ND);
 
-            // convert y_oct to BIG_512_60[HFLEN_4096]
-            FF_4096_zero(yi_, HFLEN_4096);
-            FF_4096_fromOctet(yi_, &y_oct, HFLEN_4096);
+    if (FF_2048_isunity(ws, HFLEN_2048)){
+        return 1;
+    }
 
-            // if ai=1 -> (-1)^{ai} becomes -1 -> we compute -yi mod N = N - yi
-            // note: if ai=0 -> (-1)^{ai} becomes 0 -> we don't need to do anything
-            if (ab_[j][0]) {
-                FF_4096_sub(yi_, paillierKeys.paillier_pk.n, yi_, HFLEN_4096);
-                FF_4096_norm(yi_, HFLEN_4096);
-            }
+    FF_2048_inc(ws, 1, HFLEN_2048);
+    FF_2048_norm(ws, HFLEN_2048);
 
-            // if bi=1 -> we compute yi = w * yi
-            if (ab_[j][1]) {
-                FF_4096_zero(yMULw, FFLEN_4096);
-                FF_4096_mul(yMULw, yi_, pimodProof->w, HFLEN_4096);
-                FF_4096_mod(yMULw, n_, FFLEN_4096);
-                FF_4096_copy(yi_, yMULw, HFLEN_4096);
-            }
+    if (FF_2048_comp(ws, p, HFLEN_2048) == 0){
+        return -1;
+    }
 
-            // convert yi_ from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
-            FF_4096_toOctet(&OCT, yi_, HFLEN_4096);
-            FF_2048_fromOctet(yi_2048, &OCT, FFLEN_2048);
+    return 0;
+}
 
-            // check whether yi_2048 has any square root in mod p and q
-            bool rc1 = CG21_check_sqrt_exist(yi_2048, paillierKeys.paillier_sk.p);
-            bool rc2 = CG21_check_sqrt_exist(yi_2048, paillierKeys.paillier_sk.q);
+/* Precompute, for P (and Q)
+ *
+ *   e = (P-1)/2                    Euler criterion
+ *   f = ((P+1)/4)^2 mod P-1        4th root of a QR, since P = 3 mod 4
+ *   m = Q^(-1) mod P-1             N-th root, since N = Q mod P-1
+ */
+static int CG21_PI_MOD_PROVER_PRIME(BIG_1024_58 *p, BIG_1024_58 *q, BIG_1024_58 *ND, BIG_1024_58 *e,
+                                    BIG_1024_58 *f, BIG_1024_58 *m){
+    BIG_1024_58 ws[HFLEN_2048];
+    BIG_1024_58 dws[FFLEN_2048];
+
+    // P should be a Blum prime
+    if (FF_2048_lastbits(p, 2) != 3){
+        return CG21_PAILLIER_NOT_BLUM;
+    }
 
-            if (rc1 && rc2){
+    FF_2048_invmod2m(ND, p, HFLEN_2048);
 
-                // 4th root of yi_2048 mod p
-                CG21_sqrt(r1,yi_2048,paillierKeys.paillier_sk.p);
-                CG21_sqrt(r11,r1,paillierKeys.paillier_sk.p);
+    // Since P is odd P>>1 = (P-1)/2
+    FF_2048_copy(e, p, HFLEN_2048);
+    FF_2048_shr(e, HFLEN_2048);
 
-                // 4th root of yi_2048 mod q
-                CG21_sqrt(r2,yi_2048,paillierKeys.paillier_sk.q);
-                CG21_sqrt(r22,r2,paillierKeys.paillier_sk.q);
+    // Compute inverse mod (P-1)/2
+    FF_2048_invmodp(m, q, e, HFLEN_2048);
 
-                // combine r11 and r22 using CRT to get the final result xi
-                FF_2048_crt(pimodProof->xi[i], r11, r22, paillierKeys.paillier_sk.p, paillierKeys.paillier_sk.invpq, n_2048, HFLEN_2048);
+    // Apply correction to obtain inverse mod P-1
+    if (!FF_2048_parity(m))
+    {
+        FF_2048_add(m, e, m, HFLEN_2048);
+        FF_2048_norm(m, HFLEN_2048);
+    }
 
-                // stores ai and bi values, verifier needs these values
-                pimodProof->ab[i][0] = ab_[j][0];
-                pimodProof->ab[i][1] = ab_[j][1];
+    // Since P = 3 mod 4, (P+1)/4 = (P>>2) + 1
+    FF_2048_copy(ws, e, HFLEN_2048);
+    FF_2048_shr(ws, HFLEN_2048);
+    FF_2048_inc(ws, 1, HFLEN_2048);
+    FF_2048_norm(ws, HFLEN_2048);
 
-                // don't need to check the other combinations of ai and bi
-                break;
-            }
-        }
-    }
+    FF_2048_sqr(dws, ws, HFLEN_2048);
+    FF_2048_copy(ws, p, HFLEN_2048);
+    FF_2048_dec(ws, 1, HFLEN_2048);
+    FF_2048_norm(ws, HFLEN_2048);
+    FF_2048_dmod(f, dws, ws, HFLEN_2048);
 
     // clean up
-    FF_4096_zero(yi_, HFLEN_4096);
-    FF_4096_zero(yMULw, FFLEN_4096);
-    FF_4096_zero(n_, FFLEN_4096);
-
-    FF_2048_zero(r1, FFLEN_2048);
-    FF_2048_zero(r2, HFLEN_2048);
-    FF_2048_zero(r11, FFLEN_2048);
-    FF_2048_zero(r22, HFLEN_2048);
-    FF_2048_zero(yi_2048, FFLEN_2048);
-    FF_2048_zero(n_2048, FFLEN_2048);
-
-    OCT_clear(&OCT);
-}
+    FF_2048_zero(ws, HFLEN_2048);
+    FF_2048_zero(dws, FFLEN_2048);
 
-static void CG21_PI_MOD_GEN_Zi(CG21_PIMOD_PROOF *pimodProof, CG21_PAILLIER_KEYS paillierKeys){
-
-    BIG_1024_58 Mp[HFLEN_2048];
-    BIG_1024_58 Mq[HFLEN_2048];
-    BIG_1024_58 Xp[HFLEN_2048];
-    BIG_1024_58 Xq[HFLEN_2048];
-    BIG_1024_58 ws[FFLEN_2048];
-    BIG_1024_58 n_2048[FFLEN_2048];
+    return CG21_OK;
+}
 
+int CG21_PI_MOD_PROVER_SETUP(CG21_PIMOD_PROVER *prover, CG21_PAILLIER_KEYS *paillierKeys){
     char oct[2*FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
-    /* Compute Mp, Mq s.t.
-     *
-     *   T ← PQ^(-1) mod (P-1)(Q-1)
-     *   zi ← yi^T mod PQ, for i ∈ [1 ... m]
-     *
-     * i.e.
-     *   Mp = Q^(-1) mod P-1
-     *   Mq = P^(-1) mod Q-1
-     */
-
-    // Compute Mp
+    // convert paillier_pk.n from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
+    FF_4096_toOctet(&OCT, paillierKeys->paillier_pk.n, HFLEN_4096);
+    FF_2048_fromOctet(prover->n, &OCT, FFLEN_2048);
 
-    // Since P is odd P>>1 = (P-1)/2
-    FF_2048_copy(ws, paillierKeys.paillier_sk.p, HFLEN_2048);
-    FF_2048_shr(ws, HFLEN_2048);
+    FF_2048_copy(prover->p, paillierKeys->paillier_sk.p, HFLEN_2048);
+    FF_2048_copy(prover->q, paillierKeys->paillier_sk.q, HFLEN_2048);
+    FF_2048_copy(prover->invpq, paillierKeys->paillier_sk.invpq, HFLEN_2048);
 
-    // Compute inverse mod (P-1)/2
-    FF_2048_invmodp(Mp, paillierKeys.paillier_sk.q, ws, HFLEN_2048);
+    int rc = CG21_PI_MOD_PROVER_PRIME(prover->p, prover->q, prover->ndp, prover->ep, prover->fp, prover->mp);
+    if (rc == CG21_OK){
+        rc = CG21_PI_MOD_PROVER_PRIME(prover->q, prover->p, prover->ndq, prover->eq, prover->fq, prover->mq);
+    }
 
-    // Apply correction to obtain inverse mod P-1
-    if (!FF_2048_parity(Mp))
-    {
-        FF_2048_add(Mp, ws, Mp, HFLEN_2048);
-        FF_2048_norm(Mp, HFLEN_2048);
+    if (rc != CG21_OK){
+        CG21_PI_MOD_PROVER_KILL(prover);
     }
 
-    // Compute Mq
+    return rc;
+}
+
+void CG21_PI_MOD_PROVER_KILL(CG21_PIMOD_PROVER *prover){
+    FF_2048_zero(prover->n, FFLEN_2048);
+    FF_2048_zero(prover->p, HFLEN_2048);
+    FF_2048_zero(prover->q, HFLEN_2048);
+    FF_2048_zero(prover->invpq, HFLEN_2048);
+    FF_2048_zero(prover->ndp, HFLEN_2048);
+    FF_2048_zero(prover->ndq, HFLEN_2048);
+    FF_2048_zero(prover->ep, HFLEN_2048);
+    FF_2048_zero(prover->eq, HFLEN_2048);
+    FF_2048_zero(prover->fp, HFLEN_2048);
+    FF_2048_zero(prover->fq, HFLEN_2048);
+    FF_2048_zero(prover->mp, HFLEN_2048);
+    FF_2048_zero(prover->mq, HFLEN_2048);
+}
 
-    // Since Q is odd Q>>1 = (Q-1)/2
-    FF_2048_copy(ws, paillierKeys.paillier_sk.q, HFLEN_2048);
-    FF_2048_shr(ws, HFLEN_2048);
+/* Choose random w ← ZN of Jacobi symbol −1, i.e. a QR modulo exactly one of P and Q.
+ * Returns the Legendre symbol (w/P)
+ */
+static int CG21_PI_MOD_GET_W(csprng *RNG, CG21_PIMOD_PROVER *prover, BIG_1024_58 *w){
+    BIG_1024_58 wp[HFLEN_2048];
+    BIG_1024_58 wq[HFLEN_2048];
 
-    // Compute inverse mod (Q-1)/2
-    FF_2048_invmodp(Mq, paillierKeys.paillier_sk.p, ws, HFLEN_2048);
+    while(1){
+        FF_2048_randomnum(w, prover->n, RNG, FFLEN_2048);
 
-    // Apply correction to obtain inverse mod Q-1
-    if (!FF_2048_parity(Mq))
-    {
-        FF_2048_add(Mq, ws, Mq, HFLEN_2048);
-        FF_2048_norm(Mq, HFLEN_2048);
+        FF_2048_dmod(wp, w, prover->p, HFLEN_2048);
+        FF_2048_dmod(wq, w, prover->q, HFLEN_2048);
+
+        int lp = CG21_PI_MOD_LEGENDRE(wp, prover->p, prover->ep, prover->ndp);
+        int lq = CG21_PI_MOD_LEGENDRE(wq, prover->q, prover->eq, prover->ndq);
+
+        if (lp * lq == -1) {
+            return lp;
+        }
     }
+}
 
-    // convert paillier_pk.n from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
-    FF_4096_toOctet(&OCT, paillierKeys.paillier_pk.n, HFLEN_4096);
-    FF_2048_fromOctet(n_2048, &OCT, FFLEN_2048);
+/* Generate (ai,bi,xi) and zi for every challenge yi.
+ *
+ * Since P and Q are Blum primes -1 is a QNR modulo both, and w is a QNR modulo
+ * exactly one of them. The Legendre symbols of yi then fix the only (ai,bi)
+ * such that y'i = (-1)^ai * w^bi * yi is a QR modulo P and Q, and
+ * xi = y'i^f is a 4th root of y'i.
+ */
+static void CG21_PI_MOD_GEN_XZi(CG21_PIMOD_PROOF *pimodProof, CG21_PIMOD_PROVER *prover,
+                                BIG_1024_58 *w, int wp){
+    BIG_1024_58 yi_[FFLEN_2048];
+    BIG_1024_58 yMULw[2 * FFLEN_2048];
+    BIG_1024_58 Xp[HFLEN_2048];
+    BIG_1024_58 Xq[HFLEN_2048];
 
-    for (int i=0; i<CG21_PAILLIER_PROOF_ITERS;i++){
+    for (int i=0;i<CG21_PAILLIER_PROOF_ITERS;i++){
+
+        // Xp = yi % p, Xq = yi % q
+        FF_2048_dmod(Xp, pimodProof->yi[i], prover->p, HFLEN_2048);
+        FF_2048_dmod(Xq, pimodProof->yi[i], prover->q, HFLEN_2048);
 
-        // Xp = yi % p
-        FF_2048_dmod(Xp, pimodProof->yi[i], paillierKeys.paillier_sk.p, HFLEN_2048);
+        bool np = CG21_PI_MOD_LEGENDRE(Xp, prover->p, prover->ep, prover->ndp) != 1;
+        bool nq = CG21_PI_MOD_LEGENDRE(Xq, prover->q, prover->eq, prover->ndq) != 1;
 
-        // Xq = yi % q
-        FF_2048_dmod(Xq, pimodProof->yi[i], paillierKeys.paillier_sk.q, HFLEN_2048);
+        // bi flips exactly one of the two symbols, ai flips both
+        bool b = np ^ nq;
+        bool a = np ^ (b && wp == -1);
 
-        // Compute zi^M using Mp, Mq and CRT
-        FF_2048_ct_pow(Xp, Xp, Mp, paillierKeys.paillier_sk.p, HFLEN_2048, HFLEN_2048);
-        FF_2048_ct_pow(Xq, Xq, Mq, paillierKeys.paillier_sk.q, HFLEN_2048, HFLEN_2048);
+        pimodProof->ab[i][0] = a;
+        pimodProof->ab[i][1] = b;
+
+        // zi ← yi^{N^(-1) mod phi(N)} mod PQ
+        CG21_PI_MOD_POW(Xp, Xp, prover->mp, prover->p, prover->ndp);
+        CG21_PI_MOD_POW(Xq, Xq, prover->mq, prover->q, prover->ndq);
+        FF_2048_crt(pimodProof->zi[i], Xp, Xq, prover->p, prover->invpq, prover->n, HFLEN_2048);
+
+        // if ai=1 -> we compute -yi mod N = N - yi
+        FF_2048_copy(yi_, pimodProof->yi[i], FFLEN_2048);
+        if (a) {
+            FF_2048_sub(yi_, prover->n, yi_, FFLEN_2048);
+            FF_2048_norm(yi_, FFLEN_2048);
+        }
 
-        // zi ← yi^T mod PQ, for i ∈ [1 ... m]
-        FF_2048_crt(pimodProof->zi[i], Xp, Xq, paillierKeys.paillier_sk.p, paillierKeys.paillier_sk.invpq, n_2048, HFLEN_2048);
+        // if bi=1 -> we compute yi = w * yi
+        if (b) {
+            FF_2048_mul(yMULw, yi_, w, FFLEN_2048);
+            FF_2048_dmod(yi_, yMULw, prover->n, FFLEN_2048);
+        }
+
+        // 4th root of y'i mod p and q, combined using CRT
+        FF_2048_dmod(Xp, yi_, prover->p, HFLEN_2048);
+        FF_2048_dmod(Xq, yi_, prover->q, HFLEN_2048);
+        CG21_PI_MOD_POW(Xp, Xp, prover->fp, prover->p, prover->ndp);
+        CG21_PI_MOD_POW(Xq, Xq, prover->fq, prover->q, prover->ndq);
+        FF_2048_crt(pimodProof->xi[i], Xp, Xq, prover->p, prover->invpq, prover->n, HFLEN_2048);
     }
 
     // clean up
-    FF_2048_zero(Mp,HFLEN_2048);
-    FF_2048_zero(Mq,HFLEN_2048);
-    FF_2048_zero(Xp,HFLEN_2048);
-    FF_2048_zero(Xq,FFLEN_2048);
-    FF_2048_zero(ws,FFLEN_2048);
+    FF_2048_zero(yi_, FFLEN_2048);
+    FF_2048_zero(yMULw, 2 * FFLEN_2048);
+    FF_2048_zero(Xp, HFLEN_2048);
+    FF_2048_zero(Xq, HFLEN_2048);
 }
 
 static void boolToChar(const bool arr[][2], char* result) {
@@ -341,34 +384,25 @@ static void CG21_PI_MOD_proof_toOctet(CG21_PIMOD_PROOF_OCT *paillierProof, CG21_
     OCT_jstring(paillierProof->ab,result);
 }
 
-int CG21_PI_MOD_PROVE(csprng *RNG, CG21_PAILLIER_KEYS paillierKeys,
-                      const CG21_SSID *ssid, CG21_PIMOD_PROOF_OCT *paillierProof, int n){
 
-    CG21_PIMOD_PROOF pimodProof;
-    BIG_1024_58 n_[FFLEN_2048];
+int CG21_PI_MOD_PROVE_WITH_PROVER(csprng *RNG, CG21_PIMOD_PROVER *prover,
+                                  const CG21_SSID *ssid, CG21_PIMOD_PROOF_OCT *paillierProof, int n){
 
-    char oct1[FS_2048];
-    octet OCT = {0, sizeof(oct1), oct1};
+    CG21_PIMOD_PROOF pimodProof;
+    BIG_1024_58 w[FFLEN_2048];
 
     // choose random w ← ZN of Jacobi symbol −1
-    CG21_PI_MOD_GET_W(RNG, paillierKeys.paillier_pk.n, pimodProof.w);
-    FF_4096_toOctet(paillierProof->w, pimodProof.w, HFLEN_4096);
-
-    // change the type of paillier_pk.n from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
-    FF_4096_toOctet(&OCT, paillierKeys.paillier_pk.n, HFLEN_4096);
-    FF_2048_fromOctet(n_, &OCT, FFLEN_2048);
+    int wp = CG21_PI_MOD_GET_W(RNG, prover, w);
+    FF_2048_toOctet(paillierProof->w, w, FFLEN_2048);
 
     // generate CG21_PAILLIER_PROOF_ITERS number of the challenges
-    int rc = CG21_PI_MOD_CHALLENGE(n_, *paillierProof->w, ssid, pimodProof.yi, n);
+    int rc = CG21_PI_MOD_CHALLENGE(prover->n, *paillierProof->w, ssid, pimodProof.yi, n);
     if (rc != CG21_OK){
         return rc;
     }
 
-    // generate (ai,bi,xi)
-    CG21_PI_MOD_GEN_Xi(&pimodProof, paillierKeys);
-
-    // generate (zi)
-    CG21_PI_MOD_GEN_Zi(&pimodProof, paillierKeys);
+    // generate (ai,bi,xi) and (zi)
+    CG21_PI_MOD_GEN_XZi(&pimodProof, prover, w, wp);
 
     // convert the proofs into octet
     CG21_PI_MOD_proof_toOctet(paillierProof, pimodProof);
@@ -376,26 +410,36 @@ int CG21_PI_MOD_PROVE(csprng *RNG, CG21_PAILLIER_KEYS paillierKeys,
     return CG21_OK;
 }
 
-int CG21_PI_MOD_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid, PAILLIER_public_key pk, int n){
+int CG21_PI_MOD_PROVE(csprng *RNG, CG21_PAILLIER_KEYS paillierKeys,
+                      const CG21_SSID *ssid, CG21_PIMOD_PROOF_OCT *paillierProof, int n){
 
-    BIG_512_60 r[HFLEN_4096];
-    BIG_512_60 num2[HFLEN_4096];
-    BIG_512_60 yi_[HFLEN_4096];
-    BIG_512_60 yMULw[FFLEN_4096];
-    BIG_512_60 n_[FFLEN_4096];
+    CG21_PIMOD_PROVER prover;
 
-    BIG_1024_58 ws[FFLEN_2048];
-    BIG_1024_58 n_2048[FFLEN_2048];
-    BIG_1024_58 yi_2048[FFLEN_2048];
+    int rc = CG21_PI_MOD_PROVER_SETUP(&prover, &paillierKeys);
+    if (rc != CG21_OK){
+        return rc;
+    }
 
-    CG21_PIMOD_PROOF pimodProof;
+    rc = CG21_PI_MOD_PROVE_WITH_PROVER(RNG, &prover, ssid, paillierProof, n);
+
+    // clean up
+    CG21_PI_MOD_PROVER_KILL(&prover);
+
+    return rc;
+}
+
+/* Recover the proof and the challenges, and convert N and w to BIG_1024_58
+ * once, so that the checks do not need to go through octets
+ */
+static int CG21_PI_MOD_VERIFY_SETUP(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid, PAILLIER_public_key pk,
+                                    int n, CG21_PIMOD_PROOF *pimodProof, BIG_1024_58 *n_2048, BIG_1024_58 *w_2048){
+
+    BIG_512_60 r[HFLEN_4096];
+    BIG_512_60 num2[HFLEN_4096];
 
     char oct[2*FS_2048];
     octet OCT = {0, sizeof(oct), oct};
 
-    FF_4096_zero(n_,FFLEN_4096);
-    FF_4096_copy(n_,pk.n,HFLEN_4096);
-
     // convert paillier_pk.n from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
     FF_4096_toOctet(&OCT, pk.n, HFLEN_4096);
     FF_2048_fromOctet(n_2048, &OCT, FFLEN_2048);
@@ -411,55 +455,65 @@ int CG21_PI_MOD_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssi
         return CG21_PAILLIER_N_IS_EVEN;
     }
 
-    int rc = CG21_PI_MOD_proof_fromOCTET(paillierProof, &pimodProof);
+    int rc = CG21_PI_MOD_proof_fromOCTET(paillierProof, pimodProof);
     if (rc != CG21_OK){
         return rc;
     }
 
+    // convert w from BIG_512_60[HFLEN_4096] to BIG_1024_58[FFLEN_2048]
+    FF_4096_toOctet(&OCT, pimodProof->w, HFLEN_4096);
+    FF_2048_fromOctet(w_2048, &OCT, FFLEN_2048);
+
     // generate yi
-    rc = CG21_PI_MOD_CHALLENGE(n_2048, *paillierProof->w, ssid, pimodProof.yi, n);
-    if (rc != CG21_OK){
-        return rc;
-    }
+    return CG21_PI_MOD_CHALLENGE(n_2048, *paillierProof->w, ssid, pimodProof->yi, n);
+}
 
-    for (int i=0; i<CG21_PAILLIER_PROOF_ITERS;i++){
+/* Check zi^N = yi mod N for the iterations in [from, to) */
+static int CG21_PI_MOD_CHECK_Zi(CG21_PIMOD_PROOF *pimodProof, BIG_1024_58 *n_2048, int from, int to){
+
+    BIG_1024_58 ws[FFLEN_2048];
 
-        FF_2048_nt_pow(ws, pimodProof.zi[i], n_2048, n_2048, FFLEN_2048, FFLEN_2048);
+    for (int i=from; i<to;i++){
+
+        FF_2048_nt_pow(ws, pimodProof->zi[i], n_2048, n_2048, FFLEN_2048, FFLEN_2048);
 
         // These values are all public, so it is ok to terminate early
-        if (FF_2048_comp(ws, pimodProof.yi[i], FFLEN_2048) != 0)
+        if (FF_2048_comp(ws, pimodProof->yi[i], FFLEN_2048) != 0)
         {
             return CG21_PAILLIER_PROVE_FAIL;
         }
     }
 
-    for (int i=0; i<CG21_PAILLIER_PROOF_ITERS;i++){
-        char oct2[2 * FS_2048];
-        octet y_oct = {0, sizeof(oct2), oct2};
-        FF_2048_toOctet(&y_oct, pimodProof.yi[i], FFLEN_2048);
+    return CG21_OK;
+}
+
+/* Check xi^4 = (-1)^ai * w^bi * yi mod N for the iterations in [from, to) */
+static int CG21_PI_MOD_CHECK_Xi(CG21_PIMOD_PROOF *pimodProof, BIG_1024_58 *n_2048, BIG_1024_58 *w_2048, int from, int to){
+
+    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 yi_[FFLEN_2048];
+    BIG_1024_58 yMULw[2 * FFLEN_2048];
+
+    for (int i=from; i<to;i++){
+
+        FF_2048_copy(yi_, pimodProof->yi[i], FFLEN_2048);
 
-        FF_4096_zero(yi_, HFLEN_4096);
-        FF_4096_fromOctet(yi_, &y_oct, HFLEN_4096);
         // if ai=1 -> (-1)^{ai} becomes -1 -> we compute -yi mod N = N - yi
         // note: if ai=0 -> (-1)^{ai} becomes 0 -> we don't need to do anything
-        if (pimodProof.ab[i][0]) {
-            FF_4096_sub(yi_, pk.n, yi_, HFLEN_4096);
-            FF_4096_norm(yi_, HFLEN_4096);
+        if (pimodProof->ab[i][0]) {
+            FF_2048_sub(yi_, n_2048, yi_, FFLEN_2048);
+            FF_2048_norm(yi_, FFLEN_2048);
         }
 
         // if bi=1 -> we compute yi = w * yi
-        if (pimodProof.ab[i][1]) {
-            FF_4096_zero(yMULw, FFLEN_4096);
-            FF_4096_mul(yMULw, yi_, pimodProof.w, HFLEN_4096);
-            FF_4096_mod(yMULw, n_, FFLEN_4096);
-            FF_4096_copy(yi_, yMULw, HFLEN_4096);
+        if (pimodProof->ab[i][1]) {
+            FF_2048_mul(yMULw, yi_, w_2048, FFLEN_2048);
+            FF_2048_dmod(yi_, yMULw, n_2048, FFLEN_2048);
         }
 
-        FF_4096_toOctet(&OCT, yi_, HFLEN_4096);
-        FF_2048_fromOctet(yi_2048, &OCT, FFLEN_2048);
-        FF_2048_nt_pow_int(ws,pimodProof.xi[i],4,n_2048,FFLEN_2048);
+        FF_2048_nt_pow_int(ws,pimodProof->xi[i],4,n_2048,FFLEN_2048);
 
-        if (FF_2048_comp(ws, yi_2048, FFLEN_2048) != 0)
+        if (FF_2048_comp(ws, yi_, FFLEN_2048) != 0)
         {
             return CG21_PAILLIER_PROVE_FAIL;
         }
@@ -467,3 +521,215 @@ int CG21_PI_MOD_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssi
 
     return CG21_OK;
 }
+
+/* Derive the batching coefficients from the whole proof. Since they
+ * depend on zi, a prover can not choose zi after seeing them
+ */
+static void CG21_PI_MOD_BATCH_COEFFICIENTS(CG21_PIMOD_PROOF *pimodProof, BIG_1024_58 *n_2048, BIG_1024_58 *w_2048,
+                                           BIG_1024_58 C[CG21_PAILLIER_PROOF_ITERS][FFLEN_2048]){
+    hash256 sha;
+    csprng RNG;
+
+    char w[FS_2048];
+    octet W = {0, sizeof(w), w};
+
+    HASH256_init(&sha);
+
+    FF_2048_toOctet(&W, n_2048, FFLEN_2048);
+    HASH_UTILS_hash_oct(&sha, &W);
+    FF_2048_toOctet(&W, w_2048, FFLEN_2048);
+    HASH_UTILS_hash_oct(&sha, &W);
+
+    for (int i=0; i<CG21_PAILLIER_PROOF_ITERS;i++){
+        FF_2048_toOctet(&W, pimodProof->yi[i], FFLEN_2048);
+        HASH_UTILS_hash_oct(&sha, &W);
+        FF_2048_toOctet(&W, pimodProof->xi[i], FFLEN_2048);
+        HASH_UTILS_hash_oct(&sha, &W);
+        FF_2048_toOctet(&W, pimodProof->zi[i], FFLEN_2048);
+        HASH_UTILS_hash_oct(&sha, &W);
+        HASH_UTILS_hash_i2osp4(&sha, 2 * pimodProof->ab[i][0] + pimodProof->ab[i][1]);
+    }
+
+    HASH256_hash(&sha, w);
+    RAND_seed(&RNG, SHA256, w);
+
+    for (int i=0; i<CG21_PAILLIER_PROOF_ITERS;i++){
+        OCT_clear(&W);
+        OCT_jbyte(&W, 0, FS_2048 - CG21_PI_MOD_BATCH_COEFFICIENT_SIZE);
+
+        for (int j=0; j<CG21_PI_MOD_BATCH_COEFFICIENT_SIZE;j++){
+            OCT_jbyte(&W, RAND_byte(&RNG), 1);
+        }
+
+        FF_2048_fromOctet(C[i], &W, FFLEN_2048);
+    }
+
+    RAND_clean(&RNG);
+}
+
+/* Accumulate Z = prod zi^ci and Y = prod yi^ci for the iterations in [from, to),
+ * in groups of B_BASES bases
+ */
+static void CG21_PI_MOD_BATCH_Zi(CG21_PIMOD_PROOF *pimodProof, BIG_1024_58 *n_2048, BIG_1024_58 *ND,
+                                 BIG_1024_58 C[CG21_PAILLIER_PROOF_ITERS][FFLEN_2048],
+                                 BIG_1024_58 *Z, BIG_1024_58 *Y, int from, int to){
+
+    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 dws[2 * FFLEN_2048];
+
+    BIG_1024_58 *ZS[B_BASES];
+    BIG_1024_58 *YS[B_BASES];
+    BIG_1024_58 *ES[B_BASES];
+
+    BIG_1024_58 PT_mem[B_BASES * B_SIZE][FFLEN_2048];
+    BIG_1024_58 *PT[B_BASES * B_SIZE];
+
+    for (int i=0; i<B_BASES * B_SIZE;i++){
+        PT[i] = PT_mem[i];
+    }
+
+    FF_2048_one(Z, FFLEN_2048);
+    FF_2048_one(Y, FFLEN_2048);
+
+    for (int i=from; i<to;i+=B_BASES){
+        int nb = to - i;
+        if (nb > B_BASES){
+            nb = B_BASES;
+        }
+
+        for (int j=0; j<nb;j++){
+            ZS[j] = pimodProof->zi[i + j];
+            YS[j] = pimodProof->yi[i + j];
+            ES[j] = C[i + j];
+        }
+
+        // The coefficients fit in the lowest BIG of C
+        FF_2048_bi_precompute(ZS, PT, nb, B_WINDOW, n_2048, ND, FFLEN_2048);
+        FF_2048_bi_pow(ws, PT, ES, nb, B_WINDOW, n_2048, ND, FFLEN_2048, 1);
+        FF_2048_mul(dws, Z, ws, FFLEN_2048);
+        FF_2048_dmod(Z, dws, n_2048, FFLEN_2048);
+
+        FF_2048_bi_precompute(YS, PT, nb, B_WINDOW, n_2048, ND, FFLEN_2048);
+        FF_2048_bi_pow(ws, PT, ES, nb, B_WINDOW, n_2048, ND, FFLEN_2048, 1);
+        FF_2048_mul(dws, Y, ws, FFLEN_2048);
+        FF_2048_dmod(Y, dws, n_2048, FFLEN_2048);
+    }
+}
+
+// Number of groups of bases the batched verification is split in
+#define CG21_PI_MOD_GROUPS ((CG21_PAILLIER_PROOF_ITERS + B_BASES - 1) / B_BASES)
+
+typedef struct
+{
+    CG21_PIMOD_PROOF *pimodProof;
+    BIG_1024_58 *n_2048;
+    BIG_1024_58 *w_2048;
+    BIG_1024_58 *ND;
+    BIG_1024_58 (*C)[FFLEN_2048];
+    BIG_1024_58 (*Z)[FFLEN_2048];
+    BIG_1024_58 (*Y)[FFLEN_2048];
+} CG21_PI_MOD_JOB;
+
+// Check the x_i and accumulate Z_j, Y_j for the j-th group of bases
+static int CG21_PI_MOD_BATCH_JOB(void *arg, int j){
+    CG21_PI_MOD_JOB *job = (CG21_PI_MOD_JOB *)arg;
+
+    int from = j * B_BASES;
+    int to = from + B_BASES;
+    if (to > CG21_PAILLIER_PROOF_ITERS){
+        to = CG21_PAILLIER_PROOF_ITERS;
+    }
+
+    int rc = CG21_PI_MOD_CHECK_Xi(job->pimodProof, job->n_2048, job->w_2048, from, to);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    CG21_PI_MOD_BATCH_Zi(job->pimodProof, job->n_2048, job->ND, job->C, job->Z[j], job->Y[j], from, to);
+
+    return CG21_OK;
+}
+
+int CG21_PI_MOD_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid, PAILLIER_public_key pk, int n){
+
+    BIG_1024_58 n_2048[FFLEN_2048];
+    BIG_1024_58 w_2048[FFLEN_2048];
+
+    CG21_PIMOD_PROOF pimodProof;
+
+    int rc = CG21_PI_MOD_VERIFY_SETUP(paillierProof, ssid, pk, n, &pimodProof, n_2048, w_2048);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    rc = CG21_PI_MOD_CHECK_Zi(&pimodProof, n_2048, 0, CG21_PAILLIER_PROOF_ITERS);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    return CG21_PI_MOD_CHECK_Xi(&pimodProof, n_2048, w_2048, 0, CG21_PAILLIER_PROOF_ITERS);
+}
+
+int CG21_PI_MOD_BATCH_VERIFY(CG21_PIMOD_PROOF_OCT *paillierProof, const CG21_SSID *ssid, PAILLIER_public_key pk,
+                             int n, int threads){
+
+    BIG_1024_58 n_2048[FFLEN_2048];
+    BIG_1024_58 w_2048[FFLEN_2048];
+    BIG_1024_58 ND[FFLEN_2048];
+    BIG_1024_58 Z[FFLEN_2048];
+    BIG_1024_58 Y[FFLEN_2048];
+    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 dws[2 * FFLEN_2048];
+
+    BIG_1024_58 C[CG21_PAILLIER_PROOF_ITERS][FFLEN_2048];
+    BIG_1024_58 Zs[CG21_PI_MOD_GROUPS][FFLEN_2048];
+    BIG_1024_58 Ys[CG21_PI_MOD_GROUPS][FFLEN_2048];
+
+    CG21_PIMOD_PROOF pimodProof;
+    CG21_PI_MOD_JOB job;
+
+    int rc = CG21_PI_MOD_VERIFY_SETUP(paillierProof, ssid, pk, n, &pimodProof, n_2048, w_2048);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    CG21_PI_MOD_BATCH_COEFFICIENTS(&pimodProof, n_2048, w_2048, C);
+    FF_2048_invmod2m(ND, n_2048, FFLEN_2048);
+
+    // One job per group of bases, so the multi-exponentiations are never
+    // split across threads
+    job.pimodProof = &pimodProof;
+    job.n_2048 = n_2048;
+    job.w_2048 = w_2048;
+    job.ND = ND;
+    job.C = C;
+    job.Z = Zs;
+    job.Y = Ys;
+
+    rc = CG21_FANOUT(CG21_PI_MOD_BATCH_JOB, &job, CG21_PI_MOD_GROUPS, threads);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    // Z = prod Z_j, Y = prod Y_j over the groups
+    FF_2048_copy(Z, Zs[0], FFLEN_2048);
+    FF_2048_copy(Y, Ys[0], FFLEN_2048);
+
+    for (int i=1; i<CG21_PI_MOD_GROUPS;i++){
+        FF_2048_mul(dws, Z, Zs[i], FFLEN_2048);
+        FF_2048_dmod(Z, dws, n_2048, FFLEN_2048);
+        FF_2048_mul(dws, Y, Ys[i], FFLEN_2048);
+        FF_2048_dmod(Y, dws, n_2048, FFLEN_2048);
+    }
+
+    // prod zi^{N*ci} = prod yi^ci
+    FF_2048_nt_pow(ws, Z, n_2048, n_2048, FFLEN_2048, FFLEN_2048);
+
+    // These values are all public, so it is ok to terminate early
+    if (FF_2048_comp(ws, Y, FFLEN_2048) != 0)
+    {
+        return CG21_PAILLIER_PROVE_FAIL;
+    }
+
+    return CG21_OK;
+}
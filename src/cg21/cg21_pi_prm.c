@@ -27,6 +27,11 @@ static void CG21_PI_PRM_PROOF_to_OCT(CG21_PIPRM_PROOF *proof, CG21_PIPRM_PROOF_O
 }
 
 int CG21_PI_PRM_PROVE(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct){
+    return CG21_PI_PRM_PROVE_MT(RNG, priv, ssid, proofOct, 1);
+}
+
+int CG21_PI_PRM_PROVE_MT(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct,
+                         int threads){
 
     CG21_PIPRM_PROOF proof;
     HDLOG_iter_values R;
@@ -38,7 +43,14 @@ int CG21_PI_PRM_PROVE(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid, C
 
     /* generate proof for both alpha and ialpha based on FO97:section3.1:setup procedure (step5) */
     // Prove b1 = b0^alpha
-    HDLOG_commit(RNG, &priv->mod, priv->pq, priv->b0, R, proof.rho);
+    if (priv->comb_b0 != NULL)
+    {
+        HDLOG_commit_comb_mt(RNG, &priv->mod, priv->pq, priv->comb_b0, R, proof.rho, threads);
+    }
+    else
+    {
+        HDLOG_commit_mt(RNG, &priv->mod, priv->pq, priv->b0, R, proof.rho, threads);
+    }
     int rc = HDLOG_challenge_CG21(priv->mod.n, priv->b0, priv->b1, proof.rho, (const HDLOG_SSID *) ssid, &E, n);
     if (rc != HDLOG_OK)
     {
@@ -47,7 +59,14 @@ int CG21_PI_PRM_PROVE(csprng *RNG, PEDERSEN_PRIV *priv, const CG21_SSID *ssid, C
     HDLOG_prove(priv->pq, priv->alpha, R, &E, proof.t);
 
     // Prove b0 = b1 ^ ialpha
-    HDLOG_commit(RNG, &priv->mod, priv->pq, priv->b1, R, proof.irho);
+    if (priv->comb_b1 != NULL)
+    {
+        HDLOG_commit_comb_mt(RNG, &priv->mod, priv->pq, priv->comb_b1, R, proof.irho, threads);
+    }
+    else
+    {
+        HDLOG_commit_mt(RNG, &priv->mod, priv->pq, priv->b1, R, proof.irho, threads);
+    }
     rc = HDLOG_challenge_CG21(priv->mod.n, priv->b1, priv->b0, proof.irho, (const HDLOG_SSID *) ssid, &E, n);
     if (rc != HDLOG_OK)
     {
@@ -89,8 +108,29 @@ int CG21_PI_PRM_OCT_to_PROOF(CG21_PIPRM_PROOF *proof, CG21_PIPRM_PROOF_OCT *proo
     return CG21_OK;
 }
 
-int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n){
+/* Verify one HDLOG proof. The combined check is only used when the
+ * caller passes an RNG for the coefficients, see HDLOG_batch_verify */
+static int pi_prm_verify_dlog(csprng *RNG, BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO,
+                              const octet *E, HDLOG_iter_values T, int threads){
+    if (RNG != NULL)
+    {
+        return HDLOG_batch_verify(RNG, N, B0, B1, RHO, E, T, NULL);
+    }
 
+    if (threads > 1)
+    {
+        return HDLOG_verify_mt(N, B0, B1, RHO, E, T, threads);
+    }
+
+    return HDLOG_verify(N, B0, B1, RHO, E, T);
+}
+
+/* Verify both HDLOG proofs, iteration by iteration on threads workers
+ * or with the combined check */
+static int pi_prm_verify(csprng *RNG, PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n,
+                         int threads){
+
+    int rc;
     CG21_PIPRM_PROOF proof;
 
     char e[HDLOG_CHALLENGE_SIZE];
@@ -101,15 +141,15 @@ int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROO
 
     // Verify knowledge of DLOG of b1
     HDLOG_challenge_CG21(pub->N, pub->b0, pub->b1, proof.rho, (const HDLOG_SSID *) ssid, &E, n);
-    int rc = HDLOG_verify(pub->N, pub->b0, pub->b1, proof.rho, &E, proof.t);
+    rc = pi_prm_verify_dlog(RNG, pub->N, pub->b0, pub->b1, proof.rho, &E, proof.t, threads);
     if (rc != HDLOG_OK)
     {
         return CG21_PI_PRM_INVALID_PROOF;
     }
 
-    // Verify knowledge of DLOG of b1
+    // Verify knowledge of DLOG of b0
     HDLOG_challenge_CG21(pub->N, pub->b1, pub->b0, proof.irho, (const HDLOG_SSID *) ssid, &E, n);
-    rc = HDLOG_verify(pub->N, pub->b1, pub->b0, proof.irho, &E, proof.it);
+    rc = pi_prm_verify_dlog(RNG, pub->N, pub->b1, pub->b0, proof.irho, &E, proof.it, threads);
     if (rc != HDLOG_OK)
     {
         return CG21_PI_PRM_INVALID_PROOF;
@@ -117,3 +157,16 @@ int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROO
 
     return CG21_OK;
 }
+
+int CG21_PI_PRM_VERIFY(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n){
+    return pi_prm_verify(NULL, pub, ssid, proofOct, n, 1);
+}
+
+int CG21_PI_PRM_VERIFY_MT(PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct, int n, int threads){
+    return pi_prm_verify(NULL, pub, ssid, proofOct, n, threads);
+}
+
+int CG21_PI_PRM_VERIFY_BATCH(csprng *RNG, PEDERSEN_PUB *pub, const CG21_SSID *ssid, CG21_PIPRM_PROOF_OCT *proofOct,
+                             int n){
+    return pi_prm_verify(RNG, pub, ssid, proofOct, n, 1);
+}
@@ -37,10 +37,15 @@ int CG21_VALIDATE_PARTIAL_PKS(CG21_RESHARE_OUTPUT *reshareOutput){
     }
 
     // add all the partial PKs
-    OCT_copy(&X, &CC[0]);
-    for (int j =1; j<size; j++){
-        CG21_ADD_TWO_PK(&X, &CC[j]);
+    CG21_ECP_ACCUMULATOR sum;
+    CG21_ECP_ACCUMULATOR_init(&sum);
+    for (int j =0; j<size; j++){
+        rc = CG21_ECP_ACCUMULATOR_add(&sum, &CC[j]);
+        if (rc!=CG21_OK){
+            return rc;
+        }
     }
+    CG21_ECP_ACCUMULATOR_output(&sum, &X);
 
     // check whether the sum-of-PKs match the main PK
     rc = OCT_comp(&X, reshareOutput->pk.X);
@@ -84,19 +89,19 @@ void CG21_PRESIGN_GET_SSID(CG21_SSID *ssid, const CG21_RESHARE_OUTPUT *reshareOu
     *ssid->n2 = n2;
 }
 
-int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
-                        CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
-                        CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys){
+/* Steps 1 and 2 of Round 1: sample k, gamma, rho, nu and encrypt gamma and k */
+static int CG21_PRESIGN_ROUND1_ENCRYPT(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                                       CG21_PRESIGN_ROUND1_OUTPUT *output,
+                                       CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys,
+                                       CG21_PAILLIER_POOL *pool){
+
+    int rc = CG21_OK;
 
-    /* define and initialize variables to form SSID */
     char oct1[FS_2048];
     char oct2[FS_2048];
-    char x_[setting->t2 - 1][EGS_SECP256K1];
 
     octet OCT1 = {0, sizeof(oct1), oct1};
     octet OCT2 = {0, sizeof(oct2), oct2};
-    octet X[setting->t2 - 1];
-    init_octets((char *) x_, X, EGS_SECP256K1, setting->t2 - 1);
 
     BIG_512_60 ss[FFLEN_4096];
     BIG_256_56 s;
@@ -107,8 +112,8 @@ int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
      * ---------STEP 1: choosing randoms -----------
      * k:               q bits
      * gamma:           q bits
-     * rho:             Z^*_N
-     * nu:              Z^*_N
+     * rho:             Z^*_N, taken from the pool if given
+     * nu:              Z^*_N, taken from the pool if given
      */
 
     // sample random k
@@ -124,16 +129,18 @@ int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
     BIG_256_56_toBytes(store->gamma->val, s);
     BIG_256_56_zero(s);
 
-    // sample rho
-    FF_4096_zero(ss, FFLEN_4096);
-    FF_4096_randomnum(ss, keys->n, RNG,HFLEN_4096);
-    FF_4096_toOctet(store->rho,ss,FFLEN_4096);
-    FF_4096_zero(ss, FFLEN_4096);
-
-    // sample nu
-    FF_4096_randomnum(ss, keys->n, RNG,HFLEN_4096);
-    FF_4096_toOctet(store->nu,ss,FFLEN_4096);
-    FF_4096_zero(ss, FFLEN_4096);
+    if (pool == NULL){
+        // sample rho
+        FF_4096_zero(ss, FFLEN_4096);
+        FF_4096_randomnum(ss, keys->n, RNG,HFLEN_4096);
+        FF_4096_toOctet(store->rho,ss,FFLEN_4096);
+        FF_4096_zero(ss, FFLEN_4096);
+
+        // sample nu
+        FF_4096_randomnum(ss, keys->n, RNG,HFLEN_4096);
+        FF_4096_toOctet(store->nu,ss,FFLEN_4096);
+        FF_4096_zero(ss, FFLEN_4096);
+    }
 
     // copy player's ID into different variables to be used later
     store->i = reshareOutput->myID;
@@ -154,43 +161,166 @@ int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
     OCT_pad(&OCT1, FS_2048);
     OCT_pad(&OCT2, FS_2048);
 
-    PAILLIER_ENCRYPT(NULL, keys, &OCT1, output->G, store->nu); // encrypt(gamma;nu)
-    PAILLIER_ENCRYPT(NULL, keys, &OCT2, output->K, store->rho); // encrypt(k;rho)
+    if (pool == NULL){
+        PAILLIER_ENCRYPT(NULL, keys, &OCT1, output->G, store->nu); // encrypt(gamma;nu)
+        PAILLIER_ENCRYPT(NULL, keys, &OCT2, output->K, store->rho); // encrypt(k;rho)
+    }
+    else{
+        // nu and rho come with their precomputed nu^N and rho^N
+        rc = CG21_PAILLIER_POOL_ENCRYPT(pool, keys, &OCT1, output->G, store->nu);
+        if (rc == CG21_OK){
+            rc = CG21_PAILLIER_POOL_ENCRYPT(pool, keys, &OCT2, output->K, store->rho);
+        }
+    }
+
+    //clean up
+    OCT_clear(&OCT1);
+    OCT_clear(&OCT2);
+
+    return rc;
+}
+
+/* Step 3 of Round 1 with the Lagrange coefficient of the set T2 taken from a cache */
+static int CG21_PRESIGN_ROUND1_ADDITIVE_CACHED(const CG21_RESHARE_OUTPUT *reshareOutput,
+                                               CG21_RESHARE_SETTING *setting, octet *a,
+                                               CG21_LAGRANGE_CACHE *lagrange){
+
+    BIG_256_56 q;
+    BIG_256_56 coeff;
+    BIG_256_56 y;
+    DBIG_256_56 dw;
+
+    int rc = CG21_LAGRANGE_CACHE_coeff(lagrange, setting->t2, setting->T2, reshareOutput->myID, coeff);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    // a = coeff * y
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_fromBytesLen(y, reshareOutput->shares.Y->val, reshareOutput->shares.Y->len);
+    BIG_256_56_mul(dw, coeff, y);
+    BIG_256_56_dmod(y, dw, q);
+
+    BIG_256_56_toBytes(a->val, y);
+    a->len = EGS_SECP256K1;
+
+    // clean up
+    BIG_256_56_zero(y);
+    BIG_256_56_dzero(dw);
+
+    return CG21_OK;
+}
+
+/* Step 3 of Round 1: convert sum-of-the-shares to additive share a */
+static void CG21_PRESIGN_ROUND1_ADDITIVE(const CG21_RESHARE_OUTPUT *reshareOutput,
+                                         CG21_RESHARE_SETTING *setting, octet *a){
+
+    char x_[setting->t2 - 1][EGS_SECP256K1];
+    octet X[setting->t2 - 1];
+    init_octets((char *) x_, X, EGS_SECP256K1, setting->t2 - 1);
 
-    /*
-     * ---------STEP 3: convert sum-of-the-shares to additive shares -----------
-     */
     // packed ID of the players in T2 into one octet X
     CG21_lagrange_index_to_octet(setting->t2, setting->T2, reshareOutput->myID, X);
 
     // convert SSS shared to additive
-    SSS_shamir_to_additive(setting->t2, reshareOutput->shares.X, reshareOutput->shares.Y, X, store->a);
+    SSS_shamir_to_additive(setting->t2, reshareOutput->shares.X, reshareOutput->shares.Y, X, a);
+}
 
-    //clean up
-    OCT_clear(&OCT1);
-    OCT_clear(&OCT2);
+int CG21_PRESIGN_ROUND1_CACHED(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                               CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                               CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys,
+                               CG21_PAILLIER_POOL *myPool, CG21_LAGRANGE_CACHE *lagrange){
+
+    int rc = CG21_PRESIGN_ROUND1_ENCRYPT(RNG, reshareOutput, output, store, keys, myPool);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    return CG21_PRESIGN_ROUND1_ADDITIVE_CACHED(reshareOutput, setting, store->a, lagrange);
+}
+
+int CG21_PRESIGN_ROUND1_POOLED(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                               CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                               CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys,
+                               CG21_PAILLIER_POOL *myPool){
+
+    /*
+     * ---------STEP 1 and 2: choose randoms, compute G and K -----------
+     */
+    int rc = CG21_PRESIGN_ROUND1_ENCRYPT(RNG, reshareOutput, output, store, keys, myPool);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    /*
+     * ---------STEP 3: convert sum-of-the-shares to additive shares -----------
+     */
+    CG21_PRESIGN_ROUND1_ADDITIVE(reshareOutput, setting, store->a);
 
     return CG21_OK;
 }
 
-void CG21_MTA_decrypt_reduce_q(octet *T, octet *ALPHA)
-{
-    BIG_1024_58 q[FFLEN_2048];
-    BIG_1024_58 alpha[FFLEN_2048];
+int CG21_PRESIGN_ROUND1(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                        CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                        CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys){
 
-    char t[FS_2048];
-    octet Q = {0,sizeof(t),t};
+    return CG21_PRESIGN_ROUND1_POOLED(RNG, reshareOutput, setting, output, store, keys, NULL);
+}
 
-    char tt[FS_2048];
-    octet TT = {0,sizeof(tt),tt};
+int CG21_PRESIGN_ROUND1_BATCH(csprng *RNG, const CG21_RESHARE_OUTPUT *reshareOutput,
+                              CG21_RESHARE_SETTING *setting, CG21_PRESIGN_ROUND1_OUTPUT *output,
+                              CG21_PRESIGN_ROUND1_STORE *store, PAILLIER_public_key *keys, int K, int *bad){
 
-    OCT_copy(&TT, T);
+    if (bad != NULL){
+        *bad = -1;
+    }
+
+    if (K < 1){
+        return CG21_OK;
+    }
+
+    // the outputs are broadcast as one message, so the batch stops at the first failure
+    for (int k=0; k<K; k++){
+        int rc = CG21_PRESIGN_ROUND1_ENCRYPT(RNG, reshareOutput, output + k, store + k, keys, NULL);
+        if (rc != CG21_OK){
+            if (bad != NULL){
+                *bad = k;
+            }
+            return rc;
+        }
+    }
+
+    // the additive share only depends on the set T2, so it is shared by the whole batch
+    CG21_PRESIGN_ROUND1_ADDITIVE(reshareOutput, setting, store[0].a);
+    for (int k=1; k<K; k++){
+        OCT_copy(store[k].a, store[0].a);
+    }
+
+    return CG21_OK;
+}
+
+/* Load the curve order as a 2048-bit number */
+static void CG21_MTA_LOAD_q(BIG_1024_58 *q)
+{
+    char t[FS_2048];
+    octet Q = {0,sizeof(t),t};
 
     // Curve order
     CG21_get_q(&Q);
 
     OCT_pad(&Q, FS_2048);
     FF_2048_fromOctet(q, &Q, FFLEN_2048);
+}
+
+/* Reduce T modulo the curve order q, loaded with CG21_MTA_LOAD_q */
+static void CG21_MTA_REDUCE_q(octet *T, octet *ALPHA, BIG_1024_58 *q)
+{
+    BIG_1024_58 alpha[FFLEN_2048];
+
+    char tt[FS_2048];
+    octet TT = {0,sizeof(tt),tt};
+
+    OCT_copy(&TT, T);
 
     FF_2048_fromOctet(alpha, &TT, FFLEN_2048);
 
@@ -206,10 +336,41 @@ void CG21_MTA_decrypt_reduce_q(octet *T, octet *ALPHA)
     OCT_clear(&TT);
 }
 
+void CG21_MTA_decrypt_reduce_q(octet *T, octet *ALPHA)
+{
+    BIG_1024_58 q[FFLEN_2048];
+
+    CG21_MTA_LOAD_q(q);
+    CG21_MTA_REDUCE_q(T, ALPHA, q);
+}
 
-int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
-                        const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
-                        PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK){
+/* Compute q^5, the range of beta and beta_hat in Round 2 */
+static void CG21_PRESIGN_ROUND2_q5(BIG_1024_58 *q5)
+{
+    BIG_1024_58 q[HFLEN_2048];          //curve order
+    BIG_1024_58 q2[FFLEN_2048];         //q^2
+    BIG_1024_58 q3[FFLEN_2048];         //q^3
+
+    char oct1[2 * FS_2048];
+    octet OCT = {0, sizeof(oct1), oct1};
+
+    // Curve order
+    CG21_get_q(&OCT);   // get curve order
+    OCT_pad(&OCT, HFS_2048);    // pad curve order with zeros to become 1024-bit number
+    FF_2048_fromOctet(q, &OCT, HFLEN_2048); // store padded curve order in q
+
+    FF_2048_sqr(q2, q, HFLEN_2048);
+    FF_2048_mul(q3, q, q2, HFLEN_2048);
+    FF_2048_mul(q5, q3, q2, FFLEN_2048);
+}
+
+
+static int CG21_PRESIGN_ROUND2_q5_GIVEN(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                                        const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                                        PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK, BIG_1024_58 *q5,
+                                        CG21_PAILLIER_POOL *hisPool, CG21_PAILLIER_POOL *myPool){
+
+    int rc = CG21_OK;
 
 
     r2store->i = r1store->i;
@@ -225,9 +386,8 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
     BIG_256_56 s;
     ECP_SECP256K1 G;
 
-    ECP_SECP256K1_generator(&G);    // get curve generator
     BIG_256_56_fromBytesLen(s, r1store->gamma->val, r1store->gamma->len);   // load gamma into big
-    ECP_SECP256K1_mul(&G, s);   // compute gamma*G
+    ECP_GEN_mul(&G, s);   // compute gamma*G
     ECP_SECP256K1_toOctet(r2store->Gamma, &G, true); // store gamma*G
     ECP_SECP256K1_toOctet(r2output->Gamma, &G, true); // store gamma*G
     BIG_256_56_zero(s); // zeroize s
@@ -238,24 +398,8 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
      * beta_hat:         q^5 bits
      */
 
-    BIG_1024_58 q[HFLEN_2048];          //curve order
-    BIG_1024_58 q2[FFLEN_2048];         //q^2
-    BIG_1024_58 q3[FFLEN_2048];         //q^3
-    BIG_1024_58 q5[FFLEN_2048];         //q^5
     BIG_1024_58 t[FFLEN_2048];
 
-    char oct1[2 * FS_2048];
-    octet OCT = {0, sizeof(oct1), oct1};
-
-    // Curve order
-    CG21_get_q(&OCT);   // get curve order
-    OCT_pad(&OCT, HFS_2048);    // pad curve order with zeros to become 1024-bit number
-    FF_2048_fromOctet(q, &OCT, HFLEN_2048); // store padded curve order in q
-
-    FF_2048_sqr(q2, q, HFLEN_2048);
-    FF_2048_mul(q3, q, q2, HFLEN_2048);
-    FF_2048_mul(q5, q3, q2, FFLEN_2048);
-
     // Generate beta in [0, .., q^5]
     FF_2048_random(t, RNG, FFLEN_2048);        //t: a 2048-bit
     FF_2048_mod(t, q5, FFLEN_2048);            //t mod q^5
@@ -274,6 +418,8 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
      * r_hat:           Z^*_N
      * s:               Z^*_N
      * s_hat:           Z^*_N
+     *
+     * r, r_hat are taken from myPool and s, s_hat from hisPool if given
      */
 
     // sample rho and nu
@@ -287,15 +433,21 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
     FF_4096_zero(ss,FFLEN_4096);
     FF_4096_zero(ss_hat,FFLEN_4096);
 
-    FF_4096_randomnum(rr, myPK->n, RNG,HFLEN_4096);
-    FF_4096_randomnum(rr_hat, myPK->n, RNG,HFLEN_4096);
-    FF_4096_randomnum(ss, hisPK->n, RNG,HFLEN_4096);
-    FF_4096_randomnum(ss_hat, hisPK->n, RNG,HFLEN_4096);
+    if (myPool == NULL){
+        FF_4096_randomnum(rr, myPK->n, RNG,HFLEN_4096);
+        FF_4096_randomnum(rr_hat, myPK->n, RNG,HFLEN_4096);
 
-    FF_4096_toOctet(r2store->r,rr,FFLEN_4096);
-    FF_4096_toOctet(r2store->r_hat,rr_hat,FFLEN_4096);
-    FF_4096_toOctet(r2store->s,ss,FFLEN_4096);
-    FF_4096_toOctet(r2store->s_hat,ss_hat,FFLEN_4096);
+        FF_4096_toOctet(r2store->r,rr,FFLEN_4096);
+        FF_4096_toOctet(r2store->r_hat,rr_hat,FFLEN_4096);
+    }
+
+    if (hisPool == NULL){
+        FF_4096_randomnum(ss, hisPK->n, RNG,HFLEN_4096);
+        FF_4096_randomnum(ss_hat, hisPK->n, RNG,HFLEN_4096);
+
+        FF_4096_toOctet(r2store->s,ss,FFLEN_4096);
+        FF_4096_toOctet(r2store->s_hat,ss_hat,FFLEN_4096);
+    }
 
     FF_4096_zero(rr,FFLEN_4096);
     FF_4096_zero(rr_hat,FFLEN_4096);
@@ -308,8 +460,19 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
      * F_hat:               Enc(Beta_hat, r_hat)
      */
 
-    PAILLIER_ENCRYPT(NULL, myPK, r2store->beta, r2output->F, r2store->r);
-    PAILLIER_ENCRYPT(NULL, myPK, r2store->beta_hat, r2output->F_hat, r2store->r_hat);
+    if (myPool == NULL){
+        PAILLIER_ENCRYPT(NULL, myPK, r2store->beta, r2output->F, r2store->r);
+        PAILLIER_ENCRYPT(NULL, myPK, r2store->beta_hat, r2output->F_hat, r2store->r_hat);
+    }
+    else{
+        rc = CG21_PAILLIER_POOL_ENCRYPT(myPool, myPK, r2store->beta, r2output->F, r2store->r);
+        if (rc == CG21_OK){
+            rc = CG21_PAILLIER_POOL_ENCRYPT(myPool, myPK, r2store->beta_hat, r2output->F_hat, r2store->r_hat);
+        }
+        if (rc != CG21_OK){
+            return rc;
+        }
+    }
 
 
     /*
@@ -337,7 +500,12 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
     FF_2048_toOctet(r2store->neg_beta,t_, FFLEN_2048);
 
     // Enc(Beta, s)
-    PAILLIER_ENCRYPT(NULL, hisPK, r2store->beta, &H_oct, r2store->s);
+    if (hisPool == NULL){
+        PAILLIER_ENCRYPT(NULL, hisPK, r2store->beta, &H_oct, r2store->s);
+    }
+    else{
+        rc = CG21_PAILLIER_POOL_ENCRYPT(hisPool, hisPK, r2store->beta, &H_oct, r2store->s);
+    }
 
     // store -Beta_hat
     OCT_pad(r2store->neg_beta_hat, HFS_4096);
@@ -347,51 +515,195 @@ int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_
     FF_2048_toOctet(r2store->neg_beta_hat,t_, FFLEN_2048);
 
     // Enc(Beta_hat, s_hat)
-    PAILLIER_ENCRYPT(NULL, hisPK, r2store->beta_hat, &H_hat_oct, r2store->s_hat);
+    if (hisPool == NULL){
+        PAILLIER_ENCRYPT(NULL, hisPK, r2store->beta_hat, &H_hat_oct, r2store->s_hat);
+    }
+    else if (rc == CG21_OK){
+        rc = CG21_PAILLIER_POOL_ENCRYPT(hisPool, hisPK, r2store->beta_hat, &H_hat_oct, r2store->s_hat);
+    }
 
     FF_2048_zero(t, FFLEN_2048);
     FF_2048_zero(t_, FFLEN_2048);
 
+    if (rc != CG21_OK){
+        OCT_clear(&H_oct);
+        OCT_clear(&H_hat_oct);
+        return rc;
+    }
+
     /*
     * ---------STEP 6: compute D and D_hat -----------
     * D:                   K*gamma + H
     * D_hat:               K*a + H_hat ('a' is the additive share computed in Round1)
     */
 
-    char oct11[FS_2048];
-    char oct22[FS_2048];
+    char oct11[EGS_SECP256K1];
+    char oct22[EGS_SECP256K1];
     octet OCT1 = {0, sizeof(oct11), oct11};
     octet OCT2 = {0, sizeof(oct22), oct22};
 
+    char ct_hat[FS_4096];
+    octet CT_hat = {0, sizeof(ct_hat), ct_hat};
+
     OCT_copy(&OCT1, r1store->gamma);
     OCT_copy(&OCT2, r1store->a);
 
-    // PAILLIER_MULT takes plaintext as BIG_512_60 pt[HFLEN_4096], so we should pad our PTs
-    OCT_pad(&OCT1, HFS_4096);
-    OCT_pad(&OCT2, HFS_4096);
+    // gamma and a are mod q, so the exponentiations only need the length of q
+    OCT_pad(&OCT1, EGS_SECP256K1);
+    OCT_pad(&OCT2, EGS_SECP256K1);
+
+    octet *PT[2] = {&OCT1, &OCT2};
+    octet *KPT[2] = {&CT, &CT_hat};
 
-    // CT = E_A(K.gamma)
-    PAILLIER_MULT(hisPK, r1output->K, &OCT1, &CT);
+    // CT = E_A(K.gamma), CT_hat = E_A(K.a)
+    CG21_PAILLIER_MULT_SHORT(hisPK, r1output->K, PT, KPT, 2);
 
     // D = E_A(K.gamma + H)
     PAILLIER_ADD(hisPK, &CT, &H_oct, r2output->D);
 
-    // CT = E_A(K.a)
-    PAILLIER_MULT(hisPK, r1output->K, &OCT2, &CT);
-
     // D_hat = E_A(K.a + H_hat)
-    PAILLIER_ADD(hisPK, &CT, &H_hat_oct, r2output->D_hat);
+    PAILLIER_ADD(hisPK, &CT_hat, &H_hat_oct, r2output->D_hat);
 
     OCT_clear(&OCT1);
     OCT_clear(&OCT2);
     OCT_clear(&H_hat_oct);
     OCT_clear(&CT);
+    OCT_clear(&CT_hat);
 
     return CG21_OK;
 }
 
-int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
-                            const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store, int status){
+int CG21_PRESIGN_ROUND2_POOLED(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                               const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                               PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK,
+                               CG21_PAILLIER_POOL *hisPool, CG21_PAILLIER_POOL *myPool){
+
+    BIG_1024_58 q5[FFLEN_2048];
+
+    CG21_PRESIGN_ROUND2_q5(q5);
+
+    return CG21_PRESIGN_ROUND2_q5_GIVEN(RNG, r2output, r2store, r1output, r1store, hisPK, myPK, q5, hisPool, myPool);
+}
+
+int CG21_PRESIGN_ROUND2(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                        const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                        PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK){
+
+    return CG21_PRESIGN_ROUND2_POOLED(RNG, r2output, r2store, r1output, r1store, hisPK, myPK, NULL, NULL);
+}
+
+int CG21_PRESIGN_ROUND2_BATCH(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                              const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                              PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK, int K, int *bad){
+
+    BIG_1024_58 q5[FFLEN_2048];
+
+    if (bad != NULL){
+        *bad = -1;
+    }
+
+    CG21_PRESIGN_ROUND2_q5(q5);
+
+    // the outputs are sent as one message, so the batch stops at the first failure
+    for (int k=0; k<K; k++){
+        int rc = CG21_PRESIGN_ROUND2_q5_GIVEN(RNG, r2output + k, r2store + k, r1output + k, r1store + k, hisPK, myPK, q5, NULL, NULL);
+        if (rc != CG21_OK){
+            if (bad != NULL){
+                *bad = k;
+            }
+            return rc;
+        }
+    }
+
+    return CG21_OK;
+}
+
+/* Arguments of the Round 2 fan-out, shared by all the peers */
+typedef struct{
+    csprng *RNG;                                    // one RNG per peer
+    CG21_PRESIGN_ROUND2_OUTPUT *r2output;
+    CG21_PRESIGN_ROUND2_STORE *r2store;
+    const CG21_PRESIGN_ROUND1_OUTPUT *r1output;
+    const CG21_PRESIGN_ROUND1_STORE *r1store;
+    PAILLIER_public_key *hisPK;
+    PAILLIER_public_key *myPK;
+    CG21_PAILLIER_POOL *hisPool;
+    CG21_PAILLIER_POOL *myPool;
+    BIG_1024_58 *q5;
+} CG21_PRESIGN_ROUND2_FANOUT_ARGS;
+
+static int CG21_PRESIGN_ROUND2_FANOUT_JOB(void *arg, int j){
+    CG21_PRESIGN_ROUND2_FANOUT_ARGS *args = (CG21_PRESIGN_ROUND2_FANOUT_ARGS *)arg;
+
+    CG21_PAILLIER_POOL *hisPool = (args->hisPool == NULL) ? NULL : args->hisPool + j;
+
+    return CG21_PRESIGN_ROUND2_q5_GIVEN(args->RNG + j, args->r2output + j, args->r2store + j, args->r1output + j,
+                                        args->r1store, args->hisPK + j, args->myPK, args->q5, hisPool, args->myPool);
+}
+
+int CG21_PRESIGN_ROUND2_FANOUT(csprng *RNG, CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store,
+                               const CG21_PRESIGN_ROUND1_OUTPUT *r1output, const CG21_PRESIGN_ROUND1_STORE *r1store,
+                               PAILLIER_public_key *hisPK, PAILLIER_public_key *myPK,
+                               CG21_PAILLIER_POOL *hisPool, CG21_PAILLIER_POOL *myPool, int n, int threads){
+
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    BIG_1024_58 q5[FFLEN_2048];
+    csprng rngs[n];
+    char seed[32];
+
+    CG21_PRESIGN_ROUND2_q5(q5);
+
+    // the RNG can not be shared by the threads, so every peer gets its own
+    for (int j=0; j<n; j++){
+        for (int b=0; b<32; b++){
+            seed[b] = (char) RAND_byte(RNG);
+        }
+        RAND_seed(rngs + j, 32, seed);
+    }
+
+    CG21_PRESIGN_ROUND2_FANOUT_ARGS args = {rngs, r2output, r2store, r1output, r1store, hisPK, myPK, hisPool, myPool, q5};
+
+    int rc = CG21_FANOUT(CG21_PRESIGN_ROUND2_FANOUT_JOB, &args, n, threads);
+
+    // clean up
+    for (int j=0; j<n; j++){
+        RAND_clean(rngs + j);
+    }
+
+    for (int b=0; b<32; b++){
+        seed[b] = 0;
+    }
+
+    return rc;
+}
+
+/* Add a point to the running product, in acc if it is given and in the octet O otherwise */
+static int CG21_PRESIGN_ADD_POINT(CG21_ECP_ACCUMULATOR *acc, octet *O, const octet *P){
+    if (acc != NULL){
+        return CG21_ECP_ACCUMULATOR_add(acc, P);
+    }
+
+    return CG21_ADD_TWO_PK(O, P);
+}
+
+/* Start the running product at P, in acc if it is given and in the octet O otherwise */
+static int CG21_PRESIGN_START_POINT(CG21_ECP_ACCUMULATOR *acc, octet *O, const octet *P){
+    if (acc != NULL){
+        CG21_ECP_ACCUMULATOR_init(acc);
+        return CG21_ECP_ACCUMULATOR_add(acc, P);
+    }
+
+    OCT_copy(O, P);
+
+    return CG21_OK;
+}
+
+static int CG21_PRESIGN_ROUND3_2_1_SUM(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                                       const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                       int status, CG21_ECP_ACCUMULATOR *acc){
 
 
     /*
@@ -406,15 +718,23 @@ int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_
     * Gamma:            \prod Gamma_j
     */
 
+    int rc;
+
     r3Store->i = r2Store->i;
     //r3store is from example file is sending each time a different instance, it should be fixed,
     // for each i, same r3store should be sent to this function
     if (status==0 || status==3){
-        OCT_copy(r3Store->Gamma, r2Store->Gamma);
+        rc = CG21_PRESIGN_START_POINT(acc, r3Store->Gamma, r2Store->Gamma);
+        if (rc != CG21_OK){
+            return rc;
+        }
     }
 
     // add Gamma_j to r3Store->Gamma
-    CG21_ADD_TWO_PK(r3Store->Gamma, r2hisOutput->Gamma);
+    rc = CG21_PRESIGN_ADD_POINT(acc, r3Store->Gamma, r2hisOutput->Gamma);
+    if (rc != CG21_OK){
+        return rc;
+    }
 
     /*
     * ---------STEP 2: compute Delta -----------
@@ -427,8 +747,12 @@ int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_
         // convert r1Store->k from octet to BIG_256_56
         BIG_256_56_fromBytesLen(exp, r1Store->k->val, r1Store->k->len);
 
-        // convert r3Store2->Gamma from octet to ECP
-        if (!ECP_SECP256K1_fromOctet(&tt, r3Store->Gamma))
+        // Gamma = \prod Gamma_j
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_output(acc, r3Store->Gamma);
+            ECP_SECP256K1_copy(&tt, &acc->P);
+        }
+        else if (!ECP_SECP256K1_fromOctet(&tt, r3Store->Gamma))
         {
             return CG21_INVALID_ECP;
         }
@@ -447,6 +771,41 @@ int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_
     return CG21_OK;
 }
 
+int CG21_PRESIGN_ROUND3_2_1(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                            const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store, int status){
+    return CG21_PRESIGN_ROUND3_2_1_SUM(r2hisOutput, r3Store, r2Store, r1Store, status, NULL);
+}
+
+int CG21_PRESIGN_ROUND3_2_1_ACC(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                                const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                int status, CG21_ECP_ACCUMULATOR *Gamma_sum){
+    return CG21_PRESIGN_ROUND3_2_1_SUM(r2hisOutput, r3Store, r2Store, r1Store, status, Gamma_sum);
+}
+
+int CG21_PRESIGN_ROUND3_2_1_BATCH(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput, CG21_PRESIGN_ROUND3_STORE_1 *r3Store,
+                                  const CG21_PRESIGN_ROUND2_STORE *r2Store, const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                  int status, int K, int *bad){
+
+    int rc = CG21_OK;
+
+    if (bad != NULL){
+        *bad = -1;
+    }
+
+    // the presignatures are independent, so a failure does not stop the others
+    for (int k=0; k<K; k++){
+        int rck = CG21_PRESIGN_ROUND3_2_1(r2hisOutput + k, r3Store + k, r2Store + k, r1Store + k, status);
+        if (rck != CG21_OK && rc == CG21_OK){
+            rc = rck;
+            if (bad != NULL){
+                *bad = k;
+            }
+        }
+    }
+
+    return rc;
+}
+
 /** \brief Set the value for an accumulator from octets
  *
  * Set the accumulator to V1 * V2
@@ -495,21 +854,11 @@ static void CG21_MTA_ACCUMULATOR_ADD(BIG_256_56 accum, const octet *V)
     BIG_256_56_zero(v);
 }
 
-int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
-                            CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
-                            const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
-                            CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
-                            const CG21_PRESIGN_ROUND1_STORE *r1Store,
-                            PAILLIER_private_key *myKeys,
-                            const CG21_PRESIGN_ROUND2_STORE *r2Store,
-                            int status){
-
-    /*
-     * status = 0      first call
-     * status = 1      neither first call, nor last call
-     * status = 2      last call
-     * status = 3      first and last call (t=2)
-     */
+/* Step 3 of Round 3 for one peer: decrypt D and D_hat and reduce the shares mod q */
+static void CG21_PRESIGN_ROUND3_MTA_SHARES(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                                           PAILLIER_private_key *myKeys,
+                                           const CG21_PRESIGN_ROUND2_STORE *r2Store, BIG_1024_58 *q,
+                                           octet *Alpha, octet *Alpha_hat, octet *Beta, octet *Beta_hat){
 
     /*
     * ---------STEP 3: compute alpha and alpha_hat -----------
@@ -519,36 +868,48 @@ int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
 
     char pt1[FS_2048];
     char pt2[FS_2048];
-    char tt1[EGS_SECP256K1];
-    char tt2[EGS_SECP256K1];
-    char beta[EGS_SECP256K1];
-    char beta_hat[EGS_SECP256K1];
 
     octet PT1 = {0, sizeof(pt1), pt1};
     octet PT2 = {0, sizeof(pt2), pt2};
-    octet Alpha = {0, sizeof(tt1), tt1};
-    octet Alpha_hat = {0, sizeof(tt2), tt2};
-    octet Beta = {0, sizeof(beta), beta};
-    octet Beta_hat = {0, sizeof(beta_hat), beta_hat};
 
-    OCT_clear(&Alpha);
-    OCT_clear(&Alpha_hat);
-    OCT_clear(&Beta);
-    OCT_clear(&Beta_hat);
-
-    r3Store2->i = r2Store->i;
-    r3Output->i = r2Store->i;
-    OCT_copy(r3Output->Delta, r3Store1->Delta);
+    OCT_clear(Alpha);
+    OCT_clear(Alpha_hat);
+    OCT_clear(Beta);
+    OCT_clear(Beta_hat);
 
     PAILLIER_DECRYPT(myKeys, r2hisOutput->D, &PT1);
     PAILLIER_DECRYPT(myKeys, r2hisOutput->D_hat, &PT2);
 
-    CG21_MTA_decrypt_reduce_q(&PT1, &Alpha);
-    CG21_MTA_decrypt_reduce_q(&PT2, &Alpha_hat);
+    CG21_MTA_REDUCE_q(&PT1, Alpha, q);
+    CG21_MTA_REDUCE_q(&PT2, Alpha_hat, q);
+
+    CG21_MTA_REDUCE_q(r2Store->neg_beta, Beta, q);
+    CG21_MTA_REDUCE_q(r2Store->neg_beta_hat, Beta_hat, q);
+
+    // Clean memory
+    OCT_clear(&PT1);
+    OCT_clear(&PT2);
+}
+
+/* Step 4 of Round 3 for one peer: add the shares to delta and chi */
+static void CG21_PRESIGN_ROUND3_MTA_ADD(CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                                        const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                        CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                        const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                        const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                                        const octet *Alpha, const octet *Alpha_hat,
+                                        const octet *Beta, const octet *Beta_hat, int status){
 
-    CG21_MTA_decrypt_reduce_q(r2Store->neg_beta, &Beta);
-    CG21_MTA_decrypt_reduce_q(r2Store->neg_beta_hat, &Beta_hat);
+    /*
+     * status = 0      first call
+     * status = 1      neither first call, nor last call
+     * status = 2      last call
+     * status = 3      first and last call (t=2)
+     */
 
+    r3Store2->i = r2Store->i;
+    r3Output->i = r2Store->i;
+    OCT_copy(r3Output->Delta, r3Store1->Delta);
 
     /*
     * ---------STEP 4: compute delta and chi -----------
@@ -570,12 +931,12 @@ int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
     }
 
     // sum1 = sum1 + alpha + beta
-    CG21_MTA_ACCUMULATOR_ADD(sum1, &Alpha);
-    CG21_MTA_ACCUMULATOR_ADD(sum1, &Beta);
+    CG21_MTA_ACCUMULATOR_ADD(sum1, Alpha);
+    CG21_MTA_ACCUMULATOR_ADD(sum1, Beta);
 
     // sum2 = sum2 + alpha_hat + beta_hat
-    CG21_MTA_ACCUMULATOR_ADD(sum2, &Alpha_hat);
-    CG21_MTA_ACCUMULATOR_ADD(sum2, &Beta_hat);
+    CG21_MTA_ACCUMULATOR_ADD(sum2, Alpha_hat);
+    CG21_MTA_ACCUMULATOR_ADD(sum2, Beta_hat);
 
     // Output result
     BIG_256_56_toBytes(r3Store2->delta->val, sum1);
@@ -589,20 +950,163 @@ int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
     // Clean memory
     BIG_256_56_zero(sum1);
     BIG_256_56_zero(sum2);
+}
+
+static void CG21_PRESIGN_ROUND3_2_2_q_GIVEN(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                                           CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                                           const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                           CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                           const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                           PAILLIER_private_key *myKeys,
+                                           const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                                           int status, BIG_1024_58 *q){
+
+    char tt1[EGS_SECP256K1];
+    char tt2[EGS_SECP256K1];
+    char beta[EGS_SECP256K1];
+    char beta_hat[EGS_SECP256K1];
+
+    octet Alpha = {0, sizeof(tt1), tt1};
+    octet Alpha_hat = {0, sizeof(tt2), tt2};
+    octet Beta = {0, sizeof(beta), beta};
+    octet Beta_hat = {0, sizeof(beta_hat), beta_hat};
+
+    CG21_PRESIGN_ROUND3_MTA_SHARES(r2hisOutput, myKeys, r2Store, q, &Alpha, &Alpha_hat, &Beta, &Beta_hat);
+    CG21_PRESIGN_ROUND3_MTA_ADD(r3Output, r3Store1, r3Store2, r1Store, r2Store,
+                                &Alpha, &Alpha_hat, &Beta, &Beta_hat, status);
+
+    // Clean memory
     OCT_clear(&Alpha);
     OCT_clear(&Alpha_hat);
     OCT_clear(&Beta);
     OCT_clear(&Beta_hat);
-    OCT_clear(&PT1);
-    OCT_clear(&PT2);
+}
+
+int CG21_PRESIGN_ROUND3_2_2(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                            CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                            const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                            CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                            const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                            PAILLIER_private_key *myKeys,
+                            const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                            int status){
+
+    BIG_1024_58 q[FFLEN_2048];
+
+    CG21_MTA_LOAD_q(q);
+    CG21_PRESIGN_ROUND3_2_2_q_GIVEN(r2hisOutput, r3Output, r3Store1, r3Store2, r1Store, myKeys, r2Store, status, q);
 
     return CG21_OK;
 }
 
-int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
-                            const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
-                            CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
-                            int status){
+int CG21_PRESIGN_ROUND3_2_2_BATCH(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                                  CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                                  const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                  CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                  const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                  PAILLIER_private_key *myKeys,
+                                  const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                                  int status, int K){
+
+    BIG_1024_58 q[FFLEN_2048];
+
+    CG21_MTA_LOAD_q(q);
+
+    for (int k=0; k<K; k++){
+        CG21_PRESIGN_ROUND3_2_2_q_GIVEN(r2hisOutput + k, r3Output + k, r3Store1 + k, r3Store2 + k,
+                                        r1Store + k, myKeys, r2Store + k, status, q);
+    }
+
+    return CG21_OK;
+}
+
+/* Arguments of the Round 3 fan-out, shared by all the peers */
+typedef struct{
+    const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput;
+    PAILLIER_private_key *myKeys;
+    const CG21_PRESIGN_ROUND2_STORE *r2Store;
+    BIG_1024_58 *q;
+    octet *shares;                                  // alpha, alpha_hat, beta, beta_hat of each peer
+} CG21_PRESIGN_ROUND3_FANOUT_ARGS;
+
+static int CG21_PRESIGN_ROUND3_FANOUT_JOB(void *arg, int j){
+    CG21_PRESIGN_ROUND3_FANOUT_ARGS *args = (CG21_PRESIGN_ROUND3_FANOUT_ARGS *)arg;
+    octet *shares = args->shares + 4 * j;
+
+    CG21_PRESIGN_ROUND3_MTA_SHARES(args->r2hisOutput + j, args->myKeys, args->r2Store + j, args->q,
+                                   shares, shares + 1, shares + 2, shares + 3);
+
+    return CG21_OK;
+}
+
+/* Status of the call for peer j out of n, as expected by the Round 3 functions */
+static int CG21_PRESIGN_FANOUT_STATUS(int j, int n){
+    if (n == 1){
+        return 3;
+    }
+
+    if (j == 0){
+        return 0;
+    }
+
+    return (j == n - 1) ? 2 : 1;
+}
+
+int CG21_PRESIGN_ROUND3_FANOUT(const CG21_PRESIGN_ROUND2_OUTPUT *r2hisOutput,
+                               CG21_PRESIGN_ROUND3_OUTPUT *r3Output,
+                               CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                               CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                               const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                               PAILLIER_private_key *myKeys,
+                               const CG21_PRESIGN_ROUND2_STORE *r2Store,
+                               int n, int threads){
+
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    // Gamma and Delta only take point additions, run them in order within this call
+    CG21_ECP_ACCUMULATOR Gamma_sum;
+    for (int j=0; j<n; j++){
+        int rc = CG21_PRESIGN_ROUND3_2_1_ACC(r2hisOutput + j, r3Store1, r2Store + j, r1Store,
+                                             CG21_PRESIGN_FANOUT_STATUS(j, n), &Gamma_sum);
+        if (rc != CG21_OK){
+            return rc;
+        }
+    }
+
+    // the decryptions are independent, run them concurrently
+    BIG_1024_58 q[FFLEN_2048];
+
+    char shares_mem[4 * n][EGS_SECP256K1];
+    octet shares[4 * n];
+    init_octets((char *) shares_mem, shares, EGS_SECP256K1, 4 * n);
+
+    CG21_MTA_LOAD_q(q);
+
+    CG21_PRESIGN_ROUND3_FANOUT_ARGS args = {r2hisOutput, myKeys, r2Store, q, shares};
+    int rc = CG21_FANOUT(CG21_PRESIGN_ROUND3_FANOUT_JOB, &args, n, threads);
+
+    // then add the shares to delta and chi in order
+    for (int j=0; j<n && rc == CG21_OK; j++){
+        octet *share = shares + 4 * j;
+
+        CG21_PRESIGN_ROUND3_MTA_ADD(r3Output, r3Store1, r3Store2, r1Store, r2Store + j,
+                                    share, share + 1, share + 2, share + 3, CG21_PRESIGN_FANOUT_STATUS(j, n));
+    }
+
+    // clean up
+    for (int j=0; j<4 * n; j++){
+        OCT_clear(shares + j);
+    }
+
+    return rc;
+}
+
+static int CG21_PRESIGN_OUTPUT_2_1_SUM(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                                       const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                                       CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                                       int status, CG21_ECP_ACCUMULATOR *acc){
 
     /*
      * status = 0      first call
@@ -616,15 +1120,22 @@ int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
      * Delta:           \prod Delta_j
     */
     BIG_256_56 sum;
+    int rc;
 
     if (status==0 || status ==3){
-        OCT_copy(r4Store->Delta, r3myOutput->Delta);
+        rc = CG21_PRESIGN_START_POINT(acc, r4Store->Delta, r3myOutput->Delta);
+        if (rc != CG21_OK){
+            return rc;
+        }
         OCT_copy(r4Store->delta, r3myOutput->delta);
 
     }
 
     // \prod Delta_j
-    CG21_ADD_TWO_PK(r4Store->Delta, r3hisOutput->Delta);
+    rc = CG21_PRESIGN_ADD_POINT(acc, r4Store->Delta, r3hisOutput->Delta);
+    if (rc != CG21_OK){
+        return rc;
+    }
     BIG_256_56_fromBytesLen(sum, r4Store->delta->val, r4Store->delta->len);
 
     CG21_MTA_ACCUMULATOR_ADD(sum, r3hisOutput->delta);
@@ -644,16 +1155,19 @@ int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
         char tt[EFS_SECP256K1 + 1];
         octet deltaG = {0, sizeof(tt), tt};
 
-        ECP_SECP256K1_generator(&G);
         BIG_256_56_fromBytesLen(s, r4Store->delta->val, r4Store->delta->len);
 
-        ECP_SECP256K1_mul(&G, s);
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_output(acc, r4Store->Delta);
+        }
+
+        ECP_GEN_mul(&G, s);
         ECP_SECP256K1_toOctet(&deltaG, &G, true);
 
         BIG_256_56_zero(s);
         ECP_SECP256K1_inf(&G);
 
-        int rc = OCT_comp(r4Store->Delta, &deltaG);
+        rc = OCT_comp(r4Store->Delta, &deltaG);
         OCT_clear(&deltaG);
         if (rc==0){
             return CG21_PRESIGN_DELTA_NOT_VALID;
@@ -663,6 +1177,82 @@ int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
     return CG21_OK;
 }
 
+int CG21_PRESIGN_OUTPUT_2_1(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                            const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                            CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                            int status){
+    return CG21_PRESIGN_OUTPUT_2_1_SUM(r3hisOutput, r3myOutput, r4Store, status, NULL);
+}
+
+int CG21_PRESIGN_OUTPUT_2_1_ACC(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                                const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                                CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                                int status, CG21_ECP_ACCUMULATOR *Delta_sum){
+    return CG21_PRESIGN_OUTPUT_2_1_SUM(r3hisOutput, r3myOutput, r4Store, status, Delta_sum);
+}
+
+int CG21_PRESIGN_OUTPUT_2_1_BATCH(const CG21_PRESIGN_ROUND3_OUTPUT *r3hisOutput,
+                                  const CG21_PRESIGN_ROUND3_OUTPUT *r3myOutput,
+                                  CG21_PRESIGN_ROUND4_STORE_1 *r4Store,
+                                  int status, int K, int *bad){
+
+    int rc = CG21_OK;
+
+    if (bad != NULL){
+        *bad = -1;
+    }
+
+    // the presignatures are independent, so a failure does not stop the others
+    for (int k=0; k<K; k++){
+        int rck = CG21_PRESIGN_OUTPUT_2_1(r3hisOutput + k, r3myOutput + k, r4Store + k, status);
+        if (rck != CG21_OK && rc == CG21_OK){
+            rc = rck;
+            if (bad != NULL){
+                *bad = k;
+            }
+        }
+    }
+
+    return rc;
+}
+
+/* Compute R = Gamma^{delta^{-1}} given delta^{-1} */
+static int CG21_PRESIGN_OUTPUT_2_2_INV_GIVEN(const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                             const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                             const CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                             CG21_PRESIGN_ROUND4_STORE_2 *r4Store2,
+                                             CG21_PRESIGN_ROUND4_OUTPUT *r4Output,
+                                             BIG_256_56 invdelta){
+
+    ECP_SECP256K1 tt;
+
+    r4Output->i = r3Store1->i;
+
+    // convert r3Store2->Gamma from octet to ECP
+    if (!ECP_SECP256K1_fromOctet(&tt, r3Store1->Gamma))
+    {
+        r4Output->PRESIGN_SUCCESS = CG21_PRESIGN_FAILED;
+        return CG21_INVALID_ECP;
+    }
+
+    // computes Gamma^{delta{-1}}
+    ECP_SECP256K1_mul(&tt, invdelta);
+
+    // convert ECP to octet
+    ECP_SECP256K1_toOctet(r4Store2->R, &tt, true);
+
+    // form ROUND3 output and store
+    OCT_copy(r4Store2->chi, r3Store2->chi);
+    OCT_copy(r4Store2->k, r1Store->k);
+    r4Store2->i = r3Store1->i;
+
+    r4Output->PRESIGN_SUCCESS = CG21_OK;
+
+    ECP_SECP256K1_inf(&tt);
+
+    return CG21_OK;
+}
+
 int CG21_PRESIGN_OUTPUT_2_2(const CG21_PRESIGN_ROUND1_STORE *r1Store,
                             const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
                             const CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
@@ -677,42 +1267,114 @@ int CG21_PRESIGN_OUTPUT_2_2(const CG21_PRESIGN_ROUND1_STORE *r1Store,
     BIG_256_56 delta;
     BIG_256_56 invdelta;
     BIG_256_56 q;
-    ECP_SECP256K1 tt;
-
-    r4Output->i = r3Store1->i;
 
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
     BIG_256_56_fromBytesLen(delta, r4Store1->delta->val, r4Store1->delta->len);
     BIG_256_56_invmodp(invdelta, delta, q);
 
+    int rc = CG21_PRESIGN_OUTPUT_2_2_INV_GIVEN(r1Store, r3Store1, r3Store2, r4Store2, r4Output, invdelta);
 
-    // convert r3Store2->Gamma from octet to ECP
-    if (!ECP_SECP256K1_fromOctet(&tt, r3Store1->Gamma))
-    {
+    BIG_256_56_zero(delta);
+    BIG_256_56_zero(invdelta);
 
-        BIG_256_56_zero(delta);
-        BIG_256_56_zero(invdelta);
+    return rc;
+}
 
-        r4Output->PRESIGN_SUCCESS = CG21_PRESIGN_FAILED;
-        return CG21_INVALID_ECP;
+int CG21_PRESIGN_OUTPUT_2_2_BATCH(const CG21_PRESIGN_ROUND1_STORE *r1Store,
+                                  const CG21_PRESIGN_ROUND3_STORE_1 *r3Store1,
+                                  const CG21_PRESIGN_ROUND3_STORE_2 *r3Store2,
+                                  const CG21_PRESIGN_ROUND4_STORE_1 *r4Store1,
+                                  CG21_PRESIGN_ROUND4_STORE_2 *r4Store2,
+                                  CG21_PRESIGN_ROUND4_OUTPUT *r4Output, int K, int *bad){
+
+    int rc = CG21_OK;
+    int rck;
+
+    BIG_256_56 delta;
+    BIG_256_56 inv;
+    BIG_256_56 invdelta;
+    BIG_256_56 q;
+    BIG_256_56 prod[K > 0 ? K : 1];
+    bool valid[K > 0 ? K : 1];
+
+    if (bad != NULL){
+        *bad = -1;
     }
 
-    // computes Gamma^{delta{-1}}
-    ECP_SECP256K1_mul(&tt, invdelta);
+    if (K < 1){
+        return CG21_OK;
+    }
 
-    // convert ECP to octet
-    ECP_SECP256K1_toOctet(r4Store2->R, &tt, true);
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
 
-    // form ROUND3 output and store
-    OCT_copy(r4Store2->chi, r3Store2->chi);
-    OCT_copy(r4Store2->k, r1Store->k);
-    r4Store2->i = r3Store1->i;
+    /*
+     * Invert all the deltas with a single inversion:
+     * prod[k] = delta_0 * ... * delta_k, then walk back from
+     * prod[K-1]^{-1} peeling off one delta at a time.
+     * A zero delta is left out of the products, so that it
+     * only fails its own presignature
+     */
+    for (int k=0; k<K; k++){
+        BIG_256_56_fromBytesLen(delta, r4Store1[k].delta->val, r4Store1[k].delta->len);
+        BIG_256_56_mod(delta, q);
 
-    r4Output->PRESIGN_SUCCESS = CG21_OK;
+        valid[k] = !BIG_256_56_iszilch(delta);
+        if (!valid[k]){
+            BIG_256_56_one(delta);
+        }
+
+        if (k == 0){
+            BIG_256_56_copy(prod[0], delta);
+        }
+        else{
+            BIG_256_56_modmul(prod[k], prod[k-1], delta, q);
+        }
+    }
+
+    BIG_256_56_invmodp(inv, prod[K-1], q);
 
+    for (int k=K-1; k>=0; k--){
+        BIG_256_56_fromBytesLen(delta, r4Store1[k].delta->val, r4Store1[k].delta->len);
+        BIG_256_56_mod(delta, q);
+        if (!valid[k]){
+            BIG_256_56_one(delta);
+        }
+
+        if (k == 0){
+            BIG_256_56_copy(invdelta, inv);
+        }
+        else{
+            // delta_k^{-1} = (delta_0 * ... * delta_k)^{-1} * (delta_0 * ... * delta_{k-1})
+            BIG_256_56_modmul(invdelta, inv, prod[k-1], q);
+            BIG_256_56_modmul(inv, inv, delta, q);
+        }
+
+        if (valid[k]){
+            rck = CG21_PRESIGN_OUTPUT_2_2_INV_GIVEN(r1Store + k, r3Store1 + k, r3Store2 + k,
+                                                    r4Store2 + k, r4Output + k, invdelta);
+        }
+        else{
+            r4Output[k].i = r3Store1[k].i;
+            r4Output[k].PRESIGN_SUCCESS = CG21_PRESIGN_FAILED;
+            rck = CG21_PRESIGN_DELTA_NOT_VALID;
+        }
+
+        // report the first failed presignature
+        if (rck != CG21_OK){
+            rc = rck;
+            if (bad != NULL){
+                *bad = k;
+            }
+        }
+    }
+
+    // clean up
+    for (int k=0; k<K; k++){
+        BIG_256_56_zero(prod[k]);
+    }
     BIG_256_56_zero(delta);
+    BIG_256_56_zero(inv);
     BIG_256_56_zero(invdelta);
-    ECP_SECP256K1_inf(&tt);
 
-    return CG21_OK;
+    return rc;
 }
\ No newline at end of file
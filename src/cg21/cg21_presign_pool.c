@@ -0,0 +1,343 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/cg21/cg21_presign_pool.h"
+
+static void CG21_PRESIGN_POOL_ENTRY_KILL(CG21_PRESIGN_POOL_ENTRY *entry){
+    octet R = {0, sizeof(entry->R), entry->R};
+    octet chi = {0, sizeof(entry->chi), entry->chi};
+    octet k = {0, sizeof(entry->k), entry->k};
+
+    OCT_clear(&R);
+    OCT_clear(&chi);
+    OCT_clear(&k);
+
+    entry->id = -1;
+    entry->ready = 0;
+}
+
+/* Copy the presignature out of the entry and clean the entry,
+ * so that it can not be handed out again
+ */
+static void CG21_PRESIGN_POOL_ENTRY_OUT(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_POOL_ENTRY *entry,
+                                        CG21_PRESIGN_ROUND4_STORE_2 *pre){
+    OCT_clear(pre->R);
+    OCT_jbytes(pre->R, entry->R, sizeof(entry->R));
+    OCT_clear(pre->chi);
+    OCT_jbytes(pre->chi, entry->chi, sizeof(entry->chi));
+    OCT_clear(pre->k);
+    OCT_jbytes(pre->k, entry->k, sizeof(entry->k));
+    pre->i = pool->i;
+
+    CG21_PRESIGN_POOL_ENTRY_KILL(entry);
+    pool->count--;
+
+    // A slot might be free for the background generation
+    pthread_cond_broadcast(&pool->cond);
+}
+
+/* Skip the presignatures already taken by id and return the number of free
+ * entries. Each sequence number is skipped once, so this is O(1) amortized
+ */
+static int CG21_PRESIGN_POOL_FREE(CG21_PRESIGN_POOL *pool){
+    while (pool->head < pool->tail && !pool->entries[pool->head % pool->capacity].ready){
+        pool->head++;
+    }
+
+    return pool->capacity - (pool->tail - pool->head);
+}
+
+static int CG21_PRESIGN_POOL_PUT_LOCKED(CG21_PRESIGN_POOL *pool, const CG21_PRESIGN_ROUND4_STORE_2 *pre, int *id){
+    if (pre->R->len != EFS_SECP256K1 + 1 || pre->chi->len != EGS_SECP256K1 ||
+        pre->k->len != EGS_SECP256K1 || pre->i != pool->i){
+        return CG21_PRESIGN_POOL_INVALID;
+    }
+
+    if (CG21_PRESIGN_POOL_FREE(pool) == 0){
+        return CG21_PRESIGN_POOL_FULL;
+    }
+
+    CG21_PRESIGN_POOL_ENTRY *entry = pool->entries + (pool->tail % pool->capacity);
+
+    octet R = {0, sizeof(entry->R), entry->R};
+    octet chi = {0, sizeof(entry->chi), entry->chi};
+    octet k = {0, sizeof(entry->k), entry->k};
+
+    OCT_copy(&R, pre->R);
+    OCT_copy(&chi, pre->chi);
+    OCT_copy(&k, pre->k);
+
+    entry->id = pool->tail;
+    entry->ready = 1;
+
+    if (id != NULL){
+        *id = pool->tail;
+    }
+
+    pool->tail++;
+    pool->count++;
+
+    return CG21_OK;
+}
+
+int CG21_PRESIGN_POOL_INIT(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_POOL_ENTRY *entries, int capacity, int i){
+    if (entries == NULL || capacity < 1){
+        return CG21_PRESIGN_POOL_INVALID;
+    }
+
+    pool->entries = entries;
+    pool->capacity = capacity;
+    pool->i = i;
+    pool->head = 0;
+    pool->tail = 0;
+    pool->count = 0;
+
+    for (int j=0; j<capacity; j++){
+        CG21_PRESIGN_POOL_ENTRY_KILL(entries + j);
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    pool->generator = NULL;
+    pool->arg = NULL;
+    pool->low = 0;
+    pool->running = 0;
+    pool->rc = CG21_OK;
+
+    return CG21_OK;
+}
+
+void CG21_PRESIGN_POOL_KILL(CG21_PRESIGN_POOL *pool){
+    CG21_PRESIGN_POOL_STOP(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    for (int j=0; j<pool->capacity; j++){
+        CG21_PRESIGN_POOL_ENTRY_KILL(pool->entries + j);
+    }
+
+    pool->head = 0;
+    pool->tail = 0;
+    pool->count = 0;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+int CG21_PRESIGN_POOL_PUT(CG21_PRESIGN_POOL *pool, const CG21_PRESIGN_ROUND4_STORE_2 *pre, int *id){
+    pthread_mutex_lock(&pool->lock);
+    int rc = CG21_PRESIGN_POOL_PUT_LOCKED(pool, pre, id);
+    pthread_mutex_unlock(&pool->lock);
+
+    return rc;
+}
+
+int CG21_PRESIGN_POOL_CHECKOUT(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_ROUND4_STORE_2 *pre, int *id){
+    pthread_mutex_lock(&pool->lock);
+
+    CG21_PRESIGN_POOL_FREE(pool);
+    if (pool->head == pool->tail){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRESIGN_POOL_EMPTY;
+    }
+
+    *id = pool->head;
+    CG21_PRESIGN_POOL_ENTRY_OUT(pool, pool->entries + (pool->head % pool->capacity), pre);
+    pool->head++;
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return CG21_OK;
+}
+
+int CG21_PRESIGN_POOL_TAKE(CG21_PRESIGN_POOL *pool, int id, CG21_PRESIGN_ROUND4_STORE_2 *pre){
+    pthread_mutex_lock(&pool->lock);
+
+    if (id < pool->head || id >= pool->tail){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRESIGN_POOL_UNKNOWN_ID;
+    }
+
+    CG21_PRESIGN_POOL_ENTRY *entry = pool->entries + (id % pool->capacity);
+    if (!entry->ready || entry->id != id){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRESIGN_POOL_UNKNOWN_ID;
+    }
+
+    CG21_PRESIGN_POOL_ENTRY_OUT(pool, entry, pre);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return CG21_OK;
+}
+
+int CG21_PRESIGN_POOL_SIGN(CG21_PRESIGN_POOL *pool, int *id, octet *msg,
+                           CG21_SIGN_ROUND1_STORE *store, CG21_SIGN_ROUND1_OUTPUT *out){
+    int rc;
+
+    char r[EFS_SECP256K1 + 1];
+    octet R = {0, sizeof(r), r};
+
+    char c[EGS_SECP256K1];
+    octet CHI = {0, sizeof(c), c};
+
+    char k[EGS_SECP256K1];
+    octet K = {0, sizeof(k), k};
+
+    CG21_PRESIGN_ROUND4_STORE_2 pre = {&R, &CHI, &K, 0};
+
+    if (*id < 0){
+        rc = CG21_PRESIGN_POOL_CHECKOUT(pool, &pre, id);
+    }
+    else{
+        rc = CG21_PRESIGN_POOL_TAKE(pool, *id, &pre);
+    }
+
+    if (rc == CG21_OK){
+        rc = CG21_SIGN_ROUND1(msg, &pre, store, out);
+    }
+
+    // clean up
+    OCT_clear(&R);
+    OCT_clear(&CHI);
+    OCT_clear(&K);
+
+    return rc;
+}
+
+int CG21_PRESIGN_POOL_SIZE(CG21_PRESIGN_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+    int count = pool->count;
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+}
+
+static void *CG21_PRESIGN_POOL_PRODUCER(void *arg){
+    CG21_PRESIGN_POOL *pool = (CG21_PRESIGN_POOL *)arg;
+
+    char r[EFS_SECP256K1 + 1];
+    octet R = {0, sizeof(r), r};
+
+    char c[EGS_SECP256K1];
+    octet CHI = {0, sizeof(c), c};
+
+    char k[EGS_SECP256K1];
+    octet K = {0, sizeof(k), k};
+
+    CG21_PRESIGN_ROUND4_STORE_2 pre = {&R, &CHI, &K, 0};
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->running){
+
+        // wait until the pool runs low
+        if (pool->count >= pool->low || CG21_PRESIGN_POOL_FREE(pool) == 0){
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+
+        // then refill it
+        while (pool->running && CG21_PRESIGN_POOL_FREE(pool) > 0){
+
+            // the generator talks to the other players, so it runs unlocked
+            pthread_mutex_unlock(&pool->lock);
+            int rc = pool->generator(pool->arg, &pre);
+            pthread_mutex_lock(&pool->lock);
+
+            if (rc == CG21_OK){
+                rc = CG21_PRESIGN_POOL_PUT_LOCKED(pool, &pre, NULL);
+            }
+
+            OCT_clear(&R);
+            OCT_clear(&CHI);
+            OCT_clear(&K);
+
+            // a presignature stored with CG21_PRESIGN_POOL_PUT in the meantime
+            // may have taken the last slot, which is not an error
+            if (rc != CG21_OK && rc != CG21_PRESIGN_POOL_FULL){
+                pool->rc = rc;
+                pool->running = 0;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int CG21_PRESIGN_POOL_START(CG21_PRESIGN_POOL *pool, CG21_PRESIGN_GENERATOR generator, void *arg, int low){
+    if (generator == NULL || low < 1 || low > pool->capacity){
+        return CG21_PRESIGN_POOL_INVALID;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    // the generator is reset only once the thread is joined
+    if (pool->generator != NULL){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRESIGN_POOL_RUNNING;
+    }
+
+    pool->generator = generator;
+    pool->arg = arg;
+    pool->low = low;
+    pool->running = 1;
+    pool->rc = CG21_OK;
+
+    if (pthread_create(&pool->producer, NULL, CG21_PRESIGN_POOL_PRODUCER, pool) != 0){
+        pool->generator = NULL;
+        pool->running = 0;
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRESIGN_POOL_INVALID;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return CG21_OK;
+}
+
+int CG21_PRESIGN_POOL_STOP(CG21_PRESIGN_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->generator == NULL){
+        int rc = pool->rc;
+        pthread_mutex_unlock(&pool->lock);
+        return rc;
+    }
+
+    pool->running = 0;
+    pthread_cond_broadcast(&pool->cond);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_join(pool->producer, NULL);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->generator = NULL;
+    pool->arg = NULL;
+    int rc = pool->rc;
+    pthread_mutex_unlock(&pool->lock);
+
+    return rc;
+}
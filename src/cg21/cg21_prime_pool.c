@@ -0,0 +1,473 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdlib.h>
+#include "amcl/cg21/cg21_prime_pool.h"
+
+static void CG21_PRIME_POOL_ENTRY_KILL(CG21_PRIME_POOL_ENTRY *entry){
+    octet P = {0, sizeof(entry->P), entry->P};
+
+    OCT_clear(&P);
+}
+
+/* Seed the RNG of one search. Must be called with the lock held, since the pool RNG is shared */
+static void CG21_PRIME_POOL_SEED_LOCKED(CG21_PRIME_POOL *pool, csprng *RNG){
+    char seed[32];
+
+    for (int j=0; j<32; j++){
+        seed[j] = (char) RAND_byte(&pool->RNG);
+    }
+    RAND_seed(RNG, 32, seed);
+
+    for (int j=0; j<32; j++){
+        seed[j] = 0;
+    }
+}
+
+/* Search one safe prime P */
+static void CG21_PRIME_POOL_SEARCH(CG21_PRIME_POOL *pool, csprng *RNG, BIG_1024_58 *P){
+    BIG_1024_58 p[HFLEN_2048];
+
+    safe_prime_gen_mt(RNG, p, P, 1, HFLEN_2048, pool->threads);
+
+    FF_2048_zero(p, HFLEN_2048);
+}
+
+/* Store a prime. Must be called with the lock held and a free entry */
+static void CG21_PRIME_POOL_PUT_LOCKED(CG21_PRIME_POOL *pool, octet *P){
+    CG21_PRIME_POOL_ENTRY *entry = pool->entries + ((pool->head + pool->count) % pool->capacity);
+
+    for (int b=0; b<HFS_2048; b++){
+        entry->P[b] = P->val[b];
+    }
+
+    pool->count++;
+}
+
+/* Search one prime and store it. Called with the lock held,
+ * which is released during the search
+ */
+static int CG21_PRIME_POOL_ADD_LOCKED(CG21_PRIME_POOL *pool){
+    int added = 0;
+
+    BIG_1024_58 P[HFLEN_2048];
+    csprng RNG;
+
+    char p[HFS_2048];
+    octet PO = {0, sizeof(p), p};
+
+    CG21_PRIME_POOL_SEED_LOCKED(pool, &RNG);
+
+    pthread_mutex_unlock(&pool->lock);
+    CG21_PRIME_POOL_SEARCH(pool, &RNG, P);
+    FF_2048_toOctet(&PO, P, HFLEN_2048);
+    pthread_mutex_lock(&pool->lock);
+
+    // the pool may have been filled by another thread in the meantime
+    if (pool->count < pool->capacity){
+        CG21_PRIME_POOL_PUT_LOCKED(pool, &PO);
+        added = 1;
+    }
+
+    FF_2048_zero(P, HFLEN_2048);
+    OCT_clear(&PO);
+    RAND_clean(&RNG);
+
+    return added;
+}
+
+/* Compare two octets of the same length without branching on their content */
+static int CG21_PRIME_POOL_CT_EQUAL(octet *X, octet *Y){
+    char d = 0;
+
+    if (X->len != Y->len){
+        return 0;
+    }
+
+    for (int b=0; b<X->len; b++){
+        d |= X->val[b] ^ Y->val[b];
+    }
+
+    return d == 0;
+}
+
+int CG21_PRIME_POOL_INIT(CG21_PRIME_POOL *pool, CG21_PRIME_POOL_ENTRY *entries, int capacity,
+                         csprng *RNG, int threads){
+    char seed[32];
+
+    if (entries == NULL || capacity < 1 || threads < 1){
+        return CG21_PRIME_POOL_INVALID;
+    }
+
+    pool->entries = entries;
+    pool->capacity = capacity;
+    pool->head = 0;
+    pool->count = 0;
+    pool->threads = threads;
+
+    for (int j=0; j<capacity; j++){
+        CG21_PRIME_POOL_ENTRY_KILL(entries + j);
+    }
+
+    // the pool has its own RNG, so it can be used from the background thread
+    for (int j=0; j<32; j++){
+        seed[j] = (char) RAND_byte(RNG);
+    }
+    RAND_seed(&pool->RNG, 32, seed);
+
+    for (int j=0; j<32; j++){
+        seed[j] = 0;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    pool->low = 0;
+    pool->running = 0;
+
+    return CG21_OK;
+}
+
+void CG21_PRIME_POOL_KILL(CG21_PRIME_POOL *pool){
+    CG21_PRIME_POOL_STOP(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    for (int j=0; j<pool->capacity; j++){
+        CG21_PRIME_POOL_ENTRY_KILL(pool->entries + j);
+    }
+
+    pool->head = 0;
+    pool->count = 0;
+
+    RAND_clean(&pool->RNG);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+}
+
+int CG21_PRIME_POOL_FILL(CG21_PRIME_POOL *pool, int count){
+    int added = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (added < count && pool->count < pool->capacity){
+        added += CG21_PRIME_POOL_ADD_LOCKED(pool);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return added;
+}
+
+int CG21_PRIME_POOL_SIZE(CG21_PRIME_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+    int count = pool->count;
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+}
+
+static void *CG21_PRIME_POOL_PRODUCER(void *arg){
+    CG21_PRIME_POOL *pool = (CG21_PRIME_POOL *)arg;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (pool->running){
+
+        // wait until the pool runs low
+        if (pool->count >= pool->low){
+            pthread_cond_wait(&pool->cond, &pool->lock);
+            continue;
+        }
+
+        // then refill it
+        while (pool->running && pool->count < pool->capacity){
+            CG21_PRIME_POOL_ADD_LOCKED(pool);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+int CG21_PRIME_POOL_START(CG21_PRIME_POOL *pool, int low){
+    if (low < 1 || low > pool->capacity){
+        return CG21_PRIME_POOL_INVALID;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->running){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRIME_POOL_RUNNING;
+    }
+
+    pool->low = low;
+    pool->running = 1;
+
+    if (pthread_create(&pool->producer, NULL, CG21_PRIME_POOL_PRODUCER, pool) != 0){
+        pool->running = 0;
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRIME_POOL_INVALID;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    return CG21_OK;
+}
+
+void CG21_PRIME_POOL_STOP(CG21_PRIME_POOL *pool){
+    pthread_mutex_lock(&pool->lock);
+
+    if (!pool->running){
+        pthread_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    pool->running = 0;
+    pthread_cond_broadcast(&pool->cond);
+
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_join(pool->producer, NULL);
+}
+
+void CG21_PRIME_POOL_TAKE(CG21_PRIME_POOL *pool, octet *P){
+    BIG_1024_58 x[HFLEN_2048];
+    csprng RNG;
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (pool->count > 0){
+        CG21_PRIME_POOL_ENTRY *entry = pool->entries + pool->head;
+
+        OCT_empty(P);
+        OCT_jbytes(P, entry->P, HFS_2048);
+
+        // the prime is handed out only once
+        CG21_PRIME_POOL_ENTRY_KILL(entry);
+        pool->head = (pool->head + 1) % pool->capacity;
+        pool->count--;
+
+        pthread_cond_signal(&pool->cond);
+        pthread_mutex_unlock(&pool->lock);
+
+        return;
+    }
+
+    CG21_PRIME_POOL_SEED_LOCKED(pool, &RNG);
+    pthread_mutex_unlock(&pool->lock);
+
+    CG21_PRIME_POOL_SEARCH(pool, &RNG, x);
+    FF_2048_toOctet(P, x, HFLEN_2048);
+
+    // clean up
+    FF_2048_zero(x, HFLEN_2048);
+    RAND_clean(&RNG);
+}
+
+void CG21_PRIME_POOL_KEYS(CG21_PRIME_POOL *pool, csprng *RNG, CG21_PAILLIER_KEYS *paillier, CG21_PEDERSEN_KEYS *pedersen){
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    CG21_PRIME_POOL_TAKE(pool, &P);
+    CG21_PRIME_POOL_TAKE(pool, &Q);
+
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &paillier->paillier_pk, &paillier->paillier_sk);
+
+    ring_Pedersen_setup(RNG, &pedersen->pedersenPriv, &P, &Q);
+    Pedersen_get_public_param(&pedersen->pedersenPub, &pedersen->pedersenPriv);
+
+    // clean up
+    OCT_clear(&P);
+    OCT_clear(&Q);
+}
+
+/* Check if P is already stored. Must be called with the lock held */
+static int CG21_PRIME_POOL_CONTAINS_LOCKED(CG21_PRIME_POOL *pool, octet *P){
+    for (int j=0; j<pool->count; j++){
+        CG21_PRIME_POOL_ENTRY *entry = pool->entries + ((pool->head + j) % pool->capacity);
+        octet E = {HFS_2048, HFS_2048, entry->P};
+
+        if (CG21_PRIME_POOL_CT_EQUAL(&E, P)){
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int CG21_PRIME_POOL_EXPORT(CG21_PRIME_POOL *pool, csprng *RNG, octet *K, octet *OUT){
+    char h[CG21_PRIME_POOL_HEADER_SIZE];
+    octet H = {0, sizeof(h), h};
+
+    char iv[CG21_PRIME_POOL_IV_SIZE];
+    octet IV = {0, sizeof(iv), iv};
+
+    char t[CG21_PRIME_POOL_TAG_SIZE];
+    octet T = {0, sizeof(t), t};
+
+    pthread_mutex_lock(&pool->lock);
+
+    int k = pool->count;
+    if (OUT->max < CG21_PRIME_POOL_EXPORT_SIZE(k)){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRIME_POOL_OUTPUT_TOO_SMALL;
+    }
+
+    // keep the buffer non empty when the pool is empty
+    char *pt = malloc(k * HFS_2048 + 1);
+    if (pt == NULL){
+        pthread_mutex_unlock(&pool->lock);
+        return CG21_PRIME_POOL_INVALID;
+    }
+    octet PT = {0, k * HFS_2048 + 1, pt};
+
+    // take the primes out, oldest first, so they only live in the export
+    for (int j=0; j<k; j++){
+        CG21_PRIME_POOL_ENTRY *entry = pool->entries + pool->head;
+
+        OCT_jbytes(&PT, entry->P, HFS_2048);
+
+        CG21_PRIME_POOL_ENTRY_KILL(entry);
+        pool->head = (pool->head + 1) % pool->capacity;
+    }
+    pool->count = 0;
+
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    // header: version and number of primes
+    OCT_jbyte(&H, CG21_PRIME_POOL_VERSION, 1);
+    OCT_jint(&H, k, 4);
+
+    OCT_rand(&IV, RNG, CG21_PRIME_POOL_IV_SIZE);
+
+    // the encrypted primes are written straight into OUT
+    octet CT = {0, k * HFS_2048, OUT->val + CG21_PRIME_POOL_HEADER_SIZE + CG21_PRIME_POOL_IV_SIZE};
+
+    AES_GCM_ENCRYPT(K, &IV, &H, &PT, &CT, &T);
+
+    OCT_copy(OUT, &H);
+    OCT_joctet(OUT, &IV);
+    OUT->len += CT.len;
+    OCT_joctet(OUT, &T);
+
+    // clean up
+    OCT_clear(&PT);
+    free(pt);
+
+    return CG21_OK;
+}
+
+int CG21_PRIME_POOL_IMPORT(CG21_PRIME_POOL *pool, octet *K, octet *IN){
+    int k;
+    int rc = CG21_OK;
+
+    if (IN->len < CG21_PRIME_POOL_EXPORT_SIZE(0)){
+        return CG21_PRIME_POOL_INVALID_FORMAT;
+    }
+
+    if (IN->val[0] != CG21_PRIME_POOL_VERSION){
+        return CG21_PRIME_POOL_WRONG_VERSION;
+    }
+
+    unsigned int u = 0;
+    for (int b=1; b<CG21_PRIME_POOL_HEADER_SIZE; b++){
+        u = (u << 8) | (unsigned char) IN->val[b];
+    }
+
+    // bound the number of primes before computing the expected length
+    if (u > (unsigned int) ((IN->len - CG21_PRIME_POOL_EXPORT_SIZE(0)) / HFS_2048)){
+        return CG21_PRIME_POOL_INVALID_FORMAT;
+    }
+
+    k = (int) u;
+    if (IN->len != CG21_PRIME_POOL_EXPORT_SIZE(k)){
+        return CG21_PRIME_POOL_INVALID_FORMAT;
+    }
+
+    // reject an export that can not fit before decrypting it
+    pthread_mutex_lock(&pool->lock);
+    int room = pool->capacity - pool->count;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (k > room){
+        return CG21_PRIME_POOL_INVALID;
+    }
+
+    // keep the buffer non empty when the pool was exported empty
+    char *pt = malloc(k * HFS_2048 + 1);
+    if (pt == NULL){
+        return CG21_PRIME_POOL_INVALID;
+    }
+    octet PT = {0, k * HFS_2048 + 1, pt};
+
+    octet H = {CG21_PRIME_POOL_HEADER_SIZE, CG21_PRIME_POOL_HEADER_SIZE, IN->val};
+    octet IV = {CG21_PRIME_POOL_IV_SIZE, CG21_PRIME_POOL_IV_SIZE, IN->val + CG21_PRIME_POOL_HEADER_SIZE};
+    octet CT = {k * HFS_2048, k * HFS_2048, IN->val + CG21_PRIME_POOL_HEADER_SIZE + CG21_PRIME_POOL_IV_SIZE};
+    octet TI = {CG21_PRIME_POOL_TAG_SIZE, CG21_PRIME_POOL_TAG_SIZE, IN->val + IN->len - CG21_PRIME_POOL_TAG_SIZE};
+
+    char t[CG21_PRIME_POOL_TAG_SIZE];
+    octet T = {0, sizeof(t), t};
+
+    AES_GCM_DECRYPT(K, &IV, &H, &CT, &PT, &T);
+
+    if (!CG21_PRIME_POOL_CT_EQUAL(&T, &TI)){
+        rc = CG21_PRIME_POOL_AUTH_FAIL;
+    }
+
+    if (rc == CG21_OK){
+        pthread_mutex_lock(&pool->lock);
+
+        // the pool may have been filled by another thread in the meantime
+        if (k > pool->capacity - pool->count){
+            rc = CG21_PRIME_POOL_INVALID;
+        }
+
+        // a prime must not be handed out twice
+        for (int j=0; j<k && rc == CG21_OK; j++){
+            octet P = {HFS_2048, HFS_2048, pt + j * HFS_2048};
+
+            if (CG21_PRIME_POOL_CONTAINS_LOCKED(pool, &P)){
+                rc = CG21_PRIME_POOL_DUPLICATE;
+            }
+        }
+
+        for (int j=0; j<k && rc == CG21_OK; j++){
+            octet P = {HFS_2048, HFS_2048, pt + j * HFS_2048};
+            CG21_PRIME_POOL_PUT_LOCKED(pool, &P);
+        }
+
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    // clean up
+    OCT_clear(&PT);
+    free(pt);
+
+    return rc;
+}
@@ -141,9 +141,8 @@ int CG21_KEY_RESHARE_ROUND1_T1(csprng *RNG, const CG21_SSID *ssid, int ID, CG21_
     SSS_shamir_to_additive(setting.t1, myShare->X, myShare->Y, X, storeSecret->a);
 
     // computes public Key associated with the additive share
-    ECP_SECP256K1_generator(&G);
     BIG_256_56_fromBytesLen(w, storeSecret->a->val, storeSecret->a->len);
-    ECP_SECP256K1_mul(&G, w);
+    ECP_GEN_mul(&G, w);
     ECP_SECP256K1_toOctet(storePub->Xi, &G, true);
     BIG_256_56_zero(w); // clean up the secret
 
@@ -344,38 +343,32 @@ int CG21_KEY_RESHARE_ROUND3_CHECK_V_N2(const CG21_SSID *ssid,
 }
 
 static int CG21_CHECK_PARTIAL_PK(CG21_RESHARE_SETTING setting, octet *pack_pk_sum_shares, const octet *myX,
-                          const CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3){
+                          const CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                          CG21_LAGRANGE_CACHE *lagrange){
 
     int z = setting.n1-1;
-    BIG_256_56 hisX;
     BIG_256_56 coeff;
 
     char cc[z][EFS_SECP256K1 + 1];
     octet CC[z];
     init_octets((char *)cc,   CC,   EFS_SECP256K1 + 1, z);
 
-    char x_[setting.t1-1][EGS_SECP256K1];
-    octet X[setting.t1-1];
-    init_octets((char *) x_, X, EGS_SECP256K1, setting.t1-1);
-
-    char x2_[EGS_SECP256K1];
-    octet X2 = {0, sizeof(x2_), x2_};
-
     // unpack packed PK of sum-of-the-shares into array of octets
     int rc = CG21_unpack(pack_pk_sum_shares, z, CC, EFS_SECP256K1 + 1);
     if (rc!=CG21_OK){
         return rc;
     }
 
-    /* calculate Lagrangian coefficient for the party ReceiveR3->i */
-    CG21_lagrange_index_to_octet(setting.t1, setting.T1, *ReceiveR3->i, X);
-    BIG_256_56_zero(hisX);
-    BIG_256_56_inc(hisX, *ReceiveR3->i);
-
-    BIG_256_56_toBytes(X2.val, hisX);
-    X2.len = SGS_SECP256K1;
-
-    CG21_lagrange_calc_coeff(setting.t1, &X2, X, &coeff);
+    /* Lagrangian coefficient for the party ReceiveR3->i, computed with the others of T1 */
+    if (lagrange == NULL){
+        rc = CG21_lagrange_coeff(setting.t1, setting.T1, *ReceiveR3->i, coeff);
+    }
+    else{
+        rc = CG21_LAGRANGE_CACHE_coeff(lagrange, setting.t1, setting.T1, *ReceiveR3->i, coeff);
+    }
+    if (rc!=CG21_OK){
+        return rc;
+    }
 
     // convert big to int
     BIG_256_56 myXBig;
@@ -418,10 +411,19 @@ static int CG21_CHECK_PARTIAL_PK(CG21_RESHARE_SETTING setting, octet *pack_pk_su
     return CG21_OK;
 }
 
-int CG21_KEY_RESHARE_CHECK_VSS_T1(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
-                                  const CG21_RESHARE_ROUND1_STORE_PUB_T1 *myR3_T1, const SSS_shares *SS_R3, octet *myX,
-                                  octet *PK, octet *X, octet *pack_pk_sum_shares, CG21_RESHARE_ROUND4_STORE *r3Store,
-                                  int Xstatus){
+/* Add a partial PK to the running sum, in acc if it is given and in the octet X otherwise */
+static int CG21_KEY_RESHARE_ADD_PK(CG21_ECP_ACCUMULATOR *acc, octet *X, const octet *Xi){
+    if (acc != NULL){
+        return CG21_ECP_ACCUMULATOR_add(acc, Xi);
+    }
+
+    return CG21_ADD_TWO_PK(X, Xi);
+}
+
+static int CG21_KEY_RESHARE_CHECK_VSS_T1_SUM(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                             const CG21_RESHARE_ROUND1_STORE_PUB_T1 *myR3_T1, const SSS_shares *SS_R3, octet *myX,
+                                             octet *PK, octet *X, octet *pack_pk_sum_shares, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                             int Xstatus, CG21_ECP_ACCUMULATOR *acc, CG21_LAGRANGE_CACHE *lagrange){
 
     /*
      * Xstatus = 0      first call
@@ -466,20 +468,36 @@ int CG21_KEY_RESHARE_CHECK_VSS_T1(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROU
     }
 
     // check partial PK is correct based on vss checks from keygen
-    rc = CG21_CHECK_PARTIAL_PK(setting, pack_pk_sum_shares, myX, ReceiveR3);
+    rc = CG21_CHECK_PARTIAL_PK(setting, pack_pk_sum_shares, myX, ReceiveR3, lagrange);
     if (rc!=CG21_OK){
         return rc;
     }
 
     // first partial PK
     if (Xstatus==0 || Xstatus==3) {
-        OCT_copy(X, myR3_T1->Xi);
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_init(acc);
+            rc = CG21_ECP_ACCUMULATOR_add(acc, myR3_T1->Xi);
+            if (rc!=CG21_OK){
+                return rc;
+            }
+        }
+        else{
+            OCT_copy(X, myR3_T1->Xi);
+        }
     }
 
-    CG21_ADD_TWO_PK(X, ReceiveR3->Xi);
+    rc = CG21_KEY_RESHARE_ADD_PK(acc, X, ReceiveR3->Xi);
+    if (rc!=CG21_OK){
+        return rc;
+    }
 
     // last partial PK
     if (Xstatus==2 || Xstatus==3){
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_output(acc, X);
+        }
+
         rc = OCT_comp(X, PK);
         if (rc==0){
             return CG21_RESHARE_CHECKS_NOT_VALID;
@@ -489,10 +507,28 @@ int CG21_KEY_RESHARE_CHECK_VSS_T1(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROU
     return CG21_OK;
 }
 
-void CG21_KEY_RESHARE_ENCRYPT_SHARES(csprng *RNG, PAILLIER_public_key *pk, int hisID,
-                                     CG21_RESHARE_ROUND1_STORE_SECRET_T1 *storeSecret,
-                                     CG21_RESHARE_ROUND1_STORE_PUB_T1 storePub,
-                                     CG21_RESHARE_ROUND3_OUTPUT *output){
+int CG21_KEY_RESHARE_CHECK_VSS_T1(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                  const CG21_RESHARE_ROUND1_STORE_PUB_T1 *myR3_T1, const SSS_shares *SS_R3, octet *myX,
+                                  octet *PK, octet *X, octet *pack_pk_sum_shares, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                  int Xstatus){
+    return CG21_KEY_RESHARE_CHECK_VSS_T1_SUM(setting, ReceiveR3, myR3_T1, SS_R3, myX, PK, X, pack_pk_sum_shares,
+                                             r3Store, Xstatus, NULL, NULL);
+}
+
+int CG21_KEY_RESHARE_CHECK_VSS_T1_ACC(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                      const CG21_RESHARE_ROUND1_STORE_PUB_T1 *myR3_T1, const SSS_shares *SS_R3, octet *myX,
+                                      octet *PK, octet *X, octet *pack_pk_sum_shares, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                      int Xstatus, CG21_ECP_ACCUMULATOR *X_sum, CG21_LAGRANGE_CACHE *lagrange){
+    return CG21_KEY_RESHARE_CHECK_VSS_T1_SUM(setting, ReceiveR3, myR3_T1, SS_R3, myX, PK, X, pack_pk_sum_shares,
+                                             r3Store, Xstatus, X_sum, lagrange);
+}
+
+int CG21_KEY_RESHARE_ENCRYPT_SHARES_POOLED(csprng *RNG, CG21_PAILLIER_POOL *pool, PAILLIER_public_key *pk, int hisID,
+                                          CG21_RESHARE_ROUND1_STORE_SECRET_T1 *storeSecret,
+                                          CG21_RESHARE_ROUND1_STORE_PUB_T1 storePub,
+                                          CG21_RESHARE_ROUND3_OUTPUT *output){
+
+    int rc = CG21_OK;
 
     char oct1[FS_2048];
     octet OCT1 = {0, sizeof(oct1), oct1};
@@ -501,13 +537,34 @@ void CG21_KEY_RESHARE_ENCRYPT_SHARES(csprng *RNG, PAILLIER_public_key *pk, int h
     OCT_pad(&OCT1, FS_2048);
 
     // encrypt y-coord
-    PAILLIER_ENCRYPT(RNG, pk, &OCT1, output->C, NULL);
+    if (pool == NULL){
+        PAILLIER_ENCRYPT(RNG, pk, &OCT1, output->C, NULL);
+    }
+    else{
+        rc = CG21_PAILLIER_POOL_ENCRYPT(pool, pk, &OCT1, output->C, NULL);
+    }
+
+    OCT_clear(&OCT1);
+
+    if (rc != CG21_OK){
+        return rc;
+    }
 
     // copy x-coord into output->X
     OCT_copy(output->X,storeSecret->shares.X);
 
     *(output->i) = *storePub.i;
     *(output->j) = hisID;
+
+    return CG21_OK;
+}
+
+void CG21_KEY_RESHARE_ENCRYPT_SHARES(csprng *RNG, PAILLIER_public_key *pk, int hisID,
+                                     CG21_RESHARE_ROUND1_STORE_SECRET_T1 *storeSecret,
+                                     CG21_RESHARE_ROUND1_STORE_PUB_T1 storePub,
+                                     CG21_RESHARE_ROUND3_OUTPUT *output){
+
+    CG21_KEY_RESHARE_ENCRYPT_SHARES_POOLED(RNG, NULL, pk, hisID, storeSecret, storePub, output);
 }
 
 
@@ -534,9 +591,10 @@ void CG21_KEY_RESHARE_DECRYPT_SHARES(PAILLIER_private_key *sk,
 }
 
 
-int CG21_KEY_RESHARE_CHECK_VSS_N2(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
-                                  const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
-                                  CG21_RESHARE_ROUND4_STORE *r4Store, int Xstatus){
+static int CG21_KEY_RESHARE_CHECK_VSS_N2_SUM(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                             const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
+                                             CG21_RESHARE_ROUND4_STORE *r4Store, int Xstatus, CG21_ECP_ACCUMULATOR *acc,
+                                             CG21_LAGRANGE_CACHE *lagrange){
     // pack vss octets into one octet
     OCT_joctet(r4Store->pack_all_checks, ReceiveR3->checks);
 
@@ -569,21 +627,34 @@ int CG21_KEY_RESHARE_CHECK_VSS_N2(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROU
     }
 
     // check partial PK is correct based on vss checks from keygen
-    rc = CG21_CHECK_PARTIAL_PK(setting, pack_pk_sum_shares, myX, ReceiveR3);
+    rc = CG21_CHECK_PARTIAL_PK(setting, pack_pk_sum_shares, myX, ReceiveR3, lagrange);
     if (rc!=CG21_OK){
         return rc;
     }
 
     // first partial PK
     if (Xstatus==0) {
-        OCT_copy(X, ReceiveR3->Xi);
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_init(acc);
+            rc = CG21_ECP_ACCUMULATOR_add(acc, ReceiveR3->Xi);
+        }
+        else{
+            OCT_copy(X, ReceiveR3->Xi);
+        }
     }
     else {
-        CG21_ADD_TWO_PK(X, ReceiveR3->Xi);
+        rc = CG21_KEY_RESHARE_ADD_PK(acc, X, ReceiveR3->Xi);
+    }
+    if (rc!=CG21_OK){
+        return rc;
     }
 
     // last partial PK
     if (Xstatus == 2) {
+        if (acc != NULL){
+            CG21_ECP_ACCUMULATOR_output(acc, X);
+        }
+
         rc = OCT_comp(X, PK);
         if (rc == 0) {
             return CG21_RESHARE_CHECKS_NOT_VALID;
@@ -594,6 +665,21 @@ int CG21_KEY_RESHARE_CHECK_VSS_N2(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROU
     return CG21_OK;
 }
 
+int CG21_KEY_RESHARE_CHECK_VSS_N2(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                  const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
+                                  CG21_RESHARE_ROUND4_STORE *r4Store, int Xstatus){
+    return CG21_KEY_RESHARE_CHECK_VSS_N2_SUM(setting, ReceiveR3, SS_R3, myX, PK, X, pack_pk_sum_shares,
+                                             r4Store, Xstatus, NULL, NULL);
+}
+
+int CG21_KEY_RESHARE_CHECK_VSS_N2_ACC(CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND1_STORE_PUB_T1 *ReceiveR3,
+                                      const SSS_shares *SS_R3, const octet *myX, const octet *PK, octet *X, octet *pack_pk_sum_shares,
+                                      CG21_RESHARE_ROUND4_STORE *r4Store, int Xstatus, CG21_ECP_ACCUMULATOR *X_sum,
+                                      CG21_LAGRANGE_CACHE *lagrange){
+    return CG21_KEY_RESHARE_CHECK_VSS_N2_SUM(setting, ReceiveR3, SS_R3, myX, PK, X, pack_pk_sum_shares,
+                                             r4Store, Xstatus, X_sum, lagrange);
+}
+
 void CG21_KEY_RESHARE_SUM_SHARES(const SSS_shares *share, CG21_RESHARE_ROUND4_STORE *r3Store, bool first){
 
     if (first){
@@ -680,8 +766,7 @@ static int key_reshare_prove_helper(const CG21_RESHARE_ROUND4_STORE *r3Store, CG
     BIG_256_56_fromBytesLen(accum, r3Store->shares.Y->val, r3Store->shares.Y->len);
 
     // compute sum-of-the-shares * G and convert the result into octet
-    ECP_SECP256K1_generator(&G);
-    ECP_SECP256K1_mul(&G, accum);
+    ECP_GEN_mul(&G, accum);
     ECP_SECP256K1_toOctet(&X, &G, true);
 
     // clean up
@@ -728,8 +813,10 @@ int CG21_KEY_RESHARE_PROVE_N2(CG21_RESHARE_ROUND4_OUTPUT *output, const CG21_RES
     return CG21_OK;
 }
 
-static int key_reshare_verify_helper(const CG21_RESHARE_ROUND4_OUTPUT *input, CG21_RESHARE_SETTING setting,
-                              CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, int hisID, const octet *A){
+/* Check A and compute the statement Xi_ and the challenge E of the proof of hisID */
+static int key_reshare_verify_statement(const CG21_RESHARE_ROUND4_OUTPUT *input, CG21_RESHARE_SETTING setting,
+                              CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, int hisID, const octet *A,
+                              CG21_POINT_CACHE *cache, octet *Xi_, octet *E){
 
     // A received from Round1 is equal to A received from Round3
     int rc = OCT_comp(input->proof.A, A);
@@ -744,9 +831,6 @@ static int key_reshare_verify_helper(const CG21_RESHARE_ROUND4_OUTPUT *input, CG
     char id[SGS_SECP256K1];
     octet X = {0, sizeof(id), id};
 
-    char xi[SFS_SECP256K1 + 1];
-    octet Xi_ = {0, sizeof(xi), xi};
-
     // convert hisID to Big and then to octet
     BIG_256_56_zero(x);
     BIG_256_56_inc(x, hisID);
@@ -764,21 +848,31 @@ static int key_reshare_verify_helper(const CG21_RESHARE_ROUND4_OUTPUT *input, CG
     }
 
     // copy the first xi*G
-    CG21_CALC_XI(setting.t2, &X, CC , &Xi);
+    CG21_CALC_XI_CACHED(setting.t2, &X, CC, cache, 0, &Xi);
 
     // this for loop computes g^{sum_of_the_shares} of the other players using their vss checks
     for (int j = 1; j < setting.t1; j++) {
         // this functions calculates g^{x_i}, same x_i used in GG20 section 3.1 (phase 2), based on the VSS checks
-        CG21_CALC_XI(setting.t2, &X, CC + j * setting.t2, &V);
+        CG21_CALC_XI_CACHED(setting.t2, &X, CC + j * setting.t2, cache, j, &V);
 
         ECP_SECP256K1_add(&Xi, &V);
     }
-    ECP_SECP256K1_toOctet(&Xi_, &Xi, true);
+    ECP_SECP256K1_toOctet(Xi_, &Xi, true);
+
+    return CG21_KEY_RESHARE_GEN_CHALLENGE(hisID, setting.n1, Xi_, ssid, r3Store->rho, E, input->proof.A);
+}
+
+static int key_reshare_verify_helper(const CG21_RESHARE_ROUND4_OUTPUT *input, CG21_RESHARE_SETTING setting,
+                              CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, int hisID, const octet *A,
+                              CG21_POINT_CACHE *cache){
+
+    char xi[SFS_SECP256K1 + 1];
+    octet Xi_ = {0, sizeof(xi), xi};
 
     char e2[SGS_SECP256K1];
     octet E = {0, sizeof(e2), e2};
-    rc = CG21_KEY_RESHARE_GEN_CHALLENGE(hisID, setting.n1, &Xi_, ssid, r3Store->rho, &E, input->proof.A);
 
+    int rc = key_reshare_verify_statement(input, setting, r3Store, ssid, hisID, A, cache, &Xi_, &E);
     if (rc!=CG21_OK){
         return rc;
     }
@@ -792,11 +886,49 @@ static int key_reshare_verify_helper(const CG21_RESHARE_ROUND4_OUTPUT *input, CG
     return CG21_OK;
 }
 
+static int key_reshare_verify_batch_helper(csprng *RNG, const CG21_RESHARE_ROUND4_OUTPUT *input,
+                              CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid,
+                              const int *hisID, const octet **A, int n, CG21_POINT_CACHE *cache, int *bad){
+
+    char xi[n][SFS_SECP256K1 + 1];
+    octet Xi_[n];
+    init_octets((char *)xi, Xi_, SFS_SECP256K1 + 1, n);
+
+    char e2[n][SGS_SECP256K1];
+    octet E[n];
+    init_octets((char *)e2, E, SGS_SECP256K1, n);
+
+    octet C[n];
+    octet P[n];
+
+    for (int k=0; k<n; k++){
+        int rc = key_reshare_verify_statement(input + k, setting, r3Store, ssid, hisID[k], A[k], cache, Xi_ + k, E + k);
+        if (rc!=CG21_OK){
+            if (bad != NULL){
+                *bad = k;
+            }
+            return rc;
+        }
+
+        C[k] = *input[k].proof.A;
+        P[k] = *input[k].proof.psi;
+    }
+
+    // verify all the Schnorr proofs at once
+    int rc2 = SCHNORR_batch_verify(RNG, Xi_, C, E, P, n, bad);
+    if (rc2)
+    {
+        return CG21_SCHNORR_VERIFY_FAILED;
+    }
+
+    return CG21_OK;
+}
+
 int CG21_KEY_RESHARE_VERIFY_T1(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1,
                                CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
                                CG21_SSID *ssid, int hisID){
 
-    int rc = key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubT1->A);
+    int rc = key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubT1->A,NULL);
     if (rc!=CG21_OK)
     {
         return rc;
@@ -805,11 +937,35 @@ int CG21_KEY_RESHARE_VERIFY_T1(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG
     return CG21_OK;
 }
 
+int CG21_KEY_RESHARE_VERIFY_T1_CACHED(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1,
+                                      CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                      CG21_SSID *ssid, int hisID, CG21_POINT_CACHE *cache){
+
+    return key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubT1->A,cache);
+}
+
+int CG21_KEY_RESHARE_VERIFY_T1_BATCH(csprng *RNG, const CG21_RESHARE_ROUND4_OUTPUT *input,
+                                     const CG21_RESHARE_ROUND1_STORE_PUB_T1 *pubT1, CG21_RESHARE_SETTING setting,
+                                     CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, const int *hisID, int n,
+                                     CG21_POINT_CACHE *cache, int *bad){
+
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    const octet *A[n];
+    for (int k=0; k<n; k++){
+        A[k] = pubT1[k].A;
+    }
+
+    return key_reshare_verify_batch_helper(RNG, input, setting, r3Store, ssid, hisID, A, n, cache, bad);
+}
+
 int CG21_KEY_RESHARE_VERIFY_N2(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2,
                                CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
                                CG21_SSID *ssid, int hisID){
 
-    int rc = key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubN2->A);
+    int rc = key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubN2->A,NULL);
     if (rc!=CG21_OK)
     {
         return rc;
@@ -818,6 +974,30 @@ int CG21_KEY_RESHARE_VERIFY_N2(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG
     return CG21_OK;
 }
 
+int CG21_KEY_RESHARE_VERIFY_N2_CACHED(const CG21_RESHARE_ROUND4_OUTPUT *input, const CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2,
+                                      CG21_RESHARE_SETTING setting, CG21_RESHARE_ROUND4_STORE *r3Store,
+                                      CG21_SSID *ssid, int hisID, CG21_POINT_CACHE *cache){
+
+    return key_reshare_verify_helper(input,setting,r3Store,ssid,hisID,pubN2->A,cache);
+}
+
+int CG21_KEY_RESHARE_VERIFY_N2_BATCH(csprng *RNG, const CG21_RESHARE_ROUND4_OUTPUT *input,
+                                     const CG21_RESHARE_ROUND1_STORE_PUB_N2 *pubN2, CG21_RESHARE_SETTING setting,
+                                     CG21_RESHARE_ROUND4_STORE *r3Store, CG21_SSID *ssid, const int *hisID, int n,
+                                     CG21_POINT_CACHE *cache, int *bad){
+
+    if (n < 1){
+        return CG21_OK;
+    }
+
+    const octet *A[n];
+    for (int k=0; k<n; k++){
+        A[k] = pubN2[k].A;
+    }
+
+    return key_reshare_verify_batch_helper(RNG, input, setting, r3Store, ssid, hisID, A, n, cache, bad);
+}
+
 void CG21_KEY_RESHARE_OUTPUT(CG21_RESHARE_OUTPUT *output, const CG21_RESHARE_ROUND4_STORE *r3Store,
                              const CG21_RESHARE_ROUND1_STORE_PUB_T1 *r3Receive, octet *PK,
                              CG21_RESHARE_SETTING setting, octet *rid, int j, bool first){
@@ -331,9 +331,9 @@ static void Piaffg_hash_commits(hash256 *sha, Piaffg_COMMITS *com)
     HASH_UTILS_hash_oct(sha, &OCT);
 }
 
-void Piaffg_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
-                           const octet *X, const octet *Y, const octet *C, const octet *D,
-                          Piaffg_COMMITS *affg, CG21_SSID *ssid, octet *E)
+static void Piaffg_Challenge(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                             const octet *X, const octet *Y, const octet *C, const octet *D,
+                             Piaffg_COMMITS *affg, CG21_SSID *ssid, const CG21_SSID_CTX *ctx, octet *E)
 {
     hash256 sha;
     BIG_256_56 q;
@@ -353,10 +353,15 @@ void Piaffg_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb,
     /* Bind to proof commitment */
     Piaffg_hash_commits(&sha, affg);
 
-    /* Bind to SSID */
-    int rc = CG21_hash_SSID(ssid, &sha);
-    if (rc != CG21_OK){
-        exit(rc);
+    /* Bind to SSID, serialised once for the session when there is a context */
+    if (ctx != NULL){
+        CG21_SSID_CTX_hash(ctx, &sha);
+    }
+    else{
+        int rc = CG21_hash_SSID(ssid, &sha);
+        if (rc != CG21_OK){
+            exit(rc);
+        }
     }
 
     /* Output */
@@ -368,6 +373,20 @@ void Piaffg_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb,
 
 }
 
+void Piaffg_Challenge_gen_ctx(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                              const octet *X, const octet *Y, const octet *C, const octet *D,
+                              Piaffg_COMMITS *affg, const CG21_SSID_CTX *ctx, octet *E)
+{
+    Piaffg_Challenge(puba, pubb, mod, X, Y, C, D, affg, NULL, ctx, E);
+}
+
+void Piaffg_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                           const octet *X, const octet *Y, const octet *C, const octet *D,
+                          Piaffg_COMMITS *affg, CG21_SSID *ssid, octet *E)
+{
+    Piaffg_Challenge(puba, pubb, mod, X, Y, C, D, affg, ssid, NULL, E);
+}
+
 void Piaffg_Prove(PAILLIER_public_key *prover_paillier_pub, PAILLIER_public_key *verifier_paillier_pub, Piaffg_SECRETS *secrets,
                   octet *x, octet *y, octet *rho, octet *rho_y,
                   octet *E, Piaffg_PROOFS *proofs, Piaffg_PROOFS_OCT *proofsOct)
@@ -558,13 +577,7 @@ int Piaffg_Verify(PAILLIER_private_key *verifier_paillier_priv, PAILLIER_public_
 
     // ------------ VALIDATES THE PROOF - PART1 ----------
     // Split check s^z1 * t^z3 * S^(-e) == E mod PQ using CRT
-    CG21_Pedersen_verify(p_proof, pedersen_priv, proofs->z1, proofs->z3, commits->S, e, pedersen_priv->mod.p, false);
-    CG21_Pedersen_verify(q_proof, pedersen_priv, proofs->z1, proofs->z3, commits->S, e, pedersen_priv->mod.q, false);
-
-    FF_2048_dmod(p_gt, commits->E, pedersen_priv->mod.p, HFLEN_2048);
-    FF_2048_dmod(q_gt, commits->E, pedersen_priv->mod.q, HFLEN_2048);
-
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (CG21_Pedersen_check(pedersen_priv, proofs->z1, proofs->z3, commits->S, commits->E, e, false) != CG21_OK);
 
     if (fail)
     {
@@ -579,12 +592,7 @@ int Piaffg_Verify(PAILLIER_private_key *verifier_paillier_priv, PAILLIER_public_
 
     // ------------ VALIDATES THE PROOF - PART2 ----------
     // Split check s^z2 * t^z4 * T^(-e) == F mod PQ using CRT
-    CG21_Pedersen_verify(p_proof, pedersen_priv, proofs->z2, proofs->z4, commits->T, e, pedersen_priv->mod.p, 1);
-    CG21_Pedersen_verify(q_proof, pedersen_priv, proofs->z2, proofs->z4, commits->T, e, pedersen_priv->mod.q, 1);
-
-    FF_2048_dmod(p_gt, commits->F, pedersen_priv->mod.p, HFLEN_2048);
-    FF_2048_dmod(q_gt, commits->F, pedersen_priv->mod.q, HFLEN_2048);
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (CG21_Pedersen_check(pedersen_priv, proofs->z2, proofs->z4, commits->T, commits->F, e, 1) != CG21_OK);
 
     if (fail)
     {
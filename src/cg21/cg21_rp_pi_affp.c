@@ -324,9 +324,9 @@ void PiAffp_hash_commits(hash256 *sha, PiAffp_COMMITS *com)
 }
 
 // non-interactive challenge generation based on the Fiat-Shamir heuristic
-void PiAffp_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
-                           const octet *X, const octet *Y, const octet *C, const octet *D,
-                          PiAffp_COMMITS *affp, CG21_SSID *ssid, octet *E)
+static void PiAffp_Challenge(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                             const octet *X, const octet *Y, const octet *C, const octet *D,
+                             PiAffp_COMMITS *affp, CG21_SSID *ssid, const CG21_SSID_CTX *ctx, octet *E)
 {
     hash256 sha;
     BIG_256_56 q;
@@ -346,10 +346,15 @@ void PiAffp_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb,
     /* Bind to proof commitment */
     PiAffp_hash_commits(&sha, affp);
 
-    /* Bind to SSID */
-    int rc = CG21_hash_SSID(ssid, &sha);
-    if (rc != CG21_OK){
-        exit(rc);
+    /* Bind to SSID, serialised once for the session when there is a context */
+    if (ctx != NULL){
+        CG21_SSID_CTX_hash(ctx, &sha);
+    }
+    else{
+        int rc = CG21_hash_SSID(ssid, &sha);
+        if (rc != CG21_OK){
+            exit(rc);
+        }
     }
 
     /* Output */
@@ -361,6 +366,20 @@ void PiAffp_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb,
 
 }
 
+void PiAffp_Challenge_gen_ctx(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                              const octet *X, const octet *Y, const octet *C, const octet *D,
+                              PiAffp_COMMITS *affp, const CG21_SSID_CTX *ctx, octet *E)
+{
+    PiAffp_Challenge(puba, pubb, mod, X, Y, C, D, affp, NULL, ctx, E);
+}
+
+void PiAffp_Challenge_gen(PAILLIER_public_key *puba, PAILLIER_public_key *pubb, PEDERSEN_PUB *mod,
+                           const octet *X, const octet *Y, const octet *C, const octet *D,
+                          PiAffp_COMMITS *affp, CG21_SSID *ssid, octet *E)
+{
+    PiAffp_Challenge(puba, pubb, mod, X, Y, C, D, affp, ssid, NULL, E);
+}
+
 void PiAffp_Prove(PAILLIER_public_key *prover_paillier_pub, PAILLIER_public_key *verifier_paillier_pub, PiAffp_SECRETS *secrets,
                   octet *x, octet *y, octet *rho, octet *rho_x, octet *rho_y,
                   octet *E, PiAffp_PROOFS *proofs, PiAffp_PROOFS_OCT *proofsOct)
@@ -559,13 +578,7 @@ int PiAffp_Verify(PAILLIER_private_key *verifier_paillier_priv, PAILLIER_public_
 
     // ------------ VALIDATES THE PROOF - PART1 ----------
     // Split check s^z1 * t^z3 * S^(-e) == E mod PQ using CRT
-    CG21_Pedersen_verify(p_proof, pedersen_priv, proofs->z1, proofs->z3, commits->S, e, pedersen_priv->mod.p, false);
-    CG21_Pedersen_verify(q_proof, pedersen_priv, proofs->z1, proofs->z3, commits->S, e, pedersen_priv->mod.q, false);
-
-    FF_2048_dmod(p_gt, commits->E, pedersen_priv->mod.p, HFLEN_2048);
-    FF_2048_dmod(q_gt, commits->E, pedersen_priv->mod.q, HFLEN_2048);
-
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (CG21_Pedersen_check(pedersen_priv, proofs->z1, proofs->z3, commits->S, commits->E, e, false) != CG21_OK);
 
     if (fail)
     {
@@ -580,12 +593,7 @@ int PiAffp_Verify(PAILLIER_private_key *verifier_paillier_priv, PAILLIER_public_
 
     // ------------ VALIDATES THE PROOF - PART2 ----------
     // Split check s^z2 * t^z4 * T^(-e) == F mod PQ using CRT
-    CG21_Pedersen_verify(p_proof, pedersen_priv, proofs->z2, proofs->z4, commits->T, e, pedersen_priv->mod.p, 1);
-    CG21_Pedersen_verify(q_proof, pedersen_priv, proofs->z2, proofs->z4, commits->T, e, pedersen_priv->mod.q, 1);
-
-    FF_2048_dmod(p_gt, commits->F, pedersen_priv->mod.p, HFLEN_2048);
-    FF_2048_dmod(q_gt, commits->F, pedersen_priv->mod.q, HFLEN_2048);
-    fail = (FF_2048_comp(p_gt, p_proof, HFLEN_2048) != 0) || (FF_2048_comp(q_gt, q_proof, HFLEN_2048) != 0);
+    fail = (CG21_Pedersen_check(pedersen_priv, proofs->z2, proofs->z4, commits->T, commits->F, e, 1) != CG21_OK);
 
     if (fail)
     {
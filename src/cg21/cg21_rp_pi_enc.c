@@ -187,8 +187,8 @@ void PiEnc_hash_commits(hash256 *sha, PiEnc_COMMITS *com)
 }
 
 
-void PiEnc_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
-                         const octet *K, PiEnc_COMMITS *secrets, CG21_SSID *ssid, octet *E)
+static void PiEnc_Challenge(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                            const octet *K, PiEnc_COMMITS *secrets, CG21_SSID *ssid, const CG21_SSID_CTX *ctx, octet *E)
 {
     // ------------ VARIABLE DEFINITION ----------
     hash256 sha;
@@ -207,10 +207,15 @@ void PiEnc_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
     /* Bind to proof commitment (S,A,C) */
     PiEnc_hash_commits(&sha, secrets);
 
-    /* Bind to SSID */
-    int rc = CG21_hash_SSID(ssid, &sha);
-    if (rc != CG21_OK){
-        exit(rc);
+    /* Bind to SSID, serialised once for the session when there is a context */
+    if (ctx != NULL){
+        CG21_SSID_CTX_hash(ctx, &sha);
+    }
+    else{
+        int rc = CG21_hash_SSID(ssid, &sha);
+        if (rc != CG21_OK){
+            exit(rc);
+        }
     }
 
     // ------------ OUTPUT ----------
@@ -221,6 +226,18 @@ void PiEnc_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
     E->len = EGS_SECP256K1;
 }
 
+void PiEnc_Challenge_gen_ctx(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                             const octet *K, PiEnc_COMMITS *secrets, const CG21_SSID_CTX *ctx, octet *E)
+{
+    PiEnc_Challenge(pub_key, pub_com, K, secrets, NULL, ctx, E);
+}
+
+void PiEnc_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                         const octet *K, PiEnc_COMMITS *secrets, CG21_SSID *ssid, octet *E)
+{
+    PiEnc_Challenge(pub_key, pub_com, K, secrets, ssid, NULL, E);
+}
+
 void PiEnc_proof_toOctets(PiEnc_PROOFS_OCT *proofsOct, PiEnc_PROOFS *proofs)
 {
     FF_2048_toOctet(proofsOct->z1, proofs->z1, HFLEN_2048);
@@ -383,16 +400,7 @@ int PiEnc_Verify(PAILLIER_public_key *pub_key, PEDERSEN_PRIV *priv_com, octet *K
 
     // ------------ VALIDATES THE PROOF - PART1 ----------
     // Split computation of proofs for C using CRT.
-    CG21_Pedersen_verify(wp_proof, priv_com, proofs->z1, proofs->z3, commits->S, e, priv_com->mod.p,false);
-    CG21_Pedersen_verify(wq_proof, priv_com, proofs->z1, proofs->z3, commits->S, e, priv_com->mod.q, false);
-
-    // Reduce C mod P and Q for comparison
-    FF_2048_dmod(hws1, commits->C, priv_com->mod.p, HFLEN_2048);
-    FF_2048_dmod(hws2, commits->C, priv_com->mod.q, HFLEN_2048);
-
-    // Compare the results modulo P and Q
-    // since C == C' mod PQ <==> C == C' mod P & C == C' mod Q
-    int fail = (FF_2048_comp(hws1, wp_proof, HFLEN_2048) != 0) || (FF_2048_comp(hws2, wq_proof, HFLEN_2048) != 0);
+    int fail = (CG21_Pedersen_check(priv_com, proofs->z1, proofs->z3, commits->S, commits->C, e, false) != CG21_OK);
 
     // ------------ CLEAN MEMORY ----------
     OCT_clear(&OCT);
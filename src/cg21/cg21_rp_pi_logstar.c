@@ -208,8 +208,8 @@ void PiLogstar_hash_commits(hash256 *sha, PiLogstar_COMMITS *com)
 }
 
 
-void PiLogstar_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
-                         const octet *C, PiLogstar_COMMITS *commits, CG21_SSID *ssid, const octet *X, octet *E)
+static void PiLogstar_Challenge(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                                const octet *C, PiLogstar_COMMITS *commits, CG21_SSID *ssid, const CG21_SSID_CTX *ctx, const octet *X, octet *E)
 {
     // ------------ VARIABLE DEFINITION ----------
     hash256 sha;
@@ -229,10 +229,15 @@ void PiLogstar_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com
     /* Bind to proof commitment (S,A,Y,D) */
     PiLogstar_hash_commits(&sha, commits);
 
-    /* Bind to SSID */
-    int rc = CG21_hash_SSID(ssid, &sha);
-    if (rc != CG21_OK){
-        exit(rc);
+    /* Bind to SSID, serialised once for the session when there is a context */
+    if (ctx != NULL){
+        CG21_SSID_CTX_hash(ctx, &sha);
+    }
+    else{
+        int rc = CG21_hash_SSID(ssid, &sha);
+        if (rc != CG21_OK){
+            exit(rc);
+        }
     }
 
     // ------------ OUTPUT ----------
@@ -243,6 +248,18 @@ void PiLogstar_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com
     E->len = EGS_SECP256K1;
 }
 
+void PiLogstar_Challenge_gen_ctx(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                                 const octet *C, PiLogstar_COMMITS *commits, const CG21_SSID_CTX *ctx, const octet *X, octet *E)
+{
+    PiLogstar_Challenge(pub_key, pub_com, C, commits, NULL, ctx, X, E);
+}
+
+void PiLogstar_Challenge_gen(PAILLIER_public_key *pub_key, PEDERSEN_PUB *pub_com,
+                         const octet *C, PiLogstar_COMMITS *commits, CG21_SSID *ssid, const octet *X, octet *E)
+{
+    PiLogstar_Challenge(pub_key, pub_com, C, commits, ssid, NULL, X, E);
+}
+
 void PiLogstar_proof_toOctets(PiLogstar_PROOFS_OCT *proofsOct, PiLogstar_PROOFS *proofs)
 {
     FF_2048_toOctet(proofsOct->z1, proofs->z1, HFLEN_2048);
@@ -422,16 +439,7 @@ int PiLogstar_Verify(PAILLIER_public_key *pub_key, PEDERSEN_PRIV *priv_com, octe
     // ------------ VALIDATES THE PROOF - PART1 ----------
     // s^z1 * t^z3 =? D * S^e
     // Split computation of proofs for C using CRT.
-    CG21_Pedersen_verify(wp_proof, priv_com, proofs->z1, proofs->z3, commits->S, e, priv_com->mod.p,false);
-    CG21_Pedersen_verify(wq_proof, priv_com, proofs->z1, proofs->z3, commits->S, e, priv_com->mod.q, false);
-
-    // Reduce C mod P and Q for comparison
-    FF_2048_dmod(hws1, commits->D, priv_com->mod.p, HFLEN_2048);
-    FF_2048_dmod(hws2, commits->D, priv_com->mod.q, HFLEN_2048);
-
-    // Compare the results modulo P and Q
-    // since C == C' mod PQ <==> C == C' mod P & C == C' mod Q
-    fail = (FF_2048_comp(hws1, wp_proof, HFLEN_2048) != 0) || (FF_2048_comp(hws2, wq_proof, HFLEN_2048) != 0);
+    fail = (CG21_Pedersen_check(priv_com, proofs->z1, proofs->z3, commits->S, commits->D, e, false) != CG21_OK);
 
     // ------------ CLEAN MEMORY ----------
     FF_2048_zero(hws1, HFLEN_2048);
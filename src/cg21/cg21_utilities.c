@@ -16,8 +16,34 @@ KIND, either express or implied.  See the License for the
 specific language governing permissions and limitations
 under the License.
 */
+#include <pthread.h>
 #include "amcl/cg21/cg21_utilities.h"
 
+// Window for the homomorphic multiplication by a short plaintext
+#define MULT_WINDOW 4
+#define MULT_SIZE (1 << MULT_WINDOW)
+
+// Number of small primes below SAFE_PRIME_SIEVE_BOUND
+#define SIEVE_PRIMES 1900
+
+/* Safe primes shared by the threads of a search */
+typedef struct
+{
+    pthread_mutex_t lock;
+    BIG_1024_58 *p;     // k primes p of n BIGs each
+    BIG_1024_58 *P;     // k safe primes P = 2p+1
+    int k;
+    int n;
+    int found;          // the search is over once found == k
+} SAFE_PRIME_SEARCH;
+
+/* One thread of a search */
+typedef struct
+{
+    SAFE_PRIME_SEARCH *search;
+    csprng RNG;
+} SAFE_PRIME_WORKER;
+
 int teq_(sign32 b,sign32 c)
 {
     sign32 x=b^c;
@@ -211,13 +237,7 @@ static bool safe_prime_check(BIG_1024_58 *p, BIG_1024_58 *P, csprng *RNG, int n)
     BIG_1024_58 f[n];
 #endif
 
-    // Sieve small primes from P, p is already checked in Miller-Rabin
-    sign32 sf=4849845;/* 3*5*.. *19 */
-
-    if(FF_2048_cfactor(P, sf, n))
-    {
-        return false;
-    }
+    // p and P have no factor below SAFE_PRIME_SIEVE_BOUND, see safe_prime_gen
 
     // Check primality of p
     if (FF_2048_prime(p, RNG, n) == 0)
@@ -243,7 +263,115 @@ static bool safe_prime_check(BIG_1024_58 *p, BIG_1024_58 *P, csprng *RNG, int n)
     return false;
 }
 
-void safe_prime_gen(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n)
+/*
+ * Odd primes s with 3 < s < SAFE_PRIME_SIEVE_BOUND. Returns their number
+ */
+static int safe_prime_sieve_primes(int *primes)
+{
+    char composite[SAFE_PRIME_SIEVE_BOUND] = {0};
+    int k = 0;
+
+    for (int i = 2; i < SAFE_PRIME_SIEVE_BOUND; i++)
+    {
+        if (composite[i])
+        {
+            continue;
+        }
+
+        if (i > 3)
+        {
+            primes[k++] = i;
+        }
+
+        for (int j = i * i; j < SAFE_PRIME_SIEVE_BOUND; j += i)
+        {
+            composite[j] = 1;
+        }
+    }
+
+    return k;
+}
+
+/*
+ * x mod s for a small s, from the big endian bytes of x
+ */
+static int safe_prime_residue(octet *X, int s)
+{
+    int r = 0;
+
+    for (int i = 0; i < X->len; i++)
+    {
+        r = (r * 256 + (unsigned char)X->val[i]) % s;
+    }
+
+    return r;
+}
+
+/*
+ * Residues of p, given by the big endian bytes in X, and P = 2p + 1
+ * modulo the k small primes
+ */
+static void safe_prime_sieve_init(octet *X, const int *primes, int *rp, int *rP, int k)
+{
+    for (int i = 0; i < k; i++)
+    {
+        rp[i] = safe_prime_residue(X, primes[i]);
+        rP[i] = (2 * rp[i] + 1) % primes[i];
+    }
+}
+
+/*
+ * Move the residues to the next candidate p + 12, P + 24
+ */
+static void safe_prime_sieve_step(const int *primes, int *rp, int *rP, int k)
+{
+    for (int i = 0; i < k; i++)
+    {
+        rp[i] = (rp[i] + 12) % primes[i];
+        rP[i] = (rP[i] + 24) % primes[i];
+    }
+}
+
+/*
+ * Check that neither p nor P has a small factor
+ */
+static bool safe_prime_sieve_check(int *rp, int *rP, int k)
+{
+    for (int i = 0; i < k; i++)
+    {
+        if (rp[i] == 0 || rP[i] == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Check if the other threads have found all the primes
+ */
+static bool safe_prime_cancelled(SAFE_PRIME_SEARCH *search)
+{
+    bool done;
+
+    if (search == NULL)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&search->lock);
+    done = (search->found >= search->k);
+    pthread_mutex_unlock(&search->lock);
+
+    return done;
+}
+
+/*
+ * Search a safe prime P = 2p + 1 from a random starting point.
+ * Returns false if the search is cancelled first
+ */
+static bool safe_prime_search(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n, SAFE_PRIME_SEARCH *search)
 {
 #ifndef C99
     BIG_1024_58 r[HFLEN_2048];
@@ -252,6 +380,15 @@ void safe_prime_gen(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n)
     BIG_1024_58 r[n];
     BIG_1024_58 twelve[n];
 #endif
+    int primes[SIEVE_PRIMES];
+    int rp[SIEVE_PRIMES];
+    int rP[SIEVE_PRIMES];
+    int k;
+    bool found = true;
+
+    char oct[FS_2048];
+    octet OCT = {0, sizeof(oct), oct};
+
     FF_2048_init(twelve, 12, n);
 
     FF_2048_random(p, RNG, n);
@@ -276,11 +413,186 @@ void safe_prime_gen(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n)
     FF_2048_shl(P, n);
     FF_2048_inc(P, 1, n);
 
-    while (!safe_prime_check(p, P, RNG, n))
+    // Residues of p and P modulo the small primes. They are
+    // updated with the candidates, so only the survivors of
+    // the sieve reach Miller-Rabin
+    k = safe_prime_sieve_primes(primes);
+
+    FF_2048_toOctet(&OCT, p, n);
+    safe_prime_sieve_init(&OCT, primes, rp, rP, k);
+
+    for (;;)
     {
+        // The other threads are only polled before Miller-Rabin, so
+        // the sieve steps do not take the lock
+        if (safe_prime_sieve_check(rp, rP, k))
+        {
+            if (safe_prime_cancelled(search))
+            {
+                found = false;
+                break;
+            }
+
+            if (safe_prime_check(p, P, RNG, n))
+            {
+                break;
+            }
+        }
+
         // Increase p by 12 to keep it = 11 mod 12, P grows as 2*p
         FF_2048_inc(p, 12, n);
         FF_2048_inc(P, 24, n);
+
+        safe_prime_sieve_step(primes, rp, rP, k);
+    }
+
+    // Clean memory
+    OCT_clear(&OCT);
+    FF_2048_zero(r, n);
+
+    return found;
+}
+
+void safe_prime_sieve(BIG_1024_58 *p, int *pass, int m, int n)
+{
+    int primes[SIEVE_PRIMES];
+    int rp[SIEVE_PRIMES];
+    int rP[SIEVE_PRIMES];
+    int k;
+
+    char oct[FS_2048];
+    octet OCT = {0, sizeof(oct), oct};
+
+    k = safe_prime_sieve_primes(primes);
+
+    FF_2048_toOctet(&OCT, p, n);
+    safe_prime_sieve_init(&OCT, primes, rp, rP, k);
+
+    for (int i = 0; i < m; i++)
+    {
+        pass[i] = safe_prime_sieve_check(rp, rP, k);
+        safe_prime_sieve_step(primes, rp, rP, k);
+    }
+
+    // Clean memory
+    OCT_clear(&OCT);
+}
+
+void safe_prime_gen(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int n)
+{
+    safe_prime_search(RNG, p, P, n, NULL);
+}
+
+static void *safe_prime_worker(void *arg)
+{
+    SAFE_PRIME_WORKER *worker = (SAFE_PRIME_WORKER *)arg;
+    SAFE_PRIME_SEARCH *search = worker->search;
+    int n = search->n;
+    bool done = false;
+
+#ifndef C99
+    BIG_1024_58 p[HFLEN_2048];
+    BIG_1024_58 P[HFLEN_2048];
+#else
+    BIG_1024_58 p[n];
+    BIG_1024_58 P[n];
+#endif
+
+    // Keep searching from new starting points until all the
+    // primes are found. The first thread to find one takes the
+    // next free slot
+    while (!done && safe_prime_search(&worker->RNG, p, P, n, search))
+    {
+        pthread_mutex_lock(&search->lock);
+        if (search->found < search->k)
+        {
+            FF_2048_copy(search->p + search->found * n, p, n);
+            FF_2048_copy(search->P + search->found * n, P, n);
+            search->found++;
+        }
+        done = (search->found >= search->k);
+        pthread_mutex_unlock(&search->lock);
+    }
+
+    // Clean memory
+    FF_2048_zero(p, n);
+    FF_2048_zero(P, n);
+
+    return NULL;
+}
+
+void safe_prime_gen_mt(csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P, int k, int n, int threads)
+{
+    SAFE_PRIME_SEARCH search;
+    char seed[32];
+
+    // Nothing to search, leave RNG untouched
+    if (k <= 0)
+    {
+        return;
+    }
+
+    if (threads <= 1)
+    {
+        for (int i = 0; i < k; i++)
+        {
+            safe_prime_gen(RNG, p + i * n, P + i * n, n);
+        }
+
+        return;
+    }
+
+    SAFE_PRIME_WORKER workers[threads];
+    pthread_t tids[threads];
+    int spawned[threads];
+
+    search.p = p;
+    search.P = P;
+    search.k = k;
+    search.n = n;
+    search.found = 0;
+    pthread_mutex_init(&search.lock, NULL);
+
+    // The RNG can not be shared by the threads, so every thread
+    // searches with its own stream
+    for (int i = 0; i < threads; i++)
+    {
+        for (int j = 0; j < 32; j++)
+        {
+            seed[j] = (char) RAND_byte(RNG);
+        }
+
+        workers[i].search = &search;
+        RAND_seed(&workers[i].RNG, 32, seed);
+    }
+
+    for (int i = 0; i < threads - 1; i++)
+    {
+        spawned[i] = (pthread_create(&tids[i], NULL, safe_prime_worker, &workers[i]) == 0);
+    }
+
+    // The calling thread only returns once all the primes are found
+    safe_prime_worker(&workers[threads - 1]);
+
+    for (int i = 0; i < threads - 1; i++)
+    {
+        if (spawned[i])
+        {
+            pthread_join(tids[i], NULL);
+        }
+    }
+
+    pthread_mutex_destroy(&search.lock);
+
+    // Clean memory
+    for (int i = 0; i < threads; i++)
+    {
+        RAND_clean(&workers[i].RNG);
+    }
+
+    for (int j = 0; j < 32; j++)
+    {
+        seed[j] = 0;
     }
 }
 
@@ -303,6 +615,11 @@ void BC_find_generator(csprng *RNG, BIG_1024_58* x, BIG_1024_58 *P, int n)
 }
 
 void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q)
+{
+    ring_Pedersen_setup_mt(RNG, m, P, Q, 1);
+}
+
+void ring_Pedersen_setup_mt(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q, int threads)
 {
     BIG_1024_58 p[HFLEN_2048];
     BIG_1024_58 q[HFLEN_2048];
@@ -310,11 +627,22 @@ void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q)
     BIG_1024_58 gq[HFLEN_2048];
     BIG_1024_58 ap[HFLEN_2048];
     BIG_1024_58 aq[HFLEN_2048];
+    BIG_1024_58 sp[2][HFLEN_2048];
+    BIG_1024_58 SP[2][HFLEN_2048];
+
+    int k = (P == NULL) + (Q == NULL);
+
+    m->comb_b0 = NULL;
+    m->comb_b1 = NULL;
+
+    /* Generate the missing safe primes concurrently */
+    safe_prime_gen_mt(RNG, sp[0], SP[0], k, HFLEN_2048, threads);
 
     /* Load or generate safe primes P, Q */
     if (P == NULL)
     {
-        safe_prime_gen(RNG, p, m->mod.p, HFLEN_2048);
+        FF_2048_copy(p, sp[0], HFLEN_2048);
+        FF_2048_copy(m->mod.p, SP[0], HFLEN_2048);
     }
     else
     {
@@ -328,7 +656,8 @@ void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q)
 
     if (Q == NULL)
     {
-        safe_prime_gen(RNG, q, m->mod.q, HFLEN_2048);
+        FF_2048_copy(q, sp[k-1], HFLEN_2048);
+        FF_2048_copy(m->mod.q, SP[k-1], HFLEN_2048);
     }
     else
     {
@@ -340,6 +669,12 @@ void ring_Pedersen_setup(csprng *RNG, PEDERSEN_PRIV *m, octet *P, octet *Q)
         FF_2048_shr(q, HFLEN_2048);
     }
 
+    for (int i = 0; i < 2; i++)
+    {
+        FF_2048_zero(sp[i], HFLEN_2048);
+        FF_2048_zero(SP[i], HFLEN_2048);
+    }
+
     FF_2048_mul(m->mod.n, m->mod.p, m->mod.q, HFLEN_2048);
     FF_2048_mul(m->pq, p, q, HFLEN_2048);
     FF_2048_invmodp(m->mod.invpq, m->mod.p, m->mod.q, HFLEN_2048);
@@ -397,6 +732,33 @@ void CG21_Pedersen_Private_Kill( PEDERSEN_PRIV *priv){
     FF_2048_zero(priv->mod.q,  HFLEN_2048);
     FF_2048_zero(priv->mod.invpq,  HFLEN_2048);
 
+    // the combs may be shared with copies of priv, see CG21_Pedersen_comb_kill
+    priv->comb_b0 = NULL;
+    priv->comb_b1 = NULL;
+}
+
+void CG21_Pedersen_comb_kill(PEDERSEN_PRIV *priv)
+{
+    if (priv->comb_b0 != NULL)
+    {
+        HDLOG_comb_kill(priv->comb_b0);
+        priv->comb_b0 = NULL;
+    }
+
+    if (priv->comb_b1 != NULL)
+    {
+        HDLOG_comb_kill(priv->comb_b1);
+        priv->comb_b1 = NULL;
+    }
+}
+
+void CG21_Pedersen_precompute(PEDERSEN_PRIV *priv, struct HDLOG_comb *comb_b0, struct HDLOG_comb *comb_b1)
+{
+    HDLOG_comb_precompute(comb_b0, &priv->mod, priv->b0);
+    HDLOG_comb_precompute(comb_b1, &priv->mod, priv->b1);
+
+    priv->comb_b0 = comb_b0;
+    priv->comb_b1 = comb_b1;
 }
 
 void CG21_FF_2048_amod(BIG_1024_58 *r, BIG_1024_58 *x, int xlen, BIG_1024_58 *p, int plen)
@@ -457,6 +819,130 @@ void CG21_Pedersen_verify(BIG_1024_58 *proof, PEDERSEN_PRIV *st, BIG_1024_58 *z1
     FF_2048_zero(hws4, HFLEN_2048);
 }
 
+int CG21_Pedersen_check(PEDERSEN_PRIV *st, BIG_1024_58 *z1, BIG_1024_58 *z3, BIG_1024_58 *S, BIG_1024_58 *C,
+                        BIG_1024_58 *e, bool reduce_s1)
+{
+    int fail = 0;
+
+    BIG_1024_58 lhs[HFLEN_2048];
+    BIG_1024_58 rhs[HFLEN_2048];
+    BIG_1024_58 hws1[HFLEN_2048];
+    BIG_1024_58 hws2[HFLEN_2048];
+    BIG_1024_58 hws3[HFLEN_2048];
+    BIG_1024_58 hws4[HFLEN_2048];
+
+    BIG_1024_58 *primes[2] = {st->mod.p, st->mod.q};
+
+    for (int i = 0; i < 2; i++)
+    {
+        BIG_1024_58 *p = primes[i];
+
+        FF_2048_dmod(rhs, C, p, HFLEN_2048);
+
+        if (st->comb_b0 == NULL || st->comb_b1 == NULL)
+        {
+            // s^z1 * t^z3 * S^(-e) == C mod p
+            CG21_Pedersen_verify(lhs, st, z1, z3, S, e, p, reduce_s1);
+        }
+        else
+        {
+            // s^z1 * t^z3 == C * S^e mod p, using the combs of s and t
+            FF_2048_copy(hws1, p, HFLEN_2048);
+            FF_2048_dec(hws1, 1, HFLEN_2048);
+            CG21_FF_2048_amod(hws4, z3, FFLEN_2048 + HFLEN_2048, hws1, HFLEN_2048);
+
+            if (reduce_s1)
+            {
+                FF_2048_dmod(hws3, z1, hws1, HFLEN_2048);
+            }
+            else
+            {
+                FF_2048_copy(hws3, z1, HFLEN_2048);
+            }
+
+            FF_COMB_pow2(lhs, (i == 0) ? st->comb_b0->tp : st->comb_b0->tq, hws3,
+                         (i == 0) ? st->comb_b1->tp : st->comb_b1->tq, hws4, p);
+
+            // The challenge and S are public
+            FF_2048_dmod(hws2, S, p, HFLEN_2048);
+            FF_COMB_nt_mul_pow(rhs, rhs, hws2, e, p);
+        }
+
+        fail |= (FF_2048_comp(lhs, rhs, HFLEN_2048) != 0);
+    }
+
+    // Clean memory
+    FF_2048_zero(lhs,  HFLEN_2048);
+    FF_2048_zero(rhs,  HFLEN_2048);
+    FF_2048_zero(hws1, HFLEN_2048);
+    FF_2048_zero(hws3, HFLEN_2048);
+    FF_2048_zero(hws4, HFLEN_2048);
+
+    if (fail)
+    {
+        return CG21_PEDERSEN_CHECK_FAIL;
+    }
+
+    return CG21_OK;
+}
+
+void CG21_PAILLIER_MULT_SHORT(PAILLIER_public_key *PUB, octet *CT1, octet *PT[], octet *CT[], int k)
+{
+    int m = 1;
+
+    BIG_512_60 ct[FFLEN_4096];
+    BIG_512_60 pt[HFLEN_4096];
+    BIG_512_60 ws[FFLEN_4096];
+    BIG_512_60 ND[FFLEN_4096];
+
+    BIG_512_60 T_mem[MULT_SIZE][FFLEN_4096];
+    BIG_512_60 *T[MULT_SIZE];
+
+    BIG_512_60 *X[] = {ct};
+    BIG_512_60 *E[] = {pt};
+
+    char oct[HFS_4096];
+    octet OCT = {0, sizeof(oct), oct};
+
+    // The exponent length is public, only the BIGs it spans are processed
+    for (int i = 0; i < k; i++)
+    {
+        int len = (PT[i]->len + MODBYTES_512_60 - 1) / MODBYTES_512_60;
+        if (len > m)
+        {
+            m = len;
+        }
+    }
+
+    for (int i = 0; i < MULT_SIZE; i++)
+    {
+        T[i] = T_mem[i];
+    }
+
+    FF_4096_fromOctet(ct, CT1, FFLEN_4096);
+    FF_4096_invmod2m(ND, PUB->n2, FFLEN_4096);
+    FF_4096_2w_precompute(X, T, 1, MULT_WINDOW, PUB->n2, ND, FFLEN_4096);
+
+    for (int i = 0; i < k; i++)
+    {
+        OCT_copy(&OCT, PT[i]);
+        OCT_pad(&OCT, m * MODBYTES_512_60);
+        FF_4096_fromOctet(pt, &OCT, m);
+
+        FF_4096_ct_2w_pow(ws, T, E, 1, MULT_WINDOW, PUB->n2, ND, FFLEN_4096, m);
+        FF_4096_toOctet(CT[i], ws, FFLEN_4096);
+    }
+
+    // Clean memory
+    OCT_clear(&OCT);
+    FF_4096_zero(pt, HFLEN_4096);
+
+    for (int i = 0; i < MULT_SIZE; i++)
+    {
+        FF_4096_zero(T_mem[i], FFLEN_4096);
+    }
+}
+
 void CG21_GET_CURVE_ORDER(BIG_1024_58 *q){
     BIG_256_56 q_;
     BIG_256_56_rcopy(q_, CURVE_Order_SECP256K1);
@@ -520,106 +1006,147 @@ void init_octets(char* mem, octet *OCTETS, int max, int n)
     }
 }
 
-extern int CG21_unpack_and_sort(octet *set, octet *set_packed, const octet *j_packed, int n, int size, int *indices){
+/* Key of a hex digit of an ID, as its ASCII distance from '0' */
+static int CG21_PARTY_TABLE_digit(int v){
+    return v < 10 ? v : v - 10 + 'a' - '0';
+}
 
-    // checked the length of X_packed
-    if (set_packed->len != n*size)
+int CG21_PARTY_TABLE_init(CG21_PARTY_TABLE *table, int *ids, int *order, const octet *j_packed, int n){
+
+    int keys[n];
+
+    // each ID is packed in two bytes
+    if (j_packed->len < 2*n)
     {
         return CG21_UTILITIES_WRONG_PACKED_SIZE;
     }
 
-    for (int i = n - 1; i >= 0; i--)
-    {
-        OCT_clear(&set[i]);
-        OCT_chop(set_packed, &set[i], set_packed->len - size);
+    table->n = n;
+    table->ids = ids;
+    table->order = order;
+
+    for (int k=0; k<n; k++){
+        int hi = (unsigned char)j_packed->val[2*k];
+        int lo = (unsigned char)j_packed->val[2*k+1];
+
+        ids[k] = (hi << 8) | lo;
+
+        // the digits are OR-ed together as the hex strings were
+        keys[k] = CG21_PARTY_TABLE_digit(hi >> 4) << 12 |
+                  CG21_PARTY_TABLE_digit(hi & 0xf) << 8 |
+                  CG21_PARTY_TABLE_digit(lo >> 4) << 4 |
+                  CG21_PARTY_TABLE_digit(lo & 0xf);
+
+        order[k] = k;
     }
 
-    // restore length of the packed X
-    set_packed->len = n * size;
+    // same exchange sort as the hex strings, so equal keys end in the same positions
+    for (int k=0; k<n; k++){
+        for (int l=k+1; l<n; l++){
+            if (keys[order[k]] > keys[order[l]]){
+                int tmp = order[k];
+                order[k] = order[l];
+                order[l] = tmp;
+            }
+        }
+    }
 
-    // unpack j_packed and get sorted indices
-    char temp[n * 4 + 1];
+    return CG21_OK;
+}
 
-    // convert oct to hex
-    OCT_toHex(j_packed, temp);
+int CG21_PARTY_TABLE_hash_set(hash256 *sha, const CG21_PARTY_TABLE *table, const octet *X_packed, int m){
 
-    // convert each j to int, then get sorted indices
-    sort_indices(temp,indices,n);
+    // checked the length of X_packed
+    if (X_packed->len != table->n * m)
+    {
+        return CG21_UTILITIES_WRONG_PACKED_SIZE;
+    }
+
+    // process X[i] into sha in the order of the IDs, straight from the packed set
+    for (int k=0; k<table->n; k++){
+        octet X = {m, m, X_packed->val + table->order[k] * m};
+        HASH_UTILS_hash_oct(sha, &X);
+    }
 
     return CG21_OK;
 }
 
-extern int CG21_hash_set_X(hash256 *sha, octet *X_packed, octet *j_packed, int n, int m){
+extern int CG21_unpack_and_sort(octet *set, octet *set_packed, const octet *j_packed, int n, int size, int *indices){
 
-    int indices[n];
+    int ids[n];
+    CG21_PARTY_TABLE table;
 
-    char x_[n][m];
-    octet X[n];
-    init_octets((char *)x_,  X,  m, n);
+    // checked the length of X_packed
+    if (set_packed->len != n*size)
+    {
+        return CG21_UTILITIES_WRONG_PACKED_SIZE;
+    }
 
-    // unpack X_packed into X and return sorted indices based on j_packed
-    int rc = CG21_unpack_and_sort(X, X_packed,j_packed,n,m,indices);
+    // get sorted indices
+    int rc = CG21_PARTY_TABLE_init(&table, ids, indices, j_packed, n);
     if (rc != CG21_OK){
         return rc;
     }
 
-    // process X[i] into sha based on the indices
-    for (int i=0;i<n;i++){
-        HASH_UTILS_hash_oct(sha, &X[indices[i]]);
+    for (int i = 0; i < n; i++)
+    {
+        OCT_clear(&set[i]);
+        OCT_jbytes(&set[i], set_packed->val + i*size, size);
     }
 
-    for (int i=0;i<n;i++) {
-        OCT_clear(&X[i]);
+    return CG21_OK;
+}
+
+extern int CG21_hash_set_X(hash256 *sha, octet *X_packed, octet *j_packed, int n, int m){
+
+    int ids[n];
+    int order[n];
+    CG21_PARTY_TABLE table;
+
+    int rc = CG21_PARTY_TABLE_init(&table, ids, order, j_packed, n);
+    if (rc != CG21_OK){
+        return rc;
     }
 
-    return CG21_OK;
+    return CG21_PARTY_TABLE_hash_set(sha, &table, X_packed, m);
 }
 
 int CG21_set_comp(octet *set_packed1, octet *j_packed1, octet *set_packed2, octet *j_packed2, int n, int size){
 
-    int indices1[n];
-    int indices2[n];
-    int arr1[n];
-    int arr2[n];
+    int ids1[n];
+    int ids2[n];
+    int order1[n];
+    int order2[n];
     int ret;
 
-    char x1_[n][size];
-    char x2_[n][size];
-    char temp1[n * 4 + 1];
-    char temp2[n * 4 + 1];
+    CG21_PARTY_TABLE table1;
+    CG21_PARTY_TABLE table2;
 
-    octet X1[n];
-    octet X2[n];
-
-    init_octets((char *)x1_,  X1,  size, n);
-    init_octets((char *)x2_,  X2,  size, n);
-
-    // convert oct to hex
-    OCT_toHex(j_packed1, temp1);
-    OCT_toHex(j_packed2, temp2);
-
-    // convert hex to array of int
-    hex_to_array(temp1, arr1, n);
-    hex_to_array(temp2, arr2, n);
+    if (set_packed1->len != n*size || set_packed2->len != n*size)
+    {
+        return CG21_UTILITIES_WRONG_PACKED_SIZE;
+    }
 
-    ret = CG21_unpack_and_sort(X1, set_packed1,j_packed1,n,size,indices1);
+    ret = CG21_PARTY_TABLE_init(&table1, ids1, order1, j_packed1, n);
     if (ret != CG21_OK){
         return ret;
     }
-    ret = CG21_unpack_and_sort(X2, set_packed2,j_packed2,n,size,indices2);
+    ret = CG21_PARTY_TABLE_init(&table2, ids2, order2, j_packed2, n);
     if (ret != CG21_OK){
         return ret;
     }
 
     for (int i=0;i<n;i++){
-        if (arr1[indices1[i]] != arr2[indices2[i]]){
+        if (ids1[order1[i]] != ids2[order2[i]]){
             return 0;
         }
     }
 
     for (int i=0;i<n;i++){
-        ret = OCT_comp(&X1[indices1[i]],&X2[indices2[i]]);
-        if (ret != 1){
+        octet X1 = {size, size, set_packed1->val + order1[i] * size};
+        octet X2 = {size, size, set_packed2->val + order2[i] * size};
+
+        if (OCT_comp(&X1, &X2) != 1){
             return 0;
         }
     }
@@ -668,6 +1195,32 @@ int CG21_ADD_TWO_PK(octet *O, const octet *P){
     return CG21_OK;
 }
 
+void CG21_ECP_ACCUMULATOR_init(CG21_ECP_ACCUMULATOR *acc)
+{
+    ECP_SECP256K1_inf(&acc->P);
+}
+
+int CG21_ECP_ACCUMULATOR_add(CG21_ECP_ACCUMULATOR *acc, const octet *P)
+{
+    ECP_SECP256K1 tt;
+
+    if (!ECP_SECP256K1_fromOctet(&tt, (octet *)P))
+    {
+        return CG21_INVALID_ECP;
+    }
+
+    ECP_SECP256K1_add(&acc->P, &tt);
+
+    ECP_SECP256K1_inf(&tt);
+
+    return CG21_OK;
+}
+
+void CG21_ECP_ACCUMULATOR_output(CG21_ECP_ACCUMULATOR *acc, octet *O)
+{
+    ECP_SECP256K1_toOctet(O, &acc->P, true);
+}
+
 void CG21_pack_vss_checks(const octet *checks, int t, octet *out){
     for (int i = 0; i < t; i++){
         OCT_joctet(out, checks+i);
@@ -756,6 +1309,10 @@ void CG21_PedersenPriv_to_octet(PEDERSEN_PRIV *priv, octet *oct){
 
 int CG21_PedersenPriv_from_octet(PEDERSEN_PRIV *priv, octet *oct){
 
+    // the combs are not serialized
+    priv->comb_b0 = NULL;
+    priv->comb_b1 = NULL;
+
     // check whether the length of the octet is correct
     if (oct->len != 6*FS_2048+3*HFS_2048)
     {
@@ -1000,42 +1557,408 @@ void CG21_lagrange_calc_coeff(int k, const octet *X_j, const octet *X, BIG_256_5
 
 }
 
+int CG21_lagrange_coeff(int t, const int *T, int id, BIG_256_56 coeff){
+
+    int found = 0;
+
+    for (int k = 0; k < t; k++){
+        if (T[k] == id){
+            found = 1;
+        }
+    }
+
+    if (t < 2 || !found){
+        return CG21_LAGRANGE_INVALID_SET;
+    }
+
+    char x_[t - 1][EGS_SECP256K1];
+    octet X[t - 1];
+    init_octets((char *) x_, X, EGS_SECP256K1, t - 1);
+
+    // X components of the other signers
+    CG21_lagrange_index_to_octet(t, T, id, X);
+
+    // X component of the signer
+    char x2[EGS_SECP256K1];
+    octet X2 = {0, sizeof(x2), x2};
+    BIG_256_56 x;
+
+    BIG_256_56_zero(x);
+    BIG_256_56_inc(x, id);
+    BIG_256_56_toBytes(X2.val, x);
+    X2.len = SGS_SECP256K1;
+
+    CG21_lagrange_calc_coeff(t, &X2, X, &x);
+    BIG_256_56_copy(coeff, x);
+
+    return CG21_OK;
+}
+
+int CG21_lagrange_coeffs(int t, const int *T, CG21_LAGRANGE_CACHE_ENTRY *entry){
+
+    BIG_256_56 q;
+    BIG_256_56 w;
+    BIG_256_56 inv;
+    DBIG_256_56 dw;
+
+    if (t < 1 || t > CG21_LAGRANGE_MAX_SIGNERS){
+        return CG21_LAGRANGE_INVALID_SET;
+    }
+
+    // sort the IDs, the key of the set
+    for (int k = 0; k < t; k++){
+        int id = T[k];
+        int m = k;
+
+        while (m > 0 && entry->ids[m-1] > id){
+            entry->ids[m] = entry->ids[m-1];
+            m--;
+        }
+        entry->ids[m] = id;
+    }
+
+    for (int k = 0; k < t; k++){
+        if (entry->ids[k] < 1 || (k > 0 && entry->ids[k] == entry->ids[k-1])){
+            entry->t = 0;
+            return CG21_LAGRANGE_INVALID_SET;
+        }
+    }
+
+    BIG_256_56 x[t];
+    BIG_256_56 d[t];
+    BIG_256_56 acc[t];
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (int k = 0; k < t; k++){
+        BIG_256_56_zero(x[k]);
+        BIG_256_56_inc(x[k], entry->ids[k]);
+    }
+
+    // numerators coeff_k = prod_{m != k} x_m, from partial left and right products
+    BIG_256_56_one(entry->coeff[0]);
+    for (int k = 1; k < t; k++){
+        BIG_256_56_mul(dw, entry->coeff[k-1], x[k-1]);
+        BIG_256_56_dmod(entry->coeff[k], dw, q);
+    }
+
+    BIG_256_56_one(w);
+    for (int k = t-1; k >= 0; k--){
+        BIG_256_56_mul(dw, entry->coeff[k], w);
+        BIG_256_56_dmod(entry->coeff[k], dw, q);
+
+        BIG_256_56_mul(dw, w, x[k]);
+        BIG_256_56_dmod(w, dw, q);
+    }
+
+    // denominators d_k = prod_{m != k} (x_m - x_k), and their running products
+    for (int k = 0; k < t; k++){
+        BIG_256_56_one(d[k]);
+
+        for (int m = 0; m < t; m++){
+            if (m == k){
+                continue;
+            }
+
+            int diff = entry->ids[m] - entry->ids[k];
+
+            BIG_256_56_zero(w);
+            BIG_256_56_inc(w, diff < 0 ? -diff : diff);
+            if (diff < 0){
+                BIG_256_56_modneg(w, w, q);
+            }
+
+            BIG_256_56_mul(dw, d[k], w);
+            BIG_256_56_dmod(d[k], dw, q);
+        }
+
+        if (k == 0){
+            BIG_256_56_copy(acc[0], d[0]);
+        }
+        else{
+            BIG_256_56_mul(dw, acc[k-1], d[k]);
+            BIG_256_56_dmod(acc[k], dw, q);
+        }
+    }
+
+    // one inversion for all the denominators (Montgomery's trick)
+    BIG_256_56_invmodp(inv, acc[t-1], q);
+
+    for (int k = t-1; k >= 0; k--){
+        // w = 1/d_k
+        if (k > 0){
+            BIG_256_56_mul(dw, inv, acc[k-1]);
+            BIG_256_56_dmod(w, dw, q);
+
+            BIG_256_56_mul(dw, inv, d[k]);
+            BIG_256_56_dmod(inv, dw, q);
+        }
+        else{
+            BIG_256_56_copy(w, inv);
+        }
+
+        BIG_256_56_mul(dw, entry->coeff[k], w);
+        BIG_256_56_dmod(entry->coeff[k], dw, q);
+    }
+
+    entry->t = t;
+
+    return CG21_OK;
+}
+
+int CG21_lagrange_entry_coeff(const CG21_LAGRANGE_CACHE_ENTRY *entry, int id, BIG_256_56 coeff){
+
+    int lo = 0;
+    int hi = entry->t - 1;
+
+    while (lo <= hi){
+        int mid = (lo + hi) / 2;
+
+        if (entry->ids[mid] == id){
+            BIG_256_56_copy(coeff, entry->coeff[mid]);
+            return CG21_OK;
+        }
+
+        if (entry->ids[mid] < id){
+            lo = mid + 1;
+        }
+        else{
+            hi = mid - 1;
+        }
+    }
+
+    return CG21_LAGRANGE_INVALID_SET;
+}
+
+void CG21_LAGRANGE_CACHE_init(CG21_LAGRANGE_CACHE *cache, CG21_LAGRANGE_CACHE_ENTRY *entries, int capacity){
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->next = 0;
+}
+
+void CG21_LAGRANGE_CACHE_kill(CG21_LAGRANGE_CACHE *cache){
+    for (int k = 0; k < cache->count; k++){
+        for (int m = 0; m < cache->entries[k].t; m++){
+            BIG_256_56_zero(cache->entries[k].coeff[m]);
+        }
+        cache->entries[k].t = 0;
+    }
+
+    cache->count = 0;
+    cache->next = 0;
+}
+
+int CG21_LAGRANGE_CACHE_coeff(CG21_LAGRANGE_CACHE *cache, int t, const int *T, int id, BIG_256_56 coeff){
+
+    CG21_LAGRANGE_CACHE_ENTRY tmp;
+    CG21_LAGRANGE_CACHE_ENTRY *e;
+
+    if (t < 1){
+        return CG21_LAGRANGE_INVALID_SET;
+    }
+
+    // too many signers for an entry, computed on each lookup
+    if (t > CG21_LAGRANGE_MAX_SIGNERS){
+        return CG21_lagrange_coeff(t, T, id, coeff);
+    }
+
+    if (cache == NULL || cache->capacity < 1){
+        int rc = CG21_lagrange_coeffs(t, T, &tmp);
+        if (rc != CG21_OK){
+            return rc;
+        }
+
+        return CG21_lagrange_entry_coeff(&tmp, id, coeff);
+    }
+
+    // sorted set, the key of the entries
+    int ids[t];
+    for (int k = 0; k < t; k++){
+        int m = k;
+
+        while (m > 0 && ids[m-1] > T[k]){
+            ids[m] = ids[m-1];
+            m--;
+        }
+        ids[m] = T[k];
+    }
+
+    for (int k = 0; k < cache->count; k++){
+        e = cache->entries + k;
+
+        if (e->t != t){
+            continue;
+        }
+
+        int m = 0;
+        while (m < t && e->ids[m] == ids[m]){
+            m++;
+        }
+
+        if (m == t){
+            return CG21_lagrange_entry_coeff(e, id, coeff);
+        }
+    }
+
+    // new set, checked before it takes a free entry or the place of the oldest one
+    int rc = CG21_lagrange_coeffs(t, ids, &tmp);
+    if (rc != CG21_OK){
+        return rc;
+    }
+
+    if (cache->count < cache->capacity){
+        e = cache->entries + cache->count;
+        cache->count++;
+    }
+    else{
+        e = cache->entries + cache->next;
+        cache->next = (cache->next + 1) % cache->capacity;
+    }
+
+    *e = tmp;
+
+    return CG21_lagrange_entry_coeff(e, id, coeff);
+}
+
+void CG21_POINT_CACHE_init(CG21_POINT_CACHE *cache, CG21_POINT_CACHE_ENTRY *entries, int capacity)
+{
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->next = 0;
+}
+
+void CG21_POINT_CACHE_kill(CG21_POINT_CACHE *cache)
+{
+    for (int k = 0; k < cache->count; k++)
+    {
+        ECP_SECP256K1_inf(&cache->entries[k].G);
+        cache->entries[k].len = 0;
+    }
+
+    cache->count = 0;
+    cache->next = 0;
+}
+
+static bool CG21_POINT_CACHE_match(const CG21_POINT_CACHE_ENTRY *e, const octet *P)
+{
+    if (e->len != P->len)
+    {
+        return false;
+    }
+
+    for (int b = 0; b < P->len; b++)
+    {
+        if (e->P[b] != P->val[b])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int CG21_POINT_CACHE_get(CG21_POINT_CACHE *cache, int id, int role, int index, const octet *P, ECP_SECP256K1 *G)
+{
+    CG21_POINT_CACHE_ENTRY *e = NULL;
+
+    if (cache != NULL && cache->capacity > 0 && P->len <= EFS_SECP256K1 + 1)
+    {
+        for (int k = 0; k < cache->count; k++)
+        {
+            CG21_POINT_CACHE_ENTRY *c = cache->entries + k;
+            if (c->id == id && c->role == role && c->index == index)
+            {
+                e = c;
+                break;
+            }
+        }
+
+        if (e != NULL && CG21_POINT_CACHE_match(e, P))
+        {
+            ECP_SECP256K1_copy(G, &e->G);
+            return CG21_OK;
+        }
+    }
+
+    if (!ECP_SECP256K1_fromOctet(G, (octet *)P))
+    {
+        return CG21_INVALID_ECP;
+    }
+
+    if (cache == NULL || cache->capacity <= 0 || P->len > EFS_SECP256K1 + 1)
+    {
+        return CG21_OK;
+    }
+
+    // Reuse the stale entry for this key, else a free one, else the oldest one
+    if (e == NULL)
+    {
+        if (cache->count < cache->capacity)
+        {
+            e = cache->entries + cache->count;
+            cache->count++;
+        }
+        else
+        {
+            e = cache->entries + cache->next;
+            cache->next = (cache->next + 1) % cache->capacity;
+        }
+    }
+
+    e->id = id;
+    e->role = role;
+    e->index = index;
+    e->len = P->len;
+    for (int b = 0; b < P->len; b++)
+    {
+        e->P[b] = P->val[b];
+    }
+    ECP_SECP256K1_copy(&e->G, G);
+
+    return CG21_OK;
+}
+
 int CG21_CALC_XI(int t, const octet *i, const octet *checks, ECP_SECP256K1 *V)
+{
+    return CG21_CALC_XI_CACHED(t, i, checks, NULL, 0, V);
+}
+
+int CG21_CALC_XI_CACHED(int t, const octet *i, const octet *checks, CG21_POINT_CACHE *cache, int id,
+                        ECP_SECP256K1 *V)
 {
     int rc;
-    ECP_SECP256K1 G;
+    ECP_SECP256K1 G[t];
     BIG_256_56  x;
-    BIG_256_56 xn;
+    BIG_256_56 xn[t];
     BIG_256_56 q;
     DBIG_256_56 w;
 
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
     BIG_256_56_fromBytesLen(x, i->val, i->len);
 
-    // Initialize accumulator and exponent
-    rc = ECP_SECP256K1_fromOctet(V, checks);
-    if (rc != 1)
-    {
-        return VSS_INVALID_CHECKS;
-    }
-    BIG_256_56_one(xn);
+    // Load checks and exponents x^j
+    BIG_256_56_one(xn[0]);
 
-    for (int j = 1; j < t; j++)
+    for (int j = 0; j < t; j++)
     {
-        rc = ECP_SECP256K1_fromOctet(&G, checks+j);
-        if (rc != 1)
+        rc = CG21_POINT_CACHE_get(cache, id, CG21_POINT_CACHE_VSS_CHECK, j, checks+j, G+j);
+        if (rc != CG21_OK)
         {
             return VSS_INVALID_CHECKS;
         }
 
-        BIG_256_56_mul(w, xn, x);
-        BIG_256_56_dmod(xn, w, q);
-
-        ECP_SECP256K1_mul(&G, xn);
-        ECP_SECP256K1_add(V, &G);
+        if (j > 0)
+        {
+            BIG_256_56_mul(w, xn[j-1], x);
+            BIG_256_56_dmod(xn[j], w, q);
+        }
     }
 
-
+    // V = C_0 + x.C_1 + ... + x^{t-1}.C_{t-1}
+    ECP_MSM_mul(V, G+1, xn+1, t-1);
+    ECP_SECP256K1_add(V, G);
 
     return VSS_OK;
 }
@@ -1206,25 +2129,116 @@ int CG21_hash_SSID(CG21_SSID *ssid, hash256 *sha){
         return rc;
     }
 
-    rc = CG21_hash_set_X(sha, ssid->N_set_packed, ssid->j_set_packed2, *ssid->n2, FS_2048);
+    // N, s and t share the IDs, so they are sorted once
+    int ids[*ssid->n2];
+    int order[*ssid->n2];
+    CG21_PARTY_TABLE table2;
+
+    rc = CG21_PARTY_TABLE_init(&table2, ids, order, ssid->j_set_packed2, *ssid->n2);
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    rc = CG21_PARTY_TABLE_hash_set(sha, &table2, ssid->N_set_packed, FS_2048);
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    rc = CG21_PARTY_TABLE_hash_set(sha, &table2, ssid->s_set_packed, FS_2048);
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    rc = CG21_PARTY_TABLE_hash_set(sha, &table2, ssid->t_set_packed, FS_2048);
+
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    return CG21_OK;
+}
+
+/* Append a packed set to S in the order of the IDs */
+static int CG21_SSID_CTX_join_set(octet *S, const CG21_PARTY_TABLE *table, const octet *X_packed, int m){
+
+    if (X_packed->len != table->n * m)
+    {
+        return CG21_UTILITIES_WRONG_PACKED_SIZE;
+    }
+
+    for (int k=0; k<table->n; k++){
+        OCT_jbytes(S, X_packed->val + table->order[k] * m, m);
+    }
+
+    return CG21_OK;
+}
+
+int CG21_SSID_CTX_init(CG21_SSID_CTX *ctx, CG21_SSID *ssid, octet *S){
+
+    int rc;
+    int n1 = *ssid->n1;
+    int n2 = *ssid->n2;
+
+    int ids1[n1];
+    int order1[n1];
+    int ids2[n2];
+    int order2[n2];
+    CG21_PARTY_TABLE table1;
+    CG21_PARTY_TABLE table2;
+
+    int len = ssid->rho->len + ssid->rid->len + ssid->uid->len + ssid->q->len + ssid->g->len +
+              ssid->X_set_packed->len + ssid->N_set_packed->len + ssid->s_set_packed->len + ssid->t_set_packed->len;
+    if (len > S->max)
+    {
+        return CG21_SSID_CTX_TOO_SMALL;
+    }
+
+    rc = CG21_PARTY_TABLE_init(&table1, ids1, order1, ssid->j_set_packed, n1);
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    rc = CG21_PARTY_TABLE_init(&table2, ids2, order2, ssid->j_set_packed2, n2);
+    if (rc!=CG21_OK){
+        return rc;
+    }
+
+    // same order as CG21_hash_SSID
+    OCT_copy(S, ssid->rho);
+    OCT_joctet(S, ssid->rid);
+    OCT_joctet(S, ssid->uid);
+    OCT_joctet(S, ssid->q);
+    OCT_joctet(S, ssid->g);
+
+    rc = CG21_SSID_CTX_join_set(S, &table1, ssid->X_set_packed, EFS_SECP256K1 + 1);
     if (rc!=CG21_OK){
         return rc;
     }
 
-    rc = CG21_hash_set_X(sha, ssid->s_set_packed, ssid->j_set_packed2, *ssid->n2, FS_2048);
+    rc = CG21_SSID_CTX_join_set(S, &table2, ssid->N_set_packed, FS_2048);
     if (rc!=CG21_OK){
         return rc;
     }
 
-    rc = CG21_hash_set_X(sha, ssid->t_set_packed, ssid->j_set_packed2, *ssid->n2, FS_2048);
+    rc = CG21_SSID_CTX_join_set(S, &table2, ssid->s_set_packed, FS_2048);
+    if (rc!=CG21_OK){
+        return rc;
+    }
 
+    rc = CG21_SSID_CTX_join_set(S, &table2, ssid->t_set_packed, FS_2048);
     if (rc!=CG21_OK){
         return rc;
     }
 
+    ctx->S = S;
+
     return CG21_OK;
 }
 
+void CG21_SSID_CTX_hash(const CG21_SSID_CTX *ctx, hash256 *sha){
+    HASH_UTILS_hash_oct(sha, ctx->S);
+}
+
 int CG21_calculateBitLength(int number) {
     int count = 0;
 
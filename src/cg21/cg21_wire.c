@@ -0,0 +1,493 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/cg21/cg21_wire.h"
+
+typedef struct
+{
+    octet *O;           // destination when encoding, source when decoding
+    int decode;
+    int pos;            // read position when decoding
+    int rc;             // first error, the following fields are skipped
+} CG21_WIRE;
+
+/* Encode or decode the fields of one message */
+typedef void (*CG21_WIRE_FIELDS)(CG21_WIRE *w, void *msg);
+
+static void CG21_WIRE_PUT(CG21_WIRE *w, const char *b, int len){
+    if (w->O->len + len > w->O->max){
+        w->rc = CG21_WIRE_BUFFER_TOO_SMALL;
+        return;
+    }
+
+    OCT_jbytes(w->O, (char *) b, len);
+}
+
+static const char *CG21_WIRE_GET(CG21_WIRE *w, int len){
+    const char *b = w->O->val + w->pos;
+
+    if (len > w->O->len - w->pos){
+        w->rc = CG21_WIRE_INVALID_FORMAT;
+        return NULL;
+    }
+
+    w->pos += len;
+
+    return b;
+}
+
+static void CG21_WIRE_PUT_INT(CG21_WIRE *w, int x){
+    char b[4];
+
+    for (int k=0; k<4; k++){
+        b[k] = (char) (((unsigned int) x >> (8 * (3 - k))) & 0xff);
+    }
+
+    CG21_WIRE_PUT(w, b, 4);
+}
+
+static int CG21_WIRE_GET_INT(CG21_WIRE *w){
+    unsigned int x = 0;
+
+    const char *b = CG21_WIRE_GET(w, 4);
+    if (b == NULL){
+        return 0;
+    }
+
+    for (int k=0; k<4; k++){
+        x = (x << 8) | (unsigned char) b[k];
+    }
+
+    return (int) x;
+}
+
+/* Integer field */
+static void CG21_WIRE_INT(CG21_WIRE *w, int *x){
+    if (w->rc != CG21_OK){
+        return;
+    }
+
+    if (w->decode){
+        int y = CG21_WIRE_GET_INT(w);
+        if (w->rc == CG21_OK){
+            *x = y;
+        }
+    }
+    else{
+        CG21_WIRE_PUT_INT(w, *x);
+    }
+}
+
+/* Octet field, prefixed by its length */
+static void CG21_WIRE_OCT(CG21_WIRE *w, octet *X){
+    if (w->rc != CG21_OK){
+        return;
+    }
+
+    if (!w->decode){
+        CG21_WIRE_PUT_INT(w, X->len);
+        if (w->rc == CG21_OK){
+            CG21_WIRE_PUT(w, X->val, X->len);
+        }
+        return;
+    }
+
+    int len = CG21_WIRE_GET_INT(w);
+    if (w->rc != CG21_OK){
+        return;
+    }
+
+    if (len < 0){
+        w->rc = CG21_WIRE_INVALID_FORMAT;
+        return;
+    }
+
+    const char *b = CG21_WIRE_GET(w, len);
+    if (b == NULL){
+        return;
+    }
+
+    if (len > X->max){
+        w->rc = CG21_WIRE_BUFFER_TOO_SMALL;
+        return;
+    }
+
+    OCT_empty(X);
+    OCT_jbytes(X, (char *) b, len);
+}
+
+static int CG21_WIRE_ENCODE(octet *OUT, int type, CG21_WIRE_FIELDS fields, void *msg){
+    char h[CG21_WIRE_HEADER_SIZE] = {CG21_WIRE_VERSION, (char) type};
+    CG21_WIRE w = {OUT, 0, 0, CG21_OK};
+
+    OUT->len = 0;
+
+    CG21_WIRE_PUT(&w, h, CG21_WIRE_HEADER_SIZE);
+    if (w.rc == CG21_OK){
+        fields(&w, msg);
+    }
+
+    return w.rc;
+}
+
+static int CG21_WIRE_DECODE(octet *IN, int type, CG21_WIRE_FIELDS fields, void *msg){
+    CG21_WIRE w = {IN, 1, 0, CG21_OK};
+
+    const char *h = CG21_WIRE_GET(&w, CG21_WIRE_HEADER_SIZE);
+    if (h == NULL){
+        return w.rc;
+    }
+
+    if (h[0] != CG21_WIRE_VERSION){
+        return CG21_WIRE_WRONG_VERSION;
+    }
+
+    if (h[1] != (char) type){
+        return CG21_WIRE_WRONG_TYPE;
+    }
+
+    fields(&w, msg);
+    if (w.rc != CG21_OK){
+        return w.rc;
+    }
+
+    // the whole message must be used
+    if (w.pos != IN->len){
+        return CG21_WIRE_INVALID_FORMAT;
+    }
+
+    return CG21_OK;
+}
+
+static void CG21_WIRE_FIELDS_KEYGEN_ROUND1_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_KEYGEN_ROUND1_output *m = (CG21_KEYGEN_ROUND1_output *)msg;
+
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_OCT(w, m->V);
+}
+
+int CG21_WIRE_ENCODE_KEYGEN_ROUND1_OUTPUT(octet *OUT, CG21_KEYGEN_ROUND1_output *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_KEYGEN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_KEYGEN_ROUND1_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_KEYGEN_ROUND1_OUTPUT(CG21_KEYGEN_ROUND1_output *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_KEYGEN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_KEYGEN_ROUND1_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_KEYGEN_ROUND1_STORE_PUB(CG21_WIRE *w, void *msg){
+    CG21_KEYGEN_ROUND1_STORE_PUB *m = (CG21_KEYGEN_ROUND1_STORE_PUB *)msg;
+
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_OCT(w, m->sid.q);
+    CG21_WIRE_OCT(w, m->sid.g);
+    CG21_WIRE_OCT(w, m->sid.P);
+    CG21_WIRE_OCT(w, m->sid.uid);
+    CG21_WIRE_OCT(w, m->rid);
+    CG21_WIRE_OCT(w, m->X);
+    CG21_WIRE_OCT(w, m->A);
+    CG21_WIRE_OCT(w, m->A2);
+    CG21_WIRE_OCT(w, m->u);
+    CG21_WIRE_OCT(w, m->packed_checks);
+}
+
+int CG21_WIRE_ENCODE_KEYGEN_ROUND1_STORE_PUB(octet *OUT, CG21_KEYGEN_ROUND1_STORE_PUB *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_KEYGEN_ROUND1_STORE_PUB, CG21_WIRE_FIELDS_KEYGEN_ROUND1_STORE_PUB, m);
+}
+
+int CG21_WIRE_DECODE_KEYGEN_ROUND1_STORE_PUB(CG21_KEYGEN_ROUND1_STORE_PUB *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_KEYGEN_ROUND1_STORE_PUB, CG21_WIRE_FIELDS_KEYGEN_ROUND1_STORE_PUB, m);
+}
+
+static void CG21_WIRE_FIELDS_KEYGEN_ROUND3_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_KEYGEN_ROUND3_OUTPUT *m = (CG21_KEYGEN_ROUND3_OUTPUT *)msg;
+
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_OCT(w, m->sid.q);
+    CG21_WIRE_OCT(w, m->sid.g);
+    CG21_WIRE_OCT(w, m->sid.P);
+    CG21_WIRE_OCT(w, m->sid.uid);
+    CG21_WIRE_OCT(w, m->ui_proof.A);
+    CG21_WIRE_OCT(w, m->ui_proof.psi);
+    CG21_WIRE_OCT(w, m->xi_proof.A);
+    CG21_WIRE_OCT(w, m->xi_proof.psi);
+}
+
+int CG21_WIRE_ENCODE_KEYGEN_ROUND3_OUTPUT(octet *OUT, CG21_KEYGEN_ROUND3_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_KEYGEN_ROUND3_OUTPUT, CG21_WIRE_FIELDS_KEYGEN_ROUND3_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_KEYGEN_ROUND3_OUTPUT(CG21_KEYGEN_ROUND3_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_KEYGEN_ROUND3_OUTPUT, CG21_WIRE_FIELDS_KEYGEN_ROUND3_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_AUX_ROUND1_OUT(CG21_WIRE *w, void *msg){
+    CG21_AUX_ROUND1_OUT *m = (CG21_AUX_ROUND1_OUT *)msg;
+
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_OCT(w, m->V);
+}
+
+int CG21_WIRE_ENCODE_AUX_ROUND1_OUT(octet *OUT, CG21_AUX_ROUND1_OUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_AUX_ROUND1_OUT, CG21_WIRE_FIELDS_AUX_ROUND1_OUT, m);
+}
+
+int CG21_WIRE_DECODE_AUX_ROUND1_OUT(CG21_AUX_ROUND1_OUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_AUX_ROUND1_OUT, CG21_WIRE_FIELDS_AUX_ROUND1_OUT, m);
+}
+
+static void CG21_WIRE_FIELDS_AUX_ROUND1_STORE_PUB(CG21_WIRE *w, void *msg){
+    CG21_AUX_ROUND1_STORE_PUB *m = (CG21_AUX_ROUND1_STORE_PUB *)msg;
+
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_INT(w, &m->t);
+    CG21_WIRE_OCT(w, m->rho);
+    CG21_WIRE_OCT(w, m->u);
+    CG21_WIRE_OCT(w, m->PedPub);
+    CG21_WIRE_OCT(w, m->PaiPub);
+    CG21_WIRE_OCT(w, m->pedersenProof.rho);
+    CG21_WIRE_OCT(w, m->pedersenProof.irho);
+    CG21_WIRE_OCT(w, m->pedersenProof.t);
+    CG21_WIRE_OCT(w, m->pedersenProof.it);
+}
+
+int CG21_WIRE_ENCODE_AUX_ROUND1_STORE_PUB(octet *OUT, CG21_AUX_ROUND1_STORE_PUB *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_AUX_ROUND1_STORE_PUB, CG21_WIRE_FIELDS_AUX_ROUND1_STORE_PUB, m);
+}
+
+int CG21_WIRE_DECODE_AUX_ROUND1_STORE_PUB(CG21_AUX_ROUND1_STORE_PUB *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_AUX_ROUND1_STORE_PUB, CG21_WIRE_FIELDS_AUX_ROUND1_STORE_PUB, m);
+}
+
+static void CG21_WIRE_FIELDS_AUX_ROUND3(CG21_WIRE *w, void *msg){
+    CG21_AUX_ROUND3 *m = (CG21_AUX_ROUND3 *)msg;
+
+    CG21_WIRE_OCT(w, m->rho);
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_INT(w, &m->t);
+    CG21_WIRE_OCT(w, m->paillierProof.w);
+    CG21_WIRE_OCT(w, m->paillierProof.x);
+    CG21_WIRE_OCT(w, m->paillierProof.z);
+    CG21_WIRE_OCT(w, m->paillierProof.ab);
+    CG21_WIRE_OCT(w, m->factorProof.z1);
+    CG21_WIRE_OCT(w, m->factorProof.z2);
+    CG21_WIRE_OCT(w, m->factorProof.w1);
+    CG21_WIRE_OCT(w, m->factorProof.w2);
+    CG21_WIRE_OCT(w, m->factorProof.v);
+    CG21_WIRE_OCT(w, m->factorCommits.P);
+    CG21_WIRE_OCT(w, m->factorCommits.Q);
+    CG21_WIRE_OCT(w, m->factorCommits.A);
+    CG21_WIRE_OCT(w, m->factorCommits.B);
+    CG21_WIRE_OCT(w, m->factorCommits.T);
+    CG21_WIRE_OCT(w, m->factorCommits.sigma);
+}
+
+int CG21_WIRE_ENCODE_AUX_ROUND3(octet *OUT, CG21_AUX_ROUND3 *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_AUX_ROUND3, CG21_WIRE_FIELDS_AUX_ROUND3, m);
+}
+
+int CG21_WIRE_DECODE_AUX_ROUND3(CG21_AUX_ROUND3 *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_AUX_ROUND3, CG21_WIRE_FIELDS_AUX_ROUND3, m);
+}
+
+static void CG21_WIRE_FIELDS_RESHARE_ROUND1_OUT(CG21_WIRE *w, void *msg){
+    CG21_RESHARE_ROUND1_OUT *m = (CG21_RESHARE_ROUND1_OUT *)msg;
+
+    CG21_WIRE_OCT(w, m->V);
+    CG21_WIRE_INT(w, m->i);
+}
+
+int CG21_WIRE_ENCODE_RESHARE_ROUND1_OUT(octet *OUT, CG21_RESHARE_ROUND1_OUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_RESHARE_ROUND1_OUT, CG21_WIRE_FIELDS_RESHARE_ROUND1_OUT, m);
+}
+
+int CG21_WIRE_DECODE_RESHARE_ROUND1_OUT(CG21_RESHARE_ROUND1_OUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_RESHARE_ROUND1_OUT, CG21_WIRE_FIELDS_RESHARE_ROUND1_OUT, m);
+}
+
+static void CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_T1(CG21_WIRE *w, void *msg){
+    CG21_RESHARE_ROUND1_STORE_PUB_T1 *m = (CG21_RESHARE_ROUND1_STORE_PUB_T1 *)msg;
+
+    CG21_WIRE_OCT(w, m->Xi);
+    CG21_WIRE_OCT(w, m->checks);
+    CG21_WIRE_OCT(w, m->rho);
+    CG21_WIRE_OCT(w, m->A);
+    CG21_WIRE_OCT(w, m->u);
+    CG21_WIRE_INT(w, m->i);
+}
+
+int CG21_WIRE_ENCODE_RESHARE_ROUND1_STORE_PUB_T1(octet *OUT, CG21_RESHARE_ROUND1_STORE_PUB_T1 *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_RESHARE_ROUND1_STORE_PUB_T1, CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_T1, m);
+}
+
+int CG21_WIRE_DECODE_RESHARE_ROUND1_STORE_PUB_T1(CG21_RESHARE_ROUND1_STORE_PUB_T1 *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_RESHARE_ROUND1_STORE_PUB_T1, CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_T1, m);
+}
+
+static void CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_N2(CG21_WIRE *w, void *msg){
+    CG21_RESHARE_ROUND1_STORE_PUB_N2 *m = (CG21_RESHARE_ROUND1_STORE_PUB_N2 *)msg;
+
+    CG21_WIRE_OCT(w, m->rho);
+    CG21_WIRE_OCT(w, m->A);
+    CG21_WIRE_OCT(w, m->u);
+    CG21_WIRE_INT(w, m->i);
+}
+
+int CG21_WIRE_ENCODE_RESHARE_ROUND1_STORE_PUB_N2(octet *OUT, CG21_RESHARE_ROUND1_STORE_PUB_N2 *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_RESHARE_ROUND1_STORE_PUB_N2, CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_N2, m);
+}
+
+int CG21_WIRE_DECODE_RESHARE_ROUND1_STORE_PUB_N2(CG21_RESHARE_ROUND1_STORE_PUB_N2 *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_RESHARE_ROUND1_STORE_PUB_N2, CG21_WIRE_FIELDS_RESHARE_ROUND1_STORE_PUB_N2, m);
+}
+
+static void CG21_WIRE_FIELDS_RESHARE_ROUND3_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_RESHARE_ROUND3_OUTPUT *m = (CG21_RESHARE_ROUND3_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->X);
+    CG21_WIRE_OCT(w, m->C);
+    CG21_WIRE_INT(w, m->i);
+    CG21_WIRE_INT(w, m->j);
+}
+
+int CG21_WIRE_ENCODE_RESHARE_ROUND3_OUTPUT(octet *OUT, CG21_RESHARE_ROUND3_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_RESHARE_ROUND3_OUTPUT, CG21_WIRE_FIELDS_RESHARE_ROUND3_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_RESHARE_ROUND3_OUTPUT(CG21_RESHARE_ROUND3_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_RESHARE_ROUND3_OUTPUT, CG21_WIRE_FIELDS_RESHARE_ROUND3_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_RESHARE_ROUND4_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_RESHARE_ROUND4_OUTPUT *m = (CG21_RESHARE_ROUND4_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->proof.A);
+    CG21_WIRE_OCT(w, m->proof.psi);
+    CG21_WIRE_INT(w, m->i);
+}
+
+int CG21_WIRE_ENCODE_RESHARE_ROUND4_OUTPUT(octet *OUT, CG21_RESHARE_ROUND4_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_RESHARE_ROUND4_OUTPUT, CG21_WIRE_FIELDS_RESHARE_ROUND4_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_RESHARE_ROUND4_OUTPUT(CG21_RESHARE_ROUND4_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_RESHARE_ROUND4_OUTPUT, CG21_WIRE_FIELDS_RESHARE_ROUND4_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_PRESIGN_ROUND1_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_PRESIGN_ROUND1_OUTPUT *m = (CG21_PRESIGN_ROUND1_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->psi);
+    CG21_WIRE_OCT(w, m->G);
+    CG21_WIRE_OCT(w, m->K);
+    CG21_WIRE_INT(w, &m->i);
+}
+
+int CG21_WIRE_ENCODE_PRESIGN_ROUND1_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND1_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_PRESIGN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND1_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_PRESIGN_ROUND1_OUTPUT(CG21_PRESIGN_ROUND1_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_PRESIGN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND1_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_PRESIGN_ROUND2_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_PRESIGN_ROUND2_OUTPUT *m = (CG21_PRESIGN_ROUND2_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->Gamma);
+    CG21_WIRE_OCT(w, m->D);
+    CG21_WIRE_OCT(w, m->D_hat);
+    CG21_WIRE_OCT(w, m->F);
+    CG21_WIRE_OCT(w, m->F_hat);
+    CG21_WIRE_OCT(w, m->psi);
+    CG21_WIRE_OCT(w, m->psi_hat);
+    CG21_WIRE_OCT(w, m->psi_prime);
+    CG21_WIRE_INT(w, &m->i);
+    CG21_WIRE_INT(w, &m->j);
+}
+
+int CG21_WIRE_ENCODE_PRESIGN_ROUND2_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND2_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_PRESIGN_ROUND2_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND2_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(CG21_PRESIGN_ROUND2_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_PRESIGN_ROUND2_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND2_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_PRESIGN_ROUND3_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_PRESIGN_ROUND3_OUTPUT *m = (CG21_PRESIGN_ROUND3_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->delta);
+    CG21_WIRE_OCT(w, m->Delta);
+    CG21_WIRE_OCT(w, m->psi_douplePrime);
+    CG21_WIRE_INT(w, &m->i);
+}
+
+int CG21_WIRE_ENCODE_PRESIGN_ROUND3_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND3_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_PRESIGN_ROUND3_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND3_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_PRESIGN_ROUND3_OUTPUT(CG21_PRESIGN_ROUND3_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_PRESIGN_ROUND3_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND3_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_PRESIGN_ROUND4_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_PRESIGN_ROUND4_OUTPUT *m = (CG21_PRESIGN_ROUND4_OUTPUT *)msg;
+
+    CG21_WIRE_INT(w, &m->PRESIGN_SUCCESS);
+    CG21_WIRE_INT(w, &m->i);
+}
+
+int CG21_WIRE_ENCODE_PRESIGN_ROUND4_OUTPUT(octet *OUT, CG21_PRESIGN_ROUND4_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_PRESIGN_ROUND4_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND4_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_PRESIGN_ROUND4_OUTPUT(CG21_PRESIGN_ROUND4_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_PRESIGN_ROUND4_OUTPUT, CG21_WIRE_FIELDS_PRESIGN_ROUND4_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_SIGN_ROUND1_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_SIGN_ROUND1_OUTPUT *m = (CG21_SIGN_ROUND1_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->sigma);
+    CG21_WIRE_INT(w, &m->i);
+}
+
+int CG21_WIRE_ENCODE_SIGN_ROUND1_OUTPUT(octet *OUT, CG21_SIGN_ROUND1_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_SIGN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_SIGN_ROUND1_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_SIGN_ROUND1_OUTPUT(CG21_SIGN_ROUND1_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_SIGN_ROUND1_OUTPUT, CG21_WIRE_FIELDS_SIGN_ROUND1_OUTPUT, m);
+}
+
+static void CG21_WIRE_FIELDS_SIGN_ROUND2_OUTPUT(CG21_WIRE *w, void *msg){
+    CG21_SIGN_ROUND2_OUTPUT *m = (CG21_SIGN_ROUND2_OUTPUT *)msg;
+
+    CG21_WIRE_OCT(w, m->r);
+    CG21_WIRE_OCT(w, m->sigma);
+    CG21_WIRE_INT(w, &m->i);
+}
+
+int CG21_WIRE_ENCODE_SIGN_ROUND2_OUTPUT(octet *OUT, CG21_SIGN_ROUND2_OUTPUT *m){
+    return CG21_WIRE_ENCODE(OUT, CG21_WIRE_SIGN_ROUND2_OUTPUT, CG21_WIRE_FIELDS_SIGN_ROUND2_OUTPUT, m);
+}
+
+int CG21_WIRE_DECODE_SIGN_ROUND2_OUTPUT(CG21_SIGN_ROUND2_OUTPUT *m, octet *IN){
+    return CG21_WIRE_DECODE(IN, CG21_WIRE_SIGN_ROUND2_OUTPUT, CG21_WIRE_FIELDS_SIGN_ROUND2_OUTPUT, m);
+}
@@ -0,0 +1,111 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Fixed-base multiplication by the curve generator */
+
+#include <pthread.h>
+#include "amcl/ecp_gen.h"
+
+// ECP_GEN_table[i][j] = j * 16^i * G
+static ECP_SECP256K1 ECP_GEN_table[ECP_GEN_WINDOWS][ECP_GEN_DIGITS];
+static pthread_once_t ECP_GEN_once = PTHREAD_ONCE_INIT;
+
+static void ECP_GEN_build(void)
+{
+    ECP_SECP256K1 B;
+
+    // B = 16^i * G
+    ECP_SECP256K1_generator(&B);
+
+    for (int i = 0; i < ECP_GEN_WINDOWS; i++)
+    {
+        ECP_SECP256K1_inf(&ECP_GEN_table[i][0]);
+        ECP_SECP256K1_copy(&ECP_GEN_table[i][1], &B);
+
+        for (int j = 2; j < ECP_GEN_DIGITS; j++)
+        {
+            ECP_SECP256K1_copy(&ECP_GEN_table[i][j], &ECP_GEN_table[i][j-1]);
+            ECP_SECP256K1_add(&ECP_GEN_table[i][j], &B);
+        }
+
+        for (int j = 0; j < ECP_GEN_WINDOW; j++)
+        {
+            ECP_SECP256K1_dbl(&B);
+        }
+    }
+}
+
+/* 1 if b == c, 0 otherwise, without branching */
+static int ECP_GEN_teq(sign32 b, sign32 c)
+{
+    sign32 x = b ^ c;
+    x -= 1;
+    return (x >> 31) & 1;
+}
+
+/* Constant time P = W[d], scanning the whole row */
+static void ECP_GEN_select(ECP_SECP256K1 *P, ECP_SECP256K1 W[], sign32 d)
+{
+    for (int j = 0; j < ECP_GEN_DIGITS; j++)
+    {
+        int s = ECP_GEN_teq(d, j);
+
+        FP_SECP256K1_cmove(&(P->x), &(W[j].x), s);
+        FP_SECP256K1_cmove(&(P->y), &(W[j].y), s);
+        FP_SECP256K1_cmove(&(P->z), &(W[j].z), s);
+    }
+}
+
+void ECP_GEN_precompute(void)
+{
+    pthread_once(&ECP_GEN_once, ECP_GEN_build);
+}
+
+void ECP_GEN_mul(ECP_SECP256K1 *P, BIG_256_56 s)
+{
+    BIG_256_56 t;
+    BIG_256_56 q;
+    ECP_SECP256K1 W;
+
+    ECP_GEN_precompute();
+
+    // G has order q, so the scalar can be reduced to fit the table
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_copy(t, s);
+    BIG_256_56_norm(t);
+    BIG_256_56_mod(t, q);
+
+    ECP_SECP256K1_inf(P);
+    ECP_SECP256K1_inf(&W);
+
+    for (int i = 0; i < ECP_GEN_WINDOWS; i++)
+    {
+        sign32 d = BIG_256_56_lastbits(t, ECP_GEN_WINDOW);
+        BIG_256_56_fshr(t, ECP_GEN_WINDOW);
+
+        ECP_GEN_select(&W, ECP_GEN_table[i], d);
+        ECP_SECP256K1_add(P, &W);
+    }
+
+    ECP_SECP256K1_affine(P);
+
+    // Clean memory
+    BIG_256_56_zero(t);
+    ECP_SECP256K1_inf(&W);
+}
@@ -0,0 +1,205 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Multi-scalar multiplication */
+
+#include "amcl/ecp_msm.h"
+
+#define ECP_MSM_BITS (8 * MODBYTES_256_56)  /**< Bits of a scalar reduced modulo the curve order */
+#define ECP_MSM_STRAUS_WINDOW 4             /**< Window size for Straus' method */
+#define ECP_MSM_PIPPENGER_MIN 4             /**< Smallest window size for Pippenger's method */
+#define ECP_MSM_PIPPENGER_MAX 8             /**< Largest window size for Pippenger's method */
+
+/* Digit w of width c of the scalar e */
+static int ECP_MSM_digit(BIG_256_56 e, int w, int c)
+{
+    int d = 0;
+
+    for (int b = c - 1; b >= 0; b--)
+    {
+        int k = w * c + b;
+
+        d <<= 1;
+        if (k < ECP_MSM_BITS)
+        {
+            d |= BIG_256_56_bit(e, k);
+        }
+    }
+
+    return d;
+}
+
+/* P += Q, with P at infinity tracked by the flag */
+static void ECP_MSM_add(ECP_SECP256K1 *P, int *used, ECP_SECP256K1 *Q)
+{
+    if (*used)
+    {
+        ECP_SECP256K1_add(P, Q);
+    }
+    else
+    {
+        ECP_SECP256K1_copy(P, Q);
+        *used = 1;
+    }
+}
+
+/* Straus' method: one table of multiples for each point, shared doublings */
+static void ECP_MSM_straus(ECP_SECP256K1 *P, ECP_SECP256K1 Q[], BIG_256_56 e[], int n)
+{
+    int used = 0;
+    int windows = (ECP_MSM_BITS + ECP_MSM_STRAUS_WINDOW - 1) / ECP_MSM_STRAUS_WINDOW;
+
+    // W[i][j] = (j+1).Q_i
+    ECP_SECP256K1 W[n][(1 << ECP_MSM_STRAUS_WINDOW) - 1];
+
+    for (int i = 0; i < n; i++)
+    {
+        ECP_SECP256K1_copy(&W[i][0], &Q[i]);
+        for (int j = 1; j < (1 << ECP_MSM_STRAUS_WINDOW) - 1; j++)
+        {
+            ECP_SECP256K1_copy(&W[i][j], &W[i][j-1]);
+            ECP_SECP256K1_add(&W[i][j], &Q[i]);
+        }
+    }
+
+    ECP_SECP256K1_inf(P);
+
+    for (int w = windows - 1; w >= 0; w--)
+    {
+        if (used)
+        {
+            for (int j = 0; j < ECP_MSM_STRAUS_WINDOW; j++)
+            {
+                ECP_SECP256K1_dbl(P);
+            }
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            int d = ECP_MSM_digit(e[i], w, ECP_MSM_STRAUS_WINDOW);
+            if (d != 0)
+            {
+                ECP_MSM_add(P, &used, &W[i][d-1]);
+            }
+        }
+    }
+}
+
+/* Pippenger's method: sort the points in buckets by digit, then sum the buckets */
+static void ECP_MSM_pippenger(ECP_SECP256K1 *P, ECP_SECP256K1 Q[], BIG_256_56 e[], int n)
+{
+    int used = 0;
+    int c = ECP_MSM_PIPPENGER_MIN;
+
+    // Window size close to log2(n) - 2
+    while (c < ECP_MSM_PIPPENGER_MAX && (n >> (c + 2)) > 0)
+    {
+        c++;
+    }
+
+    int windows = (ECP_MSM_BITS + c - 1) / c;
+    int buckets = (1 << c) - 1;
+
+    ECP_SECP256K1 B[buckets];
+    int full[buckets];
+
+    ECP_SECP256K1 S;
+    ECP_SECP256K1 R;
+
+    ECP_SECP256K1_inf(P);
+
+    for (int w = windows - 1; w >= 0; w--)
+    {
+        if (used)
+        {
+            for (int j = 0; j < c; j++)
+            {
+                ECP_SECP256K1_dbl(P);
+            }
+        }
+
+        for (int b = 0; b < buckets; b++)
+        {
+            full[b] = 0;
+        }
+
+        // B[d-1] = sum of the points with digit d
+        for (int i = 0; i < n; i++)
+        {
+            int d = ECP_MSM_digit(e[i], w, c);
+            if (d != 0)
+            {
+                ECP_MSM_add(&B[d-1], &full[d-1], &Q[i]);
+            }
+        }
+
+        // R = sum of d.B[d-1], as the sum of the running sums S
+        int s_used = 0;
+        int r_used = 0;
+        for (int b = buckets - 1; b >= 0; b--)
+        {
+            if (full[b])
+            {
+                ECP_MSM_add(&S, &s_used, &B[b]);
+            }
+
+            if (s_used)
+            {
+                ECP_MSM_add(&R, &r_used, &S);
+            }
+        }
+
+        if (r_used)
+        {
+            ECP_MSM_add(P, &used, &R);
+        }
+    }
+}
+
+void ECP_MSM_mul(ECP_SECP256K1 *P, ECP_SECP256K1 Q[], BIG_256_56 e[], int n)
+{
+    BIG_256_56 q;
+    BIG_256_56 k[n > 0 ? n : 1];
+
+    if (n < 1)
+    {
+        ECP_SECP256K1_inf(P);
+        return;
+    }
+
+    // The points have order q, so the scalars can be reduced to ECP_MSM_BITS bits
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    for (int i = 0; i < n; i++)
+    {
+        BIG_256_56_copy(k[i], e[i]);
+        BIG_256_56_norm(k[i]);
+        BIG_256_56_mod(k[i], q);
+    }
+
+    if (n <= ECP_MSM_STRAUS_MAX)
+    {
+        ECP_MSM_straus(P, Q, k, n);
+    }
+    else
+    {
+        ECP_MSM_pippenger(P, Q, k, n);
+    }
+
+    ECP_SECP256K1_affine(P);
+}
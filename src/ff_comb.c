@@ -0,0 +1,253 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Fixed-base exponentiation modulo a 1024 bit prime */
+
+#include "amcl/ff_comb.h"
+
+// Window for the exponentiation with a public exponent
+#define N_WINDOW 4
+#define N_SIZE (1 << N_WINDOW)
+
+/* Montgomery constant -1/p mod 2^BASEBITS for the lowest word of p */
+static chunk FF_COMB_mconst(BIG_1024_58 p)
+{
+    uint64_t x = (uint64_t)p[0];
+    uint64_t inv = x;
+
+    // Newton iteration, each step doubles the correct bits
+    for (int i = 0; i < 6; i++)
+    {
+        inv *= 2 - x * inv;
+    }
+
+    return (chunk)((0 - inv) & (uint64_t)BMASK_1024_58);
+}
+
+/* r = a * b / R mod p, with a, b and r in [0, 2p) */
+static void FF_COMB_modmul(BIG_1024_58 r, BIG_1024_58 a, BIG_1024_58 b, BIG_1024_58 p, chunk mc)
+{
+    DBIG_1024_58 d;
+
+    BIG_1024_58_mul(d, a, b);
+    BIG_1024_58_monty(r, p, mc, d);
+}
+
+/* r = a * R mod p. Not constant time in a */
+static void FF_COMB_nres(BIG_1024_58 r, BIG_1024_58 a, BIG_1024_58 p)
+{
+    DBIG_1024_58 d;
+
+    BIG_1024_58_dzero(d);
+    BIG_1024_58_dsucopy(d, a);
+    BIG_1024_58_dmod(r, d, p);
+}
+
+/* Constant time r = a / R mod p, fully reduced */
+static void FF_COMB_redc(BIG_1024_58 r, BIG_1024_58 a, BIG_1024_58 p, chunk mc)
+{
+    DBIG_1024_58 d;
+    BIG_1024_58 t;
+
+    BIG_1024_58_dzero(d);
+    BIG_1024_58_dscopy(d, a);
+    BIG_1024_58_monty(r, p, mc, d);
+
+    // r is in [0, p], subtract p if r - p is not negative
+    BIG_1024_58_sub(t, r, p);
+    BIG_1024_58_norm(t);
+    BIG_1024_58_cmove(r, t, 1 - (int)((t[NLEN_1024_58 - 1] >> (CHUNK - 1)) & 1));
+
+    BIG_1024_58_zero(t);
+}
+
+/* 1 if b == c, 0 otherwise, without branching */
+static int FF_COMB_teq(sign32 b, sign32 c)
+{
+    sign32 x = b ^ c;
+    x -= 1;
+    return (x >> 31) & 1;
+}
+
+/* Constant time w = T[d], scanning the whole comb */
+static void FF_COMB_select(BIG_1024_58 w, BIG_1024_58 T[FF_COMB_SIZE], sign32 d)
+{
+    BIG_1024_58_copy(w, T[0]);
+
+    for (int j = 1; j < FF_COMB_SIZE; j++)
+    {
+        BIG_1024_58_cmove(w, T[j], FF_COMB_teq(d, j));
+    }
+}
+
+/* Bits of e at column c of the comb */
+static sign32 FF_COMB_column(BIG_1024_58 e, int c)
+{
+    sign32 d = 0;
+
+    for (int k = FF_COMB_TEETH - 1; k >= 0; k--)
+    {
+        d = (d << 1) | BIG_1024_58_bit(e, k * FF_COMB_SPACING + c);
+    }
+
+    return d;
+}
+
+void FF_COMB_precompute(BIG_1024_58 T[FF_COMB_SIZE], BIG_1024_58 *B, BIG_1024_58 *p)
+{
+    BIG_1024_58 one;
+    BIG_1024_58 g[FF_COMB_TEETH][HFLEN_2048];
+
+    chunk mc = FF_COMB_mconst(p[0]);
+
+    BIG_1024_58_one(one);
+    FF_COMB_nres(T[0], one, p[0]);
+
+    // g[k] = B^(2^(k * FF_COMB_SPACING))
+    FF_2048_dmod(g[0], B, p, HFLEN_2048);
+    FF_COMB_nres(g[0][0], g[0][0], p[0]);
+
+    for (int k = 1; k < FF_COMB_TEETH; k++)
+    {
+        BIG_1024_58_copy(g[k][0], g[k-1][0]);
+        for (int i = 0; i < FF_COMB_SPACING; i++)
+        {
+            FF_COMB_modmul(g[k][0], g[k][0], g[k][0], p[0], mc);
+        }
+    }
+
+    // Add the highest tooth of j to the entry without it
+    for (int j = 1; j < FF_COMB_SIZE; j++)
+    {
+        int k = FF_COMB_TEETH - 1;
+        while (!(j & (1 << k)))
+        {
+            k--;
+        }
+
+        FF_COMB_modmul(T[j], T[j ^ (1 << k)], g[k][0], p[0], mc);
+    }
+
+    // Clean memory
+    for (int k = 0; k < FF_COMB_TEETH; k++)
+    {
+        BIG_1024_58_zero(g[k][0]);
+    }
+}
+
+void FF_COMB_pow(BIG_1024_58 *r, BIG_1024_58 T[FF_COMB_SIZE], BIG_1024_58 *e, BIG_1024_58 *p)
+{
+    BIG_1024_58 acc;
+    BIG_1024_58 w;
+
+    chunk mc = FF_COMB_mconst(p[0]);
+
+    BIG_1024_58_copy(acc, T[0]);
+
+    for (int c = FF_COMB_SPACING - 1; c >= 0; c--)
+    {
+        FF_COMB_select(w, T, FF_COMB_column(e[0], c));
+
+        FF_COMB_modmul(acc, acc, acc, p[0], mc);
+        FF_COMB_modmul(acc, acc, w, p[0], mc);
+    }
+
+    FF_COMB_redc(r[0], acc, p[0], mc);
+
+    // Clean memory
+    BIG_1024_58_zero(acc);
+    BIG_1024_58_zero(w);
+}
+
+void FF_COMB_pow2(BIG_1024_58 *r, BIG_1024_58 T0[FF_COMB_SIZE], BIG_1024_58 *e0, BIG_1024_58 T1[FF_COMB_SIZE], BIG_1024_58 *e1, BIG_1024_58 *p)
+{
+    BIG_1024_58 acc;
+    BIG_1024_58 w;
+
+    chunk mc = FF_COMB_mconst(p[0]);
+
+    BIG_1024_58_copy(acc, T0[0]);
+
+    for (int c = FF_COMB_SPACING - 1; c >= 0; c--)
+    {
+        FF_COMB_modmul(acc, acc, acc, p[0], mc);
+
+        FF_COMB_select(w, T0, FF_COMB_column(e0[0], c));
+        FF_COMB_modmul(acc, acc, w, p[0], mc);
+
+        FF_COMB_select(w, T1, FF_COMB_column(e1[0], c));
+        FF_COMB_modmul(acc, acc, w, p[0], mc);
+    }
+
+    FF_COMB_redc(r[0], acc, p[0], mc);
+
+    // Clean memory
+    BIG_1024_58_zero(acc);
+    BIG_1024_58_zero(w);
+}
+
+void FF_COMB_nt_mul_pow(BIG_1024_58 *r, BIG_1024_58 *c, BIG_1024_58 *x, BIG_1024_58 *e, BIG_1024_58 *p)
+{
+    BIG_1024_58 acc;
+    BIG_1024_58 W[N_SIZE];
+
+    chunk mc = FF_COMB_mconst(p[0]);
+    int windows = (BIG_1024_58_nbits(e[0]) + N_WINDOW - 1) / N_WINDOW;
+
+    // W[j] = x^j
+    BIG_1024_58_one(acc);
+    FF_COMB_nres(W[0], acc, p[0]);
+    FF_COMB_nres(W[1], x[0], p[0]);
+
+    for (int j = 2; j < N_SIZE; j++)
+    {
+        FF_COMB_modmul(W[j], W[j-1], W[1], p[0], mc);
+    }
+
+    BIG_1024_58_copy(acc, W[0]);
+
+    for (int i = windows - 1; i >= 0; i--)
+    {
+        int d = 0;
+
+        for (int b = N_WINDOW - 1; b >= 0; b--)
+        {
+            FF_COMB_modmul(acc, acc, acc, p[0], mc);
+            d = (d << 1) | BIG_1024_58_bit(e[0], i * N_WINDOW + b);
+        }
+
+        if (d != 0)
+        {
+            FF_COMB_modmul(acc, acc, W[d], p[0], mc);
+        }
+    }
+
+    FF_COMB_nres(W[1], c[0], p[0]);
+    FF_COMB_modmul(acc, acc, W[1], p[0], mc);
+
+    FF_COMB_redc(r[0], acc, p[0], mc);
+}
+
+void FF_COMB_kill(BIG_1024_58 T[FF_COMB_SIZE])
+{
+    for (int j = 0; j < FF_COMB_SIZE; j++)
+    {
+        BIG_1024_58_zero(T[j]);
+    }
+}
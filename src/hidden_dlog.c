@@ -18,74 +18,48 @@ under the License.
 */
 
 #include "amcl/hidden_dlog.h"
+#include "amcl/cg21/cg21_fanout.h"
 
 /* Definitions for ZKPoK of a DLOG in a hidden order group */
 
-// Window and table size for CT precomputation
-// using 2^w ary method
-#define C_WINDOW 4
-#define C_SIZE 1 << C_WINDOW
-
 // Window and table size for non CT precomputation
 // using basic interleaving
 #define N_WINDOW 5
 #define N_SIZE 1 << (N_WINDOW - 1)
 
-void HDLOG_commit(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B0, HDLOG_iter_values R, HDLOG_iter_values RHO)
+// Window, table size and number of bases per multi-exponentiation
+// for the small batching coefficients
+#define B_WINDOW 4
+#define B_SIZE (1 << (B_WINDOW - 1))
+#define B_BASES 16
+
+/* Compute RHO[i] = B0^R[i] mod PQ for the iterations in [from, to) */
+static void hdlog_commit_range(MODULUS_priv *m, HDLOG_comb *C, HDLOG_iter_values R, HDLOG_iter_values RHO, int from, int to)
 {
     int i;
 
     BIG_1024_58 fm1[HFLEN_2048];
     BIG_1024_58 rhoq[HFLEN_2048];
-    BIG_1024_58 ND[HFLEN_2048];
-
     BIG_1024_58 ws[HFLEN_2048];
-    BIG_1024_58 *WS[] = {ws};
-
-    BIG_1024_58 T_mem[C_SIZE][HFLEN_2048];
-    BIG_1024_58 *T[C_SIZE] = {0};
-
-    for (i = 0; i < C_SIZE; i++)
-    {
-        T[i] = T_mem[i];
-    }
-
-    // Generate random values for commitments
-    if (RNG != NULL)
-    {
-        for (i = 0; i < HDLOG_PROOF_ITERS; i++)
-        {
-            FF_2048_randomnum(R[i], ord, RNG, FFLEN_2048);
-        }
-    }
 
     // Compute exponents B0^R mod P for later use in CRT
     FF_2048_copy(fm1, m->p, HFLEN_2048);
     FF_2048_dec(fm1, 1, HFLEN_2048);
 
-    FF_2048_dmod(ws, B0, m->p, HFLEN_2048);
-
-    FF_2048_invmod2m(ND, m->p, HFLEN_2048);
-    FF_2048_2w_precompute(WS, T, 1, C_WINDOW, m->p, ND, HFLEN_2048);
-
-    for (i = 0; i < HDLOG_PROOF_ITERS; i++)
+    for (i = from; i < to; i++)
     {
         FF_2048_dmod(ws, R[i], fm1, HFLEN_2048);
-        FF_2048_ct_2w_pow(RHO[i], T, WS, 1, C_WINDOW, m->p, ND, HFLEN_2048, HFLEN_2048);
+        FF_COMB_pow(RHO[i], C->tp, ws, m->p);
     }
 
     // Compute exponents B0^R mod Q and recombine using CRT
-    FF_2048_dmod(ws, B0, m->q, HFLEN_2048);
-    FF_2048_invmod2m(ND, m->q, HFLEN_2048);
-    FF_2048_2w_precompute(WS, T, 1, C_WINDOW, m->q, ND, HFLEN_2048);
-
     FF_2048_copy(fm1, m->q, HFLEN_2048);
     FF_2048_dec(fm1, 1, HFLEN_2048);
 
-    for (i = 0; i < HDLOG_PROOF_ITERS; i++)
+    for (i = from; i < to; i++)
     {
         FF_2048_dmod(ws, R[i], fm1, HFLEN_2048);
-        FF_2048_ct_2w_pow(rhoq, T, WS, 1, C_WINDOW, m->q, ND, HFLEN_2048, HFLEN_2048);
+        FF_COMB_pow(rhoq, C->tq, ws, m->q);
 
         FF_2048_crt(RHO[i], RHO[i], rhoq, m->p, m->invpq, m->n, HFLEN_2048);
     }
@@ -94,7 +68,145 @@ void HDLOG_commit(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B
     FF_2048_zero(fm1,  HFLEN_2048);
     FF_2048_zero(ws,   HFLEN_2048);
     FF_2048_zero(rhoq, HFLEN_2048);
-    FF_2048_zero(ND,   HFLEN_2048);
+}
+
+/* Check B0^T[i] * B1^E[i] = RHO[i] mod N for the iterations in [from, to).
+ * If bad is not NULL it is set to the first failing iteration */
+static int hdlog_verify_range(BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T, int from, int to, int *bad)
+{
+    int i;
+
+    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 dws[2 * FFLEN_2048];
+    BIG_1024_58 ND[FFLEN_2048];
+
+    BIG_1024_58 *Ti[1];
+
+    BIG_1024_58 PT_mem[N_SIZE][FFLEN_2048];
+    BIG_1024_58 *PT[N_SIZE];
+
+    for (i = 0; i < N_SIZE; i++)
+    {
+        PT[i] = PT_mem[i];
+    }
+
+    FF_2048_invmod2m(ND, N, FFLEN_2048);
+    FF_2048_bi_precompute(&B0, PT, 1, N_WINDOW, N, ND, FFLEN_2048);
+
+    for (i = from; i < to; i++)
+    {
+        Ti[0] = T[i];
+        FF_2048_bi_pow(ws, PT, Ti, 1, N_WINDOW, N, ND, FFLEN_2048, FFLEN_2048);
+
+        // No need to be constant time over the value of E
+        // since it is public
+        if (E->val[i / 8] & (0x80 >> (i % 8)))
+        {
+            FF_2048_mul(dws, ws, B1, FFLEN_2048);
+            FF_2048_dmod(ws, dws, N, FFLEN_2048);
+        }
+
+        if (FF_2048_comp(ws, RHO[i], FFLEN_2048))
+        {
+            if (bad != NULL)
+            {
+                *bad = i;
+            }
+
+            return HDLOG_FAIL;
+        }
+    }
+
+    return HDLOG_OK;
+}
+
+/* Work item for the multi-threaded commitment and verification */
+typedef struct
+{
+    MODULUS_priv *m;
+    HDLOG_comb *C;
+    BIG_1024_58 *N;
+    BIG_1024_58 *B0;
+    BIG_1024_58 *B1;
+    BIG_1024_58 (*R)[FFLEN_2048];
+    BIG_1024_58 (*RHO)[FFLEN_2048];
+    BIG_1024_58 (*T)[FFLEN_2048];
+    const octet *E;
+} hdlog_job;
+
+/* Commitment of iteration i, run through CG21_FANOUT */
+static int hdlog_commit_job(void *arg, int i)
+{
+    hdlog_job *job = (hdlog_job *)arg;
+
+    hdlog_commit_range(job->m, job->C, job->R, job->RHO, i, i + 1);
+
+    return HDLOG_OK;
+}
+
+/* Verification of iteration i, run through CG21_FANOUT */
+static int hdlog_verify_job(void *arg, int i)
+{
+    hdlog_job *job = (hdlog_job *)arg;
+
+    return hdlog_verify_range(job->N, job->B0, job->B1, job->RHO, job->E, job->T, i, i + 1, NULL);
+}
+
+static void hdlog_random(csprng *RNG, BIG_1024_58 *ord, HDLOG_iter_values R)
+{
+    // Generate random values for commitments
+    if (RNG != NULL)
+    {
+        for (int i = 0; i < HDLOG_PROOF_ITERS; i++)
+        {
+            FF_2048_randomnum(R[i], ord, RNG, FFLEN_2048);
+        }
+    }
+}
+
+void HDLOG_comb_precompute(HDLOG_comb *C, MODULUS_priv *m, BIG_1024_58 *B0)
+{
+    FF_COMB_precompute(C->tp, B0, m->p);
+    FF_COMB_precompute(C->tq, B0, m->q);
+}
+
+void HDLOG_comb_kill(HDLOG_comb *C)
+{
+    FF_COMB_kill(C->tp);
+    FF_COMB_kill(C->tq);
+}
+
+void HDLOG_commit(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B0, HDLOG_iter_values R, HDLOG_iter_values RHO)
+{
+    HDLOG_commit_mt(RNG, m, ord, B0, R, RHO, 1);
+}
+
+void HDLOG_commit_mt(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, BIG_1024_58 *B0, HDLOG_iter_values R, HDLOG_iter_values RHO, int threads)
+{
+    HDLOG_comb C;
+
+    // The comb is built once and shared by all the iterations
+    HDLOG_comb_precompute(&C, m, B0);
+    HDLOG_commit_comb_mt(RNG, m, ord, &C, R, RHO, threads);
+
+    // Clean memory
+    HDLOG_comb_kill(&C);
+}
+
+void HDLOG_commit_comb_mt(csprng *RNG, MODULUS_priv *m, BIG_1024_58 *ord, HDLOG_comb *C, HDLOG_iter_values R, HDLOG_iter_values RHO, int threads)
+{
+    hdlog_job job = {0};
+
+    // The random values are drawn serially so the output is the same
+    // as HDLOG_commit for any number of threads
+    hdlog_random(RNG, ord, R);
+
+    job.m = m;
+    job.C = C;
+    job.R = R;
+    job.RHO = RHO;
+
+    CG21_FANOUT(hdlog_commit_job, &job, HDLOG_PROOF_ITERS, threads);
 }
 
 
@@ -233,53 +345,154 @@ void HDLOG_prove(BIG_1024_58 *ord, BIG_1024_58 *alpha, HDLOG_iter_values R, octe
 
 
 int HDLOG_verify(BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T)
+{
+    return hdlog_verify_range(N, B0, B1, RHO, E, T, 0, HDLOG_PROOF_ITERS, NULL);
+}
+
+int HDLOG_verify_mt(BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T, int threads)
+{
+    hdlog_job job = {0};
+
+    job.N = N;
+    job.B0 = B0;
+    job.B1 = B1;
+    job.RHO = RHO;
+    job.T = T;
+    job.E = E;
+
+    return CG21_FANOUT(hdlog_verify_job, &job, HDLOG_PROOF_ITERS, threads);
+}
+
+/* Draw the batching coefficients from the verifier's RNG.
+ * They must stay unknown to the prover until the proof is fixed
+ */
+static void hdlog_batch_coefficients(csprng *RNG, BIG_1024_58 C[HDLOG_PROOF_ITERS][FFLEN_2048])
+{
+    int i;
+    int j;
+
+    char w[FS_2048];
+    octet W = {0, sizeof(w), w};
+
+    for (i = 0; i < HDLOG_PROOF_ITERS; i++)
+    {
+        OCT_clear(&W);
+        OCT_jbyte(&W, 0, FS_2048 - HDLOG_BATCH_COEFFICIENT_SIZE);
+
+        for (j = 0; j < HDLOG_BATCH_COEFFICIENT_SIZE; j++)
+        {
+            OCT_jbyte(&W, RAND_byte(RNG), 1);
+        }
+
+        FF_2048_fromOctet(C[i], &W, FFLEN_2048);
+    }
+
+    OCT_clear(&W);
+}
+
+int HDLOG_batch_verify(csprng *RNG, BIG_1024_58 *N, BIG_1024_58 *B0, BIG_1024_58 *B1, HDLOG_iter_values RHO, const octet *E, HDLOG_iter_values T, int *bad)
 {
     int i;
+    int j;
+    int nb;
     int mask;
 
-    BIG_1024_58 ws[FFLEN_2048];
+    BIG_1024_58 C[HDLOG_PROOF_ITERS][FFLEN_2048];
+
+    BIG_1024_58 S[2 * FFLEN_2048];
+    BIG_1024_58 F[2 * FFLEN_2048];
     BIG_1024_58 dws[2 * FFLEN_2048];
+
+    BIG_1024_58 lhs[FFLEN_2048];
+    BIG_1024_58 rhs[FFLEN_2048];
+    BIG_1024_58 ws[FFLEN_2048];
     BIG_1024_58 ND[FFLEN_2048];
 
-    BIG_1024_58 PT_mem[N_SIZE][FFLEN_2048];
-    BIG_1024_58 *PT[N_SIZE];
+    BIG_1024_58 *BS[B_BASES];
+    BIG_1024_58 *ES[B_BASES];
 
-    for (i = 0; i < N_SIZE; i++)
+    BIG_1024_58 PT_mem[B_BASES * B_SIZE][FFLEN_2048];
+    BIG_1024_58 *PT[B_BASES * B_SIZE];
+
+    for (i = 0; i < B_BASES * B_SIZE; i++)
     {
         PT[i] = PT_mem[i];
     }
 
-    FF_2048_invmod2m(ND, N, FFLEN_2048);
-    FF_2048_bi_precompute(&B0, PT, 1, N_WINDOW, N, ND, FFLEN_2048);
+    if (bad != NULL)
+    {
+        *bad = -1;
+    }
 
-    for (i = 0; i < HDLOG_CHALLENGE_SIZE; i++)
+    hdlog_batch_coefficients(RNG, C);
+
+    // S = sum c_i * T_i, F = sum c_i * e_i
+    FF_2048_zero(S, 2 * FFLEN_2048);
+    FF_2048_zero(F, 2 * FFLEN_2048);
+    FF_2048_zero(dws, 2 * FFLEN_2048);
+
+    i = 0;
+    for (j = 0; j < HDLOG_CHALLENGE_SIZE; j++)
     {
-        mask = 0x80;
-        while (mask)
+        for (mask = 0x80; mask; mask >>= 1, i++)
         {
-            FF_2048_bi_pow(ws, PT, (BIG_1024_58 **)(&T), 1, N_WINDOW, N, ND, FFLEN_2048, FFLEN_2048);
+            FF_2048_mul(dws, T[i], C[i], FFLEN_2048);
+            FF_2048_add(S, S, dws, 2 * FFLEN_2048);
+            FF_2048_norm(S, 2 * FFLEN_2048);
 
             // No need to be constant time over the value of E
             // since it is public
-            if (E->val[i] & mask)
+            if (E->val[j] & mask)
             {
-                FF_2048_mul(dws, ws, B1, FFLEN_2048);
-                FF_2048_dmod(ws, dws, N, FFLEN_2048);
+                FF_2048_add(F, F, C[i], FFLEN_2048);
+                FF_2048_norm(F, FFLEN_2048);
             }
+        }
+    }
 
-            if (FF_2048_comp(ws, *RHO, FFLEN_2048))
-            {
-                return HDLOG_FAIL;
-            }
+    // lhs = B0^S * B1^F
+    FF_2048_nt_pow_2(lhs, B0, S, B1, F, N, FFLEN_2048, 2 * FFLEN_2048);
 
-            // Advance mask and iter values
-            mask>>=1;
-            RHO++;
-            T++;
+    // rhs = prod RHO_i^c_i, in groups of B_BASES bases
+    FF_2048_invmod2m(ND, N, FFLEN_2048);
+    FF_2048_one(rhs, FFLEN_2048);
+
+    for (i = 0; i < HDLOG_PROOF_ITERS; i += B_BASES)
+    {
+        nb = HDLOG_PROOF_ITERS - i;
+        if (nb > B_BASES)
+        {
+            nb = B_BASES;
         }
+
+        for (j = 0; j < nb; j++)
+        {
+            BS[j] = RHO[i + j];
+            ES[j] = C[i + j];
+        }
+
+        // The coefficients fit in the lowest BIG of C
+        FF_2048_bi_precompute(BS, PT, nb, B_WINDOW, N, ND, FFLEN_2048);
+        FF_2048_bi_pow(ws, PT, ES, nb, B_WINDOW, N, ND, FFLEN_2048, 1);
+
+        FF_2048_mul(dws, rhs, ws, FFLEN_2048);
+        FF_2048_dmod(rhs, dws, N, FFLEN_2048);
     }
 
-    return HDLOG_OK;
+    // Compare the squares. This removes the elements of order two of Z/NZ,
+    // on which small coefficients can not be used safely
+    FF_2048_sqr(dws, lhs, FFLEN_2048);
+    FF_2048_dmod(lhs, dws, N, FFLEN_2048);
+    FF_2048_sqr(dws, rhs, FFLEN_2048);
+    FF_2048_dmod(rhs, dws, N, FFLEN_2048);
+
+    if (FF_2048_comp(lhs, rhs, FFLEN_2048) == 0)
+    {
+        return HDLOG_OK;
+    }
+
+    // Find the invalid iteration
+    return hdlog_verify_range(N, B0, B1, RHO, E, T, 0, HDLOG_PROOF_ITERS, bad);
 }
 
 void HDLOG_iter_values_toOctet(octet *O, HDLOG_iter_values v)
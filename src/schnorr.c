@@ -19,6 +19,8 @@ under the License.
 
 #include "amcl/schnorr.h"
 #include "amcl/hash_utils.h"
+#include "amcl/ecp_gen.h"
+#include "amcl/ecp_msm.h"
 
 void SCHNORR_random_challenge(csprng *RNG, octet *E)
 {
@@ -56,8 +58,7 @@ void SCHNORR_commit(csprng *RNG, octet *R, octet *C)
     }
 
     // Generate commitment r.G
-    ECP_SECP256K1_generator(&G);
-    ECP_SECP256K1_mul(&G, r);
+    ECP_GEN_mul(&G, r);
 
     // Output C compressed
     ECP_SECP256K1_toOctet(C, &G, true);
@@ -173,6 +174,121 @@ int SCHNORR_verify(const octet *V, const octet*C, const octet *E, const octet *P
     return SCHNORR_OK;
 }
 
+/* Check w_0.(p_0.G + e_0.V_0 - C_0) + ... + w_{n-1}.(p_{n-1}.G + e_{n-1}.V_{n-1} - C_{n-1}) = 0 */
+static int SCHNORR_batch_check(csprng *RNG, ECP_SECP256K1 *V, ECP_SECP256K1 *C, BIG_256_56 *e, BIG_256_56 *p, int n)
+{
+    ECP_SECP256K1 Q[2 * n];
+    BIG_256_56 k[2 * n];
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 R;
+
+    BIG_256_56 w;
+    BIG_256_56 s;
+    BIG_256_56 t;
+    BIG_256_56 q;
+    DBIG_256_56 d;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_zero(s);
+
+    for (int i = 0; i < n; i++)
+    {
+        // A zero weight would drop the proof from the check
+        BIG_256_56_randomnum(w, q, RNG);
+        if (BIG_256_56_iszilch(w))
+        {
+            BIG_256_56_one(w);
+        }
+
+        // s = s + w.p
+        BIG_256_56_mul(d, w, p[i]);
+        BIG_256_56_dmod(t, d, q);
+        BIG_256_56_add(s, s, t);
+        BIG_256_56_mod(s, q);
+
+        // w.e.V
+        BIG_256_56_mul(d, w, e[i]);
+        BIG_256_56_dmod(k[2 * i], d, q);
+        ECP_SECP256K1_copy(Q + 2 * i, V + i);
+
+        // -w.C
+        BIG_256_56_modneg(k[2 * i + 1], w, q);
+        ECP_SECP256K1_copy(Q + 2 * i + 1, C + i);
+    }
+
+    ECP_MSM_mul(&R, Q, k, 2 * n);
+    ECP_GEN_mul(&G, s);
+    ECP_SECP256K1_add(&R, &G);
+
+    return ECP_SECP256K1_isinf(&R);
+}
+
+/* Find the first invalid proof, halving the batch each time its check fails */
+static int SCHNORR_batch_search(csprng *RNG, ECP_SECP256K1 *V, ECP_SECP256K1 *C, BIG_256_56 *e, BIG_256_56 *p,
+                                int n, int offset, int *bad)
+{
+    int rc;
+    int h = n / 2;
+
+    if (SCHNORR_batch_check(RNG, V, C, e, p, n))
+    {
+        return SCHNORR_OK;
+    }
+
+    // With a non zero weight the check of a single proof is exact
+    if (n == 1)
+    {
+        if (bad != NULL)
+        {
+            *bad = offset;
+        }
+
+        return SCHNORR_FAIL;
+    }
+
+    rc = SCHNORR_batch_search(RNG, V, C, e, p, h, offset, bad);
+    if (rc != SCHNORR_OK)
+    {
+        return rc;
+    }
+
+    return SCHNORR_batch_search(RNG, V + h, C + h, e + h, p + h, n - h, offset + h, bad);
+}
+
+int SCHNORR_batch_verify(csprng *RNG, const octet *V, const octet *C, const octet *E, const octet *P, int n, int *bad)
+{
+    ECP_SECP256K1 GT[n > 0 ? n : 1];
+    ECP_SECP256K1 CO[n > 0 ? n : 1];
+    BIG_256_56 e[n > 0 ? n : 1];
+    BIG_256_56 p[n > 0 ? n : 1];
+
+    if (n < 1)
+    {
+        return SCHNORR_OK;
+    }
+
+    // Read octets
+    for (int i = 0; i < n; i++)
+    {
+        if (!ECP_SECP256K1_fromOctet(GT + i, (octet *)(V + i)) || !ECP_SECP256K1_fromOctet(CO + i, (octet *)(C + i)))
+        {
+            if (bad != NULL)
+            {
+                *bad = i;
+            }
+
+            return SCHNORR_INVALID_ECP;
+        }
+
+        BIG_256_56_fromBytesLen(e[i], E[i].val, E[i].len);
+        BIG_256_56_fromBytesLen(p[i], P[i].val, P[i].len);
+    }
+
+    return SCHNORR_batch_search(RNG, GT, CO, e, p, n, 0, bad);
+}
+
+/* Double Schnorr's Proof Definitions */
+
 int SCHNORR_D_commit(csprng *RNG, const octet *R, octet *A, octet *B, octet *C)
 {
     BIG_256_56 a;
@@ -20,6 +20,9 @@ under the License.
 /* Shamir Secret Sharing and Verifiable Secret Sharing API */
 
 #include "amcl/shamir.h"
+#include "amcl/ecp_gen.h"
+#include "amcl/ecp_msm.h"
+#include "amcl/hash_utils.h"
 
 // Polynomial interpolation coefficients
 static void SSS_lagrange_coefficients(int k, const octet* X, BIG_256_56* lc, const BIG_256_56 q)
@@ -302,8 +305,7 @@ void VSS_make_shares(int k, int n, csprng *RNG, SSS_shares *shares, octet *C, oc
     // Make checks
     for (i = 0; i < k; i++)
     {
-        ECP_SECP256K1_generator(&G);
-        ECP_SECP256K1_mul(&G, poly[i]);
+        ECP_GEN_mul(&G, poly[i]);
         ECP_SECP256K1_toOctet(C+i, &G, true);
     }
 
@@ -320,42 +322,41 @@ int VSS_verify_shares(int k, const octet *X_j, const octet * Y_j, const octet *C
 
     ECP_SECP256K1 G;
     ECP_SECP256K1 V;
+    ECP_SECP256K1 CC[k];
 
     BIG_256_56  x;
-    BIG_256_56 xn;
+    BIG_256_56 xn[k];
     BIG_256_56 q;
     DBIG_256_56 w;
 
     BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
     BIG_256_56_fromBytesLen(x, X_j->val, X_j->len);
 
-    // Initialize accumulator and exponent
-    rc = ECP_SECP256K1_fromOctet(&V, C);
-    if (rc != 1)
-    {
-        return VSS_INVALID_CHECKS;
-    }
-    BIG_256_56_one(xn);
+    // Load checks and exponents x^i
+    BIG_256_56_one(xn[0]);
 
-    for (int i = 1; i < k; i++)
+    for (int i = 0; i < k; i++)
     {
-        rc = ECP_SECP256K1_fromOctet(&G, C+i);
+        rc = ECP_SECP256K1_fromOctet(CC+i, C+i);
         if (rc != 1)
         {
             return VSS_INVALID_CHECKS;
         }
 
-        BIG_256_56_mul(w, xn, x);
-        BIG_256_56_dmod(xn, w, q);
-
-        ECP_SECP256K1_mul(&G, xn);
-        ECP_SECP256K1_add(&V, &G);
+        if (i > 0)
+        {
+            BIG_256_56_mul(w, xn[i-1], x);
+            BIG_256_56_dmod(xn[i], w, q);
+        }
     }
 
+    // V = C_0 + x.C_1 + ... + x^{k-1}.C_{k-1}
+    ECP_MSM_mul(&V, CC+1, xn+1, k-1);
+    ECP_SECP256K1_add(&V, CC);
+
     // Compute ground truth
-    ECP_SECP256K1_generator(&G);
     BIG_256_56_fromBytesLen(x, Y_j->val, Y_j->len);
-    ECP_SECP256K1_mul(&G, x);
+    ECP_GEN_mul(&G, x);
 
     if (!ECP_SECP256K1_equals(&G, &V))
     {
@@ -364,3 +365,163 @@ int VSS_verify_shares(int k, const octet *X_j, const octet * Y_j, const octet *C
 
     return VSS_OK;
 }
+
+// Random coefficients for the batch verification, bound to all the shares and checks
+static void VSS_batch_coefficients(int k, int m, const octet *X, const octet *Y, const octet *C, int stride, BIG_256_56 *r)
+{
+    hash256 sha;
+    csprng RNG;
+
+    char seed[SHA256];
+    char rb[VSS_BATCH_COEFFICIENT_SIZE];
+
+    HASH256_init(&sha);
+
+    HASH_UTILS_hash_i2osp4(&sha, k);
+    HASH_UTILS_hash_i2osp4(&sha, m);
+
+    for (int i = 0; i < m; i++)
+    {
+        HASH_UTILS_hash_oct(&sha, X+i);
+        HASH_UTILS_hash_oct(&sha, Y+i);
+
+        for (int j = 0; j < k; j++)
+        {
+            HASH_UTILS_hash_oct(&sha, C + i * stride + j);
+        }
+    }
+
+    HASH256_hash(&sha, seed);
+    RAND_seed(&RNG, SHA256, seed);
+
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < VSS_BATCH_COEFFICIENT_SIZE; j++)
+        {
+            rb[j] = RAND_byte(&RNG);
+        }
+
+        BIG_256_56_fromBytesLen(r[i], rb, VSS_BATCH_COEFFICIENT_SIZE);
+    }
+
+    RAND_clean(&RNG);
+}
+
+int VSS_batch_verify_shares(int k, int m, const octet *X, const octet *Y, const octet *C, int stride, int *bad)
+{
+    int rc;
+
+    if (bad != NULL)
+    {
+        *bad = -1;
+    }
+
+    if (m < 1)
+    {
+        return VSS_OK;
+    }
+
+    // Distinct checks
+    int np = (stride == 0) ? k : m * k;
+
+    ECP_SECP256K1 P[np];
+    ECP_SECP256K1 V;
+    ECP_SECP256K1 G;
+
+    BIG_256_56 a[np];
+    BIG_256_56 r[m];
+    BIG_256_56 x;
+    BIG_256_56 xn;
+    BIG_256_56 y;
+    BIG_256_56 s;
+    BIG_256_56 q;
+    DBIG_256_56 w;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    // Load checks
+    for (int p = 0; p < np; p++)
+    {
+        int i = (stride == 0) ? 0 : p / k;
+
+        rc = ECP_SECP256K1_fromOctet(P+p, C + i * stride + p % k);
+        if (rc != 1)
+        {
+            if (bad != NULL && stride != 0)
+            {
+                *bad = i;
+            }
+
+            return VSS_INVALID_CHECKS;
+        }
+
+        BIG_256_56_zero(a[p]);
+    }
+
+    VSS_batch_coefficients(k, m, X, Y, C, stride, r);
+
+    /*
+     * (sum r_i.y_i).G = sum r_i.x_i^j.C_ij
+     *
+     * The terms for the same check are merged, so with
+     * shared checks the MSM only has k terms
+     */
+    BIG_256_56_zero(s);
+
+    for (int i = 0; i < m; i++)
+    {
+        BIG_256_56_fromBytesLen(x, X[i].val, X[i].len);
+        BIG_256_56_fromBytesLen(y, Y[i].val, Y[i].len);
+
+        // s = s + r_i.y_i
+        BIG_256_56_mul(w, r[i], y);
+        BIG_256_56_dmod(y, w, q);
+        BIG_256_56_add(s, s, y);
+        BIG_256_56_mod(s, q);
+
+        // a_ij = a_ij + r_i.x_i^j
+        BIG_256_56_copy(xn, r[i]);
+
+        for (int j = 0; j < k; j++)
+        {
+            int p = (stride == 0) ? j : i * k + j;
+
+            BIG_256_56_add(a[p], a[p], xn);
+            BIG_256_56_mod(a[p], q);
+
+            BIG_256_56_mul(w, xn, x);
+            BIG_256_56_dmod(xn, w, q);
+        }
+    }
+
+    // The shares are secret, so their side uses the constant time multiplication
+    ECP_MSM_mul(&V, P, a, np);
+    ECP_GEN_mul(&G, s);
+
+    // Clean memory
+    BIG_256_56_zero(s);
+    BIG_256_56_zero(y);
+    BIG_256_56_dzero(w);
+
+    if (ECP_SECP256K1_equals(&G, &V))
+    {
+        return VSS_OK;
+    }
+
+    // Find the invalid share
+    for (int i = 0; i < m; i++)
+    {
+        rc = VSS_verify_shares(k, X+i, Y+i, C + i * stride);
+        if (rc != VSS_OK)
+        {
+            if (bad != NULL)
+            {
+                *bad = i;
+            }
+
+            return rc;
+        }
+    }
+
+    return VSS_INVALID_SHARES;
+}
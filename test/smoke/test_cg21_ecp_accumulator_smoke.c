@@ -0,0 +1,113 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Running point sum smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_utilities.h"
+
+#define N_POINTS 6
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    char p[N_POINTS][EFS_SECP256K1 + 1];
+    octet PTS[N_POINTS];
+
+    char o[EFS_SECP256K1 + 1];
+    octet O = {0, sizeof(o), o};
+
+    char s[EFS_SECP256K1 + 1];
+    octet S = {0, sizeof(s), s};
+
+    char bad[EFS_SECP256K1 + 1];
+    octet BAD = {0, sizeof(bad), bad};
+
+    BIG_256_56 q;
+    BIG_256_56 k;
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 P;
+
+    CG21_ECP_ACCUMULATOR acc;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    init_octets((char *)p, PTS, EFS_SECP256K1 + 1, N_POINTS);
+
+    // Random points, the last one repeats the first to add a point to itself
+    for (int i = 0; i < N_POINTS - 1; i++)
+    {
+        BIG_256_56_randomnum(k, q, &RNG);
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_copy(&P, &G);
+        ECP_SECP256K1_mul(&P, k);
+        ECP_SECP256K1_toOctet(&PTS[i], &P, true);
+    }
+    OCT_copy(&PTS[N_POINTS - 1], &PTS[0]);
+
+    // Same sum as a chain of CG21_ADD_TWO_PK
+    OCT_copy(&O, &PTS[0]);
+    for (int i = 1; i < N_POINTS; i++)
+    {
+        expect("CG21_ADD_TWO_PK", CG21_ADD_TWO_PK(&O, &PTS[i]), CG21_OK);
+    }
+
+    CG21_ECP_ACCUMULATOR_init(&acc);
+    for (int i = 0; i < N_POINTS; i++)
+    {
+        expect("CG21_ECP_ACCUMULATOR_add", CG21_ECP_ACCUMULATOR_add(&acc, &PTS[i]), CG21_OK);
+    }
+    CG21_ECP_ACCUMULATOR_output(&acc, &S);
+
+    expect("CG21_ECP_ACCUMULATOR_output", OCT_comp(&S, &O), 1);
+
+    // A single point is output unchanged
+    CG21_ECP_ACCUMULATOR_init(&acc);
+    expect("CG21_ECP_ACCUMULATOR_add single", CG21_ECP_ACCUMULATOR_add(&acc, &PTS[1]), CG21_OK);
+    CG21_ECP_ACCUMULATOR_output(&acc, &S);
+    expect("CG21_ECP_ACCUMULATOR_output single", OCT_comp(&S, &PTS[1]), 1);
+
+    // Invalid points are rejected and leave the sum as it was
+    OCT_copy(&BAD, &PTS[2]);
+    BAD.val[0] = 0x05;
+
+    OCT_copy(&O, &PTS[1]);
+    expect("CG21_ADD_TWO_PK invalid", CG21_ADD_TWO_PK(&O, &BAD), CG21_INVALID_ECP);
+    expect("CG21_ECP_ACCUMULATOR_add invalid", CG21_ECP_ACCUMULATOR_add(&acc, &BAD), CG21_INVALID_ECP);
+
+    CG21_ECP_ACCUMULATOR_output(&acc, &S);
+    expect("CG21_ECP_ACCUMULATOR_output invalid", OCT_comp(&S, &PTS[1]), 1);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
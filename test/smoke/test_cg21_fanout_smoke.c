@@ -0,0 +1,95 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Per-peer fan-out smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_fanout.h"
+#include "amcl/cg21/cg21_utilities.h"
+
+#define MAX_PEERS 15
+
+typedef struct
+{
+    int calls[MAX_PEERS];   // number of calls for each peer
+    int fail[MAX_PEERS];    // error returned for each peer
+} job_state;
+
+static int job(void *arg, int j)
+{
+    job_state *state = (job_state *)arg;
+
+    state->calls[j]++;
+
+    return state->fail[j];
+}
+
+static void check(int n, int threads, int fail_at, int fail_at2)
+{
+    job_state state = {{0}, {0}};
+    int expected = CG21_OK;
+
+    if (fail_at >= 0)
+    {
+        state.fail[fail_at] = fail_at + 1;
+        expected = fail_at + 1;
+    }
+
+    if (fail_at2 >= 0)
+    {
+        state.fail[fail_at2] = fail_at2 + 1;
+    }
+
+    int rc = CG21_FANOUT(job, &state, n, threads);
+    if (rc != expected)
+    {
+        printf("FAILURE CG21_FANOUT n=%d threads=%d. rc %d, expected %d\n", n, threads, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+
+    // every peer runs exactly once, even after an error
+    for (int j = 0; j < n; j++)
+    {
+        if (state.calls[j] != 1)
+        {
+            printf("FAILURE CG21_FANOUT n=%d threads=%d. Peer %d called %d times\n", n, threads, j, state.calls[j]);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int main()
+{
+    int threads[] = {0, 1, 2, 4, MAX_PEERS + 1};
+
+    for (int i = 0; i < (int)(sizeof(threads) / sizeof(threads[0])); i++)
+    {
+        check(0, threads[i], -1, -1);
+        check(1, threads[i], -1, -1);
+        check(MAX_PEERS, threads[i], -1, -1);
+
+        // the error of the first failed peer is reported
+        check(MAX_PEERS, threads[i], 3, MAX_PEERS - 1);
+        check(MAX_PEERS, threads[i], MAX_PEERS - 1, -1);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,140 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Lagrange coefficient cache smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_utilities.h"
+
+#define CACHE_SIZE 2
+#define T 4
+#define BIG_T (CG21_LAGRANGE_MAX_SIGNERS + 1)
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    CG21_LAGRANGE_CACHE_ENTRY entries[CACHE_SIZE];
+    CG21_LAGRANGE_CACHE cache;
+    CG21_LAGRANGE_CACHE_ENTRY entry;
+
+    int set[T] = {7, 2, 11, 5};
+    int set2[T] = {5, 11, 2, 7};
+    int set3[T] = {1, 2, 3, 4};
+    int dup[T] = {1, 2, 2, 4};
+
+    BIG_256_56 coeff;
+    BIG_256_56 golden;
+
+    char x_[T - 1][EGS_SECP256K1];
+    octet X[T - 1];
+    init_octets((char *)x_, X, EGS_SECP256K1, T - 1);
+
+    int big_set[BIG_T];
+    for (int k = 0; k < BIG_T; k++)
+    {
+        big_set[k] = BIG_T - k;
+    }
+
+    char big_x_[BIG_T - 1][EGS_SECP256K1];
+    octet BIG_X[BIG_T - 1];
+    init_octets((char *)big_x_, BIG_X, EGS_SECP256K1, BIG_T - 1);
+
+    char xj[EGS_SECP256K1];
+    octet XJ = {0, sizeof(xj), xj};
+
+    expect("CG21_lagrange_coeffs", CG21_lagrange_coeffs(T, set, &entry), CG21_OK);
+
+    // Same coefficients as the ones computed one at a time
+    for (int k = 0; k < T; k++)
+    {
+        CG21_lagrange_index_to_octet(T, set, set[k], X);
+
+        BIG_256_56_zero(golden);
+        BIG_256_56_inc(golden, set[k]);
+        BIG_256_56_toBytes(XJ.val, golden);
+        XJ.len = EGS_SECP256K1;
+
+        CG21_lagrange_calc_coeff(T, &XJ, X, &golden);
+
+        expect("CG21_lagrange_entry_coeff", CG21_lagrange_entry_coeff(&entry, set[k], coeff), CG21_OK);
+        expect("CG21_lagrange_entry_coeff value", BIG_256_56_comp(coeff, golden), 0);
+
+        expect("CG21_lagrange_coeff", CG21_lagrange_coeff(T, set, set[k], coeff), CG21_OK);
+        expect("CG21_lagrange_coeff value", BIG_256_56_comp(coeff, golden), 0);
+    }
+
+    expect("CG21_lagrange_entry_coeff missing", CG21_lagrange_entry_coeff(&entry, 3, coeff), CG21_LAGRANGE_INVALID_SET);
+    expect("CG21_lagrange_coeffs repeated", CG21_lagrange_coeffs(T, dup, &entry), CG21_LAGRANGE_INVALID_SET);
+
+    // The set is the key, whatever the order of the IDs
+    CG21_LAGRANGE_CACHE_init(&cache, entries, CACHE_SIZE);
+
+    expect("CG21_LAGRANGE_CACHE_coeff", CG21_LAGRANGE_CACHE_coeff(&cache, T, set, 11, coeff), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff count", cache.count, 1);
+    expect("CG21_LAGRANGE_CACHE_coeff hit", CG21_LAGRANGE_CACHE_coeff(&cache, T, set2, 11, golden), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff hit count", cache.count, 1);
+    expect("CG21_LAGRANGE_CACHE_coeff hit value", BIG_256_56_comp(coeff, golden), 0);
+
+    expect("CG21_LAGRANGE_CACHE_coeff other set", CG21_LAGRANGE_CACHE_coeff(&cache, T, set3, 1, coeff), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff other set count", cache.count, 2);
+    expect("CG21_LAGRANGE_CACHE_coeff missing", CG21_LAGRANGE_CACHE_coeff(&cache, T, set3, 7, coeff), CG21_LAGRANGE_INVALID_SET);
+
+    // An invalid set does not evict an entry of the full cache
+    expect("CG21_LAGRANGE_CACHE_coeff repeated", CG21_LAGRANGE_CACHE_coeff(&cache, T, dup, 1, coeff), CG21_LAGRANGE_INVALID_SET);
+    expect("CG21_LAGRANGE_CACHE_coeff repeated count", cache.count, 2);
+    expect("CG21_LAGRANGE_CACHE_coeff repeated next", cache.next, 0);
+    expect("CG21_LAGRANGE_CACHE_coeff repeated hit", CG21_LAGRANGE_CACHE_coeff(&cache, T, set2, 11, golden), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff repeated entry", cache.entries[0].t, T);
+    expect("CG21_LAGRANGE_CACHE_coeff repeated ID", cache.entries[0].ids[0], 2);
+
+    // No cache
+    expect("CG21_LAGRANGE_CACHE_coeff NULL", CG21_LAGRANGE_CACHE_coeff(NULL, T, set, 11, coeff), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff NULL value", BIG_256_56_comp(coeff, golden), 0);
+
+    // Sets too large for an entry are computed on each lookup, not cached
+    CG21_lagrange_index_to_octet(BIG_T, big_set, 33, BIG_X);
+
+    BIG_256_56_zero(golden);
+    BIG_256_56_inc(golden, 33);
+    BIG_256_56_toBytes(XJ.val, golden);
+    XJ.len = EGS_SECP256K1;
+
+    CG21_lagrange_calc_coeff(BIG_T, &XJ, BIG_X, &golden);
+
+    expect("CG21_lagrange_coeffs too large", CG21_lagrange_coeffs(BIG_T, big_set, &entry), CG21_LAGRANGE_INVALID_SET);
+    expect("CG21_LAGRANGE_CACHE_coeff large", CG21_LAGRANGE_CACHE_coeff(&cache, BIG_T, big_set, 33, coeff), CG21_OK);
+    expect("CG21_LAGRANGE_CACHE_coeff large value", BIG_256_56_comp(coeff, golden), 0);
+    expect("CG21_LAGRANGE_CACHE_coeff large count", cache.count, 2);
+    expect("CG21_LAGRANGE_CACHE_coeff large missing", CG21_LAGRANGE_CACHE_coeff(&cache, BIG_T, big_set, BIG_T + 1, coeff), CG21_LAGRANGE_INVALID_SET);
+
+    CG21_LAGRANGE_CACHE_kill(&cache);
+    expect("CG21_LAGRANGE_CACHE_kill", cache.count, 0);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,193 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Paillier randomizer pool and short multiplication smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_paillier_pool.h"
+
+#define POOL_SIZE 4
+
+char *P_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Encrypt with the pool and check against PAILLIER_ENCRYPT with the same randomizer
+static void check(const char *name, CG21_PAILLIER_POOL *pool, PAILLIER_public_key *pub, csprng *RNG)
+{
+    char pt[FS_2048];
+    octet PT = {0, sizeof(pt), pt};
+
+    char ct[FS_4096];
+    octet CT = {0, sizeof(ct), ct};
+
+    char golden[FS_4096];
+    octet GOLDEN = {0, sizeof(golden), golden};
+
+    char r[FS_4096];
+    octet R = {0, sizeof(r), r};
+
+    OCT_rand(&PT, RNG, FS_2048);
+
+    expect(name, CG21_PAILLIER_POOL_ENCRYPT(pool, pub, &PT, &CT, &R), CG21_OK);
+
+    PAILLIER_ENCRYPT(NULL, pub, &PT, &GOLDEN, &R);
+
+    if (!OCT_comp(&CT, &GOLDEN))
+    {
+        printf("FAILURE %s. Wrong ciphertext\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    CG21_PAILLIER_POOL_ENTRY entries[POOL_SIZE];
+    CG21_PAILLIER_POOL pool;
+
+    PAILLIER_public_key pub;
+    PAILLIER_public_key other;
+    PAILLIER_private_key priv;
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    char pt[FS_2048];
+    octet PT = {0, sizeof(pt), pt};
+
+    char ct[FS_4096];
+    octet CT = {0, sizeof(ct), ct};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &pub, &priv);
+
+    // Remote key, without the factors
+    expect("CG21_PAILLIER_POOL_INIT", CG21_PAILLIER_POOL_INIT(&pool, entries, POOL_SIZE, &RNG, &pub, NULL), CG21_OK);
+
+    if (CG21_PAILLIER_POOL_FILL(&pool, POOL_SIZE + 1) != POOL_SIZE || CG21_PAILLIER_POOL_SIZE(&pool) != POOL_SIZE)
+    {
+        printf("FAILURE CG21_PAILLIER_POOL_FILL\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < POOL_SIZE; i++)
+    {
+        check("CG21_PAILLIER_POOL_ENCRYPT", &pool, &pub, &RNG);
+    }
+
+    // An empty pool computes the randomizer on the spot
+    expect("CG21_PAILLIER_POOL_SIZE", CG21_PAILLIER_POOL_SIZE(&pool), 0);
+    check("CG21_PAILLIER_POOL_ENCRYPT empty", &pool, &pub, &RNG);
+
+    CG21_PAILLIER_POOL_KILL(&pool);
+
+    // Local key, with the CRT
+    expect("CG21_PAILLIER_POOL_INIT CRT", CG21_PAILLIER_POOL_INIT(&pool, entries, POOL_SIZE, &RNG, &pub, &priv), CG21_OK);
+
+    CG21_PAILLIER_POOL_FILL(&pool, 2);
+    for (int i = 0; i < 3; i++)
+    {
+        check("CG21_PAILLIER_POOL_ENCRYPT CRT", &pool, &pub, &RNG);
+    }
+
+    // Background generation
+    expect("CG21_PAILLIER_POOL_START", CG21_PAILLIER_POOL_START(&pool, POOL_SIZE), CG21_OK);
+    expect("CG21_PAILLIER_POOL_START running", CG21_PAILLIER_POOL_START(&pool, POOL_SIZE), CG21_PAILLIER_POOL_RUNNING);
+
+    while (CG21_PAILLIER_POOL_SIZE(&pool) < POOL_SIZE);
+
+    for (int i = 0; i < 2 * POOL_SIZE; i++)
+    {
+        check("CG21_PAILLIER_POOL_ENCRYPT background", &pool, &pub, &RNG);
+    }
+
+    CG21_PAILLIER_POOL_STOP(&pool);
+
+    // A different key is rejected
+    other = pub;
+    FF_4096_inc(other.n, 2, FFLEN_4096);
+
+    OCT_clear(&PT);
+    OCT_pad(&PT, FS_2048);
+    expect("CG21_PAILLIER_POOL_ENCRYPT wrong key", CG21_PAILLIER_POOL_ENCRYPT(&pool, &other, &PT, &CT, NULL), CG21_PAILLIER_POOL_WRONG_KEY);
+
+    CG21_PAILLIER_POOL_KILL(&pool);
+
+    // The multiplication by short plaintexts agrees with PAILLIER_MULT
+    char s1[EGS_SECP256K1];
+    octet S1 = {0, sizeof(s1), s1};
+
+    char s2[EGS_SECP256K1];
+    octet S2 = {0, sizeof(s2), s2};
+
+    char ct1[FS_4096];
+    octet CT1 = {0, sizeof(ct1), ct1};
+
+    char ct2[FS_4096];
+    octet CT2 = {0, sizeof(ct2), ct2};
+
+    char golden[FS_4096];
+    octet GOLDEN = {0, sizeof(golden), golden};
+
+    octet *PTS[2] = {&S1, &S2};
+    octet *CTS[2] = {&CT1, &CT2};
+
+    OCT_rand(&S1, &RNG, EGS_SECP256K1);
+    OCT_rand(&S2, &RNG, EGS_SECP256K1);
+    OCT_rand(&PT, &RNG, FS_2048);
+    PAILLIER_ENCRYPT(&RNG, &pub, &PT, &CT, NULL);
+
+    CG21_PAILLIER_MULT_SHORT(&pub, &CT, PTS, CTS, 2);
+
+    for (int i = 0; i < 2; i++)
+    {
+        OCT_copy(&PT, PTS[i]);
+        OCT_pad(&PT, HFS_4096);
+        PAILLIER_MULT(&pub, &CT, &PT, &GOLDEN);
+
+        if (!OCT_comp(CTS[i], &GOLDEN))
+        {
+            printf("FAILURE CG21_PAILLIER_MULT_SHORT\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    PAILLIER_PRIVATE_KEY_KILL(&priv);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,165 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Party table smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "amcl/cg21/cg21_utilities.h"
+
+#define N_PLAYERS 6
+#define X_SIZE (EFS_SECP256K1 + 1)
+
+// IDs with hex digits a-f. 0x000a and 0x0031 had the same key in the hex string sort
+static const int IDS[N_PLAYERS] = {0x0031, 0x000a, 0x00ff, 0x0010, 0x0002, 0x0100};
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Order of the positions as sorted from the hex string of the IDs
+static void hex_order(octet *J, int *indices, int n)
+{
+    char temp[4 * N_PLAYERS + 1];
+
+    OCT_toHex(J, temp);
+    sort_indices(temp, indices, n);
+}
+
+static void digest(hash256 *sha, char *h)
+{
+    HASH256_hash(sha, h);
+}
+
+int main()
+{
+    char j[2 * N_PLAYERS];
+    octet J = {0, sizeof(j), j};
+
+    char x[N_PLAYERS * X_SIZE];
+    octet X = {0, sizeof(x), x};
+
+    char x2[N_PLAYERS * X_SIZE];
+    octet X2 = {0, sizeof(x2), x2};
+
+    char j2[2 * N_PLAYERS];
+    octet J2 = {0, sizeof(j2), j2};
+
+    char ref[SHA256];
+    char h[SHA256];
+
+    int ref_order[N_PLAYERS];
+    int indices[N_PLAYERS];
+    int ids[N_PLAYERS];
+    int order[N_PLAYERS];
+
+    char xs[N_PLAYERS][X_SIZE];
+    octet XS[N_PLAYERS];
+
+    CG21_PARTY_TABLE table;
+    hash256 sha;
+
+    for (int i = 0; i < N_PLAYERS; i++)
+    {
+        j[2*i] = (char)(IDS[i] >> 8);
+        j[2*i+1] = (char)IDS[i];
+    }
+    J.len = sizeof(j);
+
+    for (int i = 0; i < (int)sizeof(x); i++)
+    {
+        x[i] = (char)(7 * i + 3);
+    }
+    X.len = sizeof(x);
+
+    hex_order(&J, ref_order, N_PLAYERS);
+
+    HASH256_init(&sha);
+    for (int i = 0; i < N_PLAYERS; i++)
+    {
+        octet XI = {X_SIZE, X_SIZE, x + ref_order[i] * X_SIZE};
+        HASH_UTILS_hash_oct(&sha, &XI);
+    }
+    digest(&sha, ref);
+
+    // The table keeps the order of the hex strings
+    expect("CG21_PARTY_TABLE_init", CG21_PARTY_TABLE_init(&table, ids, order, &J, N_PLAYERS), CG21_OK);
+    for (int i = 0; i < N_PLAYERS; i++)
+    {
+        expect("CG21_PARTY_TABLE_init id", ids[i], IDS[i]);
+        expect("CG21_PARTY_TABLE_init order", order[i], ref_order[i]);
+    }
+
+    init_octets((char *)xs, XS, X_SIZE, N_PLAYERS);
+    expect("CG21_unpack_and_sort", CG21_unpack_and_sort(XS, &X, &J, N_PLAYERS, X_SIZE, indices), CG21_OK);
+    for (int i = 0; i < N_PLAYERS; i++)
+    {
+        expect("CG21_unpack_and_sort order", indices[i], ref_order[i]);
+        expect("CG21_unpack_and_sort X", memcmp(XS[i].val, x + i * X_SIZE, X_SIZE), 0);
+    }
+
+    HASH256_init(&sha);
+    expect("CG21_hash_set_X", CG21_hash_set_X(&sha, &X, &J, N_PLAYERS, X_SIZE), CG21_OK);
+    digest(&sha, h);
+    expect("CG21_hash_set_X digest", memcmp(h, ref, SHA256), 0);
+
+    HASH256_init(&sha);
+    expect("CG21_PARTY_TABLE_hash_set", CG21_PARTY_TABLE_hash_set(&sha, &table, &X, X_SIZE), CG21_OK);
+    digest(&sha, h);
+    expect("CG21_PARTY_TABLE_hash_set digest", memcmp(h, ref, SHA256), 0);
+
+    X.len--;
+    expect("CG21_PARTY_TABLE_hash_set length", CG21_PARTY_TABLE_hash_set(&sha, &table, &X, X_SIZE), CG21_UTILITIES_WRONG_PACKED_SIZE);
+    X.len++;
+
+    // Same set in reverse order, but for the two IDs with equal keys
+    for (int i = 0; i < N_PLAYERS; i++)
+    {
+        int k = N_PLAYERS - 1 - i;
+
+        if (i == 4)
+        {
+            k = 0;
+        }
+        else if (i == 5)
+        {
+            k = 1;
+        }
+
+        memcpy(j2 + 2 * i, j + 2 * k, 2);
+        memcpy(x2 + i * X_SIZE, x + k * X_SIZE, X_SIZE);
+    }
+    J2.len = J.len;
+    X2.len = X.len;
+
+    expect("CG21_set_comp", CG21_set_comp(&X, &J, &X2, &J2, N_PLAYERS, X_SIZE), 1);
+
+    x2[0] ^= 1;
+    expect("CG21_set_comp different", CG21_set_comp(&X, &J, &X2, &J2, N_PLAYERS, X_SIZE), 0);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
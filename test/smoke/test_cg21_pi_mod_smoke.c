@@ -0,0 +1,167 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Paillier-Blum modulus proof smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_pi_mod.h"
+
+// Blum primes P and Q
+char *P_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+char *rid_hex = "fe3d9b2809ea3595990283e7baf121910ec681e70a83255c05761008d42dce95";
+char *rho_hex = "b40a06d473a944f6100d16f4900291eb929325339f52b9a058584be26f934ca2";
+char *X_packed_hex = "03868dccba08f5021b5f9bf59e7834ba093ed7ca6381c6e8122207d9cdd67aa07a03bba617c6a6c6d6f76d4ea64b58bc66fb02a00de037d47fbf4852003374b9983303bc549c825221baeaa606d875e7ae28afd1785e170388c6e1d1defca48d4b3c2a";
+char *j_packed_hex = "000100020003";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    int n = 3;
+
+    char p[FS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[FS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    char rid[EGS_SECP256K1];
+    octet RID = {0, sizeof(rid), rid};
+
+    char rho[EGS_SECP256K1];
+    octet RHO = {0, sizeof(rho), rho};
+
+    char x_packed[3 * (EFS_SECP256K1 + 1)];
+    octet X_PACKED = {0, sizeof(x_packed), x_packed};
+
+    char j_packed[3 * 4 + 1];
+    octet J_PACKED = {0, sizeof(j_packed), j_packed};
+
+    char w[HFS_4096];
+    octet W = {0, sizeof(w), w};
+
+    char x[CG21_PAILLIER_PROOF_SIZE];
+    octet X = {0, sizeof(x), x};
+
+    char z[CG21_PAILLIER_PROOF_SIZE];
+    octet Z = {0, sizeof(z), z};
+
+    char ab[CG21_PAILLIER_PROOF_ITERS * 4];
+    octet AB = {0, sizeof(ab), ab};
+
+    CG21_PIMOD_PROOF_OCT proof = {&W, &X, &Z, &AB};
+
+    char w2[HFS_4096];
+    octet W2 = {0, sizeof(w2), w2};
+
+    char x2[CG21_PAILLIER_PROOF_SIZE];
+    octet X2 = {0, sizeof(x2), x2};
+
+    char z2[CG21_PAILLIER_PROOF_SIZE];
+    octet Z2 = {0, sizeof(z2), z2};
+
+    char ab2[CG21_PAILLIER_PROOF_ITERS * 4];
+    octet AB2 = {0, sizeof(ab2), ab2};
+
+    CG21_PIMOD_PROOF_OCT proof2 = {&W2, &X2, &Z2, &AB2};
+
+    CG21_SSID ssid;
+    CG21_PAILLIER_KEYS keys;
+    CG21_PIMOD_PROVER prover;
+
+    // Deterministic RNGs for testing
+    char seed[32] = {0};
+    csprng RNG;
+    csprng RNG2;
+    RAND_seed(&RNG, 32, seed);
+    RAND_seed(&RNG2, 32, seed);
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    OCT_fromHex(&RID, rid_hex);
+    OCT_fromHex(&RHO, rho_hex);
+    OCT_fromHex(&X_PACKED, X_packed_hex);
+    OCT_fromHex(&J_PACKED, j_packed_hex);
+
+    ssid.rid = &RID;
+    ssid.rho = &RHO;
+    ssid.X_set_packed = &X_PACKED;
+    ssid.j_set_packed = &J_PACKED;
+    ssid.n1 = &n;
+
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &keys.paillier_pk, &keys.paillier_sk);
+
+    expect("CG21_PI_MOD_PROVE", CG21_PI_MOD_PROVE(&RNG, keys, &ssid, &proof, n), CG21_OK);
+
+    expect("CG21_PI_MOD_VERIFY", CG21_PI_MOD_VERIFY(&proof, &ssid, keys.paillier_pk, n), CG21_OK);
+    expect("CG21_PI_MOD_BATCH_VERIFY", CG21_PI_MOD_BATCH_VERIFY(&proof, &ssid, keys.paillier_pk, n, 2), CG21_OK);
+
+    // Tampered z in one iteration
+    z[5 * FS_2048 + FS_2048 / 2] ^= 1;
+
+    expect("CG21_PI_MOD_VERIFY tampered z", CG21_PI_MOD_VERIFY(&proof, &ssid, keys.paillier_pk, n) != CG21_OK, 1);
+    expect("CG21_PI_MOD_BATCH_VERIFY tampered z", CG21_PI_MOD_BATCH_VERIFY(&proof, &ssid, keys.paillier_pk, n, 2) != CG21_OK, 1);
+
+    z[5 * FS_2048 + FS_2048 / 2] ^= 1;
+
+    // Tampered x in the last iteration
+    x[CG21_PAILLIER_PROOF_SIZE - 1] ^= 1;
+
+    expect("CG21_PI_MOD_VERIFY tampered x", CG21_PI_MOD_VERIFY(&proof, &ssid, keys.paillier_pk, n) != CG21_OK, 1);
+    expect("CG21_PI_MOD_BATCH_VERIFY tampered x", CG21_PI_MOD_BATCH_VERIFY(&proof, &ssid, keys.paillier_pk, n, 2) != CG21_OK, 1);
+
+    x[CG21_PAILLIER_PROOF_SIZE - 1] ^= 1;
+
+    // Proof for another SSID
+    rid[0] ^= 1;
+
+    expect("CG21_PI_MOD_VERIFY ssid", CG21_PI_MOD_VERIFY(&proof, &ssid, keys.paillier_pk, n) != CG21_OK, 1);
+
+    rid[0] ^= 1;
+
+    // The reused prover gives the same proof on the same RNG
+    expect("CG21_PI_MOD_PROVER_SETUP", CG21_PI_MOD_PROVER_SETUP(&prover, &keys), CG21_OK);
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER", CG21_PI_MOD_PROVE_WITH_PROVER(&RNG2, &prover, &ssid, &proof2, n), CG21_OK);
+
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER w", OCT_comp(&W, &W2), 1);
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER x", OCT_comp(&X, &X2), 1);
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER z", OCT_comp(&Z, &Z2), 1);
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER ab", OCT_comp(&AB, &AB2), 1);
+
+    // and can be used again for a fresh proof
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER again", CG21_PI_MOD_PROVE_WITH_PROVER(&RNG2, &prover, &ssid, &proof2, n), CG21_OK);
+    expect("CG21_PI_MOD_VERIFY again", CG21_PI_MOD_VERIFY(&proof2, &ssid, keys.paillier_pk, n), CG21_OK);
+    expect("CG21_PI_MOD_PROVE_WITH_PROVER fresh", OCT_comp(&W, &W2), 0);
+
+    CG21_PI_MOD_PROVER_KILL(&prover);
+    PAILLIER_PRIVATE_KEY_KILL(&keys.paillier_sk);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
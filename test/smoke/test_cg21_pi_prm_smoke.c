@@ -0,0 +1,128 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Ring-Pedersen parameters proof smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_pi_prm.h"
+
+// Safe primes P = 2p+1 and Q = 2q+1
+char *P_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+char *rid_hex = "fe3d9b2809ea3595990283e7baf121910ec681e70a83255c05761008d42dce95";
+char *rho_hex = "b40a06d473a944f6100d16f4900291eb929325339f52b9a058584be26f934ca2";
+char *X_packed_hex = "03868dccba08f5021b5f9bf59e7834ba093ed7ca6381c6e8122207d9cdd67aa07a03bba617c6a6c6d6f76d4ea64b58bc66fb02a00de037d47fbf4852003374b9983303bc549c825221baeaa606d875e7ae28afd1785e170388c6e1d1defca48d4b3c2a";
+char *j_packed_hex = "000100020003";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    int n = 3;
+
+    char p[FS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[FS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    char rid[EGS_SECP256K1];
+    octet RID = {0, sizeof(rid), rid};
+
+    char rho[EGS_SECP256K1];
+    octet RHO = {0, sizeof(rho), rho};
+
+    char x_packed[3 * (EFS_SECP256K1 + 1)];
+    octet X_PACKED = {0, sizeof(x_packed), x_packed};
+
+    char j_packed[3 * 4 + 1];
+    octet J_PACKED = {0, sizeof(j_packed), j_packed};
+
+    char r1[HDLOG_VALUES_SIZE];
+    octet RHO_OCT = {0, sizeof(r1), r1};
+
+    char r2[HDLOG_VALUES_SIZE];
+    octet IRHO_OCT = {0, sizeof(r2), r2};
+
+    char r3[HDLOG_VALUES_SIZE];
+    octet T_OCT = {0, sizeof(r3), r3};
+
+    char r4[HDLOG_VALUES_SIZE];
+    octet IT_OCT = {0, sizeof(r4), r4};
+
+    CG21_PIPRM_PROOF_OCT proof = {&RHO_OCT, &IRHO_OCT, &T_OCT, &IT_OCT};
+
+    CG21_SSID ssid;
+    CG21_PEDERSEN_KEYS keys;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    OCT_fromHex(&RID, rid_hex);
+    OCT_fromHex(&RHO, rho_hex);
+    OCT_fromHex(&X_PACKED, X_packed_hex);
+    OCT_fromHex(&J_PACKED, j_packed_hex);
+
+    ssid.rid = &RID;
+    ssid.rho = &RHO;
+    ssid.X_set_packed = &X_PACKED;
+    ssid.j_set_packed = &J_PACKED;
+    ssid.n1 = &n;
+
+    ring_Pedersen_setup(&RNG, &keys.pedersenPriv, &P, &Q);
+    Pedersen_get_public_param(&keys.pedersenPub, &keys.pedersenPriv);
+
+    expect("CG21_PI_PRM_PROVE", CG21_PI_PRM_PROVE(&RNG, &keys.pedersenPriv, &ssid, &proof), CG21_OK);
+
+    expect("CG21_PI_PRM_VERIFY", CG21_PI_PRM_VERIFY(&keys.pedersenPub, &ssid, &proof, n), CG21_OK);
+    expect("CG21_PI_PRM_VERIFY_MT", CG21_PI_PRM_VERIFY_MT(&keys.pedersenPub, &ssid, &proof, n, 4), CG21_OK);
+    expect("CG21_PI_PRM_VERIFY_BATCH", CG21_PI_PRM_VERIFY_BATCH(&RNG, &keys.pedersenPub, &ssid, &proof, n), CG21_OK);
+
+    // Tampered response in one iteration of the b1 proof
+    r3[HDLOG_VALUES_SIZE / 2] ^= 1;
+
+    expect("CG21_PI_PRM_VERIFY tampered", CG21_PI_PRM_VERIFY(&keys.pedersenPub, &ssid, &proof, n), CG21_PI_PRM_INVALID_PROOF);
+    expect("CG21_PI_PRM_VERIFY_MT tampered", CG21_PI_PRM_VERIFY_MT(&keys.pedersenPub, &ssid, &proof, n, 4), CG21_PI_PRM_INVALID_PROOF);
+    expect("CG21_PI_PRM_VERIFY_BATCH tampered", CG21_PI_PRM_VERIFY_BATCH(&RNG, &keys.pedersenPub, &ssid, &proof, n), CG21_PI_PRM_INVALID_PROOF);
+
+    r3[HDLOG_VALUES_SIZE / 2] ^= 1;
+
+    // Tampered commitment of the b0 proof
+    r2[0] ^= 1;
+
+    expect("CG21_PI_PRM_VERIFY tampered commitment", CG21_PI_PRM_VERIFY(&keys.pedersenPub, &ssid, &proof, n), CG21_PI_PRM_INVALID_PROOF);
+
+    CG21_Pedersen_Private_Kill(&keys.pedersenPriv);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
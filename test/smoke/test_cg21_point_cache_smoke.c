@@ -0,0 +1,100 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Point cache smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_utilities.h"
+
+#define CACHE_SIZE 2
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    CG21_POINT_CACHE_ENTRY entries[CACHE_SIZE];
+    CG21_POINT_CACHE cache;
+
+    ECP_SECP256K1 G;
+    ECP_SECP256K1 H;
+    ECP_SECP256K1 R;
+    BIG_256_56 x;
+
+    char p[3][EFS_SECP256K1 + 1];
+    octet P[3];
+    init_octets((char *)p, P, EFS_SECP256K1 + 1, 3);
+
+    // Three distinct points G, 2G and 3G
+    ECP_SECP256K1_generator(&G);
+    for (int k = 0; k < 3; k++)
+    {
+        BIG_256_56_zero(x);
+        BIG_256_56_inc(x, k + 1);
+        ECP_SECP256K1_copy(&H, &G);
+        ECP_SECP256K1_mul(&H, x);
+        ECP_SECP256K1_toOctet(P + k, &H, true);
+    }
+
+    CG21_POINT_CACHE_init(&cache, entries, CACHE_SIZE);
+
+    // Miss then hit
+    expect("CG21_POINT_CACHE_get", CG21_POINT_CACHE_get(&cache, 1, CG21_POINT_CACHE_VSS_CHECK, 0, P + 0, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get count", cache.count, 1);
+    expect("CG21_POINT_CACHE_get point", ECP_SECP256K1_equals(&R, &G), 1);
+
+    expect("CG21_POINT_CACHE_get hit", CG21_POINT_CACHE_get(&cache, 1, CG21_POINT_CACHE_VSS_CHECK, 0, P + 0, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get hit count", cache.count, 1);
+    expect("CG21_POINT_CACHE_get hit point", ECP_SECP256K1_equals(&R, &G), 1);
+
+    // A changed encoding for the same key replaces the entry
+    expect("CG21_POINT_CACHE_get changed", CG21_POINT_CACHE_get(&cache, 1, CG21_POINT_CACHE_VSS_CHECK, 0, P + 1, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get changed count", cache.count, 1);
+    ECP_SECP256K1_fromOctet(&H, P + 1);
+    expect("CG21_POINT_CACHE_get changed point", ECP_SECP256K1_equals(&R, &H), 1);
+
+    // Other keys fill the cache, then replace the oldest entry
+    expect("CG21_POINT_CACHE_get index", CG21_POINT_CACHE_get(&cache, 1, CG21_POINT_CACHE_VSS_CHECK, 1, P + 2, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get full count", cache.count, CACHE_SIZE);
+    expect("CG21_POINT_CACHE_get party", CG21_POINT_CACHE_get(&cache, 2, CG21_POINT_CACHE_VSS_CHECK, 0, P + 0, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get party point", ECP_SECP256K1_equals(&R, &G), 1);
+    expect("CG21_POINT_CACHE_get replaced", entries[0].id, 2);
+
+    // Invalid points are not stored
+    P[0].val[0] = 0x05;
+    expect("CG21_POINT_CACHE_get invalid", CG21_POINT_CACHE_get(&cache, 3, CG21_POINT_CACHE_GAMMA, 0, P + 0, &R), CG21_INVALID_ECP);
+    expect("CG21_POINT_CACHE_get invalid replaced", entries[1].id, 1);
+
+    // No cache
+    expect("CG21_POINT_CACHE_get NULL", CG21_POINT_CACHE_get(NULL, 1, CG21_POINT_CACHE_VSS_CHECK, 0, P + 1, &R), CG21_OK);
+    expect("CG21_POINT_CACHE_get NULL point", ECP_SECP256K1_equals(&R, &H), 1);
+
+    CG21_POINT_CACHE_kill(&cache);
+    expect("CG21_POINT_CACHE_kill", cache.count, 0);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
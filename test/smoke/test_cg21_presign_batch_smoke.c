@@ -0,0 +1,357 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Batched presign rounds smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21.h"
+
+#define N_PRESIGN 4
+#define MY_ID 1
+#define PT_SIZE (EFS_SECP256K1 + 1)
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Random scalar s and, optionally, S = s.G
+static void random_pair(csprng *RNG, octet *s, octet *S)
+{
+    BIG_256_56 q;
+    BIG_256_56 x;
+    ECP_SECP256K1 G;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(x, q, RNG);
+
+    if (s != NULL)
+    {
+        BIG_256_56_toBytes(s->val, x);
+        s->len = EGS_SECP256K1;
+    }
+
+    if (S != NULL)
+    {
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+        ECP_SECP256K1_toOctet(S, &G, true);
+    }
+}
+
+static void test_round3_2_1(csprng *RNG)
+{
+    int bad;
+
+    char k[N_PRESIGN][EGS_SECP256K1];
+    octet KK[N_PRESIGN];
+    char gamma_my[N_PRESIGN][PT_SIZE];
+    octet GAMMA_MY[N_PRESIGN];
+    char gamma_his[N_PRESIGN][PT_SIZE];
+    octet GAMMA_HIS[N_PRESIGN];
+    char gamma[2][N_PRESIGN][PT_SIZE];
+    octet GAMMA[2][N_PRESIGN];
+    char delta[2][N_PRESIGN][PT_SIZE];
+    octet DELTA[2][N_PRESIGN];
+
+    CG21_PRESIGN_ROUND1_STORE r1Store[N_PRESIGN];
+    CG21_PRESIGN_ROUND2_STORE r2Store[N_PRESIGN];
+    CG21_PRESIGN_ROUND2_OUTPUT r2hisOutput[N_PRESIGN];
+    CG21_PRESIGN_ROUND3_STORE_1 r3Store[2][N_PRESIGN];
+
+    init_octets((char *)k, KK, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)gamma_my, GAMMA_MY, PT_SIZE, N_PRESIGN);
+    init_octets((char *)gamma_his, GAMMA_HIS, PT_SIZE, N_PRESIGN);
+    init_octets((char *)gamma, GAMMA[0], PT_SIZE, 2 * N_PRESIGN);
+    init_octets((char *)delta, DELTA[0], PT_SIZE, 2 * N_PRESIGN);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        random_pair(RNG, KK + j, NULL);
+        random_pair(RNG, NULL, GAMMA_MY + j);
+        random_pair(RNG, NULL, GAMMA_HIS + j);
+
+        r1Store[j].k = KK + j;
+        r2Store[j].Gamma = GAMMA_MY + j;
+        r2Store[j].i = MY_ID;
+        r2hisOutput[j].Gamma = GAMMA_HIS + j;
+
+        for (int b = 0; b < 2; b++)
+        {
+            r3Store[b][j].Gamma = &GAMMA[b][j];
+            r3Store[b][j].Delta = &DELTA[b][j];
+        }
+    }
+
+    // The batch gives the same stores as one call per presignature
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_ROUND3_2_1", CG21_PRESIGN_ROUND3_2_1(r2hisOutput + j, r3Store[0] + j, r2Store + j, r1Store + j, 3), CG21_OK);
+    }
+    expect("CG21_PRESIGN_ROUND3_2_1_BATCH", CG21_PRESIGN_ROUND3_2_1_BATCH(r2hisOutput, r3Store[1], r2Store, r1Store, 3, N_PRESIGN, &bad), CG21_OK);
+    expect("CG21_PRESIGN_ROUND3_2_1_BATCH bad", bad, -1);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_ROUND3_2_1_BATCH Gamma", OCT_comp(&GAMMA[0][j], &GAMMA[1][j]), 1);
+        expect("CG21_PRESIGN_ROUND3_2_1_BATCH Delta", OCT_comp(&DELTA[0][j], &DELTA[1][j]), 1);
+        expect("CG21_PRESIGN_ROUND3_2_1_BATCH i", r3Store[1][j].i, MY_ID);
+    }
+
+    // Three peers of the first presignature, with the store reloaded from
+    // its octets between the calls, and with the running product in memory
+    CG21_ECP_ACCUMULATOR Gamma_sum;
+    char saved[PT_SIZE];
+    octet SAVED = {0, sizeof(saved), saved};
+
+    for (int j = 0; j < 3; j++)
+    {
+        CG21_PRESIGN_ROUND3_STORE_1 reloaded = {&GAMMA[0][0], &DELTA[0][0], 0};
+
+        if (j > 0)
+        {
+            OCT_copy(&GAMMA[0][0], &SAVED);
+        }
+
+        expect("CG21_PRESIGN_ROUND3_2_1 reloaded", CG21_PRESIGN_ROUND3_2_1(r2hisOutput + j, &reloaded, r2Store, r1Store, j), CG21_OK);
+        expect("CG21_PRESIGN_ROUND3_2_1_ACC", CG21_PRESIGN_ROUND3_2_1_ACC(r2hisOutput + j, r3Store[1], r2Store, r1Store, j, &Gamma_sum), CG21_OK);
+
+        OCT_copy(&SAVED, &GAMMA[0][0]);
+        OCT_clear(&GAMMA[0][0]);
+    }
+
+    expect("CG21_PRESIGN_ROUND3_2_1_ACC Gamma", OCT_comp(&SAVED, &GAMMA[1][0]), 1);
+    expect("CG21_PRESIGN_ROUND3_2_1_ACC Delta", OCT_comp(&DELTA[0][0], &DELTA[1][0]), 1);
+
+    expect("CG21_PRESIGN_ROUND3_2_1", CG21_PRESIGN_ROUND3_2_1(r2hisOutput, r3Store[0], r2Store, r1Store, 3), CG21_OK);
+
+    // An invalid point only fails its own presignature
+    gamma_his[2][0] = 0x05;
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        OCT_clear(&GAMMA[1][j]);
+        OCT_clear(&DELTA[1][j]);
+    }
+
+    expect("CG21_PRESIGN_ROUND3_2_1_BATCH invalid", CG21_PRESIGN_ROUND3_2_1_BATCH(r2hisOutput, r3Store[1], r2Store, r1Store, 3, N_PRESIGN, &bad), CG21_INVALID_ECP);
+    expect("CG21_PRESIGN_ROUND3_2_1_BATCH invalid bad", bad, 2);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        if (j != 2)
+        {
+            expect("CG21_PRESIGN_ROUND3_2_1_BATCH invalid Delta", OCT_comp(&DELTA[0][j], &DELTA[1][j]), 1);
+        }
+    }
+}
+
+static void test_output_2_1(csprng *RNG)
+{
+    int bad;
+
+    char d_my[N_PRESIGN][EGS_SECP256K1];
+    octet D_MY[N_PRESIGN];
+    char D_my[N_PRESIGN][PT_SIZE];
+    octet DD_MY[N_PRESIGN];
+    char d_his[N_PRESIGN][EGS_SECP256K1];
+    octet D_HIS[N_PRESIGN];
+    char D_his[N_PRESIGN][PT_SIZE];
+    octet DD_HIS[N_PRESIGN];
+    char d[2][N_PRESIGN][EGS_SECP256K1];
+    octet D[2][N_PRESIGN];
+    char DD_[2][N_PRESIGN][PT_SIZE];
+    octet DD[2][N_PRESIGN];
+
+    CG21_PRESIGN_ROUND3_OUTPUT r3myOutput[N_PRESIGN];
+    CG21_PRESIGN_ROUND3_OUTPUT r3hisOutput[N_PRESIGN];
+    CG21_PRESIGN_ROUND4_STORE_1 r4Store[2][N_PRESIGN];
+
+    init_octets((char *)d_my, D_MY, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)D_my, DD_MY, PT_SIZE, N_PRESIGN);
+    init_octets((char *)d_his, D_HIS, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)D_his, DD_HIS, PT_SIZE, N_PRESIGN);
+    init_octets((char *)d, D[0], EGS_SECP256K1, 2 * N_PRESIGN);
+    init_octets((char *)DD_, DD[0], PT_SIZE, 2 * N_PRESIGN);
+
+    // Consistent shares, Delta_j = delta_j.G
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        random_pair(RNG, D_MY + j, DD_MY + j);
+        random_pair(RNG, D_HIS + j, DD_HIS + j);
+
+        r3myOutput[j].delta = D_MY + j;
+        r3myOutput[j].Delta = DD_MY + j;
+        r3hisOutput[j].delta = D_HIS + j;
+        r3hisOutput[j].Delta = DD_HIS + j;
+
+        for (int b = 0; b < 2; b++)
+        {
+            r4Store[b][j].delta = &D[b][j];
+            r4Store[b][j].Delta = &DD[b][j];
+        }
+    }
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_OUTPUT_2_1", CG21_PRESIGN_OUTPUT_2_1(r3hisOutput + j, r3myOutput + j, r4Store[0] + j, 3), CG21_OK);
+    }
+    expect("CG21_PRESIGN_OUTPUT_2_1_BATCH", CG21_PRESIGN_OUTPUT_2_1_BATCH(r3hisOutput, r3myOutput, r4Store[1], 3, N_PRESIGN, &bad), CG21_OK);
+    expect("CG21_PRESIGN_OUTPUT_2_1_BATCH bad", bad, -1);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_OUTPUT_2_1_BATCH delta", OCT_comp(&D[0][j], &D[1][j]), 1);
+        expect("CG21_PRESIGN_OUTPUT_2_1_BATCH Delta", OCT_comp(&DD[0][j], &DD[1][j]), 1);
+    }
+
+    // A wrong delta share only fails its own presignature
+    d_his[1][EGS_SECP256K1 - 1] ^= 1;
+
+    expect("CG21_PRESIGN_OUTPUT_2_1_BATCH invalid", CG21_PRESIGN_OUTPUT_2_1_BATCH(r3hisOutput, r3myOutput, r4Store[1], 3, N_PRESIGN, &bad), CG21_PRESIGN_DELTA_NOT_VALID);
+    expect("CG21_PRESIGN_OUTPUT_2_1_BATCH invalid bad", bad, 1);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        if (j != 1)
+        {
+            expect("CG21_PRESIGN_OUTPUT_2_1_BATCH invalid delta", OCT_comp(&D[0][j], &D[1][j]), 1);
+        }
+    }
+}
+
+static void test_output_2_2(csprng *RNG)
+{
+    int bad;
+
+    char k[N_PRESIGN][EGS_SECP256K1];
+    octet KK[N_PRESIGN];
+    char chi[N_PRESIGN][EGS_SECP256K1];
+    octet CHI[N_PRESIGN];
+    char gamma[N_PRESIGN][PT_SIZE];
+    octet GAMMA[N_PRESIGN];
+    char delta[N_PRESIGN][EGS_SECP256K1];
+    octet DELTA[N_PRESIGN];
+    char r[2][N_PRESIGN][PT_SIZE];
+    octet R[2][N_PRESIGN];
+    char chi_out[2][N_PRESIGN][EGS_SECP256K1];
+    octet CHI_OUT[2][N_PRESIGN];
+    char k_out[2][N_PRESIGN][EGS_SECP256K1];
+    octet K_OUT[2][N_PRESIGN];
+
+    CG21_PRESIGN_ROUND1_STORE r1Store[N_PRESIGN];
+    CG21_PRESIGN_ROUND3_STORE_1 r3Store1[N_PRESIGN];
+    CG21_PRESIGN_ROUND3_STORE_2 r3Store2[N_PRESIGN];
+    CG21_PRESIGN_ROUND4_STORE_1 r4Store1[N_PRESIGN];
+    CG21_PRESIGN_ROUND4_STORE_2 r4Store2[2][N_PRESIGN];
+    CG21_PRESIGN_ROUND4_OUTPUT r4Output[2][N_PRESIGN];
+
+    init_octets((char *)k, KK, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)chi, CHI, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)gamma, GAMMA, PT_SIZE, N_PRESIGN);
+    init_octets((char *)delta, DELTA, EGS_SECP256K1, N_PRESIGN);
+    init_octets((char *)r, R[0], PT_SIZE, 2 * N_PRESIGN);
+    init_octets((char *)chi_out, CHI_OUT[0], EGS_SECP256K1, 2 * N_PRESIGN);
+    init_octets((char *)k_out, K_OUT[0], EGS_SECP256K1, 2 * N_PRESIGN);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        random_pair(RNG, KK + j, NULL);
+        random_pair(RNG, CHI + j, NULL);
+        random_pair(RNG, NULL, GAMMA + j);
+        random_pair(RNG, DELTA + j, NULL);
+
+        r1Store[j].k = KK + j;
+        r3Store1[j].Gamma = GAMMA + j;
+        r3Store1[j].i = MY_ID;
+        r3Store2[j].chi = CHI + j;
+        r4Store1[j].delta = DELTA + j;
+
+        for (int b = 0; b < 2; b++)
+        {
+            r4Store2[b][j].R = &R[b][j];
+            r4Store2[b][j].chi = &CHI_OUT[b][j];
+            r4Store2[b][j].k = &K_OUT[b][j];
+        }
+    }
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_OUTPUT_2_2", CG21_PRESIGN_OUTPUT_2_2(r1Store + j, r3Store1 + j, r3Store2 + j, r4Store1 + j, r4Store2[0] + j, r4Output[0] + j), CG21_OK);
+    }
+    expect("CG21_PRESIGN_OUTPUT_2_2_BATCH", CG21_PRESIGN_OUTPUT_2_2_BATCH(r1Store, r3Store1, r3Store2, r4Store1, r4Store2[1], r4Output[1], N_PRESIGN, &bad), CG21_OK);
+    expect("CG21_PRESIGN_OUTPUT_2_2_BATCH bad", bad, -1);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH R", OCT_comp(&R[0][j], &R[1][j]), 1);
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH chi", OCT_comp(&CHI_OUT[0][j], &CHI_OUT[1][j]), 1);
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH k", OCT_comp(&K_OUT[0][j], &K_OUT[1][j]), 1);
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH i", r4Store2[1][j].i, MY_ID);
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH output", r4Output[1][j].PRESIGN_SUCCESS, CG21_OK);
+    }
+
+    // A zero delta only fails its own presignature, and every output is written
+    OCT_clear(DELTA + 2);
+    OCT_jbyte(DELTA + 2, 0, EGS_SECP256K1);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        OCT_clear(&R[1][j]);
+        r4Output[1][j].PRESIGN_SUCCESS = -1;
+        r4Output[1][j].i = -1;
+    }
+
+    expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero", CG21_PRESIGN_OUTPUT_2_2_BATCH(r1Store, r3Store1, r3Store2, r4Store1, r4Store2[1], r4Output[1], N_PRESIGN, &bad), CG21_PRESIGN_DELTA_NOT_VALID);
+    expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero bad", bad, 2);
+
+    for (int j = 0; j < N_PRESIGN; j++)
+    {
+        expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero i", r4Output[1][j].i, MY_ID);
+
+        if (j == 2)
+        {
+            expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero output", r4Output[1][j].PRESIGN_SUCCESS, CG21_PRESIGN_FAILED);
+        }
+        else
+        {
+            expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero other output", r4Output[1][j].PRESIGN_SUCCESS, CG21_OK);
+            expect("CG21_PRESIGN_OUTPUT_2_2_BATCH zero other R", OCT_comp(&R[0][j], &R[1][j]), 1);
+        }
+    }
+}
+
+int main()
+{
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    test_round3_2_1(&RNG);
+    test_output_2_1(&RNG);
+    test_output_2_2(&RNG);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,288 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Presign fan-out over the other players smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21.h"
+
+#define N_PEERS 3
+#define MY_ID 1
+#define R2_OCTETS 14
+
+// Safe primes P = 2p+1 and Q = 2q+1
+char *P_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void expect_equal(const char *name, octet *A, octet *B)
+{
+    if (!OCT_comp(A, B))
+    {
+        printf("FAILURE %s. Serial and fan-out results differ\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Random value modulo the curve order in EGS_SECP256K1 bytes
+static void random_mod_q(csprng *RNG, octet *X)
+{
+    BIG_256_56 q;
+    BIG_256_56 x;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(x, q, RNG);
+
+    BIG_256_56_toBytes(X->val, x);
+    X->len = EGS_SECP256K1;
+}
+
+// Status of the call for peer j, as documented for the Round 3 functions
+static int status(int j)
+{
+    if (N_PEERS == 1)
+    {
+        return 3;
+    }
+
+    if (j == 0)
+    {
+        return 0;
+    }
+
+    return (j == N_PEERS - 1) ? 2 : 1;
+}
+
+// Point the Round 2 output and store of every peer to 14 octets of O
+static void init_round2(CG21_PRESIGN_ROUND2_OUTPUT *r2output, CG21_PRESIGN_ROUND2_STORE *r2store, octet *O)
+{
+    for (int j = 0; j < N_PEERS; j++, O += R2_OCTETS)
+    {
+        r2output[j].Gamma = O;
+        r2output[j].D = O + 1;
+        r2output[j].D_hat = O + 2;
+        r2output[j].F = O + 3;
+        r2output[j].F_hat = O + 4;
+        r2output[j].psi = NULL;
+        r2output[j].psi_hat = NULL;
+        r2output[j].psi_prime = NULL;
+
+        r2store[j].Gamma = O + 5;
+        r2store[j].r = O + 6;
+        r2store[j].r_hat = O + 7;
+        r2store[j].s = O + 8;
+        r2store[j].s_hat = O + 9;
+        r2store[j].beta = O + 10;
+        r2store[j].beta_hat = O + 11;
+        r2store[j].neg_beta = O + 12;
+        r2store[j].neg_beta_hat = O + 13;
+    }
+}
+
+static void test_fanout(csprng *RNG, PAILLIER_public_key *PUB, PAILLIER_private_key *PRIV, int threads)
+{
+    char seed[32];
+    csprng rng;
+    csprng RNG_FANOUT;
+
+    char k[EGS_SECP256K1];
+    octet KK = {0, sizeof(k), k};
+
+    char gamma[EGS_SECP256K1];
+    octet GAMMA = {0, sizeof(gamma), gamma};
+
+    char a[EGS_SECP256K1];
+    octet A = {0, sizeof(a), a};
+
+    char pt[FS_2048];
+    octet PT = {0, sizeof(pt), pt};
+
+    char his_k[N_PEERS][FS_4096];
+    octet HIS_K[N_PEERS];
+
+    char r2_mem[2][N_PEERS * R2_OCTETS][FS_4096];
+    octet R2[2][N_PEERS * R2_OCTETS];
+
+    // delta, Delta and psi'' of the output, Gamma and Delta of store 1, delta and chi of store 2
+    char r3_mem[2][7][FS_2048];
+    octet R3[2][7];
+
+    PAILLIER_public_key hisPK[N_PEERS];
+
+    CG21_PRESIGN_ROUND1_STORE r1store;
+    CG21_PRESIGN_ROUND1_OUTPUT r1output[N_PEERS];
+    CG21_PRESIGN_ROUND2_OUTPUT r2output[2][N_PEERS];
+    CG21_PRESIGN_ROUND2_STORE r2store[2][N_PEERS];
+    CG21_PRESIGN_ROUND3_OUTPUT r3output[2];
+    CG21_PRESIGN_ROUND3_STORE_1 r3store1[2];
+    CG21_PRESIGN_ROUND3_STORE_2 r3store2[2];
+
+    init_octets((char *)his_k, HIS_K, FS_4096, N_PEERS);
+    init_octets((char *)r2_mem, R2[0], FS_4096, 2 * N_PEERS * R2_OCTETS);
+    init_octets((char *)r3_mem, R3[0], FS_2048, 2 * 7);
+
+    random_mod_q(RNG, &KK);
+    random_mod_q(RNG, &GAMMA);
+    random_mod_q(RNG, &A);
+
+    r1store.k = &KK;
+    r1store.gamma = &GAMMA;
+    r1store.a = &A;
+    r1store.i = MY_ID;
+
+    /*
+     * Every player uses the same Paillier key, so the Round 2 outputs
+     * computed here can be decrypted in Round 3 as if sent back by the peers
+     */
+    for (int j = 0; j < N_PEERS; j++)
+    {
+        hisPK[j] = *PUB;
+
+        random_mod_q(RNG, &PT);
+        OCT_pad(&PT, FS_2048);
+        PAILLIER_ENCRYPT(RNG, PUB, &PT, HIS_K + j, NULL);
+
+        r1output[j].K = HIS_K + j;
+        r1output[j].i = MY_ID + 1 + j;
+    }
+
+    for (int b = 0; b < 2; b++)
+    {
+        init_round2(r2output[b], r2store[b], R2[b]);
+
+        r3output[b].delta = &R3[b][0];
+        r3output[b].Delta = &R3[b][1];
+        r3output[b].psi_douplePrime = &R3[b][2];
+        r3store1[b].Gamma = &R3[b][3];
+        r3store1[b].Delta = &R3[b][4];
+        r3store2[b].delta = &R3[b][5];
+        r3store2[b].chi = &R3[b][6];
+    }
+
+    /*
+     * Round 2: the fan-out seeds the RNG of peer j with the next 32 bytes of
+     * RNG, the serial calls get the same RNGs
+     */
+    RNG_FANOUT = *RNG;
+
+    for (int j = 0; j < N_PEERS; j++)
+    {
+        for (int i = 0; i < 32; i++)
+        {
+            seed[i] = (char) RAND_byte(RNG);
+        }
+        RAND_seed(&rng, 32, seed);
+
+        expect("CG21_PRESIGN_ROUND2",
+               CG21_PRESIGN_ROUND2(&rng, r2output[0] + j, r2store[0] + j, r1output + j, &r1store, hisPK + j, PUB),
+               CG21_OK);
+    }
+
+    expect("CG21_PRESIGN_ROUND2_FANOUT",
+           CG21_PRESIGN_ROUND2_FANOUT(&RNG_FANOUT, r2output[1], r2store[1], r1output, &r1store, hisPK, PUB, NULL, NULL, N_PEERS, threads),
+           CG21_OK);
+
+    for (int i = 0; i < N_PEERS * R2_OCTETS; i++)
+    {
+        expect_equal("CG21_PRESIGN_ROUND2_FANOUT", &R2[0][i], &R2[1][i]);
+    }
+
+    for (int j = 0; j < N_PEERS; j++)
+    {
+        expect("CG21_PRESIGN_ROUND2_FANOUT output i", r2output[1][j].i, MY_ID);
+        expect("CG21_PRESIGN_ROUND2_FANOUT output j", r2output[1][j].j, r1output[j].i);
+        expect("CG21_PRESIGN_ROUND2_FANOUT store i", r2store[1][j].i, MY_ID);
+        expect("CG21_PRESIGN_ROUND2_FANOUT store j", r2store[1][j].j, r1output[j].i);
+    }
+
+    // Round 3
+    for (int j = 0; j < N_PEERS; j++)
+    {
+        expect("CG21_PRESIGN_ROUND3_2_1",
+               CG21_PRESIGN_ROUND3_2_1(r2output[0] + j, r3store1, r2store[0] + j, &r1store, status(j)),
+               CG21_OK);
+    }
+
+    for (int j = 0; j < N_PEERS; j++)
+    {
+        expect("CG21_PRESIGN_ROUND3_2_2",
+               CG21_PRESIGN_ROUND3_2_2(r2output[0] + j, r3output, r3store1, r3store2, &r1store, PRIV, r2store[0] + j, status(j)),
+               CG21_OK);
+    }
+
+    expect("CG21_PRESIGN_ROUND3_FANOUT",
+           CG21_PRESIGN_ROUND3_FANOUT(r2output[0], r3output + 1, r3store1 + 1, r3store2 + 1, &r1store, PRIV, r2store[0], N_PEERS, threads),
+           CG21_OK);
+
+    // psi'' is not written by Round 3
+    for (int i = 0; i < 7; i++)
+    {
+        if (i != 2)
+        {
+            expect_equal("CG21_PRESIGN_ROUND3_FANOUT", &R3[0][i], &R3[1][i]);
+        }
+    }
+
+    expect("CG21_PRESIGN_ROUND3_FANOUT output i", r3output[1].i, MY_ID);
+    expect("CG21_PRESIGN_ROUND3_FANOUT store 1 i", r3store1[1].i, MY_ID);
+    expect("CG21_PRESIGN_ROUND3_FANOUT store 2 i", r3store2[1].i, MY_ID);
+
+    RAND_clean(&rng);
+    RAND_clean(&RNG_FANOUT);
+}
+
+int main()
+{
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    PAILLIER_private_key priv;
+    PAILLIER_public_key pub;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &pub, &priv);
+
+    // One worker per peer, and fewer workers than peers
+    test_fanout(&RNG, &pub, &priv, N_PEERS);
+    test_fanout(&RNG, &pub, &priv, 2);
+
+    PAILLIER_PRIVATE_KEY_KILL(&priv);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,222 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Presignature pool smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_presign_pool.h"
+
+#define POOL_SIZE 4
+#define MY_ID 1
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    int calls;      // number of generated presignatures
+    int fail_after; // return an error after this many calls, if positive
+    int failed;     // the generator returned an error
+} generator_state;
+
+// Fill a dummy presignature tagged with n
+static void fill(CG21_PRESIGN_ROUND4_STORE_2 *pre, int n, int i)
+{
+    OCT_clear(pre->R);
+    OCT_jbyte(pre->R, 2, 1);
+    OCT_jbyte(pre->R, n, EFS_SECP256K1);
+    OCT_clear(pre->chi);
+    OCT_jbyte(pre->chi, n + 1, EGS_SECP256K1);
+    OCT_clear(pre->k);
+    OCT_jbyte(pre->k, n + 2, EGS_SECP256K1);
+    pre->i = i;
+}
+
+// Check the presignature is the one tagged with n
+static void check(const char *name, CG21_PRESIGN_ROUND4_STORE_2 *pre, int n)
+{
+    if (pre->R->len != EFS_SECP256K1 + 1 || pre->R->val[1] != (char)n ||
+        pre->chi->val[0] != (char)(n + 1) || pre->k->val[0] != (char)(n + 2) || pre->i != MY_ID)
+    {
+        printf("FAILURE %s. Wrong presignature\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static int generator(void *arg, CG21_PRESIGN_ROUND4_STORE_2 *pre)
+{
+    int rc = CG21_OK;
+    generator_state *state = (generator_state *)arg;
+
+    pthread_mutex_lock(&state->lock);
+
+    if (state->fail_after > 0 && state->calls >= state->fail_after)
+    {
+        state->failed = 1;
+        rc = CG21_PRESIGN_FAILED;
+    }
+    else
+    {
+        fill(pre, 100 + state->calls, MY_ID);
+        state->calls++;
+    }
+
+    pthread_mutex_unlock(&state->lock);
+
+    return rc;
+}
+
+static int generator_failed(generator_state *state)
+{
+    pthread_mutex_lock(&state->lock);
+    int failed = state->failed;
+    pthread_mutex_unlock(&state->lock);
+
+    return failed;
+}
+
+int main()
+{
+    int rc;
+    int id;
+
+    char r[EFS_SECP256K1 + 1];
+    octet R = {0, sizeof(r), r};
+
+    char c[EGS_SECP256K1];
+    octet CHI = {0, sizeof(c), c};
+
+    char k[EGS_SECP256K1];
+    octet K = {0, sizeof(k), k};
+
+    CG21_PRESIGN_ROUND4_STORE_2 pre = {&R, &CHI, &K, 0};
+
+    CG21_PRESIGN_POOL_ENTRY entries[POOL_SIZE];
+    CG21_PRESIGN_POOL pool;
+
+    generator_state state;
+    pthread_mutex_init(&state.lock, NULL);
+    state.calls = 0;
+    state.fail_after = 0;
+    state.failed = 0;
+
+    rc = CG21_PRESIGN_POOL_INIT(&pool, entries, POOL_SIZE, MY_ID);
+    expect("CG21_PRESIGN_POOL_INIT", rc, CG21_OK);
+
+    // Fill the pool by hand
+    for (int i = 0; i < POOL_SIZE; i++)
+    {
+        fill(&pre, i, MY_ID);
+        rc = CG21_PRESIGN_POOL_PUT(&pool, &pre, &id);
+        expect("CG21_PRESIGN_POOL_PUT", rc, CG21_OK);
+        expect("CG21_PRESIGN_POOL_PUT id", id, i);
+    }
+
+    rc = CG21_PRESIGN_POOL_PUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_PUT full", rc, CG21_PRESIGN_POOL_FULL);
+
+    fill(&pre, 0, MY_ID + 1);
+    rc = CG21_PRESIGN_POOL_PUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_PUT invalid", rc, CG21_PRESIGN_POOL_INVALID);
+
+    // Take by id, only once
+    rc = CG21_PRESIGN_POOL_TAKE(&pool, 2, &pre);
+    expect("CG21_PRESIGN_POOL_TAKE", rc, CG21_OK);
+    check("CG21_PRESIGN_POOL_TAKE", &pre, 2);
+
+    rc = CG21_PRESIGN_POOL_TAKE(&pool, 2, &pre);
+    expect("CG21_PRESIGN_POOL_TAKE reuse", rc, CG21_PRESIGN_POOL_UNKNOWN_ID);
+
+    rc = CG21_PRESIGN_POOL_TAKE(&pool, POOL_SIZE, &pre);
+    expect("CG21_PRESIGN_POOL_TAKE unknown", rc, CG21_PRESIGN_POOL_UNKNOWN_ID);
+
+    expect("CG21_PRESIGN_POOL_SIZE", CG21_PRESIGN_POOL_SIZE(&pool), POOL_SIZE - 1);
+
+    // Checkout in order, skipping the one taken by id
+    int order[] = {0, 1, 3};
+    for (int i = 0; i < 3; i++)
+    {
+        rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+        expect("CG21_PRESIGN_POOL_CHECKOUT", rc, CG21_OK);
+        expect("CG21_PRESIGN_POOL_CHECKOUT id", id, order[i]);
+        check("CG21_PRESIGN_POOL_CHECKOUT", &pre, order[i]);
+    }
+
+    rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_CHECKOUT empty", rc, CG21_PRESIGN_POOL_EMPTY);
+
+    rc = CG21_PRESIGN_POOL_TAKE(&pool, 3, &pre);
+    expect("CG21_PRESIGN_POOL_TAKE used", rc, CG21_PRESIGN_POOL_UNKNOWN_ID);
+
+    // Background generation fills the pool and refills it when it runs low
+    rc = CG21_PRESIGN_POOL_START(&pool, generator, &state, 2);
+    expect("CG21_PRESIGN_POOL_START", rc, CG21_OK);
+
+    rc = CG21_PRESIGN_POOL_START(&pool, generator, &state, 2);
+    expect("CG21_PRESIGN_POOL_START running", rc, CG21_PRESIGN_POOL_RUNNING);
+
+    while (CG21_PRESIGN_POOL_SIZE(&pool) < POOL_SIZE);
+
+    for (int i = 0; i < 3; i++)
+    {
+        rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+        expect("CG21_PRESIGN_POOL_CHECKOUT background", rc, CG21_OK);
+        expect("CG21_PRESIGN_POOL_CHECKOUT background id", id, POOL_SIZE + i);
+        check("CG21_PRESIGN_POOL_CHECKOUT background", &pre, 100 + i);
+    }
+
+    while (CG21_PRESIGN_POOL_SIZE(&pool) < POOL_SIZE);
+
+    rc = CG21_PRESIGN_POOL_STOP(&pool);
+    expect("CG21_PRESIGN_POOL_STOP", rc, CG21_OK);
+    expect("CG21_PRESIGN_POOL_STOP calls", state.calls, POOL_SIZE + 3);
+
+    // A failing generator stops the background generation
+    state.fail_after = state.calls + 1;
+
+    rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_CHECKOUT", rc, CG21_OK);
+    rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_CHECKOUT", rc, CG21_OK);
+    rc = CG21_PRESIGN_POOL_CHECKOUT(&pool, &pre, &id);
+    expect("CG21_PRESIGN_POOL_CHECKOUT", rc, CG21_OK);
+
+    rc = CG21_PRESIGN_POOL_START(&pool, generator, &state, 2);
+    expect("CG21_PRESIGN_POOL_START", rc, CG21_OK);
+
+    while (!generator_failed(&state));
+
+    rc = CG21_PRESIGN_POOL_STOP(&pool);
+    expect("CG21_PRESIGN_POOL_STOP failure", rc, CG21_PRESIGN_FAILED);
+    expect("CG21_PRESIGN_POOL_SIZE", CG21_PRESIGN_POOL_SIZE(&pool), 2);
+
+    CG21_PRESIGN_POOL_KILL(&pool);
+    pthread_mutex_destroy(&state.lock);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
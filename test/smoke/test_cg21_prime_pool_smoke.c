@@ -0,0 +1,150 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Safe prime pool export and import smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_prime_pool.h"
+
+#define POOL_SIZE 2
+
+// Safe prime P = 2p+1
+char *P_hex = "e41615620cb68a9ea8df28551b27f333cf65c770c7e959435786d4b510fe360a304fd2bf437431e790dc4c54da6db03119e75ef0b3f47436acf78a9e7b2276ebdd864e49d3bf450c496b10471f024dc4ae1f659c41aacdfb8ee6d52ba46a82d41f79a14277a61474a6473b7e4ab82528383d6400dc71278941e16c138d74d5bb";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    CG21_PRIME_POOL_ENTRY entries[POOL_SIZE];
+    CG21_PRIME_POOL pool;
+
+    CG21_PRIME_POOL_ENTRY entries2[POOL_SIZE];
+    CG21_PRIME_POOL pool2;
+
+    CG21_PRIME_POOL_ENTRY entries3[1];
+    CG21_PRIME_POOL pool3;
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char golden[HFS_2048];
+    octet GOLDEN = {0, sizeof(golden), golden};
+
+    char k[32];
+    octet K = {0, sizeof(k), k};
+
+    char k2[32];
+    octet K2 = {0, sizeof(k2), k2};
+
+    char out[CG21_PRIME_POOL_EXPORT_SIZE(POOL_SIZE)];
+    octet OUT = {0, sizeof(out), out};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_fromHex(&GOLDEN, P_hex);
+    OCT_rand(&K, &RNG, 32);
+    OCT_rand(&K2, &RNG, 32);
+
+    expect("CG21_PRIME_POOL_INIT capacity", CG21_PRIME_POOL_INIT(&pool, entries, 0, &RNG, 1), CG21_PRIME_POOL_INVALID);
+    expect("CG21_PRIME_POOL_INIT", CG21_PRIME_POOL_INIT(&pool, entries, POOL_SIZE, &RNG, 1), CG21_OK);
+    expect("CG21_PRIME_POOL_INIT", CG21_PRIME_POOL_INIT(&pool2, entries2, POOL_SIZE, &RNG, 1), CG21_OK);
+    expect("CG21_PRIME_POOL_INIT", CG21_PRIME_POOL_INIT(&pool3, entries3, 1, &RNG, 1), CG21_OK);
+
+    // Store a known prime instead of searching one
+    for (int b = 0; b < HFS_2048; b++)
+    {
+        entries[0].P[b] = golden[b];
+    }
+    pool.count = 1;
+
+    // Export into an octet that is too small
+    OUT.max = CG21_PRIME_POOL_EXPORT_SIZE(1) - 1;
+    expect("CG21_PRIME_POOL_EXPORT too small", CG21_PRIME_POOL_EXPORT(&pool, &RNG, &K, &OUT), CG21_PRIME_POOL_OUTPUT_TOO_SMALL);
+    expect("CG21_PRIME_POOL_SIZE too small", CG21_PRIME_POOL_SIZE(&pool), 1);
+    OUT.max = sizeof(out);
+
+    // Export and import into another pool. The exported primes leave the pool
+    expect("CG21_PRIME_POOL_EXPORT", CG21_PRIME_POOL_EXPORT(&pool, &RNG, &K, &OUT), CG21_OK);
+    expect("CG21_PRIME_POOL_EXPORT length", OUT.len, CG21_PRIME_POOL_EXPORT_SIZE(1));
+    expect("CG21_PRIME_POOL_SIZE export", CG21_PRIME_POOL_SIZE(&pool), 0);
+
+    expect("CG21_PRIME_POOL_IMPORT wrong key", CG21_PRIME_POOL_IMPORT(&pool2, &K2, &OUT), CG21_PRIME_POOL_AUTH_FAIL);
+    expect("CG21_PRIME_POOL_SIZE wrong key", CG21_PRIME_POOL_SIZE(&pool2), 0);
+
+    expect("CG21_PRIME_POOL_IMPORT", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_OK);
+    expect("CG21_PRIME_POOL_IMPORT twice", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_PRIME_POOL_DUPLICATE);
+    expect("CG21_PRIME_POOL_SIZE import", CG21_PRIME_POOL_SIZE(&pool2), 1);
+
+    CG21_PRIME_POOL_TAKE(&pool2, &P);
+    expect("CG21_PRIME_POOL_TAKE", OCT_comp(&P, &GOLDEN), 1);
+    expect("CG21_PRIME_POOL_SIZE take", CG21_PRIME_POOL_SIZE(&pool2), 0);
+
+    // Tampered exports
+    out[CG21_PRIME_POOL_HEADER_SIZE + CG21_PRIME_POOL_IV_SIZE] ^= 1;
+    expect("CG21_PRIME_POOL_IMPORT tampered", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_PRIME_POOL_AUTH_FAIL);
+    out[CG21_PRIME_POOL_HEADER_SIZE + CG21_PRIME_POOL_IV_SIZE] ^= 1;
+
+    out[0] = CG21_PRIME_POOL_VERSION + 1;
+    expect("CG21_PRIME_POOL_IMPORT version", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_PRIME_POOL_WRONG_VERSION);
+    out[0] = CG21_PRIME_POOL_VERSION;
+
+    OUT.len--;
+    expect("CG21_PRIME_POOL_IMPORT length", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_PRIME_POOL_INVALID_FORMAT);
+    OUT.len++;
+
+    expect("CG21_PRIME_POOL_SIZE rejected", CG21_PRIME_POOL_SIZE(&pool2), 0);
+
+    // Two primes, the pool does not check them
+    for (int b = 0; b < HFS_2048; b++)
+    {
+        entries[0].P[b] = golden[b];
+        entries[1].P[b] = golden[b] ^ 2;
+    }
+    pool.head = 0;
+    pool.count = 2;
+
+    expect("CG21_PRIME_POOL_EXPORT two", CG21_PRIME_POOL_EXPORT(&pool, &RNG, &K, &OUT), CG21_OK);
+    expect("CG21_PRIME_POOL_EXPORT two length", OUT.len, CG21_PRIME_POOL_EXPORT_SIZE(2));
+
+    // An export larger than the free room is rejected before decryption, even with the wrong key
+    expect("CG21_PRIME_POOL_IMPORT too large", CG21_PRIME_POOL_IMPORT(&pool3, &K2, &OUT), CG21_PRIME_POOL_INVALID);
+    expect("CG21_PRIME_POOL_IMPORT two", CG21_PRIME_POOL_IMPORT(&pool2, &K, &OUT), CG21_OK);
+    expect("CG21_PRIME_POOL_SIZE two", CG21_PRIME_POOL_SIZE(&pool2), 2);
+
+    CG21_PRIME_POOL_TAKE(&pool2, &P);
+    expect("CG21_PRIME_POOL_TAKE oldest", OCT_comp(&P, &GOLDEN), 1);
+
+    CG21_PRIME_POOL_KILL(&pool);
+    CG21_PRIME_POOL_KILL(&pool2);
+    CG21_PRIME_POOL_KILL(&pool3);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
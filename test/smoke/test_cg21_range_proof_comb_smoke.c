@@ -0,0 +1,337 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Range proofs verification with and without the Pedersen combs smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/hidden_dlog.h"
+#include "amcl/cg21/cg21_rp_pi_enc.h"
+#include "amcl/cg21/cg21_rp_pi_logstar.h"
+#include "amcl/cg21/cg21_rp_pi_affg.h"
+#include "amcl/cg21/cg21_rp_pi_affp.h"
+
+#define N_OCTETS 7
+
+// Verifier Paillier key
+char *P1_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q1_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+// Prover Paillier key
+char *P2_hex = "f592ad30c88d719fd272095257c90395d16f6c613a3ccf1b556646a99c316275ce6bf0565f1f28e705342158c79e0d5614bcfeec3b02d60eb5bd490b930b04c64103b2b0257d73156715012c77f43872024488297b1f03d521200ffadeb3f85e86378837ed34c366b5f58e8dd042e320381d765a871f963f80fc4ac4bb4c096f";
+char *Q2_hex = "c49346cef2c4249b7df76b93191e916db4582549697a526a6aa0094c09d83dc71be94598e64fba8e34f3b27c3a40090be0a44e1818b14c5513e0b9d9cdc9bb19398a29725fa851b08addaacb430ebe55128f6c43d611d2a35ddb7e7fba5edae177c9de0271912110709125ce18dd403be71ce96784ec856115e2fc4462ccd5d5";
+
+// Verifier safe primes for the Ring-Pedersen parameters
+char *PT_hex = "c2cc5ab59ecd22f46f0869dee3d9a99cd5bd131b07ca12b295a41a900c345ba41e3f25a251f080571058c74ca16f7949acc6c62737541562ac4fea45ad4db247a505675655efbdfd81cf8b78454ad466ee11e2ebadd884cc6f67ae2c5ab3fffb97f67198092c1bbc6d19cf456232b7e3bc39d1a5ebb77f120f09c58492f415b3";
+char *QT_hex = "c6207e07c2e8b616d36b790d4ff127eb7d70b5e3b46d0acefc0a460ba544e03cf3a3d3c6e329aa2f5e0eb258bd0d7a140c5e9779ce0ec4e0f1982157ded95b3a48a1bbdffc1cec430dfbe535cc5b07ebb069e78c814f4f68ab6d5b2bd8e93a1aca4267fbe8d07b151c42393113d33deb21da82bf22e7fbfc1f64996bd1c52507";
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Both verifications must agree, and accept only the valid proof
+static void expect_same(const char *name, int rc_plain, int rc_comb, int valid)
+{
+    if (rc_plain != rc_comb)
+    {
+        printf("FAILURE %s. rc %d without combs, %d with combs\n", name, rc_plain, rc_comb);
+        exit(EXIT_FAILURE);
+    }
+
+    if ((rc_plain == 0) != valid)
+    {
+        printf("FAILURE %s. rc %d\n", name, rc_plain);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// CT = Enc(PT; R) with R sampled in Z/NZ and returned in FS_4096 bytes
+static void encrypt(csprng *RNG, PAILLIER_public_key *PUB, octet *PT, octet *CT, octet *R)
+{
+    BIG_512_60 r[FFLEN_4096];
+
+    char pt[FS_2048];
+    octet PT_PAD = {0, sizeof(pt), pt};
+
+    FF_4096_zero(r, FFLEN_4096);
+    FF_4096_randomnum(r, PUB->n, RNG, HFLEN_4096);
+    FF_4096_toOctet(R, r, FFLEN_4096);
+
+    OCT_copy(&PT_PAD, PT);
+    OCT_pad(&PT_PAD, FS_2048);
+
+    PAILLIER_ENCRYPT(NULL, PUB, &PT_PAD, CT, R);
+}
+
+// Random value modulo the curve order in EGS_SECP256K1 bytes
+static void random_mod_q(csprng *RNG, octet *X)
+{
+    BIG_256_56 q;
+    BIG_256_56 x;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+    BIG_256_56_randomnum(x, q, RNG);
+
+    BIG_256_56_toBytes(X->val, x);
+    X->len = EGS_SECP256K1;
+}
+
+int main()
+{
+    int rc_plain;
+    int rc_comb;
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+
+    char q[HFS_2048];
+    octet Q = {0, sizeof(q), q};
+
+    char x[EGS_SECP256K1];
+    octet X = {0, sizeof(x), x};
+
+    char y[EGS_SECP256K1];
+    octet Y = {0, sizeof(y), y};
+
+    char e[EGS_SECP256K1];
+    octet E = {0, sizeof(e), e};
+
+    char g[EFS_SECP256K1 + 1];
+    octet GEN = {0, sizeof(g), g};
+
+    char xg[EFS_SECP256K1 + 1];
+    octet XG = {0, sizeof(xg), xg};
+
+    char c1[FS_4096];
+    octet C = {0, sizeof(c1), c1};
+
+    char c2[FS_4096];
+    octet D = {0, sizeof(c2), c2};
+
+    char c3[FS_4096];
+    octet CY = {0, sizeof(c3), c3};
+
+    char c4[FS_4096];
+    octet CX = {0, sizeof(c4), c4};
+
+    char c5[FS_4096];
+    octet CT = {0, sizeof(c5), c5};
+
+    char r1[FS_4096];
+    octet RHO = {0, sizeof(r1), r1};
+
+    char r2[FS_4096];
+    octet RHO_X = {0, sizeof(r2), r2};
+
+    char r3[FS_4096];
+    octet RHO_Y = {0, sizeof(r3), r3};
+
+    char r4[FS_4096];
+    octet R = {0, sizeof(r4), r4};
+
+    // Scratch octets for the commitments and the proofs of every range proof
+    char commits_mem[N_OCTETS][FS_4096];
+    octet COMMITS[N_OCTETS];
+
+    char proofs_mem[N_OCTETS][FS_4096];
+    octet PROOFS[N_OCTETS];
+
+    PAILLIER_private_key verifier_priv;
+    PAILLIER_public_key verifier_pub;
+    PAILLIER_private_key prover_priv;
+    PAILLIER_public_key prover_pub;
+
+    PEDERSEN_PRIV pedersen_priv;
+    PEDERSEN_PRIV pedersen_comb;
+    PEDERSEN_PUB pedersen_pub;
+
+    ECP_SECP256K1 G;
+    BIG_256_56 xx;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    init_octets((char *)commits_mem, COMMITS, FS_4096, N_OCTETS);
+    init_octets((char *)proofs_mem, PROOFS, FS_4096, N_OCTETS);
+
+    OCT_fromHex(&P, P1_hex);
+    OCT_fromHex(&Q, Q1_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &verifier_pub, &verifier_priv);
+
+    OCT_fromHex(&P, P2_hex);
+    OCT_fromHex(&Q, Q2_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &prover_pub, &prover_priv);
+
+    OCT_fromHex(&P, PT_hex);
+    OCT_fromHex(&Q, QT_hex);
+    ring_Pedersen_setup(&RNG, &pedersen_priv, &P, &Q);
+    Pedersen_get_public_param(&pedersen_pub, &pedersen_priv);
+
+    // Same parameters with the combs of s and t attached
+    HDLOG_comb *combs = malloc(2 * sizeof(HDLOG_comb));
+    if (combs == NULL)
+    {
+        printf("FAILURE allocating the combs\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pedersen_comb = pedersen_priv;
+    CG21_Pedersen_precompute(&pedersen_comb, combs, combs + 1);
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_toOctet(&GEN, &G, true);
+
+    random_mod_q(&RNG, &X);
+    random_mod_q(&RNG, &Y);
+
+    // X = xG
+    BIG_256_56_fromBytesLen(xx, X.val, X.len);
+    ECP_SECP256K1_mul(&G, xx);
+    ECP_SECP256K1_toOctet(&XG, &G, true);
+    BIG_256_56_zero(xx);
+
+    // Any challenge in [0, .., q] works for the comparison
+    random_mod_q(&RNG, &E);
+
+    /*
+     * PiEnc: K = Enc_N1(x; rho)
+     */
+
+    PiEnc_SECRETS enc_secrets;
+    PiEnc_COMMITS enc_commits;
+    PiEnc_PROOFS enc_proofs;
+    PiEnc_COMMITS_OCT enc_commitsOct = {COMMITS, COMMITS + 1, COMMITS + 2};
+    PiEnc_PROOFS_OCT enc_proofsOct = {PROOFS, PROOFS + 1, PROOFS + 2};
+
+    encrypt(&RNG, &prover_pub, &X, &CX, &RHO);
+
+    PiEnc_Sample_randoms_and_commit(&RNG, &prover_priv, &pedersen_pub, &X, &enc_secrets, &enc_commits, &enc_commitsOct);
+    PiEnc_Prove(&prover_priv, &X, &RHO, &enc_secrets, &E, &enc_proofs, &enc_proofsOct);
+    PiEnc_Kill_secrets(&enc_secrets);
+
+    rc_plain = PiEnc_Verify(&prover_pub, &pedersen_priv, &CX, &enc_commits, &E, &enc_proofs);
+    rc_comb = PiEnc_Verify(&prover_pub, &pedersen_comb, &CX, &enc_commits, &E, &enc_proofs);
+    expect_same("PiEnc_Verify", rc_plain, rc_comb, 1);
+
+    FF_2048_inc(enc_proofs.z3, 1, FFLEN_2048 + HFLEN_2048);
+    rc_plain = PiEnc_Verify(&prover_pub, &pedersen_priv, &CX, &enc_commits, &E, &enc_proofs);
+    rc_comb = PiEnc_Verify(&prover_pub, &pedersen_comb, &CX, &enc_commits, &E, &enc_proofs);
+    expect_same("PiEnc_Verify tampered", rc_plain, rc_comb, 0);
+
+    /*
+     * PiLogstar: C = Enc_N1(x; rho), X = xG
+     */
+
+    PiLogstar_SECRETS logstar_secrets;
+    PiLogstar_COMMITS logstar_commits;
+    PiLogstar_PROOFS logstar_proofs;
+    PiLogstar_COMMITS_OCT logstar_commitsOct = {COMMITS, COMMITS + 1, COMMITS + 2, COMMITS + 3};
+    PiLogstar_PROOFS_OCT logstar_proofsOct = {PROOFS, PROOFS + 1, PROOFS + 2};
+
+    PiLogstar_Sample_and_commit(&RNG, &prover_priv, &pedersen_pub, &X, &GEN, &logstar_secrets, &logstar_commits, &logstar_commitsOct);
+    PiLogstar_Prove(&prover_priv, &X, &RHO, &logstar_secrets, &E, &logstar_proofs, &logstar_proofsOct);
+    PiLogstar_clean_secrets(&logstar_secrets);
+
+    rc_plain = PiLogstar_Verify(&prover_pub, &pedersen_priv, &CX, &GEN, &logstar_commits, &XG, &E, &logstar_proofs);
+    rc_comb = PiLogstar_Verify(&prover_pub, &pedersen_comb, &CX, &GEN, &logstar_commits, &XG, &E, &logstar_proofs);
+    expect_same("PiLogstar_Verify", rc_plain, rc_comb, 1);
+
+    FF_2048_inc(logstar_proofs.z3, 1, FFLEN_2048 + HFLEN_2048);
+    rc_plain = PiLogstar_Verify(&prover_pub, &pedersen_priv, &CX, &GEN, &logstar_commits, &XG, &E, &logstar_proofs);
+    rc_comb = PiLogstar_Verify(&prover_pub, &pedersen_comb, &CX, &GEN, &logstar_commits, &XG, &E, &logstar_proofs);
+    expect_same("PiLogstar_Verify tampered", rc_plain, rc_comb, 0);
+
+    /*
+     * Affine operations: C = Enc_N0(c), D = C^x * Enc_N0(y; rho),
+     * Y = Enc_N1(y; rho_y) and X = xG (Piaffg) or X = Enc_N1(x; rho_x) (PiAffp)
+     */
+
+    octet *PT[1] = {&X};
+    octet *CT_PTR[1] = {&CT};
+
+    random_mod_q(&RNG, &CT);
+    encrypt(&RNG, &verifier_pub, &CT, &C, &R);
+
+    CG21_PAILLIER_MULT_SHORT(&verifier_pub, &C, PT, CT_PTR, 1);
+    encrypt(&RNG, &verifier_pub, &Y, &CY, &RHO);
+    PAILLIER_ADD(&verifier_pub, &CT, &CY, &D);
+
+    encrypt(&RNG, &prover_pub, &Y, &CY, &RHO_Y);
+    encrypt(&RNG, &prover_pub, &X, &CX, &RHO_X);
+
+    Piaffg_SECRETS affg_secrets;
+    Piaffg_COMMITS affg_commits;
+    Piaffg_PROOFS affg_proofs;
+    Piaffg_COMMITS_OCT affg_commitsOct = {COMMITS, COMMITS + 1, COMMITS + 2, COMMITS + 3, COMMITS + 4, COMMITS + 5, COMMITS + 6};
+    Piaffg_PROOFS_OCT affg_proofsOct = {PROOFS, PROOFS + 1, PROOFS + 2, PROOFS + 3, PROOFS + 4, PROOFS + 5};
+
+    expect("Piaffg_Sample_and_Commit",
+           Piaffg_Sample_and_Commit(&RNG, &prover_priv, &verifier_pub, &pedersen_pub, &X, &Y, &affg_secrets, &affg_commits, &affg_commitsOct, &C),
+           Piaffg_OK);
+    Piaffg_Prove(&prover_pub, &verifier_pub, &affg_secrets, &X, &Y, &RHO, &RHO_Y, &E, &affg_proofs, &affg_proofsOct);
+    Piaffg_Kill_secrets(&affg_secrets);
+
+    rc_plain = Piaffg_Verify(&verifier_priv, &prover_pub, &pedersen_priv, &C, &D, &XG, &CY, &affg_commits, &E, &affg_proofs);
+    rc_comb = Piaffg_Verify(&verifier_priv, &prover_pub, &pedersen_comb, &C, &D, &XG, &CY, &affg_commits, &E, &affg_proofs);
+    expect_same("Piaffg_Verify", rc_plain, rc_comb, 1);
+
+    FF_2048_inc(affg_proofs.z3, 1, FFLEN_2048 + HFLEN_2048);
+    rc_plain = Piaffg_Verify(&verifier_priv, &prover_pub, &pedersen_priv, &C, &D, &XG, &CY, &affg_commits, &E, &affg_proofs);
+    rc_comb = Piaffg_Verify(&verifier_priv, &prover_pub, &pedersen_comb, &C, &D, &XG, &CY, &affg_commits, &E, &affg_proofs);
+    expect_same("Piaffg_Verify tampered", rc_plain, rc_comb, 0);
+
+    PiAffp_SECRETS affp_secrets;
+    PiAffp_COMMITS affp_commits;
+    PiAffp_PROOFS affp_proofs;
+    PiAffp_COMMITS_OCT affp_commitsOct = {COMMITS[0], COMMITS[1], COMMITS[2], COMMITS[3], COMMITS[4], COMMITS[5], COMMITS[6]};
+    PiAffp_PROOFS_OCT affp_proofsOct = {PROOFS[0], PROOFS[1], PROOFS[2], PROOFS[3], PROOFS[4], PROOFS[5], PROOFS[6]};
+
+    expect("PiAffp_Sample_and_Commit",
+           PiAffp_Sample_and_Commit(&RNG, &prover_priv, &verifier_pub, &pedersen_pub, &X, &Y, &affp_secrets, &affp_commits, &affp_commitsOct, &C),
+           PiAffp_OK);
+    PiAffp_Prove(&prover_pub, &verifier_pub, &affp_secrets, &X, &Y, &RHO, &RHO_X, &RHO_Y, &E, &affp_proofs, &affp_proofsOct);
+    PiAffp_Kill_secrets(&affp_secrets);
+
+    rc_plain = PiAffp_Verify(&verifier_priv, &prover_pub, &pedersen_priv, &C, &D, &CX, &CY, &affp_commits, &E, &affp_proofs);
+    rc_comb = PiAffp_Verify(&verifier_priv, &prover_pub, &pedersen_comb, &C, &D, &CX, &CY, &affp_commits, &E, &affp_proofs);
+    expect_same("PiAffp_Verify", rc_plain, rc_comb, 1);
+
+    FF_2048_inc(affp_proofs.z3, 1, FFLEN_2048 + HFLEN_2048);
+    rc_plain = PiAffp_Verify(&verifier_priv, &prover_pub, &pedersen_priv, &C, &D, &CX, &CY, &affp_commits, &E, &affp_proofs);
+    rc_comb = PiAffp_Verify(&verifier_priv, &prover_pub, &pedersen_comb, &C, &D, &CX, &CY, &affp_commits, &E, &affp_proofs);
+    expect_same("PiAffp_Verify tampered", rc_plain, rc_comb, 0);
+
+    CG21_Pedersen_comb_kill(&pedersen_comb);
+    free(combs);
+
+    CG21_Pedersen_Private_Kill(&pedersen_priv);
+    PAILLIER_PRIVATE_KEY_KILL(&verifier_priv);
+    PAILLIER_PRIVATE_KEY_KILL(&prover_priv);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,193 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Safe prime generation smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_utilities.h"
+
+#define N_CANDIDATES 512
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// x mod s by trial division of the big endian bytes of x
+static int residue(octet *X, int s)
+{
+    int r = 0;
+
+    for (int i = 0; i < X->len; i++)
+    {
+        r = (r * 256 + (unsigned char)X->val[i]) % s;
+    }
+
+    return r;
+}
+
+// Check P = 2p + 1, and p and P prime
+static void check_safe_prime(const char *name, csprng *RNG, BIG_1024_58 *p, BIG_1024_58 *P)
+{
+    BIG_1024_58 t[HFLEN_2048];
+
+    FF_2048_copy(t, p, HFLEN_2048);
+    FF_2048_shl(t, HFLEN_2048);
+    FF_2048_inc(t, 1, HFLEN_2048);
+
+    expect(name, FF_2048_comp(t, P, HFLEN_2048), 0);
+    expect(name, FF_2048_prime(p, RNG, HFLEN_2048), 1);
+    expect(name, FF_2048_prime(P, RNG, HFLEN_2048), 1);
+}
+
+/*
+ * The incremental sieve must agree with the trial division of every
+ * candidate by the small primes, and reject every candidate rejected by
+ * the former sieve of P by 3, 5, ..., 19
+ */
+static void test_sieve(csprng *RNG)
+{
+    char composite[SAFE_PRIME_SIEVE_BOUND] = {0};
+    int primes[SAFE_PRIME_SIEVE_BOUND];
+    int k = 0;
+
+    int pass[N_CANDIDATES];
+    int rejected = 0;
+
+    BIG_1024_58 p[HFLEN_2048];
+    BIG_1024_58 P[HFLEN_2048];
+
+    char oct[HFS_2048];
+    octet OCT = {0, sizeof(oct), oct};
+
+    for (int i = 2; i < SAFE_PRIME_SIEVE_BOUND; i++)
+    {
+        if (composite[i])
+        {
+            continue;
+        }
+
+        if (i > 3)
+        {
+            primes[k++] = i;
+        }
+
+        for (int j = i * i; j < SAFE_PRIME_SIEVE_BOUND; j += i)
+        {
+            composite[j] = 1;
+        }
+    }
+
+    // Random p = 11 mod 12, as the candidates of safe_prime_gen
+    FF_2048_random(p, RNG, HFLEN_2048);
+    FF_2048_shr(p, HFLEN_2048);
+
+    FF_2048_toOctet(&OCT, p, HFLEN_2048);
+    FF_2048_inc(p, 11, HFLEN_2048);
+    FF_2048_dec(p, residue(&OCT, 12), HFLEN_2048);
+
+    safe_prime_sieve(p, pass, N_CANDIDATES, HFLEN_2048);
+
+    for (int i = 0; i < N_CANDIDATES; i++)
+    {
+        int expected = 1;
+
+        FF_2048_copy(P, p, HFLEN_2048);
+        FF_2048_shl(P, HFLEN_2048);
+        FF_2048_inc(P, 1, HFLEN_2048);
+
+        FF_2048_toOctet(&OCT, p, HFLEN_2048);
+
+        for (int j = 0; j < k && expected; j++)
+        {
+            int r = residue(&OCT, primes[j]);
+
+            if (r == 0 || (2 * r + 1) % primes[j] == 0)
+            {
+                expected = 0;
+            }
+        }
+
+        expect("safe_prime_sieve trial division", pass[i], expected);
+
+        // 4849845 = 3*5*7*11*13*17*19
+        if (FF_2048_cfactor(P, 4849845, HFLEN_2048))
+        {
+            expect("safe_prime_sieve former sieve", pass[i], 0);
+            rejected++;
+        }
+
+        FF_2048_inc(p, 12, HFLEN_2048);
+    }
+
+    if (rejected == 0)
+    {
+        printf("FAILURE safe_prime_sieve. No candidate rejected by the former sieve\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void test_gen_mt(csprng *RNG)
+{
+    BIG_1024_58 p[2][HFLEN_2048];
+    BIG_1024_58 P[2][HFLEN_2048];
+
+    csprng RNG_COPY = *RNG;
+
+    // No prime to search, the RNG stream is left untouched
+    safe_prime_gen_mt(RNG, p[0], P[0], 0, HFLEN_2048, 4);
+
+    for (int i = 0; i < 32; i++)
+    {
+        expect("safe_prime_gen_mt k=0", RAND_byte(RNG), RAND_byte(&RNG_COPY));
+    }
+
+    safe_prime_gen_mt(RNG, p[0], P[0], 2, HFLEN_2048, 2);
+    check_safe_prime("safe_prime_gen_mt first", RNG, p[0], P[0]);
+    check_safe_prime("safe_prime_gen_mt second", RNG, p[1], P[1]);
+
+    RAND_clean(&RNG_COPY);
+}
+
+int main()
+{
+    BIG_1024_58 p[HFLEN_2048];
+    BIG_1024_58 P[HFLEN_2048];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    test_sieve(&RNG);
+
+    safe_prime_gen(&RNG, p, P, HFLEN_2048);
+    check_safe_prime("safe_prime_gen", &RNG, p, P);
+
+    test_gen_mt(&RNG);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
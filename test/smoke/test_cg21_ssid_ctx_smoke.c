@@ -0,0 +1,230 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+
+/* Range proof challenges with and without the session context smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "amcl/cg21/cg21_rp_pi_enc.h"
+#include "amcl/cg21/cg21_rp_pi_logstar.h"
+#include "amcl/cg21/cg21_rp_pi_affg.h"
+#include "amcl/cg21/cg21_rp_pi_affp.h"
+
+#define N1 3
+#define N2 4
+#define UID_LEN 16
+
+char *P_hex = "ffa0ec8cec4d2ffbef2a251111a361ad0199133f0aaa715df5ef052ad1efee2efda77a9349a74743e394ecef4da268c63171b8a896df79ec940f0c11d5de4a90d66628646f21f1ac0ac5f13adf45d2fd1d795c766dff1f656c91c3650ac2b59734efd3431332d691815da465b0d6f65b1620f4b1c7b9c18b38f63f478c06ca67";
+char *Q_hex = "e4d2fcd44d6bda22588e7f64e47fb32b1783cdc6ea43df8618cd27ae50e38a7d2ff1a252aec54625ab497f3cfe5860547ee0c66cb4ca0e29ccb1098fa3c04cee2565a20510596f5e0c8e4e2adde5aedcbb1803250f3465941880055798f1e36f5ba60e8878328132c070c6fad3c8ad2c155fd4cc88927f4410d498a5a5e40d8b";
+
+// IDs with hex digits a-f, packed out of order
+static const int IDS1[N1] = {0x00b2, 0x0003, 0x0011};
+static const int IDS2[N2] = {0x0031, 0x000a, 0x0100, 0x0002};
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void fill(octet *O, int len, int seed)
+{
+    for (int i = 0; i < len; i++)
+    {
+        O->val[i] = (char)(seed + 13 * i);
+    }
+    O->len = len;
+}
+
+static void pack_ids(octet *J, const int *ids, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        J->val[2*i] = (char)(ids[i] >> 8);
+        J->val[2*i+1] = (char)ids[i];
+    }
+    J->len = 2 * n;
+}
+
+int main()
+{
+    char rho[EGS_SECP256K1];
+    octet RHO = {0, sizeof(rho), rho};
+    char rid[EGS_SECP256K1];
+    octet RID = {0, sizeof(rid), rid};
+    char uid[UID_LEN];
+    octet UID = {0, sizeof(uid), uid};
+    char q[EGS_SECP256K1];
+    octet Q_ORDER = {0, sizeof(q), q};
+    char g[EFS_SECP256K1 + 1];
+    octet G = {0, sizeof(g), g};
+    char x_set[N1 * (EFS_SECP256K1 + 1)];
+    octet X_SET = {0, sizeof(x_set), x_set};
+    char j_set[2 * N1];
+    octet J_SET = {0, sizeof(j_set), j_set};
+    char n_set[N2 * FS_2048];
+    octet N_SET = {0, sizeof(n_set), n_set};
+    char s_set[N2 * FS_2048];
+    octet S_SET = {0, sizeof(s_set), s_set};
+    char t_set[N2 * FS_2048];
+    octet T_SET = {0, sizeof(t_set), t_set};
+    char j_set2[2 * N2];
+    octet J_SET2 = {0, sizeof(j_set2), j_set2};
+    int n1 = N1;
+    int n2 = N2;
+
+    char ssid_bytes[CG21_SSID_CTX_SIZE(UID_LEN, N1, N2)];
+    octet SSID_BYTES = {0, sizeof(ssid_bytes), ssid_bytes};
+
+    char c[FS_4096];
+    octet C = {0, sizeof(c), c};
+    char d[FS_4096];
+    octet D = {0, sizeof(d), d};
+    char x[EFS_SECP256K1 + 1];
+    octet X = {0, sizeof(x), x};
+    char y[FS_4096];
+    octet Y = {0, sizeof(y), y};
+
+    char e1[EGS_SECP256K1];
+    octet E1 = {0, sizeof(e1), e1};
+    char e2[EGS_SECP256K1];
+    octet E2 = {0, sizeof(e2), e2};
+
+    char h1[SHA256];
+    char h2[SHA256];
+
+    char p[HFS_2048];
+    octet P = {0, sizeof(p), p};
+    char qq[HFS_2048];
+    octet Q = {0, sizeof(qq), qq};
+
+    CG21_SSID ssid;
+    CG21_SSID_CTX ctx;
+    hash256 sha;
+
+    PAILLIER_private_key priv;
+    PAILLIER_public_key pub;
+    PEDERSEN_PUB pedersen;
+
+    PiEnc_COMMITS enc;
+    PiLogstar_COMMITS logstar;
+    Piaffg_COMMITS affg;
+    PiAffp_COMMITS affp;
+
+    OCT_fromHex(&P, P_hex);
+    OCT_fromHex(&Q, Q_hex);
+    PAILLIER_KEY_PAIR(NULL, &P, &Q, &pub, &priv);
+
+    // The challenges only serialise the parameters and commitments
+    memset(&pedersen, 0, sizeof(pedersen));
+    FF_2048_init(pedersen.N, 35, FFLEN_2048);
+    FF_2048_init(pedersen.b0, 4, FFLEN_2048);
+    FF_2048_init(pedersen.b1, 9, FFLEN_2048);
+
+    memset(&enc, 0, sizeof(enc));
+    memset(&logstar, 0, sizeof(logstar));
+    memset(&affg, 0, sizeof(affg));
+    memset(&affp, 0, sizeof(affp));
+    FF_2048_init(enc.S, 5, FFLEN_2048);
+    FF_2048_init(logstar.S, 6, FFLEN_2048);
+    ECP_SECP256K1_generator(&logstar.Y);
+    ECP_SECP256K1_generator(&affg.Bx);
+
+    fill(&C, FS_4096, 1);
+    fill(&D, FS_4096, 2);
+    fill(&X, EFS_SECP256K1 + 1, 3);
+    fill(&Y, FS_4096, 4);
+
+    fill(&RHO, EGS_SECP256K1, 5);
+    fill(&RID, EGS_SECP256K1, 6);
+    fill(&UID, UID_LEN, 7);
+    fill(&Q_ORDER, EGS_SECP256K1, 8);
+    fill(&G, EFS_SECP256K1 + 1, 9);
+    fill(&X_SET, sizeof(x_set), 10);
+    fill(&N_SET, sizeof(n_set), 11);
+    fill(&S_SET, sizeof(s_set), 12);
+    fill(&T_SET, sizeof(t_set), 13);
+    pack_ids(&J_SET, IDS1, N1);
+    pack_ids(&J_SET2, IDS2, N2);
+
+    ssid.uid = &UID;
+    ssid.rid = &RID;
+    ssid.rho = &RHO;
+    ssid.X_set_packed = &X_SET;
+    ssid.j_set_packed = &J_SET;
+    ssid.n1 = &n1;
+    ssid.q = &Q_ORDER;
+    ssid.g = &G;
+    ssid.N_set_packed = &N_SET;
+    ssid.s_set_packed = &S_SET;
+    ssid.t_set_packed = &T_SET;
+    ssid.j_set_packed2 = &J_SET2;
+    ssid.n2 = &n2;
+
+    // Session context
+    SSID_BYTES.max--;
+    expect("CG21_SSID_CTX_init too small", CG21_SSID_CTX_init(&ctx, &ssid, &SSID_BYTES), CG21_SSID_CTX_TOO_SMALL);
+    SSID_BYTES.max++;
+
+    expect("CG21_SSID_CTX_init", CG21_SSID_CTX_init(&ctx, &ssid, &SSID_BYTES), CG21_OK);
+    expect("CG21_SSID_CTX_init length", SSID_BYTES.len, CG21_SSID_CTX_SIZE(UID_LEN, N1, N2));
+
+    HASH256_init(&sha);
+    expect("CG21_hash_SSID", CG21_hash_SSID(&ssid, &sha), CG21_OK);
+    HASH256_hash(&sha, h1);
+
+    HASH256_init(&sha);
+    CG21_SSID_CTX_hash(&ctx, &sha);
+    HASH256_hash(&sha, h2);
+
+    expect("CG21_SSID_CTX_hash", memcmp(h1, h2, SHA256), 0);
+
+    // Challenges with and without the context
+    PiEnc_Challenge_gen(&pub, &pedersen, &C, &enc, &ssid, &E1);
+    PiEnc_Challenge_gen_ctx(&pub, &pedersen, &C, &enc, &ctx, &E2);
+    expect("PiEnc_Challenge_gen_ctx", OCT_comp(&E1, &E2), 1);
+
+    PiLogstar_Challenge_gen(&pub, &pedersen, &C, &logstar, &ssid, &X, &E1);
+    PiLogstar_Challenge_gen_ctx(&pub, &pedersen, &C, &logstar, &ctx, &X, &E2);
+    expect("PiLogstar_Challenge_gen_ctx", OCT_comp(&E1, &E2), 1);
+
+    Piaffg_Challenge_gen(&pub, &pub, &pedersen, &X, &Y, &C, &D, &affg, &ssid, &E1);
+    Piaffg_Challenge_gen_ctx(&pub, &pub, &pedersen, &X, &Y, &C, &D, &affg, &ctx, &E2);
+    expect("Piaffg_Challenge_gen_ctx", OCT_comp(&E1, &E2), 1);
+
+    PiAffp_Challenge_gen(&pub, &pub, &pedersen, &Y, &Y, &C, &D, &affp, &ssid, &E1);
+    PiAffp_Challenge_gen_ctx(&pub, &pub, &pedersen, &Y, &Y, &C, &D, &affp, &ctx, &E2);
+    expect("PiAffp_Challenge_gen_ctx", OCT_comp(&E1, &E2), 1);
+
+    // The challenge binds the SSID, the context keeps the SSID it was built from
+    x_set[0] ^= 1;
+    PiEnc_Challenge_gen(&pub, &pedersen, &C, &enc, &ssid, &E1);
+    PiEnc_Challenge_gen_ctx(&pub, &pedersen, &C, &enc, &ctx, &E2);
+    expect("PiEnc_Challenge_gen SSID", OCT_comp(&E1, &E2), 0);
+
+    PAILLIER_PRIVATE_KEY_KILL(&priv);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
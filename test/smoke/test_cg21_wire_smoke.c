@@ -0,0 +1,125 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+/* Round message encoding smoke test */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/cg21/cg21_wire.h"
+
+#define N_OCTETS 8
+
+static void expect(const char *name, int rc, int expected)
+{
+    if (rc != expected)
+    {
+        printf("FAILURE %s. rc %d, expected %d\n", name, rc, expected);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    char src[N_OCTETS][FS_4096];
+    octet SRC[N_OCTETS];
+
+    char dst[N_OCTETS][FS_4096];
+    octet DST[N_OCTETS];
+
+    char small[1];
+    octet SMALL = {0, sizeof(small), small};
+
+    char enc[CG21_WIRE_HEADER_SIZE + 2 * 4 + N_OCTETS * (4 + FS_4096)];
+    octet ENC = {0, sizeof(enc), enc};
+
+    char short_enc[16];
+    octet SHORT_ENC = {0, sizeof(short_enc), short_enc};
+
+    CG21_PRESIGN_ROUND2_OUTPUT in;
+    CG21_PRESIGN_ROUND2_OUTPUT out;
+    CG21_SIGN_ROUND1_OUTPUT sign;
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    init_octets((char *)src, SRC, FS_4096, N_OCTETS);
+    init_octets((char *)dst, DST, FS_4096, N_OCTETS);
+
+    // Octets of different lengths, the last one empty
+    for (int k = 0; k < N_OCTETS - 1; k++)
+    {
+        OCT_rand(SRC + k, &RNG, FS_4096 >> k);
+    }
+
+    in.Gamma = SRC + 0;
+    in.D = SRC + 1;
+    in.D_hat = SRC + 2;
+    in.F = SRC + 3;
+    in.F_hat = SRC + 4;
+    in.psi = SRC + 5;
+    in.psi_hat = SRC + 6;
+    in.psi_prime = SRC + 7;
+    in.i = 3;
+    in.j = 5;
+
+    out.Gamma = DST + 0;
+    out.D = DST + 1;
+    out.D_hat = DST + 2;
+    out.F = DST + 3;
+    out.F_hat = DST + 4;
+    out.psi = DST + 5;
+    out.psi_hat = DST + 6;
+    out.psi_prime = DST + 7;
+
+    // Round trip
+    expect("CG21_WIRE_ENCODE", CG21_WIRE_ENCODE_PRESIGN_ROUND2_OUTPUT(&ENC, &in), CG21_OK);
+    expect("CG21_WIRE_DECODE", CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(&out, &ENC), CG21_OK);
+
+    for (int k = 0; k < N_OCTETS; k++)
+    {
+        expect("CG21_WIRE_DECODE octet", OCT_comp(SRC + k, DST + k), 1);
+    }
+
+    expect("CG21_WIRE_DECODE i", out.i, in.i);
+    expect("CG21_WIRE_DECODE j", out.j, in.j);
+
+    // Errors
+    expect("CG21_WIRE_ENCODE small", CG21_WIRE_ENCODE_PRESIGN_ROUND2_OUTPUT(&SHORT_ENC, &in), CG21_WIRE_BUFFER_TOO_SMALL);
+
+    sign.sigma = &SMALL;
+    expect("CG21_WIRE_DECODE type", CG21_WIRE_DECODE_SIGN_ROUND1_OUTPUT(&sign, &ENC), CG21_WIRE_WRONG_TYPE);
+
+    out.Gamma = &SMALL;
+    expect("CG21_WIRE_DECODE small", CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(&out, &ENC), CG21_WIRE_BUFFER_TOO_SMALL);
+    out.Gamma = DST + 0;
+
+    ENC.len--;
+    expect("CG21_WIRE_DECODE truncated", CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(&out, &ENC), CG21_WIRE_INVALID_FORMAT);
+    ENC.len += 2;
+    expect("CG21_WIRE_DECODE trailing", CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(&out, &ENC), CG21_WIRE_INVALID_FORMAT);
+    ENC.len--;
+
+    enc[0] = CG21_WIRE_VERSION + 1;
+    expect("CG21_WIRE_DECODE version", CG21_WIRE_DECODE_PRESIGN_ROUND2_OUTPUT(&out, &ENC), CG21_WIRE_WRONG_VERSION);
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,92 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/randapi.h"
+#include "amcl/ecp_gen.h"
+
+/* Fixed-base generator multiplication smoke test */
+
+#define N_RANDOM 32
+
+static void check(const char *name, BIG_256_56 s)
+{
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 G;
+
+    ECP_GEN_mul(&P, s);
+
+    ECP_SECP256K1_generator(&G);
+    ECP_SECP256K1_mul(&G, s);
+
+    if (!ECP_SECP256K1_equals(&P, &G))
+    {
+        printf("FAILURE ECP_GEN_mul %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    BIG_256_56 s;
+    BIG_256_56 q;
+
+    char all[MODBYTES_256_56];
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    ECP_GEN_precompute();
+
+    BIG_256_56_zero(s);
+    check("zero", s);
+
+    BIG_256_56_one(s);
+    check("one", s);
+
+    BIG_256_56_copy(s, q);
+    BIG_256_56_dec(s, 1);
+    BIG_256_56_norm(s);
+    check("q-1", s);
+
+    BIG_256_56_copy(s, q);
+    check("q", s);
+
+    // Scalars larger than q are reduced
+    for (int i = 0; i < MODBYTES_256_56; i++)
+    {
+        all[i] = (char) 0xFF;
+    }
+    BIG_256_56_fromBytesLen(s, all, MODBYTES_256_56);
+    check("2^256-1", s);
+
+    for (int i = 0; i < N_RANDOM; i++)
+    {
+        BIG_256_56_randomnum(s, q, &RNG);
+        check("random", s);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,92 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/randapi.h"
+#include "amcl/ecp_msm.h"
+
+/* Multi-scalar multiplication smoke test */
+
+#define MAX_TERMS 40
+
+static void check(csprng *RNG, int n)
+{
+    BIG_256_56 q;
+    BIG_256_56 r;
+    BIG_256_56 e[MAX_TERMS];
+    ECP_SECP256K1 Q[MAX_TERMS];
+
+    ECP_SECP256K1 P;
+    ECP_SECP256K1 V;
+    ECP_SECP256K1 T;
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (int i = 0; i < n; i++)
+    {
+        BIG_256_56_randomnum(e[i], q, RNG);
+
+        BIG_256_56_randomnum(r, q, RNG);
+        ECP_SECP256K1_generator(&Q[i]);
+        ECP_SECP256K1_mul(&Q[i], r);
+    }
+
+    // Zero scalars and repeated points end up in the same buckets
+    if (n > 2)
+    {
+        BIG_256_56_zero(e[0]);
+        ECP_SECP256K1_copy(&Q[2], &Q[1]);
+        BIG_256_56_copy(e[2], e[1]);
+    }
+
+    ECP_MSM_mul(&P, Q, e, n);
+
+    ECP_SECP256K1_inf(&V);
+    for (int i = 0; i < n; i++)
+    {
+        ECP_SECP256K1_copy(&T, &Q[i]);
+        ECP_SECP256K1_mul(&T, e[i]);
+        ECP_SECP256K1_add(&V, &T);
+    }
+
+    if (!ECP_SECP256K1_equals(&P, &V))
+    {
+        printf("FAILURE ECP_MSM_mul n=%d\n", n);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    int sizes[] = {0, 1, 2, 5, ECP_MSM_STRAUS_MAX, ECP_MSM_STRAUS_MAX + 1, MAX_TERMS};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        check(&RNG, sizes[i]);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
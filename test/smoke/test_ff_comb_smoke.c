@@ -0,0 +1,126 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "amcl/randapi.h"
+#include "amcl/ff_comb.h"
+
+/* Fixed-base exponentiation smoke test */
+
+#define N_RANDOM 8
+
+// Safe prime P = 2p+1
+char *Phex = "e41615620cb68a9ea8df28551b27f333cf65c770c7e959435786d4b510fe360a304fd2bf437431e790dc4c54da6db03119e75ef0b3f47436acf78a9e7b2276ebdd864e49d3bf450c496b10471f024dc4ae1f659c41aacdfb8ee6d52ba46a82d41f79a14277a61474a6473b7e4ab82528383d6400dc71278941e16c138d74d5bb";
+
+static void compare(const char *name, BIG_1024_58 *r, BIG_1024_58 *golden)
+{
+    if (FF_2048_comp(r, golden, HFLEN_2048))
+    {
+        printf("FAILURE %s\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int main()
+{
+    BIG_1024_58 p[HFLEN_2048];
+    BIG_1024_58 pm1[HFLEN_2048];
+
+    BIG_1024_58 b0[FFLEN_2048];
+    BIG_1024_58 b1[FFLEN_2048];
+    BIG_1024_58 b0p[HFLEN_2048];
+    BIG_1024_58 b1p[HFLEN_2048];
+
+    BIG_1024_58 e0[HFLEN_2048];
+    BIG_1024_58 e1[HFLEN_2048];
+
+    BIG_1024_58 r[HFLEN_2048];
+    BIG_1024_58 golden[HFLEN_2048];
+
+    BIG_1024_58 T0[FF_COMB_SIZE];
+    BIG_1024_58 T1[FF_COMB_SIZE];
+
+    char oct[HFS_2048];
+    octet P = {0, sizeof(oct), oct};
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_fromHex(&P, Phex);
+    FF_2048_fromOctet(p, &P, HFLEN_2048);
+
+    FF_2048_copy(pm1, p, HFLEN_2048);
+    FF_2048_dec(pm1, 1, HFLEN_2048);
+
+    FF_2048_random(b0, &RNG, FFLEN_2048);
+    FF_2048_random(b1, &RNG, FFLEN_2048);
+    FF_2048_dmod(b0p, b0, p, HFLEN_2048);
+    FF_2048_dmod(b1p, b1, p, HFLEN_2048);
+
+    FF_COMB_precompute(T0, b0, p);
+    FF_COMB_precompute(T1, b1, p);
+
+    // Edge exponents
+    FF_2048_zero(e0, HFLEN_2048);
+    FF_COMB_pow(r, T0, e0, p);
+    FF_2048_one(golden, HFLEN_2048);
+    compare("FF_COMB_pow zero", r, golden);
+
+    FF_COMB_pow(r, T0, pm1, p);
+    FF_2048_ct_pow(golden, b0p, pm1, p, HFLEN_2048, HFLEN_2048);
+    compare("FF_COMB_pow p-1", r, golden);
+
+    for (int i = 0; i < N_RANDOM; i++)
+    {
+        FF_2048_randomnum(e0, pm1, &RNG, HFLEN_2048);
+        FF_2048_randomnum(e1, pm1, &RNG, HFLEN_2048);
+
+        FF_COMB_pow(r, T0, e0, p);
+        FF_2048_ct_pow(golden, b0p, e0, p, HFLEN_2048, HFLEN_2048);
+        compare("FF_COMB_pow", r, golden);
+
+        FF_COMB_pow2(r, T0, e0, T1, e1, p);
+        FF_2048_ct_pow_2(golden, b0p, e0, b1p, e1, p, HFLEN_2048, HFLEN_2048);
+        compare("FF_COMB_pow2", r, golden);
+
+        // c * b1^e0 with c = b0^e1
+        FF_2048_ct_pow(r, b0p, e1, p, HFLEN_2048, HFLEN_2048);
+        FF_2048_ct_pow_2(golden, b0p, e1, b1p, e0, p, HFLEN_2048, HFLEN_2048);
+        FF_COMB_nt_mul_pow(r, r, b1p, e0, p);
+        compare("FF_COMB_nt_mul_pow", r, golden);
+    }
+
+    FF_COMB_kill(T0);
+    FF_COMB_kill(T1);
+
+    for (int j = 0; j < FF_COMB_SIZE; j++)
+    {
+        if (!BIG_1024_58_iszilch(T0[j]))
+        {
+            printf("FAILURE FF_COMB_kill\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
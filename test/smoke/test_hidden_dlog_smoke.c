@@ -57,6 +57,9 @@ int main()
     HDLOG_iter_values r;
     HDLOG_iter_values rho;
     HDLOG_iter_values t;
+    HDLOG_iter_values rho_mt;
+
+    HDLOG_comb C;
 
     char id[32];
     octet ID = {0, sizeof(id), id};
@@ -114,6 +117,49 @@ int main()
         exit(EXIT_FAILURE);
     }
 
+    // Multi-threaded commitment from the same R must match
+    HDLOG_commit_mt(NULL, &m, ord, b0, r, rho_mt, 4);
+
+    for (int i = 0; i < HDLOG_PROOF_ITERS; i++)
+    {
+        if (FF_2048_comp(rho[i], rho_mt[i], FFLEN_2048))
+        {
+            printf("FAILURE HDLOG_commit_mt at %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Commitment with a precomputed comb must also match
+    HDLOG_comb_precompute(&C, &m, b0);
+    HDLOG_commit_comb_mt(NULL, &m, ord, &C, r, rho_mt, 2);
+    HDLOG_comb_kill(&C);
+
+    for (int i = 0; i < HDLOG_PROOF_ITERS; i++)
+    {
+        if (FF_2048_comp(rho[i], rho_mt[i], FFLEN_2048))
+        {
+            printf("FAILURE HDLOG_commit_comb_mt at %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    rc = HDLOG_verify_mt(m.n, b0, b1, rho, &E, t, 4);
+    if (rc != HDLOG_OK)
+    {
+        printf("FAILURE HDLOG_verify_mt failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Invalid value in the last iteration must be caught
+    FF_2048_inc(t[HDLOG_PROOF_ITERS - 1], 1, FFLEN_2048);
+
+    rc = HDLOG_verify_mt(m.n, b0, b1, rho, &E, t, 4);
+    if (rc != HDLOG_FAIL)
+    {
+        printf("FAILURE HDLOG_verify_mt invalid proof accepted\n");
+        exit(EXIT_FAILURE);
+    }
+
     HDLOG_iter_values_kill(r);
 
     for (int i = 0; i < HDLOG_PROOF_ITERS; i++)
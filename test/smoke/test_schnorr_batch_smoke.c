@@ -0,0 +1,137 @@
+/*
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"); you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+*/
+
+#include "amcl/schnorr.h"
+
+/* Schnorr's proofs batch verification smoke test */
+
+#define N_PROOFS 5
+
+static void init(char *mem, octet *O, int max, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        O[i].len = 0;
+        O[i].max = max;
+        O[i].val = mem + i * max;
+    }
+}
+
+int main()
+{
+    int rc;
+    int bad;
+
+    BIG_256_56 x;
+    BIG_256_56 q;
+    ECP_SECP256K1 G;
+
+    char id[32];
+    octet ID = {0, sizeof(id), id};
+
+    char x_char[SGS_SECP256K1];
+    octet X = {0, sizeof(x_char), x_char};
+
+    char r[SGS_SECP256K1];
+    octet R = {0, sizeof(r), r};
+
+    char v[N_PROOFS][SFS_SECP256K1+1];
+    octet V[N_PROOFS];
+
+    char c[N_PROOFS][SFS_SECP256K1+1];
+    octet C[N_PROOFS];
+
+    char e[N_PROOFS][SGS_SECP256K1];
+    octet E[N_PROOFS];
+
+    char p[N_PROOFS][SGS_SECP256K1];
+    octet P[N_PROOFS];
+
+    init((char *)v, V, SFS_SECP256K1+1, N_PROOFS);
+    init((char *)c, C, SFS_SECP256K1+1, N_PROOFS);
+    init((char *)e, E, SGS_SECP256K1, N_PROOFS);
+    init((char *)p, P, SGS_SECP256K1, N_PROOFS);
+
+    // Deterministic RNG for testing
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
+    OCT_rand(&ID, &RNG, ID.len);
+
+    BIG_256_56_rcopy(q, CURVE_Order_SECP256K1);
+
+    for (int i = 0; i < N_PROOFS; i++)
+    {
+        BIG_256_56_randomnum(x, q, &RNG);
+
+        ECP_SECP256K1_generator(&G);
+        ECP_SECP256K1_mul(&G, x);
+
+        BIG_256_56_toBytes(X.val, x);
+        X.len = SGS_SECP256K1;
+
+        ECP_SECP256K1_toOctet(V + i, &G, 1);
+
+        SCHNORR_commit(&RNG, &R, C + i);
+        SCHNORR_challenge(V + i, C + i, &ID, NULL, E + i);
+        SCHNORR_prove(&R, E + i, &X, P + i);
+    }
+
+    rc = SCHNORR_batch_verify(&RNG, V, C, E, P, N_PROOFS, &bad);
+    if (rc)
+    {
+        printf("FAILURE SCHNORR_batch_verify. RC %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // The invalid proof is found
+    P[3].val[0] ^= 1;
+    rc = SCHNORR_batch_verify(&RNG, V, C, E, P, N_PROOFS, &bad);
+    if (rc != SCHNORR_FAIL || bad != 3)
+    {
+        printf("FAILURE SCHNORR_batch_verify invalid proof. RC %d, bad %d\n", rc, bad);
+        exit(EXIT_FAILURE);
+    }
+    P[3].val[0] ^= 1;
+
+    // The first of two invalid proofs is found
+    P[4].val[0] ^= 1;
+    P[1].val[0] ^= 1;
+    rc = SCHNORR_batch_verify(&RNG, V, C, E, P, N_PROOFS, &bad);
+    if (rc != SCHNORR_FAIL || bad != 1)
+    {
+        printf("FAILURE SCHNORR_batch_verify invalid proofs. RC %d, bad %d\n", rc, bad);
+        exit(EXIT_FAILURE);
+    }
+    P[4].val[0] ^= 1;
+    P[1].val[0] ^= 1;
+
+    // Invalid commitment
+    C[2].val[0] = 0x05;
+    rc = SCHNORR_batch_verify(&RNG, V, C, E, P, N_PROOFS, &bad);
+    if (rc != SCHNORR_INVALID_ECP || bad != 2)
+    {
+        printf("FAILURE SCHNORR_batch_verify invalid ECP. RC %d, bad %d\n", rc, bad);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("SUCCESS\n");
+    exit(EXIT_SUCCESS);
+}
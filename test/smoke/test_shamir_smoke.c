@@ -167,6 +167,51 @@ int main()
         }
     }
 
+    // Verify all the shares at once
+    int bad;
+
+    rc = VSS_batch_verify_shares(k, n, X, Y, C, 0, &bad);
+
+    if (rc != VSS_OK || bad != -1)
+    {
+        printf("FAILURE VSS_batch_verify_shares. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Same checks repeated for each share, as if from different dealers
+    char cc[n * k][1 + SFS_SECP256K1];
+    octet CC[n * k];
+
+    for(i = 0; i < n * k; i++)
+    {
+        CC[i].max = 1 + SFS_SECP256K1;
+        CC[i].len = 0;
+        CC[i].val = cc[i];
+
+        OCT_copy(CC + i, C + i % k);
+    }
+
+    rc = VSS_batch_verify_shares(k, n, X, Y, CC, k, &bad);
+
+    if (rc != VSS_OK || bad != -1)
+    {
+        printf("FAILURE VSS_batch_verify_shares, one share per dealer. rc %d\n", rc);
+        exit(EXIT_FAILURE);
+    }
+
+    // Tamper with one share and identify it
+    Y[2].val[0] ^= 0x01;
+
+    rc = VSS_batch_verify_shares(k, n, X, Y, C, 0, &bad);
+
+    if (rc != VSS_INVALID_SHARES || bad != 2)
+    {
+        printf("FAILURE VSS_batch_verify_shares, invalid share. rc %d, bad %d\n", rc, bad);
+        exit(EXIT_FAILURE);
+    }
+
+    Y[2].val[0] ^= 0x01;
+
     // Test secret recovery when shares are generated using VSS
     SSS_recover_secret(k, &shares, &S);
 
@@ -34,6 +34,7 @@ int main(int argc, char **argv)
     }
 
     int rc;
+    int bad;
     int test_run = 0;
 
     FILE *fp;
@@ -61,6 +62,11 @@ int main(int argc, char **argv)
     octet E = {0, sizeof(e), e};
     const char *Eline = "E = ";
 
+    // Deterministic RNG for the batching coefficients
+    char seed[32] = {0};
+    csprng RNG;
+    RAND_seed(&RNG, 32, seed);
+
     // Line terminating a test vector
     const char *last_line = Tline;
 
@@ -92,6 +98,10 @@ int main(int argc, char **argv)
 
             assert_tv(fp, testNo, "HDLOG_verify", rc == HDLOG_OK);
 
+            rc = HDLOG_batch_verify(&RNG, N, B0, B1, RHO, &E, T, &bad);
+
+            assert_tv(fp, testNo, "HDLOG_batch_verify", rc == HDLOG_OK && bad == -1);
+
             // Mark that at least one test vector was executed
             test_run = 1;
         }
@@ -112,6 +122,10 @@ int main(int argc, char **argv)
 
     assert(NULL, "HDLOG_verify. Invalid proof", rc == HDLOG_FAIL);
 
+    rc = HDLOG_batch_verify(&RNG, N, B0, B1, RHO, &E, T, &bad);
+
+    assert(NULL, "HDLOG_batch_verify. Invalid proof", rc == HDLOG_FAIL && bad == 1);
+
     printf("SUCCESS\n");
     exit(EXIT_SUCCESS);
 }